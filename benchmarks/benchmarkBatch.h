@@ -0,0 +1,59 @@
+#ifndef __INCLUDE_GUARD_benchmarkBatch_h__
+#define __INCLUDE_GUARD_benchmarkBatch_h__
+
+
+
+// Scalar loops over Float3 (how Mesh used to transform its vertices) against the mathf::batch kernels.
+void BenchmarkBatch()
+{
+	constexpr size_t count = 1000000;
+	std::vector<Float3> points(count);
+	for (Float3& point : points)
+		point = Float3(mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f));
+	std::vector<Float3> work = points;
+	Float3x3 rotation = Float3x3::RotateY(0.1f) * Float3x3::RotateX(0.2f);
+	Float4x4 trs = Float4x4::TRS(Float3(1.0f, 2.0f, 3.0f), rotation, Float3(1.0f));
+	Float3 translation = Float3(0.5f, -0.25f, 0.125f);
+
+	std::cout << "mathf::batch, " << count << " Float3, scalar loop -> batch:\n";
+	double before, after;
+
+	before = Measure([&]() { for (Float3& point : work) point += translation; Consume(work); });
+	after = Measure([&]() { mathf::batch::Translate(work, translation); Consume(work); });
+	Report("translate", before, after);
+
+	work = points;
+	before = Measure([&]() { for (Float3& point : work) point = rotation * point; Consume(work); });
+	after = Measure([&]() { mathf::batch::Transform(work, rotation); Consume(work); });
+	Report("rotate (Float3x3)", before, after);
+
+	work = points;
+	before = Measure([&]() { for (Float3& point : work) point = Float3(trs * Float4(point, 1.0f)); Consume(work); });
+	work = points;
+	after = Measure([&]() { mathf::batch::TransformPoints(work, trs); Consume(work); });
+	Report("transform points (Float4x4)", before, after);
+
+	work = points;
+	before = Measure([&]() { for (Float3& point : work) point = point.Normalize(); Consume(work); });
+	work = points;
+	after = Measure([&]() { mathf::batch::Normalize(work); Consume(work); });
+	Report("normalize", before, after);
+
+	Float3 min, max;
+	before = Measure([&]()
+	{
+		min = max = points[0];
+		for (const Float3& point : points)
+		{
+			min = Float3::Min(min, point);
+			max = Float3::Max(max, point);
+		}
+		sink = min.x + max.x;
+	});
+	after = Measure([&]() { mathf::batch::MinMax(points, min, max); sink = min.x + max.x; });
+	Report("min/max", before, after);
+}
+
+
+
+#endif // __INCLUDE_GUARD_benchmarkBatch_h__
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef __INCLUDE_GUARD_benchmarkMatrix_h__
+#define __INCLUDE_GUARD_benchmarkMatrix_h__
+
+
+
+// Matrix operator throughput on 1M elements, run on two trees to compare out-of-line against header-inline operators.
+void BenchmarkMatrix()
+{
+	constexpr size_t count = 1000000;
+	std::vector<Float3> vectors(count);
+	for (Float3& vector : vectors)
+		vector = Float3(mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f));
+	std::vector<Float3> work = vectors;
+	Float2x2 rotation2 = Float2x2::Rotate(0.1f);
+	Float3x3 rotation3 = Float3x3::RotateY(0.1f) * Float3x3::RotateX(0.2f);
+	Float4x4 trs = Float4x4::TRS(Float3(1.0f, 2.0f, 3.0f), rotation3, Float3(1.0f));
+
+	std::cout << "matrix operators, " << count << " elements:\n";
+
+	Report("Float2x2 * Float2", Measure([&]()
+	{
+		for (Float3& vector : work)
+		{
+			Float2 xy = rotation2 * Float2(vector.x, vector.y);
+			vector.x = xy.x;
+			vector.y = xy.y;
+		}
+		Consume(work);
+	}));
+	Report("Float3x3 * Float3", Measure([&]() { for (Float3& vector : work) vector = rotation3 * vector; Consume(work); }));
+	Report("Float3 * Float3x3", Measure([&]() { for (Float3& vector : work) vector = vector * rotation3; Consume(work); }));
+	Report("Float3x3 * Float3x3", Measure([&]()
+	{
+		Float3x3 matrix = Float3x3::identity;
+		for (size_t i = 0; i < count; i++)
+			matrix = rotation3 * matrix;
+		sink = matrix[0];
+	}));
+	Report("Float3x3 Determinant", Measure([&]()
+	{
+		float sum = 0.0f;
+		for (const Float3& vector : vectors)
+			sum += Float3x3::Columns(vector, rotation3.GetColumn(1), rotation3.GetColumn(2)).Determinant();
+		sink = sum;
+	}));
+	Report("Float4 * Float4x4", Measure([&]() { for (Float3& vector : work) vector = Float3(Float4(vector, 1.0f) * trs); Consume(work); }));
+	Report("Float4x4 * Float4x4", Measure([&]()
+	{
+		Float4x4 matrix = Float4x4::identity;
+		for (size_t i = 0; i < count; i++)
+			matrix = trs * matrix;
+		sink = matrix[0];
+	}));
+	Report("Float4x4 + Float4x4 * s", Measure([&]()
+	{
+		Float4x4 matrix = Float4x4::zero;
+		for (size_t i = 0; i < count; i++)
+			matrix = 0.5f * (matrix + trs);
+		sink = matrix[0];
+	}));
+}
+
+
+
+#endif // __INCLUDE_GUARD_benchmarkMatrix_h__
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef __INCLUDE_GUARD_benchmarkShadowCascade_h__
+#define __INCLUDE_GUARD_benchmarkShadowCascade_h__
+#include "shadowCascade.h"
+
+
+
+// ShadowCascadeSolver::Solve() per directional light and frame, the camera moves a little between calls like in a game loop.
+void BenchmarkShadowCascade()
+{
+	constexpr uint32_t count = 100000;
+	float splits[3] = { 0.1f, 0.3f, 0.6f };
+	Float3 lightDirection = Float3(0.3f, -1.0f, 0.2f).Normalize();
+	std::array<ShadowCascade, ShadowCascadeSolver::s_maxCascadeCount> cascades;
+	std::vector<Float4x4> cameraLocalToWorldMatrices(1024);
+	for (uint32_t i = 0; i < cameraLocalToWorldMatrices.size(); i++)
+		cameraLocalToWorldMatrices[i] = Float4x4::TRS(Float3(0.01f * i, 2.0f, -0.02f * i), Float3x3::RotateY(0.001f * i), Float3::one);
+
+	std::cout << "ShadowCascadeSolver::Solve(), " << count << " calls, time per call:\n";
+	for (uint32_t cascadeCount = 1; cascadeCount <= ShadowCascadeSolver::s_maxCascadeCount; cascadeCount++)
+	{
+		double time = Measure([&]()
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				ShadowCascadeSolver::Solve(cameraLocalToWorldMatrices[i % 1024], 60.0f * mathf::DEG2RAD, 16.0f / 9.0f, 0.1f, 1000.0f,
+					lightDirection, cascadeCount, splits, 100.0f, 1024, cascades);
+				sink = cascades[cascadeCount - 1].worldToClipMatrix[0];
+			}
+		});
+		Report(std::to_string(cascadeCount) + " cascades", 1e6 * time / count, "ns");
+	}
+}
+
+
+
+#endif // __INCLUDE_GUARD_benchmarkShadowCascade_h__
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "logger.h"
+#include "mathf.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+// Number of runs per measurement, the fastest run is reported:
+constexpr int repetitions = 20;
+
+// Runs the function repeatedly and returns the fastest run in milliseconds:
+template<typename Function>
+double Measure(Function&& function)
+{
+	double best = std::numeric_limits<double>::max();
+	for (int i = 0; i < repetitions; i++)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		function();
+		auto end = std::chrono::high_resolution_clock::now();
+		best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+	}
+	return best;
+}
+
+// Prints one line of a before -> after comparison:
+void Report(const std::string& name, double before, double after, const std::string& unit = "ms")
+{
+	std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3)
+		<< std::setw(10) << before << " " << unit << " -> " << std::setw(10) << after << " " << unit
+		<< "  (x" << std::setprecision(1) << before / after << ")\n";
+}
+
+// Prints a single measurement:
+void Report(const std::string& name, double time, const std::string& unit = "ms")
+{
+	std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3)
+		<< std::setw(10) << time << " " << unit << "\n";
+}
+
+// Keeps results observable, so the measured loops can not be optimized away:
+volatile float sink;
+void Consume(std::span<const Float3> vectors)
+{
+	sink = vectors.front().x + vectors.back().z;
+}
+
+// mathf and shadow cascade benchmarks:
+#include "benchmarkBatch.h"
+#include "benchmarkMatrix.h"
+#include "benchmarkShadowCascade.h"
+
+
+
+int main()
+{
+	mathf::Random::Init();
+	Logger::Init();
+	BenchmarkBatch();
+	BenchmarkMatrix();
+	BenchmarkShadowCascade();
+	return 0;
+}
\ No newline at end of file
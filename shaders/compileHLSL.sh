@@ -0,0 +1,26 @@
+#!/bin/sh
+# Compiles all *.vert.hlsl and *.frag.hlsl shaders in this directory to SPIR-V (same flags as compileHLSL.bat).
+set -e
+cd "$(dirname "$0")"
+
+# Ensure dxc is available (Vulkan SDK or PATH):
+if [ -n "$VULKAN_SDK" ] && [ -x "$VULKAN_SDK/bin/dxc" ]; then
+    DXC_PATH="$VULKAN_SDK/bin/dxc"
+elif command -v dxc > /dev/null 2>&1; then
+    DXC_PATH="dxc"
+else
+    echo "compileHLSL.sh: dxc not found, install the Vulkan SDK or add dxc to the PATH." >&2
+    exit 1
+fi
+
+# Compile vertex shaders (*.vert.hlsl):
+for f in *.vert.hlsl; do
+    echo "Compiling vertex shader $f"
+    "$DXC_PATH" -spirv -T vs_6_0 -E main "$f" -Fo "${f%.hlsl}.spv"
+done
+
+# Compile fragment shaders (*.frag.hlsl):
+for f in *.frag.hlsl; do
+    echo "Compiling fragment shader $f"
+    "$DXC_PATH" -spirv -T ps_6_0 -E main "$f" -Fo "${f%.hlsl}.spv"
+done
\ No newline at end of file
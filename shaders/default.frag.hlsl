@@ -1,15 +1,13 @@
-SamplerState colorSampler : register(s10);
-SamplerComparisonState shadowSampler : register(s11);
-Texture2DArray<float> shadowMaps : register(t20);
-Texture2D colorMap : register(t21);     // format = VK_FORMAT_R8G8B8A8_SRGB,
-Texture2D roughnessMap : register(t22); // format = VK_FORMAT_R8_UNORM,         single channel unorm roughness map
-Texture2D normalMap : register(t23);    // format = VK_FORMAT_R8G8B8A8_UNORM,   opengl style unorm normal map
+SamplerState colorSampler : register(s10, space1);
+Texture2D colorMap : register(t21, space1);     // format = VK_FORMAT_R8G8B8A8_SRGB,
+Texture2D roughnessMap : register(t22, space1); // format = VK_FORMAT_R8_UNORM,         single channel unorm roughness map
+Texture2D normalMap : register(t23, space1);    // format = VK_FORMAT_R8G8B8A8_UNORM,   opengl style unorm normal map
 #include "shadowMapping.hlsli"
 #include "shadingPushConstant.hlsli"
 
 
 
-cbuffer SurfaceProperties : register(b1)
+cbuffer SurfaceProperties : register(b1, space1)
 {
     float4 diffuseColor;    // (1.0, 1.0, 1.0)
     float roughness;        // 0.5
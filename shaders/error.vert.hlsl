@@ -1,14 +1,12 @@
+#include "frameData.hlsli"
 #include "shadingPushConstant.hlsli"
 
 
 
-cbuffer RenderMatrizes : register(b0)
+cbuffer RenderMatrizes : register(b0, space1)
 {
     float4x4 modelMatrix;       // mesh local to world matrix
-    float4x4 viewMatrix;        // camera world to local matrix
-    float4x4 projMatrix;        // camera projection matrix
     float4x4 normalMatrix;      // rotation matrix for directions: (model^-1)^T
-    float4x4 localToClipMatrix; // local to camera clip space matrix: (projection * view * model)
 };
 
 
@@ -28,6 +26,6 @@ struct VertexOutput
 VertexOutput main(VertexInput input)
 { 
     VertexOutput output;
-    output.clipPosition = mul(localToClipMatrix, float4(input.position, 1.0f));
+    output.clipPosition = mul(worldToClipMatrix, mul(modelMatrix, float4(input.position, 1.0f)));
     return output;
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef __INCLUDE_GUARD_frameData_hlsli__
+#define __INCLUDE_GUARD_frameData_hlsli__
+
+
+
+// Per frame data shared by all draw calls, descriptor set 0 (space0). Must match frameData.h.
+// Written once per frame by the renderer. Per object resources live in descriptor set 1 (space1).
+static const uint MAX_D_LIGHTS = 3;     // directional lights: sun, moon, etc.
+static const uint MAX_S_LIGHTS = 10;    // spot lights: car headlights, etc.
+static const uint MAX_P_LIGHTS = 5;     // point lights: candles, etc.
+static const uint MAX_D_CASCADES = 4;   // shadow cascades per directional light, ShadowCascadeSolver::s_maxCascadeCount
+
+
+
+struct DirectionalLightData
+{
+    float4x4 worldToClipMatrix[MAX_D_CASCADES]; // world to light clip space matrix per shadow cascade (projection * view), finest first
+    float3 direction;           // light direction
+    uint cascadeCount;          // valid entries of worldToClipMatrix and shadowAtlasRect
+    float4 colorIntensity;      // light color (xyz) and intensity (w)
+    float4 shadowAtlasRect[MAX_D_CASCADES]; // shadow map tile per cascade in atlas uv space: offset (xy) and size (zw)
+};
+struct SpotLightData
+{
+    float4x4 worldToClipMatrix; // world to light clip space matrix (projection * view)
+    float3 position;            // light position
+    float4 colorIntensity;      // light color (xyz) and intensity (w)
+    float2 blendStartEnd;
+    float4 shadowAtlasRect;     // shadow map tile in atlas uv space: offset (xy) and size (zw)
+};
+struct PointLightData
+{
+    float4x4 worldToClipMatrix[6]; // world to light clip space matrix (projection * view)
+    float3 position; // light position
+    float4 colorIntensity; // light color (xyz) and intensity (w)
+    float4 shadowAtlasRect[6]; // shadow map tile per cube face in atlas uv space: offset (xy) and size (zw)
+};
+
+
+
+cbuffer CameraData : register(b0, space0)
+{
+    float4x4 viewMatrix;        // camera world to local matrix
+    float4x4 projMatrix;        // camera projection matrix
+    float4x4 worldToClipMatrix; // world to camera clip space matrix: (projection * view)
+};
+cbuffer LightData : register(b1, space0)
+{
+    DirectionalLightData directionalLightData[MAX_D_LIGHTS];
+    SpotLightData spotLightData[MAX_S_LIGHTS];
+    PointLightData pointLightData[MAX_P_LIGHTS];
+};
+SamplerComparisonState shadowSampler : register(s2, space0);
+Texture2D<float> shadowMaps : register(t3, space0);  // shadow atlas, see shadowAtlasRect of the lights
+
+
+
+#endif //__INCLUDE_GUARD_frameData_hlsli__
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef __INCLUDE_GUARD_instanceData_hlsli__
+#define __INCLUDE_GUARD_instanceData_hlsli__
+
+
+
+// Per instance data of instanced draw calls, must match InstanceData in instanceData.h.
+// SV_InstanceID includes the firstInstance of the draw call, so it indexes the whole buffer directly.
+struct InstanceData
+{
+    float4x4 modelMatrix;   // mesh local to world matrix
+    float4x4 normalMatrix;  // rotation matrix for directions: (model^-1)^T
+    float4 color;           // replaces SurfaceProperties.diffuseColor
+};
+StructuredBuffer<InstanceData> instanceData : register(t30, space1);
+
+
+
+#endif //__INCLUDE_GUARD_instanceData_hlsli__
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "frameData.hlsli"
+#include "pointShadowPushConstant.hlsli"
+
+
+
+struct VertexInput
+{
+    float3 position : POSITION;
+};
+
+struct VertexOutput
+{
+    float4 position : SV_POSITION;
+    float4 clipDistance : SV_ClipDistance0;
+};
+
+
+
+// All cube faces of a point light are rendered in one instanced draw. The viewport covers the whole shadow atlas,
+// so every instance maps its face clip space into the face tile and clips triangles at the tile borders.
+VertexOutput main(VertexInput input, uint instanceID : SV_InstanceID)
+{
+    uint faceIndex = (pc.faceIndices >> (4 * instanceID)) & 0xF;
+    PointLightData light = pointLightData[pc.pointLightIndex];
+    float4 worldPos = mul(pc.localToWorldMatrix, float4(input.position, 1.0));
+    float4 clipPos = mul(light.worldToClipMatrix[faceIndex], worldPos);
+
+    // Tile uv rect (offset, size) to atlas clip space, linear in clipPos so perspective is preserved:
+    float4 rect = light.shadowAtlasRect[faceIndex];
+    VertexOutput output;
+    output.position = float4(clipPos.xy * rect.zw + (2.0 * rect.xy + rect.zw - 1.0) * clipPos.w, clipPos.zw);
+    output.clipDistance = float4(clipPos.w + clipPos.x, clipPos.w - clipPos.x, clipPos.w + clipPos.y, clipPos.w - clipPos.y);
+    return output;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef __INCLUDE_GUARD_pointShadowPushConstant_hlsli__
+#define __INCLUDE_GUARD_pointShadowPushConstant_hlsli__
+
+
+
+struct PointShadowPushConstant
+{
+    float4x4 localToWorldMatrix;
+    uint pointLightIndex;
+    uint faceIndices;   // 4 bits per instance: cube face rendered by instance i = (faceIndices >> 4 * i) & 0xF
+};
+#if defined(_DXC)
+[[vk::push_constant]] PointShadowPushConstant pc;
+#else
+[[vk::push_constant]] ConstantBuffer<PointShadowPushConstant> pc;
+#endif
+
+
+
+#endif //__INCLUDE_GUARD_pointShadowPushConstant_hlsli__
\ No newline at end of file
@@ -10,7 +10,6 @@ struct VertexInput
 struct VertexOutput
 {
     float4 position : SV_POSITION;
-    uint layer : SV_RenderTargetArrayIndex;
 };
 
 
@@ -21,6 +20,5 @@ VertexOutput main(VertexInput input)
     
     VertexOutput output;
     output.position = mul(pc.localToClipMatrix, pos);
-    output.layer = pc.shadowMapIndex;
     return output;
 }
\ No newline at end of file
@@ -1,39 +1,13 @@
 #ifndef __INCLUDE_GUARD_shadowMapping_hlsli__
 #define __INCLUDE_GUARD_shadowMapping_hlsli__
+#include "frameData.hlsli"
 #include "mathf.hlsli"
 
 
 
-static const uint MAX_D_LIGHTS = 3;     // directional lights: sun, moon, etc.
-static const uint MAX_S_LIGHTS = 10;    // spot lights: car headlights, etc.
-static const uint MAX_P_LIGHTS = 5;     // point lights: candles, etc.
-
-
-
-struct DirectionalLightData
-{
-    float4x4 worldToClipMatrix; // world to light clip space matrix (projection * view)
-    float3 direction;           // light direction
-    float4 colorIntensity;      // light color (xyz) and intensity (w)
-};
-struct SpotLightData
+// Per object, the light data itself is global (frameData.hlsli):
+cbuffer ShadowProperties : register(b9, space1)
 {
-    float4x4 worldToClipMatrix; // world to light clip space matrix (projection * view)
-    float3 position;            // light position
-    float4 colorIntensity;      // light color (xyz) and intensity (w)
-    float2 blendStartEnd;
-};
-struct PointLightData
-{
-    float4x4 worldToClipMatrix[6]; // world to light clip space matrix (projection * view)
-    float3 position; // light position
-    float4 colorIntensity; // light color (xyz) and intensity (w)
-};
-cbuffer LightData : register(b9)
-{
-    DirectionalLightData directionalLightData[MAX_D_LIGHTS];
-    SpotLightData spotLightData[MAX_S_LIGHTS];
-    PointLightData pointLightData[MAX_P_LIGHTS];
     bool receiveShadows; // 0 = false, 1 = true
 }
 
@@ -59,6 +33,16 @@ float3 FresnelDistribution(float3 F0, float dot)
 {
     return F0 + (1.0f - F0) * pow(1.0f - dot, 5.0f);
 }
+// Maps light uv in [0,1] into the tile of the light in the shadow atlas.
+// The uv is kept half a texel inside the tile, so filtering never reads from neighbouring tiles.
+float SampleShadowAtlas(Texture2D<float> shadowMaps, SamplerComparisonState shadowSampler, float4 atlasRect, float2 lightUv, float depth)
+{
+    float width, height;
+    shadowMaps.GetDimensions(width, height);
+    float2 halfTexel = 0.5f / float2(width, height);
+    float2 atlasUv = clamp(atlasRect.xy + lightUv * atlasRect.zw, atlasRect.xy + halfTexel, atlasRect.xy + atlasRect.zw - halfTexel);
+    return shadowMaps.SampleCmp(shadowSampler, atlasUv, depth);
+}
 
 
 
@@ -90,23 +74,27 @@ float3 PhysicalLight
 
 float3 PhysicalDirectionalLights
 (float3 worldPos, float3 cameraPos, float3 normal, float3 color, float roughness, float3 reflectivity, bool metallic,
- int dLightsCount, int shadowMapOffset, DirectionalLightData lightData[MAX_D_LIGHTS],
- Texture2DArray<float> shadowMaps, SamplerComparisonState shadowSampler)
+ int dLightsCount, DirectionalLightData lightData[MAX_D_LIGHTS],
+ Texture2D<float> shadowMaps, SamplerComparisonState shadowSampler)
 {
     float3 totalLight = 0;
     for (uint i = 0; i < dLightsCount; i++)
     {
-        // Shadow:
+        // Shadow, from the finest cascade that contains the fragment. Fragments beyond the last cascade are not shadowed:
         float shadow = 0.0f;
         if (receiveShadows)
         {
-            float4 lightSpacePos = mul(lightData[i].worldToClipMatrix, float4(worldPos, 1.0f));
-            if (lightSpacePos.w > 1e-4f)
+            shadow = 1.0f;
+            for (uint cascadeIndex = 0; cascadeIndex < lightData[i].cascadeCount; cascadeIndex++)
             {
-                float3 lightUvz = lightSpacePos.xyz / lightSpacePos.w;
+                float4 lightSpacePos = mul(lightData[i].worldToClipMatrix[cascadeIndex], float4(worldPos, 1.0f));
+                float3 lightUvz = lightSpacePos.xyz / lightSpacePos.w; // orthographic, w = 1
                 lightUvz.xy = (lightUvz.xy + 1.0f) * 0.5f; // scale to [0, 1]
                 if (0.0f <= lightUvz.z && lightUvz.z <= 1.0f && 0.0 <= lightUvz.x && lightUvz.x <= 1.0 && 0.0 <= lightUvz.y && lightUvz.y <= 1.0)
-                    shadow = shadowMaps.SampleCmp(shadowSampler, float3(lightUvz.xy, i + shadowMapOffset), lightUvz.z - 0.01f);
+                {
+                    shadow = SampleShadowAtlas(shadowMaps, shadowSampler, lightData[i].shadowAtlasRect[cascadeIndex], lightUvz.xy, lightUvz.z - 0.01f);
+                    break;
+                }
             }
         }
         
@@ -122,8 +110,8 @@ float3 PhysicalDirectionalLights
 }
 float3 PhysicalSpotLights
 (float3 worldPos, float3 cameraPos, float3 normal, float3 color, float roughness, float3 reflectivity, bool metallic,
- int sLightsCount, int shadowMapOffset, SpotLightData lightData[MAX_S_LIGHTS],
- Texture2DArray<float> shadowMaps, SamplerComparisonState shadowSampler)
+ int sLightsCount, SpotLightData lightData[MAX_S_LIGHTS],
+ Texture2D<float> shadowMaps, SamplerComparisonState shadowSampler)
 {
     float3 totalLight = 0;
     for (uint i = 0; i < sLightsCount; i++)
@@ -141,8 +129,8 @@ float3 PhysicalSpotLights
                 float radius = length(2.0f * lightUvz.xy - 1.0f);
                 float falloff = saturate((radius - lightData[i].blendStartEnd.y) / (lightData[i].blendStartEnd.x - lightData[i].blendStartEnd.y));
                 
-                if (0.0f <= lightUvz.z && lightUvz.z <= 1.0f)
-                    shadow = falloff * shadowMaps.SampleCmp(shadowSampler, float3(lightUvz.xy, i + shadowMapOffset), lightUvz.z);
+                if (0.0f <= lightUvz.z && lightUvz.z <= 1.0f && 0.0 <= lightUvz.x && lightUvz.x <= 1.0 && 0.0 <= lightUvz.y && lightUvz.y <= 1.0)
+                    shadow = falloff * SampleShadowAtlas(shadowMaps, shadowSampler, lightData[i].shadowAtlasRect, lightUvz.xy, lightUvz.z);
             }
         }
         
@@ -159,8 +147,8 @@ float3 PhysicalSpotLights
 }
 float3 PhysicalPointLights
 (float3 worldPos, float3 cameraPos, float3 normal, float3 color, float roughness, float3 reflectivity, bool metallic,
- int pLightsCount, int shadowMapOffset, PointLightData lightData[MAX_P_LIGHTS],
- Texture2DArray<float> shadowMaps, SamplerComparisonState shadowSampler)
+ int pLightsCount, PointLightData lightData[MAX_P_LIGHTS],
+ Texture2D<float> shadowMaps, SamplerComparisonState shadowSampler)
 {
     float3 totalLight = 0;
     for (uint i = 0; i < pLightsCount; i++)
@@ -176,8 +164,8 @@ float3 PhysicalPointLights
                 {
                     float3 lightUvz = lightSpacePos.xyz / lightSpacePos.w;
                     lightUvz.xy = (lightUvz.xy + 1.0f) * 0.5f; // scale to [0, 1]
-                    if (0.0f <= lightUvz.z && lightUvz.z <= 1.0f)
-                        shadow = shadowMaps.SampleCmp(shadowSampler, float3(lightUvz.xy, 6 * i + faceIndex + shadowMapOffset), lightUvz.z);
+                    if (0.0f <= lightUvz.z && lightUvz.z <= 1.0f && 0.0 <= lightUvz.x && lightUvz.x <= 1.0 && 0.0 <= lightUvz.y && lightUvz.y <= 1.0)
+                        shadow = SampleShadowAtlas(shadowMaps, shadowSampler, lightData[i].shadowAtlasRect[faceIndex], lightUvz.xy, lightUvz.z);
                 }
             }
         
@@ -199,11 +187,11 @@ float3 PhysicalPointLights
 float3 PhysicalLighting
 (float3 worldPos, float3 cameraPos, float3 worldNormal, float3 color, float roughness, float3 reflectivity, bool metallic,
  int dLightsCount, int sLightsCount, int pLightsCount, DirectionalLightData directionalLightData[MAX_D_LIGHTS], SpotLightData spotLightData[MAX_S_LIGHTS], PointLightData pointLightData[MAX_P_LIGHTS],
- Texture2DArray<float> shadowMaps, SamplerComparisonState shadowSampler)
+ Texture2D<float> shadowMaps, SamplerComparisonState shadowSampler)
 {
-    float3 directionalLight = PhysicalDirectionalLights(worldPos, cameraPos, worldNormal, color, roughness, reflectivity, metallic, dLightsCount, 0, directionalLightData, shadowMaps, shadowSampler);
-    float3 spotLight        = PhysicalSpotLights       (worldPos, cameraPos, worldNormal, color, roughness, reflectivity, metallic, sLightsCount, dLightsCount               , spotLightData       , shadowMaps, shadowSampler);
-    float3 pointLight       = PhysicalPointLights      (worldPos, cameraPos, worldNormal, color, roughness, reflectivity, metallic, pLightsCount, dLightsCount + sLightsCount, pointLightData      , shadowMaps, shadowSampler);
+    float3 directionalLight = PhysicalDirectionalLights(worldPos, cameraPos, worldNormal, color, roughness, reflectivity, metallic, dLightsCount, directionalLightData, shadowMaps, shadowSampler);
+    float3 spotLight        = PhysicalSpotLights       (worldPos, cameraPos, worldNormal, color, roughness, reflectivity, metallic, sLightsCount, spotLightData       , shadowMaps, shadowSampler);
+    float3 pointLight       = PhysicalPointLights      (worldPos, cameraPos, worldNormal, color, roughness, reflectivity, metallic, pLightsCount, pointLightData      , shadowMaps, shadowSampler);
     return directionalLight + spotLight + pointLight;
 }
 
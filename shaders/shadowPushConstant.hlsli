@@ -5,7 +5,6 @@
 
 struct ShadowPushConstant
 {
-    int shadowMapIndex;
     float4x4 localToClipMatrix;
 };
 #if defined(_DXC)
@@ -1,11 +1,9 @@
-SamplerComparisonState shadowSampler : register(s11);
-Texture2DArray<float> shadowMaps : register(t20);
 #include "shadowMapping.hlsli"
 #include "shadingPushConstant.hlsli"
 
 
 
-cbuffer SurfaceProperties : register(b1)
+cbuffer SurfaceProperties : register(b1, space1)
 {
     float4 diffuseColor;    // (1.0, 1.0, 1.0)
     float roughness;        // 0.5
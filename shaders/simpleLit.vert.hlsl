@@ -1,14 +1,12 @@
+#include "frameData.hlsli"
 #include "shadingPushConstant.hlsli"
 
 
 
-cbuffer RenderMatrizes : register(b0)
+cbuffer RenderMatrizes : register(b0, space1)
 {
     float4x4 modelMatrix;       // mesh local to world matrix
-    float4x4 viewMatrix;        // camera world to local matrix
-    float4x4 projMatrix;        // camera projection matrix
     float4x4 normalMatrix;      // rotation matrix for directions: (model^-1)^T
-    float4x4 localToClipMatrix; // local to camera clip space matrix: (projection * view * model)
 };
 
 
@@ -34,7 +32,7 @@ VertexOutput main(VertexInput input)
     float4 normal = float4(input.normal, 0.0f);
     
     VertexOutput output;
-    output.clipPosition = mul(localToClipMatrix, pos);
+    output.clipPosition = mul(worldToClipMatrix, mul(modelMatrix, pos));
     output.worldNormal = mul(normalMatrix, normal).xyz;
     output.worldPosition = mul(modelMatrix, pos).xyz;
     return output;
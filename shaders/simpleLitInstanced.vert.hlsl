@@ -0,0 +1,38 @@
+#include "frameData.hlsli"
+#include "instanceData.hlsli"
+#include "shadingPushConstant.hlsli"
+
+
+
+struct VertexInput
+{
+    float3 position : POSITION; // position in local/model sapce
+    float3 normal : NORMAL;     // normal in local/model space
+    uint instanceID : SV_InstanceID;
+};
+
+struct VertexOutput
+{
+    float4 clipPosition : SV_POSITION;  // position in clip space: x,y[-1,1] z[0,1]
+    float3 worldNormal : NORMAL;        // normal in world space
+    float3 worldPosition : TEXCOORD1;   // position in world space
+    float4 color : COLOR;               // instance color
+};
+
+
+
+VertexOutput main(VertexInput input)
+{
+    float4 pos = float4(input.position, 1.0f);
+    float4 normal = float4(input.normal, 0.0f);
+    
+    InstanceData instance = instanceData[input.instanceID];
+    float4 worldPos = mul(instance.modelMatrix, pos);
+    
+    VertexOutput output;
+    output.clipPosition = mul(worldToClipMatrix, worldPos);
+    output.worldNormal = mul(instance.normalMatrix, normal).xyz;
+    output.worldPosition = worldPos.xyz;
+    output.color = instance.color;
+    return output;
+}
\ No newline at end of file
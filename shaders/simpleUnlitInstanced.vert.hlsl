@@ -0,0 +1,31 @@
+#include "frameData.hlsli"
+#include "instanceData.hlsli"
+#include "shadingPushConstant.hlsli"
+
+
+
+struct VertexInput
+{
+    float3 position : POSITION; // position in local/model sapce
+    uint instanceID : SV_InstanceID;
+};
+
+struct VertexOutput
+{
+    float4 clipPosition : SV_POSITION;  // position in clip space: x,y[-1,1] z[0,1]
+    float4 color : COLOR;               // instance color
+};
+
+
+
+VertexOutput main(VertexInput input)
+{
+    float4 pos = float4(input.position, 1.0f);
+    
+    InstanceData instance = instanceData[input.instanceID];
+    
+    VertexOutput output;
+    output.clipPosition = mul(worldToClipMatrix, mul(instance.modelMatrix, pos));
+    output.color = instance.color;
+    return output;
+}
\ No newline at end of file
@@ -1,5 +1,5 @@
-SamplerState colorSampler : register(s10);
-TextureCube colorMap : register(t28);
+SamplerState colorSampler : register(s10, space1);
+TextureCube colorMap : register(t28, space1);
 #include "shadingPushConstant.hlsli"
 
 
@@ -1,5 +1,5 @@
-SamplerState colorSampler : register(s10);
-Texture2D colorMap : register(t20);
+SamplerState colorSampler : register(s10, space1);
+Texture2D colorMap : register(t20, space1);
 
 
 
@@ -1,5 +1,5 @@
-SamplerState colorSampler : register(s10);
-TextureCube cubeMap : register(t20);
+SamplerState colorSampler : register(s10, space1);
+TextureCube cubeMap : register(t20, space1);
 
 
 
@@ -1,10 +1,11 @@
-cbuffer RenderMatrizes : register(b0)
+#include "frameData.hlsli"
+
+
+
+cbuffer RenderMatrizes : register(b0, space1)
 {
     float4x4 modelMatrix;       // mesh local to world matrix
-    float4x4 viewMatrix;        // camera world to local matrix
-    float4x4 projMatrix;        // camera projection matrix
     float4x4 normalMatrix;      // rotation matrix for directions: (model^-1)^T
-    float4x4 localToClipMatrix; // local to camera clip space matrix: (projection * view * model)
 };
 
 
@@ -26,7 +27,7 @@ struct VertexOutput
 VertexOutput main(VertexInput input)
 {
     VertexOutput output;
-    output.position = mul(localToClipMatrix, float4(input.position, 1.0));
+    output.position = mul(worldToClipMatrix, mul(modelMatrix, float4(input.position, 1.0)));
     output.uv = input.uv;
     return output;
 }
\ No newline at end of file
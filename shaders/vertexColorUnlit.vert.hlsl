@@ -1,14 +1,12 @@
+#include "frameData.hlsli"
 #include "shadingPushConstant.hlsli"
 
 
 
-cbuffer RenderMatrizes : register(b0)
+cbuffer RenderMatrizes : register(b0, space1)
 {
     float4x4 modelMatrix;       // mesh local to world matrix
-    float4x4 viewMatrix;        // camera world to local matrix
-    float4x4 projMatrix;        // camera projection matrix
     float4x4 normalMatrix;      // rotation matrix for directions: (model^-1)^T
-    float4x4 localToClipMatrix; // local to camera clip space matrix: (projection * view * model)
 };
 
 
@@ -33,7 +31,7 @@ VertexOutput main(VertexInput input)
     float4 pos = float4(input.position, 1.0);
     
     VertexOutput output;
-    output.clipPosition = mul(localToClipMatrix, pos);
+    output.clipPosition = mul(worldToClipMatrix, mul(modelMatrix, pos));
     output.vertexColor = input.vertexColor;
     return output;
 }
\ No newline at end of file
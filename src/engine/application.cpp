@@ -1,38 +1,52 @@
 #include "application.h"
 #include "component.h"
 #include "eventSystem.h"
+#include "frameData.h"
 #include "gameObject.h"
+#include "gpuTimer.h"
 #include "graphics.h"
 #include "logger.h"
 #include "materialManager.h"
 #include "meshManager.h"
+#include "profiler.h"
 #include "renderPassManager.h"
 #include "samplerManager.h"
 #include "scene.h"
+#include "shadowRenderPass.h"
 #include "textureManager.h"
 #include "timer.h"
+#include "uniformRingBuffer.h"
+#include "uploadManager.h"
 #include "vulkanContext.h"
 #include "vulkanRenderer.h"
+#include <algorithm>
+#include <chrono>
 
 
 
 // Constructor:
-Application::Application()
+Application::Application(const ApplicationSettings& settings)
 {
+	m_settings = settings;
 	m_pActiveScene = nullptr;
 	uint32_t framesInFlight = 2;
 	VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_4_BIT;
 	Logger::Init();
-	m_pContext = std::make_unique<VulkanContext>(framesInFlight, msaaSamples);
+	EMBER_PROFILE_THREAD("Main");
+	m_pContext = std::make_unique<VulkanContext>(framesInFlight, msaaSamples, m_settings.headless, VkExtent2D{ m_settings.width, m_settings.height });
 	m_pRenderer = std::make_unique<VulkanRenderer>(m_pContext.get());
 
 	// Init static managers:
 	mathf::Random::Init();
 	EventSystem::Init(m_pContext.get());
+	ShadowRenderPass::s_shadowMapFormat = m_settings.shadowMaps16Bit ? VK_FORMAT_D16_UNORM : VK_FORMAT_D32_SFLOAT;
 	RenderPassManager::Init(m_pContext.get());
+	SamplerManager::Init(m_pContext.get());
+	FrameData::Init(m_pContext.get());	// needs shadow render pass and sampler, must exist before any pipeline
+	UniformRingBuffer::Init(m_pContext.get());
+	UploadManager::Init(m_pContext.get());	// before any mesh or texture is loaded
 	MaterialManager::Init(m_pContext.get());
 	TextureManager::Init(m_pContext.get());
-	SamplerManager::Init(m_pContext.get());
 	MeshManager::Init(m_pContext.get());
 	Graphics::Init();
 }
@@ -45,9 +59,12 @@ Application::~Application()
 	// Clear static managers:
 	Graphics::Clear();
 	MeshManager::Clear();
-	SamplerManager::Clear();
 	TextureManager::Clear();
 	MaterialManager::Clear();
+	UploadManager::Clear();
+	UniformRingBuffer::Clear();
+	FrameData::Clear();
+	SamplerManager::Clear();
 	RenderPassManager::Clear();
 	EventSystem::Clear();
 }
@@ -55,24 +72,40 @@ Application::~Application()
 
 
 // Public methods:
-void Application::Run()
+bool Application::Run()
 {
+	// Without window there is nothing that could end the loop:
+	bool headless = m_pContext->IsHeadless();
+	uint32_t frameCount = m_settings.frameCount;
+	if (headless && frameCount == 0)
+	{
+		LOG_WARN("Headless mode needs a frameCount > 0, rendering a single frame.");
+		frameCount = 1;
+	}
+
 	Timer::Reset();
 	bool running = true;
 	Start();
 
-	while (running)
+	uint32_t renderedFrames = 0;
+	uint32_t attemptedFrames = 0;	// headless runs end after frameCount attempts, so failing frames cannot keep them alive
+	uint32_t lastImageIndex = 0;
+	std::chrono::steady_clock::time_point runStart = std::chrono::steady_clock::now();
+	while (running && (frameCount == 0 || (headless ? attemptedFrames : renderedFrames) < frameCount))
 	{
 		Timer::Update();
-		running = m_pContext->pWindow->HandleEvents();
-
-		// If window is minimized or width/height is zero, delay loop to reduce CPU usage:
-		VkExtent2D windowExtent = m_pContext->pWindow->GetExtent();
-		VkExtent2D surfaceExtend = m_pContext->pSurface->GetCurrentExtent();
-		if (m_pContext->pWindow->GetIsMinimized() || windowExtent.width == 0 || windowExtent.height == 0 || surfaceExtend.width == 0 || surfaceExtend.height == 0)
+		if (!headless)
 		{
-			SDL_Delay(10);
-			continue;
+			running = m_pContext->pWindow->HandleEvents();
+
+			// If window is minimized or width/height is zero, delay loop to reduce CPU usage:
+			VkExtent2D windowExtent = m_pContext->pWindow->GetExtent();
+			VkExtent2D surfaceExtend = m_pContext->pSurface->GetCurrentExtent();
+			if (m_pContext->pWindow->GetIsMinimized() || windowExtent.width == 0 || windowExtent.height == 0 || surfaceExtend.width == 0 || surfaceExtend.height == 0)
+			{
+				SDL_Delay(10);
+				continue;
+			}
 		}
 
 		// Game update loop:
@@ -80,9 +113,39 @@ void Application::Run()
 		LateUpdate();
 
 		// Render loop:
+		bool captureProfile = !headless && EventSystem::KeyDown(SDLK_F12);
+		attemptedFrames++;
 		if (m_pRenderer->RenderFrame(m_pActiveScene))
+		{
+			lastImageIndex = m_pRenderer->GetImageIndex();
 			m_pContext->UpdateFrameIndex();
+			renderedFrames++;
+			captureProfile |= renderedFrames == m_settings.profileFrame;
+		}
+		else if (headless)
+			LOG_ERROR("Headless frame {} of {} failed to render.", attemptedFrames, frameCount);
+
+		// Worker threads are idle between frames, so the ring buffers can be read safely:
+		if (captureProfile)
+			Profiler::WriteChromeTrace("../profiling/trace_frame" + std::to_string(renderedFrames) + ".json");
+	}
+	m_pContext->WaitDeviceIdle();
+
+	if (headless)
+	{
+		float totalTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - runStart).count();
+		LOG_INFO("Rendered {} headless frames in {:.2f}ms, {:.3f}ms per frame.", renderedFrames, totalTime, totalTime / std::max(renderedFrames, 1u));
+		const GpuTimer* pGpuTimer = m_pRenderer->GetGpuTimer();
+		if (pGpuTimer->IsEnabled())
+			LOG_INFO("Gpu frame: {:.3f}ms, shadow pass: {:.3f}ms, shading pass: {:.3f}ms (average of the last frames).", pGpuTimer->GetFrameTime(), pGpuTimer->GetShadowPassTime(), pGpuTimer->GetShadingPassTime());
+		const RenderStats& stats = m_pRenderer->GetStats();
+		LOG_INFO("Last frame: {} draw calls, {} triangles, {} pipeline binds, {} descriptor set binds, {} push constants, {} uniform bytes, {}/{} renderers culled.",
+			stats.drawCalls, stats.triangles, stats.pipelineBinds, stats.descriptorSetBinds, stats.pushConstantUpdates, stats.uniformBytes, stats.culledRenderers, stats.activeRenderers + stats.culledRenderers);
+		LOG_INFO("Last frame: {} shadow maps rendered, {} reused.", stats.shadowMapsRendered, stats.shadowMapsReused);
+		if (!m_settings.readbackPath.empty() && renderedFrames > 0)
+			m_pContext->pOffscreenTargets->SaveAsPpm(lastImageIndex, m_settings.readbackPath);
 	}
+	return !headless || renderedFrames == attemptedFrames;
 }
 void Application::SetScene(Scene* pScene)
 {
@@ -109,6 +172,7 @@ void Application::Start()
 }
 void Application::Update()
 {
+	EMBER_PROFILE_SCOPE("Application::Update");
 	// Update all components of all game objects:
 	for (auto& [_, gameObject] : m_pActiveScene->GetGameObjects())
 	{
@@ -124,6 +188,7 @@ void Application::Update()
 }
 void Application::LateUpdate()
 {
+	EMBER_PROFILE_SCOPE("Application::LateUpdate");
 	// Late update all components of all game objects:
 	for (auto& [_, gameObject] : m_pActiveScene->GetGameObjects())
 	{
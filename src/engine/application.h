@@ -1,5 +1,6 @@
 #ifndef __INCLUDE_GUARD_application_h__
 #define __INCLUDE_GUARD_application_h__
+#include <filesystem>
 #include <memory>
 
 
@@ -9,17 +10,39 @@ class VulkanRenderer;
 
 
 
+/// <summary>
+/// Startup options of the application. <para/>
+/// - headless:		render into offscreen images instead of a window, e.g. for benchmarks and ci regression tests. <para/>
+/// - width/height:	render resolution in headless mode, windowed mode uses the window size. <para/>
+/// - frameCount:	number of frames to render before Run() returns, 0 = until the window is closed. <para/>
+/// - readbackPath:	if not empty, the last rendered frame is saved there as .ppm when Run() returns (headless only). <para/>
+/// - profileFrame:	if not 0, a profiler capture is written after this many frames. F12 captures at any time. <para/>
+/// </summary>
+struct ApplicationSettings
+{
+	bool headless = false;
+	uint32_t width = 1280;
+	uint32_t height = 720;
+	uint32_t frameCount = 0;
+	std::filesystem::path readbackPath;
+	uint32_t profileFrame = 0;
+	bool shadowMaps16Bit = false;	// D16 instead of D32 shadow atlas, halves its memory
+};
+
+
+
 class Application
 {
 private: // Members:
+	ApplicationSettings m_settings;
 	std::unique_ptr<VulkanContext> m_pContext;
 	std::unique_ptr<VulkanRenderer> m_pRenderer;
 	Scene* m_pActiveScene;
 
 public: // Methods:
-	Application();
+	Application(const ApplicationSettings& settings = {});
 	~Application();
-	void Run();
+	bool Run();	// false if a headless frame failed to render.
 	void SetScene(Scene* pScene);
 
 private: // Methods:
@@ -47,7 +47,7 @@ void CameraController::Rotation()
 	if (EventSystem::MouseDown(EventSystem::MouseButton::right))
 	{
 		m_mousePosOnDown = EventSystem::MousePos();
-		m_rotationMatrixOnDown = m_pTransform->GetRotation3x3();
+		m_rotationOnDown = m_pTransform->GetRotation();
 	}
 
 	if (EventSystem::MouseHeld(EventSystem::MouseButton::right))
@@ -55,10 +55,10 @@ void CameraController::Rotation()
 		Float2 mousePos = EventSystem::MousePos();
 		Float2 delta = 0.001f * m_rotationSpeed * (mousePos - m_mousePosOnDown);
 
-		// Rotate around global Y-axis and local X-axis (note matrix multiplication order):
-		Float3x3 rotY = Float3x3::RotateY(-delta.x);
-		Float3x3 rotX = Float3x3::RotateX(-delta.y);
-		m_pTransform->SetRotationMatrix(rotY * m_rotationMatrixOnDown * rotX);
+		// Rotate around global Y-axis and local X-axis (note quaternion multiplication order):
+		Quaternion rotY = Quaternion::RotateY(-delta.x);
+		Quaternion rotX = Quaternion::RotateX(-delta.y);
+		m_pTransform->SetRotation((rotY * m_rotationOnDown * rotX).Normalize());
 	}
 }
 void CameraController::Zoom()
@@ -13,7 +13,7 @@ private: // Members:
 	float m_zoomSpeed;
 
 	Float2 m_mousePosOnDown;
-	Float3x3 m_rotationMatrixOnDown;
+	Quaternion m_rotationOnDown;
 
 
 public: // Methods:
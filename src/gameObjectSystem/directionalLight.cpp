@@ -1,5 +1,5 @@
 #include "directionalLight.h"
-#include "shadowCascade.h"
+#include "shadowAtlas.h"
 
 
 
@@ -10,6 +10,7 @@ DirectionalLight::DirectionalLight()
 	m_color = Float3::white;
 	m_nearClip = 0.01f;
 	m_farClip = 15.0f;
+	m_timeSlicedShadows = false;
 	m_viewWidth = 15.0f;
 	m_viewHeight = 15.0f;
 	m_updateProjectionMatrix = true;
@@ -21,6 +22,8 @@ DirectionalLight::DirectionalLight()
 	m_shadowCascadeSplits[0] = 0.1;
 	m_shadowCascadeSplits[1] = 0.3;
 	m_shadowCascadeSplits[2] = 0.6;
+	m_shadowCascades.fill(ShadowCascade{});
+	m_solvedShadowCascadeCount = 0;
 
 	// Visualization:
 	m_drawFrustum = false;
@@ -55,6 +58,10 @@ void DirectionalLight::SetFarClip(float farClip)
 	m_farClip = farClip;
 	m_updateProjectionMatrix = true;
 }
+void DirectionalLight::SetTimeSlicedShadows(bool timeSlicedShadows)
+{
+	m_timeSlicedShadows = timeSlicedShadows;
+}
 void DirectionalLight::SetViewWidth(float viewWidth)
 {
 	m_viewWidth = viewWidth;
@@ -139,6 +146,10 @@ float DirectionalLight::GetFarClip() const
 {
 	return m_farClip;
 }
+bool DirectionalLight::GetTimeSlicedShadows() const
+{
+	return m_timeSlicedShadows;
+}
 float DirectionalLight::GetViewWidth() const
 {
 	return m_viewWidth;
@@ -171,6 +182,33 @@ const float* const DirectionalLight::GetShadowCascadeSplits() const
 {
 	return m_shadowCascadeSplits;
 }
+/// <summary>
+/// Cascade solved in the last LateUpdate(), only the first GetSolvedShadowCascadeCount() cascades are valid.
+/// </summary>
+const ShadowCascade& DirectionalLight::GetShadowCascade(uint32_t index) const
+{
+	if (index >= m_solvedShadowCascadeCount)
+	{
+		LOG_WARN("DirectionalLight::GetShadowCascade() index {} is out of range, the light has {} solved cascades.", index, m_solvedShadowCascadeCount);
+		return m_shadowCascades[0];
+	}
+	return m_shadowCascades[index];
+}
+/// <summary>
+/// Number of cascades solved in the last LateUpdate(). Zero if the light has no active camera,
+/// the renderer then falls back to a single shadow map with GetProjectionMatrix() * GetViewMatrix().
+/// </summary>
+uint32_t DirectionalLight::GetSolvedShadowCascadeCount() const
+{
+	return m_solvedShadowCascadeCount;
+}
+/// <summary>
+/// Shadow atlas tile edge length of each cascade. Several cascades share the area of one largest tile.
+/// </summary>
+uint32_t DirectionalLight::GetShadowCascadeTileSize() const
+{
+	return m_solvedShadowCascadeCount > 1 ? ShadowAtlas::s_maxTileSize / 2 : ShadowAtlas::s_maxTileSize;
+}
 
 
 
@@ -184,6 +222,20 @@ void DirectionalLight::UpdateProjectionMatrix()
 	float top = m_viewHeight / 2.0f;
 	m_projectionMatrix = Float4x4::Orthographic(left, right, bottom, top, m_nearClip, m_farClip);
 }
+void DirectionalLight::UpdateShadowCascades()
+{
+	if (m_pActiveCamera == nullptr)
+	{
+		m_solvedShadowCascadeCount = 0;
+		return;
+	}
+
+	// Texel snapping must use the tile size the renderer allocates for the cascades:
+	m_solvedShadowCascadeCount = static_cast<uint32_t>(m_shadowCascadeCount);
+	Transform* pCameraTransform = m_pActiveCamera->GetTransform();
+	ShadowCascadeSolver::Solve(pCameraTransform->GetLocalToWorldMatrix(), m_pActiveCamera->GetFov(), m_pActiveCamera->GetAspectRatio(), m_pActiveCamera->GetNearClip(), m_pActiveCamera->GetFarClip(),
+		GetDirection(), m_solvedShadowCascadeCount, m_shadowCascadeSplits, m_maxShadowDistance, GetShadowCascadeTileSize(), m_shadowCascades);
+}
 
 
 
@@ -194,6 +246,9 @@ void DirectionalLight::Start()
 }
 void DirectionalLight::LateUpdate()
 {
+	// The renderer reads the cascades after all LateUpdate() calls:
+	UpdateShadowCascades();
+
 	if (m_drawFrustum)
 		Graphics::DrawFrustum(m_pTransform->GetLocalToWorldMatrix(), GetProjectionMatrix(), 0.1f, Float4(m_color,1.0f));
 
@@ -289,27 +344,13 @@ void DirectionalLight::LateUpdate()
 			pMaterialProperties = Graphics::DrawMesh(pQuad.get(), pUnlitMaterial, model3, false, false);
 			pMaterialProperties->SetValue("SurfaceProperties", "diffuseColor", Float4(0.1f, 0.0f, 0.0f, 1.0f));
 		}
-		{
-			ShadowCascade shadowCascade0(m_pActiveCamera, GetDirection(), 0, m_shadowCascadeSplits[0], 10.0f);
-			//ShadowCascade shadowCascade1(m_pActiveCamera, GetDirection(), m_shadowCascadeSplits[0], m_shadowCascadeSplits[1], 10.0f);
-			//ShadowCascade shadowCascade2(m_pActiveCamera, GetDirection(), m_shadowCascadeSplits[1], m_shadowCascadeSplits[2], 10.0f);
-			//ShadowCascade shadowCascade3(m_pActiveCamera, GetDirection(), m_shadowCascadeSplits[2], 1, 10.0f);
-			Float4x4 model0 = shadowCascade0.GetLightLocalToWorldMatrix();
-			//Float4x4 model1 = shadowCascade1.GetLightLocalToWorldMatrix();
-			//Float4x4 model2 = shadowCascade2.GetLightLocalToWorldMatrix();
-			//Float4x4 model3 = shadowCascade3.GetLightLocalToWorldMatrix();
-			
-			// Draw light fourLeg:
-			Graphics::DrawMesh(fourLeg, pVertexUnlit, model0, false, false);
-			//Graphics::DrawMesh(fourLeg, pVertexUnlit, model1, false, false);
-			//Graphics::DrawMesh(fourLeg, pVertexUnlit, model2, false, false);
-			//Graphics::DrawMesh(fourLeg, pVertexUnlit, model3, false, false);
-			
-			// Draw light frustums:
-			Graphics::DrawFrustum(model0, shadowCascade0.GetProjectionMatrix());
-			//Graphics::DrawFrustum(model1, shadowCascade1.GetProjectionMatrix());
-			//Graphics::DrawFrustum(model2, shadowCascade2.GetProjectionMatrix());
-			//Graphics::DrawFrustum(model3, shadowCascade3.GetProjectionMatrix());
+		{// Draw light frustums of the solved cascades, the view matrices are pure rotations:
+			for (uint32_t i = 0; i < m_solvedShadowCascadeCount; i++)
+			{
+				Float4x4 lightLocalToWorldMatrix = m_shadowCascades[i].viewMatrix.Transpose();
+				Graphics::DrawMesh(fourLeg, pVertexUnlit, lightLocalToWorldMatrix, false, false);
+				Graphics::DrawFrustum(lightLocalToWorldMatrix, m_shadowCascades[i].projectionMatrix);
+			}
 		}
 	}
 }
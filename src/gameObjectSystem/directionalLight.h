@@ -1,6 +1,7 @@
 #ifndef __INCLUDE_GUARD_directionalLight_h__
 #define __INCLUDE_GUARD_directionalLight_h__
 #include "emberEngine.h"
+#include "shadowCascade.h"
 
 
 
@@ -14,6 +15,7 @@ private: // Members:
 	Float3 m_color;
 	float m_nearClip;
 	float m_farClip;
+	bool m_timeSlicedShadows;	// shadow map updates may be delayed by the time slice budget of the renderer
 	float m_viewWidth;
 	float m_viewHeight;
 	Float4x4 m_projectionMatrix;
@@ -24,6 +26,8 @@ private: // Members:
 	float m_maxShadowDistance;	// Distance from camera to last shadow cascade.
 	ShadowCascadeCount m_shadowCascadeCount;
 	float m_shadowCascadeSplits[3];	// Percentile splits for each shadow cascade  [0,1].
+	std::array<ShadowCascade, ShadowCascadeSolver::s_maxCascadeCount> m_shadowCascades;	// solved in LateUpdate() while there is an active camera
+	uint32_t m_solvedShadowCascadeCount;	// valid entries of m_shadowCascades, 0 without active camera
 
 	// Visualization:
 	bool m_drawFrustum;
@@ -41,6 +45,7 @@ public: // Methods:
 	void SetColor(const Float3& color);
 	void SetNearClip(float nearClip);
 	void SetFarClip(float farClip);
+	void SetTimeSlicedShadows(bool timeSlicedShadows);
 	void SetViewWidth(float viewWidth);
 	void SetViewHeight(float viewHeight);
 
@@ -63,6 +68,7 @@ public: // Methods:
 	Float4 GetColorIntensity() const;
 	float GetNearClip() const;
 	float GetFarClip() const;
+	bool GetTimeSlicedShadows() const;
 	float GetViewWidth() const;
 	float GetViewHeight() const;
 	Float4x4 GetViewMatrix() const;
@@ -72,6 +78,9 @@ public: // Methods:
 	float GetMaxShadowDistance() const;
 	ShadowCascadeCount GetShadowCascadeCount() const;
 	const float* const GetShadowCascadeSplits() const;
+	const ShadowCascade& GetShadowCascade(uint32_t index) const;
+	uint32_t GetSolvedShadowCascadeCount() const;
+	uint32_t GetShadowCascadeTileSize() const;
 
 	// Overrides:
 	void Start() override;
@@ -80,6 +89,7 @@ public: // Methods:
 
 private: // Methods:
 	void UpdateProjectionMatrix();
+	void UpdateShadowCascades();
 };
 
 
@@ -1,20 +1,20 @@
 #include "meshRenderer.h"
-#include "camera.h"
-#include "directionalLight.h"
 #include "material.h"
 #include "materialManager.h"
 #include "materialProperties.h"
+#include "mesh.h"
 #include "pipeline.h"
-#include "pointLight.h"
 #include "samplerManager.h"
-#include "spotLight.h"
 #include "textureManager.h"
+#include "transform.h"
 #include "renderPassManager.h"
+#include <algorithm>
 
 
 
 // Static members:
 Material* MeshRenderer::m_pShadowMaterial = nullptr;
+Material* MeshRenderer::m_pPointShadowMaterial = nullptr;
 std::unique_ptr<MaterialProperties> MeshRenderer::m_pShadowMaterialProperties = nullptr;
 
 
@@ -24,6 +24,7 @@ MeshRenderer::MeshRenderer()
 {
 	m_castShadows = true;
 	m_receiveShadows = true;
+	m_instanced = false;
 	m_hasErrorMaterial = true;
 
 	m_pMesh = nullptr;
@@ -31,6 +32,8 @@ MeshRenderer::MeshRenderer()
 
 	if (m_pShadowMaterial == nullptr)
 		m_pShadowMaterial = MaterialManager::GetMaterial("shadow");
+	if (m_pPointShadowMaterial == nullptr)
+		m_pPointShadowMaterial = MaterialManager::GetMaterial("pointShadow");
 	if (m_pShadowMaterialProperties == nullptr)
 		m_pShadowMaterialProperties = std::make_unique<MaterialProperties>(m_pShadowMaterial);
 }
@@ -50,6 +53,17 @@ void MeshRenderer::SetCastShadows(bool castShadows)
 void MeshRenderer::SetReceiveShadows(bool receiveShadows)
 {
 	m_receiveShadows = receiveShadows;
+	if (m_pMaterialProperties != nullptr)
+		m_pMaterialProperties->SetValue("ShadowProperties", "receiveShadows", m_receiveShadows);
+}
+/// <summary>
+/// Opt in to instanced rendering. Only takes effect for materials with instancing support.
+/// Renderers sharing mesh, material and receiveShadows are then drawn with a single draw call,
+/// all material properties except for the diffuseColor are taken from one of them.
+/// </summary>
+void MeshRenderer::SetInstanced(bool instanced)
+{
+	m_instanced = instanced;
 }
 void MeshRenderer::SetMesh(Mesh* pMesh)
 {
@@ -71,71 +85,17 @@ void MeshRenderer::SetMaterial(Material* pMaterial)
 		m_hasErrorMaterial = false;
 		m_pMaterial = pMaterial;
 		m_pMaterialProperties = std::make_unique<MaterialProperties>(m_pMaterial);
+		m_pMaterialProperties->SetValue("ShadowProperties", "receiveShadows", m_receiveShadows);
 	}
 }
-void MeshRenderer::SetRenderMatrizes(Camera* const pCamera)
+/// <summary>
+/// Only model dependent matrices, camera and light data live in the global FrameData set.
+/// </summary>
+void MeshRenderer::SetRenderMatrizes()
 {
 	static std::string name = "RenderMatrizes";
-
-	Float4x4 modelMatrix = GetTransform()->GetLocalToWorldMatrix();
-	Float4x4 cameraViewMatrix = pCamera->GetViewMatrix();
-	Float4x4 cameraProjMatrix = pCamera->GetProjectionMatrix();
-	Float4x4 localToClipMatrix = cameraProjMatrix * cameraViewMatrix * modelMatrix;
-
-	m_pMaterialProperties->SetValue(name, "modelMatrix", modelMatrix);
-	m_pMaterialProperties->SetValue(name, "viewMatrix", cameraViewMatrix);
-	m_pMaterialProperties->SetValue(name, "projMatrix", cameraProjMatrix);
+	m_pMaterialProperties->SetValue(name, "modelMatrix", GetTransform()->GetLocalToWorldMatrix());
 	m_pMaterialProperties->SetValue(name, "normalMatrix", GetTransform()->GetLocalToWorldNormalMatrix());
-	m_pMaterialProperties->SetValue(name, "localToClipMatrix", localToClipMatrix);
-}
-void MeshRenderer::SetLightData(const std::array<DirectionalLight*, MAX_D_LIGHTS>& directionalLights)
-{
-	static std::string blockName = "LightData";
-	static std::string arrayName = "directionalLightData";
-
-	for (uint32_t i = 0; i < MAX_D_LIGHTS; i++)
-		if (directionalLights[i] != nullptr)
-		{
-			Float4x4 worldToClipMatrix = directionalLights[i]->GetProjectionMatrix() * directionalLights[i]->GetViewMatrix();
-			m_pMaterialProperties->SetValue(blockName, arrayName, i, "worldToClipMatrix", worldToClipMatrix);
-			m_pMaterialProperties->SetValue(blockName, arrayName, i, "direction", directionalLights[i]->GetDirection());
-			m_pMaterialProperties->SetValue(blockName, arrayName, i, "colorIntensity", directionalLights[i]->GetColorIntensity());
-		}
-	m_pMaterialProperties->SetValue(blockName, "receiveShadows", m_receiveShadows);
-}
-void MeshRenderer::SetLightData(const std::array<SpotLight*, MAX_S_LIGHTS>& spotLights)
-{
-	static std::string blockName = "LightData";
-	static std::string arrayName = "spotLightData";
-
-	for (uint32_t i = 0; i < MAX_S_LIGHTS; i++)
-		if (spotLights[i] != nullptr)
-		{
-			Float4x4 worldToClipMatrix = spotLights[i]->GetProjectionMatrix() * spotLights[i]->GetViewMatrix();
-			m_pMaterialProperties->SetValue(blockName, arrayName, i, "worldToClipMatrix", worldToClipMatrix);
-			m_pMaterialProperties->SetValue(blockName, arrayName, i, "position", spotLights[i]->GetPosition());
-			m_pMaterialProperties->SetValue(blockName, arrayName, i, "colorIntensity", spotLights[i]->GetColorIntensity());
-			m_pMaterialProperties->SetValue(blockName, arrayName, i, "blendStartEnd", spotLights[i]->GetBlendStartEnd());
-		}
-	m_pMaterialProperties->SetValue(blockName, "receiveShadows", m_receiveShadows);
-}
-void MeshRenderer::SetLightData(const std::array<PointLight*, MAX_P_LIGHTS>& pointLights)
-{
-	static std::string blockName = "LightData";
-	static std::string arrayName = "pointLightData";
-
-	for (uint32_t i = 0; i < MAX_P_LIGHTS; i++)
-		if (pointLights[i] != nullptr)
-		{
-			for (uint32_t faceIndex = 0; faceIndex < 6; faceIndex++)
-			{
-				Float4x4 worldToClipMatrix = pointLights[i]->GetProjectionMatrix() * pointLights[i]->GetViewMatrix(faceIndex);
-				m_pMaterialProperties->SetValue(blockName, arrayName, i, "worldToClipMatrix", faceIndex, worldToClipMatrix);
-			}
-			m_pMaterialProperties->SetValue(blockName, arrayName, i, "position", pointLights[i]->GetPosition());
-			m_pMaterialProperties->SetValue(blockName, arrayName, i, "colorIntensity", pointLights[i]->GetColorIntensity());
-		}
-	m_pMaterialProperties->SetValue(blockName, "receiveShadows", m_receiveShadows);
 }
 
 
@@ -151,6 +111,15 @@ bool MeshRenderer::GetReceiveShadows() const
 	// Always return false if error material is in use:
 	return !m_hasErrorMaterial && m_receiveShadows;
 }
+bool MeshRenderer::GetInstanced() const
+{
+	return m_instanced && GetUsesInstanceData();
+}
+bool MeshRenderer::GetUsesInstanceData() const
+{
+	// Error material has no instanced variant:
+	return !m_hasErrorMaterial && m_pMaterial->SupportsInstancing();
+}
 Mesh* MeshRenderer::GetMesh()
 {
 	return m_pMesh;
@@ -163,10 +132,18 @@ MaterialProperties* MeshRenderer::GetMaterialProperties()
 {
 	return m_pMaterialProperties.get();
 }
+Bounds MeshRenderer::GetWorldBounds()
+{
+	return m_pMesh->GetBounds().Transform(GetTransform()->GetLocalToWorldMatrix());
+}
 const VkDescriptorSet* const MeshRenderer::GetShadingDescriptorSets(uint32_t frameIndex) const
 {
 	return &m_pMaterialProperties->GetDescriptorSets()[frameIndex];
 }
+const std::vector<uint32_t>& MeshRenderer::GetShadingDynamicOffsets(uint32_t frameIndex) const
+{
+	return m_pMaterialProperties->GetDynamicOffsets(frameIndex);
+}
 const VkPipeline& MeshRenderer::GetShadingPipeline() const
 {
 	return m_pMaterial->GetPipeline()->GetVkPipeline();
@@ -175,6 +152,26 @@ const VkPipelineLayout& MeshRenderer::GetShadingPipelineLayout() const
 {
 	return m_pMaterial->GetPipeline()->GetVkPipelineLayout();
 }
+/// <summary>
+/// Packed 64 bit draw order key, lower keys are drawn first:
+/// - opaque/skybox: renderQueue(3) | pipeline(12) | materialProperties(16) | mesh(17) | depth(16)
+/// - transparent:   renderQueue(3) | inverted depth(16) | pipeline(12) | materialProperties(16) | mesh(17)
+/// So opaque draws are grouped by state and then drawn front to back, transparent draws are drawn back to front.
+/// depth is the quantized distance to the camera, 0 = near, 65535 = far. Pipeline, materialProperties and mesh
+/// fields are pointer hashes, collisions only weaken the grouping, never the correctness of the render queue order.
+/// </summary>
+uint64_t MeshRenderer::GetSortKey(uint16_t depth) const
+{
+	uint64_t renderQueue = std::min(static_cast<uint64_t>(m_pMaterial->GetRenderQueue()) / 1000, uint64_t(7));
+	uint64_t pipeline = HashPointer(m_pMaterial, 12);
+	uint64_t materialProperties = HashPointer(m_pMaterialProperties.get(), 16);
+	uint64_t mesh = HashPointer(m_pMesh, 17);
+
+	if (m_pMaterial->GetRenderQueue() == Material::RenderQueue::transparent)
+		return (renderQueue << 61) | (uint64_t(UINT16_MAX - depth) << 45) | (pipeline << 33) | (materialProperties << 17) | mesh;
+	else
+		return (renderQueue << 61) | (pipeline << 49) | (materialProperties << 33) | (mesh << 16) | depth;
+}
 
 // Shadow render pass getters:
 const VkDescriptorSet* const MeshRenderer::GetShadowDescriptorSets(uint32_t frameIndex)
@@ -189,6 +186,18 @@ const VkPipelineLayout& MeshRenderer::GetShadowPipelineLayout()
 {
 	return m_pShadowMaterial->GetPipeline()->GetVkPipelineLayout();
 }
+const VkPipeline& MeshRenderer::GetPointShadowPipeline()
+{
+	return m_pPointShadowMaterial->GetPipeline()->GetVkPipeline();
+}
+/// <summary>
+/// Both shadow materials only use set 0 (FrameData), their empty set 1 layouts are identical,
+/// so the descriptor sets of GetShadowDescriptorSets() are compatible with this layout too.
+/// </summary>
+const VkPipelineLayout& MeshRenderer::GetPointShadowPipelineLayout()
+{
+	return m_pPointShadowMaterial->GetPipeline()->GetVkPipelineLayout();
+}
 
 
 
@@ -196,4 +205,14 @@ const VkPipelineLayout& MeshRenderer::GetShadowPipelineLayout()
 const std::string MeshRenderer::ToString() const
 {
 	return "MeshRenderer";
+}
+
+
+
+// Private methods:
+uint64_t MeshRenderer::HashPointer(const void* pointer, uint32_t bitCount)
+{
+	// Fibonacci hashing, the top bits of the product depend on all bits of the address:
+	uint64_t address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+	return (address * 0x9E3779B97F4A7C15ull) >> (64 - bitCount);
 }
\ No newline at end of file
@@ -1,21 +1,17 @@
 #ifndef __INCLUDE_GUARD_meshRenderer_h__
 #define __INCLUDE_GUARD_meshRenderer_h__
 #include "component.h"
-#include "macros.h"
-#include <array>
 #include <memory>
 #include <string>
+#include <vector>
 #include <vulkan/vulkan.h>
 
 
 
-class Camera;
-class DirectionalLight;
+struct Bounds;
 class Mesh;
 class Material;
 class MaterialProperties;
-class PointLight;
-class SpotLight;
 
 
 
@@ -24,11 +20,13 @@ class MeshRenderer : public Component
 private: // Members:
 	bool m_castShadows;
 	bool m_receiveShadows;
+	bool m_instanced;
 	bool m_hasErrorMaterial;
 	Mesh* m_pMesh;
 	Material* m_pMaterial;
 	std::unique_ptr<MaterialProperties> m_pMaterialProperties;
 	static Material* m_pShadowMaterial;
+	static Material* m_pPointShadowMaterial;
 	static std::unique_ptr<MaterialProperties> m_pShadowMaterialProperties;
 
 public: // Methods:
@@ -38,32 +36,38 @@ public: // Methods:
 	// Setter:
 	void SetCastShadows(bool castShadows);
 	void SetReceiveShadows(bool receiveShadows);
+	void SetInstanced(bool instanced);
 	void SetMesh(Mesh* pMesh);
 	void SetMaterial(Material* pMaterial);
-	void SetRenderMatrizes(Camera* const pCamera);
-	void SetLightData(const std::array<DirectionalLight*, MAX_D_LIGHTS>& directionalLights);
-	void SetLightData(const std::array<SpotLight*, MAX_S_LIGHTS>& spotLights);
-	void SetLightData(const std::array<PointLight*, MAX_P_LIGHTS>& pointLights);
+	void SetRenderMatrizes();
 
 	// Shading render pass getters:
 	bool GetCastShadows() const;
 	bool GetReceiveShadows() const;
+	bool GetInstanced() const;
+	bool GetUsesInstanceData() const;	// material reads the instanceData buffer, independent of GetInstanced().
 	Mesh* GetMesh();
 	Material* GetMaterial();
 	MaterialProperties* GetMaterialProperties();
+	Bounds GetWorldBounds();
 	const VkDescriptorSet* const GetShadingDescriptorSets(uint32_t frameIndex) const;
+	const std::vector<uint32_t>& GetShadingDynamicOffsets(uint32_t frameIndex) const;
 	const VkPipeline& GetShadingPipeline() const;
 	const VkPipelineLayout& GetShadingPipelineLayout() const;
+	uint64_t GetSortKey(uint16_t depth) const;
 
 	// Shadow render pass getters:
 	static const VkDescriptorSet* const GetShadowDescriptorSets(uint32_t frameIndex);
 	static const VkPipeline& GetShadowPipeline();
 	static const VkPipelineLayout& GetShadowPipelineLayout();
+	static const VkPipeline& GetPointShadowPipeline();
+	static const VkPipelineLayout& GetPointShadowPipelineLayout();
 
 	// Overrides:
 	const std::string ToString() const override;
 
 private: // Methods:
+	static uint64_t HashPointer(const void* pointer, uint32_t bitCount);
 };
 
 
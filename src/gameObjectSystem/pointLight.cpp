@@ -16,6 +16,7 @@ PointLight::PointLight()
 	m_color = Float3::white;
 	m_nearClip = 0.1f;
 	m_farClip = 15.0f;
+	m_timeSlicedShadows = false;
 	m_updateProjectionMatrix = true;
 	m_drawFrustum = false;
 
@@ -56,6 +57,10 @@ void PointLight::SetFarClip(const float& farClip)
 	m_farClip = farClip;
 	m_updateProjectionMatrix = true;
 }
+void PointLight::SetTimeSlicedShadows(bool timeSlicedShadows)
+{
+	m_timeSlicedShadows = timeSlicedShadows;
+}
 void PointLight::SetDrawFrustum(bool drawFrustum)
 {
 	m_drawFrustum = drawFrustum;
@@ -88,6 +93,10 @@ float PointLight::GetFarClip() const
 {
 	return m_farClip;
 }
+bool PointLight::GetTimeSlicedShadows() const
+{
+	return m_timeSlicedShadows;
+}
 Float4x4 PointLight::GetViewMatrix(uint32_t faceIndex) const
 {
 	if (faceIndex >= 6)
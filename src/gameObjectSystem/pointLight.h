@@ -13,6 +13,7 @@ private: // Members:
 	Float3 m_color;
 	float m_nearClip;
 	float m_farClip;
+	bool m_timeSlicedShadows;	// shadow map updates may be delayed by the time slice budget of the renderer
 	bool m_updateProjectionMatrix;
 	Float4x4 m_projectionMatrix;
 	static bool s_rotationMatricesInitialized;
@@ -28,6 +29,7 @@ public: // Methods:
 	void SetColor(const Float3& color = Float3::one);
 	void SetNearClip(const float& nearClip);
 	void SetFarClip(const float& farClip);
+	void SetTimeSlicedShadows(bool timeSlicedShadows);
 	void SetDrawFrustum(bool drawFrustum);
 
 	// Getters:
@@ -37,6 +39,7 @@ public: // Methods:
 	Float4 GetColorIntensity() const;
 	float GetNearClip() const;
 	float GetFarClip() const;
+	bool GetTimeSlicedShadows() const;
 	Float4x4 GetViewMatrix(uint32_t faceIndex) const;
 	Float4x4 GetProjectionMatrix();
 
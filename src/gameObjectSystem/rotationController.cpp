@@ -37,9 +37,9 @@ void RotationController::Update()
 		{
 			float angleX = movementX * m_degreesPerSecond * mathf::DEG2RAD * Timer::GetDeltaTime();
 			float angleY = -movementY * m_degreesPerSecond * mathf::DEG2RAD * Timer::GetDeltaTime();
-			Float3x3 rotX = Float3x3::RotateX(angleX);
-			Float3x3 rotY = Float3x3::RotateY(angleY);
-			m_pTransform->SetRotationMatrix(rotY * m_pTransform->GetRotation3x3() * rotX);
+			Quaternion rotX = Quaternion::RotateX(angleX);
+			Quaternion rotY = Quaternion::RotateY(angleY);
+			m_pTransform->SetRotation((rotY * m_pTransform->GetRotation() * rotX).Normalize());
 		}
 	}
 }
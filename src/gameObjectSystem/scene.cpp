@@ -7,6 +7,7 @@
 #include "meshRenderer.h"
 #include "pointLight.h"
 #include "spotLight.h"
+#include <algorithm>
 
 
 
@@ -78,10 +79,12 @@ const std::array<PointLight*, MAX_P_LIGHTS>& Scene::GetPointLights() const
 {
 	return m_pointLights;
 }
+/// <summary>
+/// MeshRenderers ordered by the depth independent part of their sort key at the time they were added.
+/// Later material or mesh changes are not reflected here, the renderer sorts its per frame draw list anyway.
+/// </summary>
 std::vector<MeshRenderer*>* const Scene::GetSortedMeshRenderers()
 {
-	if (!m_meshRenderersSorted)
-		SortMeshRenderers();
 	return &m_sortedMeshRenderers;
 }
 
@@ -104,8 +107,12 @@ void Scene::AddGameObject(GameObject* pGameObject)
 		if (pMeshRenderer != nullptr)
 		{
 			m_meshRenderers.emplace(pGameObject->GetName(), pMeshRenderer);
-			m_sortedMeshRenderers.push_back(pMeshRenderer);
-			m_meshRenderersSorted = false;
+
+			// Insert behind all entries with a smaller or equal key instead of re-sorting the whole list:
+			uint64_t sortKey = pMeshRenderer->GetSortKey(0);
+			size_t index = std::upper_bound(m_sortKeys.begin(), m_sortKeys.end(), sortKey) - m_sortKeys.begin();
+			m_sortKeys.insert(m_sortKeys.begin() + index, sortKey);
+			m_sortedMeshRenderers.insert(m_sortedMeshRenderers.begin() + index, pMeshRenderer);
 		}
 
 		DirectionalLight* pDirectionalLight = pGameObject->GetComponent<DirectionalLight>();
@@ -201,9 +208,13 @@ void Scene::RemoveGameObject(std::string name)
 		MeshRenderer* pMeshRenderer = pGameObject->GetComponent<MeshRenderer>();
 		if (pMeshRenderer != nullptr)
 		{
-			m_sortedMeshRenderers.erase(std::remove(m_sortedMeshRenderers.begin(), m_sortedMeshRenderers.end(), pMeshRenderer), m_sortedMeshRenderers.end());
+			auto entry = std::find(m_sortedMeshRenderers.begin(), m_sortedMeshRenderers.end(), pMeshRenderer);
+			if (entry != m_sortedMeshRenderers.end())
+			{
+				m_sortKeys.erase(m_sortKeys.begin() + (entry - m_sortedMeshRenderers.begin()));
+				m_sortedMeshRenderers.erase(entry);
+			}
 			m_meshRenderers.erase(name);
-			m_meshRenderersSorted = false;
 		}
 		pGameObject->SetScene(nullptr);
 		m_gameObjects.erase(it);
@@ -249,10 +260,8 @@ void Scene::PrintMeshRenderers() const
 	for (const auto& [objName, pMeshRenderer] : m_meshRenderers)
 		LOG_TRACE("gamObject: {}, material: {}", objName, pMeshRenderer->GetMaterial()->GetName());
 }
-void Scene::PrintSortedMeshRenderers()
+void Scene::PrintSortedMeshRenderers() const
 {
-	if (!m_meshRenderersSorted)
-		SortMeshRenderers();
 	LOG_TRACE("Sorted MeshRenderers in scene:");
 	for (const auto& pMeshRenderer : m_sortedMeshRenderers)
 		LOG_TRACE("gamObject: {}, material: {}", pMeshRenderer->GetGameObject()->GetName(), pMeshRenderer->GetMaterial()->GetName());
@@ -273,18 +282,4 @@ void Scene::PrintLights() const
 	for (uint32_t i = 0; i < MAX_P_LIGHTS; i++)
 		if (m_pointLights[i] != nullptr)
 			LOG_TRACE("{}", m_pointLights[i]->GetGameObject()->GetName());
-}
-
-
-
-// Private methods:
-void Scene::SortMeshRenderers()
-{
-	m_meshRenderersSorted = true;
-	std::sort(m_sortedMeshRenderers.begin(), m_sortedMeshRenderers.end(), [](MeshRenderer* a, MeshRenderer* b)
-	{
-		uint32_t renderQueueA = static_cast<uint32_t>(a->GetMaterial()->GetRenderQueue());
-		uint32_t renderQueueB = static_cast<uint32_t>(b->GetMaterial()->GetRenderQueue());
-		return renderQueueA < renderQueueB;
-	});
 }
\ No newline at end of file
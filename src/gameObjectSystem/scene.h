@@ -36,9 +36,9 @@ private: // Members:
 	std::array<DirectionalLight*, MAX_D_LIGHTS> m_directionalLights;
 	std::array<SpotLight*, MAX_S_LIGHTS> m_spotLights;
 	std::array<PointLight*, MAX_P_LIGHTS> m_pointLights;
-	bool m_meshRenderersSorted = false;
 	std::unordered_map<std::string, MeshRenderer*> m_meshRenderers;
 	std::vector<MeshRenderer*> m_sortedMeshRenderers;
+	std::vector<uint64_t> m_sortKeys;	// depth independent sort key of each entry in m_sortedMeshRenderers at insertion time.
 
 public: // Methods:
 	Scene();
@@ -69,11 +69,8 @@ public: // Methods:
 	// Debugging:
 	void PrintGameObjects() const;
 	void PrintMeshRenderers() const;
-	void PrintSortedMeshRenderers();
+	void PrintSortedMeshRenderers() const;
 	void PrintLights() const;
-
-private: // Methods:
-	void SortMeshRenderers();
 };
 
 
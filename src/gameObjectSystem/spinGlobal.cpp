@@ -20,13 +20,12 @@ SpinGlobal::~SpinGlobal()
 void SpinGlobal::Update()
 {
 	Float3 eulerRadians = mathf::DEG2RAD * m_eulerDegreesPerSecond * Timer::GetDeltaTime();
-	Float4x4 rotation = Float4x4::Rotate(eulerRadians, m_rotationOrder);
-	Float4x4 translate = Float4x4::Translate(m_position);
-	Float4x4 translateInverse = Float4x4::Translate(-m_position);
+	Quaternion rotation = Quaternion::Rotate(eulerRadians, m_rotationOrder);
 
-	Float4x4 localToWorldMatrix = m_pTransform->GetLocalToWorldMatrix();
-	Float4x4 newLocalToWorldMatrix = translate * rotation * translateInverse * localToWorldMatrix;
-	m_pTransform->SetLocalToWorldMatrix(newLocalToWorldMatrix);
+	// Rotate around m_position in world space, scale is unaffected:
+	Float3 position = m_pTransform->GetPosition();
+	m_pTransform->SetPosition(m_position + rotation * (position - m_position));
+	m_pTransform->SetRotation((rotation * m_pTransform->GetRotation()).Normalize());
 }
 const std::string SpinGlobal::ToString() const
 {
@@ -21,14 +21,14 @@ void SpinLocal::Update()
 	if (EventSystem::KeyDownOrHeld(SDLK_LEFT))
 	{
 		Float3 eulerRadians = -mathf::DEG2RAD * m_eulerDegreesPerSecond * Timer::GetDeltaTime();
-		Float3x3 rotation = Float3x3::Rotate(eulerRadians, m_rotationOrder);
-		m_pTransform->SetRotationMatrix(m_pTransform->GetRotation3x3() * rotation);
+		Quaternion rotation = Quaternion::Rotate(eulerRadians, m_rotationOrder);
+		m_pTransform->SetRotation((m_pTransform->GetRotation() * rotation).Normalize());
 	}
 	if (EventSystem::KeyDownOrHeld(SDLK_RIGHT))
 	{
 		Float3 eulerRadians = mathf::DEG2RAD * m_eulerDegreesPerSecond * Timer::GetDeltaTime();
-		Float3x3 rotation = Float3x3::Rotate(eulerRadians, m_rotationOrder);
-		m_pTransform->SetRotationMatrix(m_pTransform->GetRotation3x3() * rotation);
+		Quaternion rotation = Quaternion::Rotate(eulerRadians, m_rotationOrder);
+		m_pTransform->SetRotation((m_pTransform->GetRotation() * rotation).Normalize());
 	}
 }
 const std::string SpinLocal::ToString() const
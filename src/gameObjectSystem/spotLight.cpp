@@ -1,5 +1,4 @@
 #include "spotLight.h"
-#include "shadowRenderPass.h"
 
 
 
@@ -9,9 +8,10 @@ SpotLight::SpotLight()
 	m_intensity = 1.0f;
 	m_color = Float3::white;
 	m_fov = mathf::DEG2RAD * 45.0f;
-	m_aspectRatio = (float)ShadowRenderPass::s_shadowMapWidth / (float)ShadowRenderPass::s_shadowMapHeight;
+	m_aspectRatio = 1.0f;	// shadow atlas tiles are square
 	m_nearClip = 0.1f;
 	m_farClip = 15.0f;
+	m_timeSlicedShadows = false;
 	m_blendStart = 0.8f;
 	m_blendEnd = 1.0f;
 	m_updateProjectionMatrix = true;
@@ -48,6 +48,10 @@ void SpotLight::SetFarClip(const float& farClip)
 	m_farClip = farClip;
 	m_updateProjectionMatrix = true;
 }
+void SpotLight::SetTimeSlicedShadows(bool timeSlicedShadows)
+{
+	m_timeSlicedShadows = timeSlicedShadows;
+}
 void SpotLight::SetBlendStart(const float& blendStart)
 {
 	m_blendStart = mathf::Clamp(blendStart, 0.0f, 1.0f);
@@ -92,6 +96,10 @@ float SpotLight::GetFarClip() const
 {
 	return m_farClip;
 }
+bool SpotLight::GetTimeSlicedShadows() const
+{
+	return m_timeSlicedShadows;
+}
 float SpotLight::GetBlendStart() const
 {
 	return m_blendStart;
@@ -13,6 +13,7 @@ private: // Members:
 	float m_aspectRatio;
 	float m_nearClip;
 	float m_farClip;
+	bool m_timeSlicedShadows;	// shadow map updates may be delayed by the time slice budget of the renderer
 	float m_blendStart;
 	float m_blendEnd;
 	Float4x4 m_projectionMatrix;
@@ -29,6 +30,7 @@ public: // Methods:
 	void SetFov(const float& fov);
 	void SetNearClip(const float& nearClip);
 	void SetFarClip(const float& farClip);
+	void SetTimeSlicedShadows(bool timeSlicedShadows);
 	void SetBlendStart(const float& blendStart);
 	void SetBlendEnd(const float& blendEnd);
 	void SetDrawFrustum(bool drawFrustum);
@@ -41,6 +43,7 @@ public: // Methods:
 	float GetFov() const;
 	float GetNearClip() const;
 	float GetFarClip() const;
+	bool GetTimeSlicedShadows() const;
 	float GetBlendStart() const;
 	float GetBlendEnd() const;
 	Float2 GetBlendStartEnd() const;
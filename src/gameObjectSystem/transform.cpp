@@ -6,14 +6,30 @@
 Transform::Transform()
 {
 	m_position = Float3(0.0f);
-	m_rotationMatrix = Float3x3::identity;
+	m_rotation = Quaternion::identity;
 	m_scale = Float3(1.0f);
 	m_updateLocalToWorldMatrix = true;
 }
 Transform::Transform(const Float3& position, const Float3x3& rotationMatrix, const Float3& scale)
 {
 	m_position = position;
-	m_rotationMatrix = rotationMatrix;
+	if (rotationMatrix.Determinant() < 0.0f)
+	{// mirrored matrix: rotationMatrix * S = (rotationMatrix * M) * (M * S) with M = diag(-1, 1, 1), so the mirroring moves into scale.x:
+		Float3x3 mirror = Float3x3::Rows(-1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+		m_rotation = Quaternion(rotationMatrix * mirror);
+		m_scale = Float3(-scale.x, scale.y, scale.z);
+	}
+	else
+	{
+		m_rotation = Quaternion(rotationMatrix);
+		m_scale = scale;
+	}
+	m_updateLocalToWorldMatrix = true;
+}
+Transform::Transform(const Float3& position, const Quaternion& rotation, const Float3& scale)
+{
+	m_position = position;
+	m_rotation = rotation;
 	m_scale = scale;
 	m_updateLocalToWorldMatrix = true;
 }
@@ -56,31 +72,35 @@ void Transform::AddToPosition(const Float3& translation)
 	m_position += translation;
 	m_updateLocalToWorldMatrix = true;
 }
-void Transform::SetRotationMatrix(const Float3x3& rotationMatrix)
+void Transform::SetRotation(const Quaternion& rotation)
 {
-	if (m_rotationMatrix == rotationMatrix)
+	if (m_rotation == rotation)
 		return;
-	m_rotationMatrix = rotationMatrix;
+	m_rotation = rotation;
 	m_updateLocalToWorldMatrix = true;
 }
+void Transform::SetRotationMatrix(const Float3x3& rotationMatrix)
+{
+	SetRotation(Quaternion(rotationMatrix));
+}
 void Transform::SetRotationEulerDegrees(float degreesX, float degreesY, float degreesZ, Uint3 rotationOrder, CoordinateSystem system)
 {
 	Float3 eulerRadians = mathf::DEG2RAD * Float3(degreesX, degreesY, degreesZ);
-	SetRotationMatrix(Float3x3::Rotate(eulerRadians, rotationOrder, system));
+	SetRotation(Quaternion::Rotate(eulerRadians, rotationOrder, system));
 }
 void Transform::SetRotationEulerRadians(float radiansX, float radiansY, float radiansZ, Uint3 rotationOrder, CoordinateSystem system)
 {
 	Float3 eulerRadians = Float3(radiansX, radiansY, radiansZ);
-	SetRotationMatrix(Float3x3::Rotate(eulerRadians, rotationOrder, system));
+	SetRotation(Quaternion::Rotate(eulerRadians, rotationOrder, system));
 }
 void Transform::SetRotationEulerDegrees(Float3 degrees, Uint3 rotationOrder, CoordinateSystem system)
 {
 	Float3 eulerRadians = mathf::DEG2RAD * degrees;
-	SetRotationMatrix(Float3x3::Rotate(eulerRadians, rotationOrder, system));
+	SetRotation(Quaternion::Rotate(eulerRadians, rotationOrder, system));
 }
 void Transform::SetRotationEulerRadians(Float3 radians, Uint3 rotationOrder, CoordinateSystem system)
 {
-	SetRotationMatrix(Float3x3::Rotate(radians, rotationOrder, system));
+	SetRotation(Quaternion::Rotate(radians, rotationOrder, system));
 }
 void Transform::SetScale(float x, float y, float z)
 {
@@ -105,9 +125,9 @@ void Transform::SetLocalToWorldMatrix(const Float4x4& localToWorldMatrix)
 {
 	m_localToWorldMatrix = localToWorldMatrix;
 	m_position = localToWorldMatrix.GetTranslation();
-	m_scale = localToWorldMatrix.GetScale();
-	m_rotationMatrix = localToWorldMatrix.GetRotation3x3(m_scale);
-	m_worldToLocalMatrix = localToWorldMatrix.Inverse();
+	m_scale = localToWorldMatrix.GetSignedScale();
+	m_rotation = Quaternion(localToWorldMatrix.GetRotation3x3(m_scale));
+	m_worldToLocalMatrix = localToWorldMatrix.InverseAffine();
 	m_localToWorldNormalMatrix = m_worldToLocalMatrix.Transpose();
 	m_worldToLocalNormalMatrix = m_localToWorldMatrix.Transpose();
 	m_updateLocalToWorldMatrix = false;
@@ -120,13 +140,17 @@ Float3 Transform::GetPosition() const
 {
 	return m_position;
 }
+Quaternion Transform::GetRotation() const
+{
+	return m_rotation;
+}
 Float3x3 Transform::GetRotation3x3() const
 {
-	return m_rotationMatrix;
+	return m_rotation.ToFloat3x3();
 }
 Float4x4 Transform::GetRotation4x4() const
 {
-	return Float4x4(m_rotationMatrix);
+	return m_rotation.ToFloat4x4();
 }
 Float3 Transform::GetScale() const
 {
@@ -199,8 +223,9 @@ Float3 Transform::GetDown()
 void Transform::UpdateLocalToWorldMatrix()
 {
 	m_updateLocalToWorldMatrix = false;
-	m_localToWorldMatrix = Float4x4::Translate(m_position) * Float4x4(m_rotationMatrix) * Float4x4::Scale(m_scale);
-	m_worldToLocalMatrix = m_localToWorldMatrix.Inverse();
+	Float3x3 rotationMatrix = m_rotation.ToFloat3x3();
+	m_localToWorldMatrix = Float4x4::TRS(m_position, rotationMatrix, m_scale);
+	m_worldToLocalMatrix = Float4x4::InverseTRS(m_position, rotationMatrix, m_scale);
 	m_localToWorldNormalMatrix = m_worldToLocalMatrix.Transpose();
 	m_worldToLocalNormalMatrix = m_localToWorldMatrix.Transpose();
 }
@@ -15,7 +15,7 @@ class Transform : public Component
 {
 private: // Members:
 	Float3 m_position;
-	Float3x3 m_rotationMatrix;
+	Quaternion m_rotation;
 	Float3 m_scale;
 	Float4x4 m_localToWorldMatrix;
 	Float4x4 m_worldToLocalMatrix;
@@ -26,6 +26,7 @@ private: // Members:
 public: // Methods:
 	Transform();
 	Transform(const Float3& position, const Float3x3& rotationMatrix = Float3x3::identity, const Float3& scale = Float3::one);
+	Transform(const Float3& position, const Quaternion& rotation, const Float3& scale = Float3::one);
 	~Transform();
 
 	// Setters:
@@ -33,7 +34,8 @@ public: // Methods:
 	void SetPosition(const Float3& position);
 	void AddToPosition(float x, float y, float z);
 	void AddToPosition(const Float3& translation);
-	void SetRotationMatrix(const Float3x3& rotationMatrix);
+	void SetRotation(const Quaternion& rotation);
+	void SetRotationMatrix(const Float3x3& rotationMatrix);	// proper rotations only, mirrored matrices need the constructor or SetLocalToWorldMatrix().
 	void SetRotationEulerDegrees(float degreesX, float degreesY, float degreesZ, Uint3 rotationOrder = Uint3(1,0,2), CoordinateSystem system = CoordinateSystem::local);
 	void SetRotationEulerRadians(float radiansX, float radiansY, float radiansZ, Uint3 rotationOrder = Uint3(1,0,2), CoordinateSystem system = CoordinateSystem::local);
 	void SetRotationEulerDegrees(Float3 degrees, Uint3 rotationOrder = Uint3(1,0,2), CoordinateSystem system = CoordinateSystem::local);
@@ -45,6 +47,7 @@ public: // Methods:
 
 	// Getters:
 	Float3 GetPosition() const;
+	Quaternion GetRotation() const;
 	Float3x3 GetRotation3x3() const;
 	Float4x4 GetRotation4x4() const;
 	Float3 GetScale() const;
@@ -1,24 +1,19 @@
 #define SDL_MAIN_HANDLED
 #include "application.h"
 #include "emberEngine.h"
+#include <stdexcept>
+#include <string>
 
 
 
 // TODO now!
 // - change coordinate system to: x right, y forward, z up
-// - directional lights: shadow cascades
-// - sort gameObjects first by material (to reduce pipeline changes) and then by proximity to pCamera to reduce fragment culling (render closer objects first)
 // - imgui integration
 // - validation layer errors when two shaders have the same binding number (binding missmatch error)
 
 // TODO:
 // - adjust shadow config in shadowPipeline.cpp (bias values) for better shadow quality
-// - optimizations: multi threaded render loop, culling, etc.
 // - add pGameObject selection (need gizmos => ui renderpass)
-// - currently one commandPool per commandBuffer, should be one commandPool per frame, shared by all commands for that frame?
-// - uniform buffer (cbuffer) data that is the same for all draw calls (e.g. light data) should be stored in a single cbuffer
-//   that is bound to a single descriptorSet that is bound to all draw calls that need that data.
-//   => make this descriptorset a "global" object in the materialProperties class.
 // - shadowMapping.hlsli: PhysicalDirectionalLights(...) has depth bias added manually. Should be done via pipeline rasterization state.
 // - add geometry shader stage => wireframe rendering
 // - gameobject parent system (GameObject  GameObject => transform hierarchy)
@@ -32,7 +27,6 @@
 
 // TODO long term:
 // - change image loading library, stb_image sucks.
-// - proper quaternion support
 // - ui renderpass that draws on top of everything and is not affected by the pCamera (constant view/projection matrix)
 // - render image while resizing
 // - implement game physics fixedUpdate loop
@@ -630,13 +624,57 @@ Scene* DefaultScene()
 
 
 
-int main()
+bool ParseArguments(int argc, char* argv[], ApplicationSettings& settings)
+{
+	const char* usage = "Usage: --headless --frames <count> --width <pixels> --height <pixels> --readback <file.ppm> --profile <frame> --shadow-d16";
+	Logger::Init();	// arguments are parsed before the application initializes the logger
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		bool hasValue = i + 1 < argc;
+		try
+		{
+			if (argument == "--headless")
+				settings.headless = true;
+			else if (argument == "--frames" && hasValue)
+				settings.frameCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+			else if (argument == "--width" && hasValue)
+				settings.width = static_cast<uint32_t>(std::stoul(argv[++i]));
+			else if (argument == "--height" && hasValue)
+				settings.height = static_cast<uint32_t>(std::stoul(argv[++i]));
+			else if (argument == "--readback" && hasValue)
+				settings.readbackPath = argv[++i];
+			else if (argument == "--profile" && hasValue)
+				settings.profileFrame = static_cast<uint32_t>(std::stoul(argv[++i]));
+			else if (argument == "--shadow-d16")
+				settings.shadowMaps16Bit = true;
+			else
+				LOG_WARN("Unknown or incomplete command line argument: {}", argument);
+		}
+		catch (const std::logic_error&)	// std::invalid_argument and std::out_of_range of std::stoul
+		{
+			LOG_ERROR("Invalid value '{}' for command line argument {}.", argv[i], argument);
+			LOG_ERROR("{}", usage);
+			return false;
+		}
+	}
+	return true;
+}
+
+
+
+int main(int argc, char* argv[])
 {
 	// VS debugging:
+	#ifdef _MSC_VER
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+	#endif
 
 	// Initialization:
-	Application app;
+	ApplicationSettings settings;
+	if (!ParseArguments(argc, argv, settings))
+		return 1;
+	Application app(settings);
 	//Scene* pScene = ShadowCascadeScene();
 	//Scene* pScene = TestScene();
 	Scene* pScene = DefaultScene();
@@ -656,16 +694,17 @@ int main()
 	// return 0;
 
 	// Run application:
+	bool success = false;
 	try
 	{
-		app.Run();
+		success = app.Run();
 	}
 	catch (const std::exception& e)
 	{
 		LOG_ERROR("Exception: {}", e.what());
 	}
 
-	// Terminate:
+	// Terminate, a non zero exit code lets headless ci runs detect failures:
 	delete pScene;
-	return 0;
+	return success ? 0 : 1;
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "materialManager.h"
 #include "material.h"
+#include "profiler.h"
+#include "threadPool.h"
 #include "vulkanContext.h"
 #include "vulkanMacros.h"
 #include "vulkanRenderer.h"
@@ -10,6 +12,9 @@
 bool MaterialManager::s_isInitialized = false;
 VulkanContext* MaterialManager::s_pContext;
 std::unordered_map<std::string, std::unique_ptr<Material>> MaterialManager::s_materials;
+std::unordered_map<std::string, std::shared_future<Material*>> MaterialManager::s_pendingMaterials;
+std::unique_ptr<ThreadPool> MaterialManager::s_pThreadPool;
+std::chrono::steady_clock::time_point MaterialManager::s_loadStart;
 
 
 
@@ -18,53 +23,52 @@ void MaterialManager::Init(VulkanContext* pContext)
 {
 	if (s_isInitialized)
 		return;
+	EMBER_PROFILE_SCOPE("MaterialManager::Init");
 
 	s_isInitialized = true;
 	s_pContext = pContext;
+	s_pThreadPool = std::make_unique<ThreadPool>(std::thread::hardware_concurrency());	// vkCreateGraphicsPipelines may be called concurrently
 	Material::RenderQueue opaqueQueue = Material::RenderQueue::opaque;
 	Material::RenderQueue transparentQueue = Material::RenderQueue::transparent;
 	Material::RenderQueue skyboxQueue = Material::RenderQueue::skybox;
 	Material::Type shadingType = Material::Type::shading;
 	Material::Type shadowType = Material::Type::shadow;
 	Material::Type skyboxType = Material::Type::skybox;
-
-	//Material* testMaterial = new Material(s_pContext, Material::Type::shading, "testMaterial", "../shaders/test.vert.spv", "../shaders/test.frag.spv");
-	//AddMaterial(testMaterial);
-
-	Material* pErrorMaterial = new Material(s_pContext, shadingType, "error", opaqueQueue, "../shaders/error.vert.spv", "../shaders/error.frag.spv");
-	AddMaterial(pErrorMaterial);
-
-	Material* pDefaultMaterial = new Material(s_pContext, shadingType, "default", opaqueQueue, "../shaders/default.vert.spv", "../shaders/default.frag.spv");
-	AddMaterial(pDefaultMaterial);
-
-	Material* pVertexColorLitMaterial = new Material(s_pContext, shadingType, "vertexColorLit", opaqueQueue, "../shaders/vertexColorLit.vert.spv", "../shaders/vertexColorLit.frag.spv");
-	AddMaterial(pVertexColorLitMaterial);
-
-	Material* pVertexColorUnlitMaterial = new Material(s_pContext, shadingType, "vertexColorUnlit", opaqueQueue, "../shaders/vertexColorUnlit.vert.spv", "../shaders/vertexColorUnlit.frag.spv");
-	AddMaterial(pVertexColorUnlitMaterial);
-
-	Material* pShadowMaterial = new Material(s_pContext, shadowType, "shadow", opaqueQueue, "../shaders/shadow.vert.spv");
-	AddMaterial(pShadowMaterial);
-
-	Material* pSkyBoxMaterial = new Material(s_pContext, skyboxType, "skybox", skyboxQueue, "../shaders/skybox.vert.spv", "../shaders/skybox.frag.spv");
-	AddMaterial(pSkyBoxMaterial);
-
-	Material* pSimpleLitMaterial = new Material(s_pContext, shadingType, "simpleLit", opaqueQueue, "../shaders/simpleLit.vert.spv", "../shaders/simpleLit.frag.spv");
-	AddMaterial(pSimpleLitMaterial);
-
-	Material* pSimpleUnlitMaterial = new Material(s_pContext, shadingType, "simpleUnlit", opaqueQueue, "../shaders/simpleUnlit.vert.spv", "../shaders/simpleUnlit.frag.spv");
-	AddMaterial(pSimpleUnlitMaterial);
+	auto loadMaterial = [](Material::Type type, const std::string& name, Material::RenderQueue renderQueue, const std::filesystem::path& vertexSpv, const std::filesystem::path& fragmentSpv = "")
+	{
+		AddMaterialAsync(name, [=]()
+		{
+			EMBER_PROFILE_SCOPE("MaterialManager::LoadMaterial");
+			return new Material(s_pContext, type, name, renderQueue, vertexSpv, fragmentSpv);
+		});
+	};
+
+	//loadMaterial(shadingType, "testMaterial", opaqueQueue, "../shaders/test.vert.spv", "../shaders/test.frag.spv");
+
+	loadMaterial(shadingType, "error", opaqueQueue, "../shaders/error.vert.spv", "../shaders/error.frag.spv");
+	loadMaterial(shadingType, "default", opaqueQueue, "../shaders/default.vert.spv", "../shaders/default.frag.spv");
+	loadMaterial(shadingType, "vertexColorLit", opaqueQueue, "../shaders/vertexColorLit.vert.spv", "../shaders/vertexColorLit.frag.spv");
+	loadMaterial(shadingType, "vertexColorUnlit", opaqueQueue, "../shaders/vertexColorUnlit.vert.spv", "../shaders/vertexColorUnlit.frag.spv");
+	loadMaterial(shadowType, "shadow", opaqueQueue, "../shaders/shadow.vert.spv");
+	loadMaterial(shadowType, "pointShadow", opaqueQueue, "../shaders/pointShadow.vert.spv");
+	loadMaterial(skyboxType, "skybox", skyboxQueue, "../shaders/skybox.vert.spv", "../shaders/skybox.frag.spv");
+	loadMaterial(shadingType, "simpleLit", opaqueQueue, "../shaders/simpleLit.vert.spv", "../shaders/simpleLit.frag.spv");
+	loadMaterial(shadingType, "simpleUnlit", opaqueQueue, "../shaders/simpleUnlit.vert.spv", "../shaders/simpleUnlit.frag.spv");
+
+	// Instanced variants, per instance data is read from the instanceData storage buffer:
+	loadMaterial(shadingType, "simpleLitInstanced", opaqueQueue, "../shaders/simpleLitInstanced.vert.spv", "../shaders/simpleLitInstanced.frag.spv");
+	loadMaterial(shadingType, "simpleUnlitInstanced", opaqueQueue, "../shaders/simpleUnlitInstanced.vert.spv", "../shaders/simpleUnlitInstanced.frag.spv");
 
 	// For testing the binding missmatch error:
-	Material* pTestA = new Material(s_pContext, shadingType, "testA", opaqueQueue, "../shaders/testA.vert.spv", "../shaders/testA.frag.spv");
-	AddMaterial(pTestA);
-	Material* pTestB = new Material(s_pContext, shadingType, "testB", opaqueQueue, "../shaders/testB.vert.spv", "../shaders/testB.frag.spv");
-	AddMaterial(pTestB);
+	loadMaterial(shadingType, "testA", opaqueQueue, "../shaders/testA.vert.spv", "../shaders/testA.frag.spv");
+	loadMaterial(shadingType, "testB", opaqueQueue, "../shaders/testB.vert.spv", "../shaders/testB.frag.spv");
 }
 void MaterialManager::Clear()
 {
+	WaitForMaterials();
 	s_pContext->WaitDeviceIdle();
 	s_materials.clear();
+	s_pThreadPool.reset();
 }
 
 
@@ -73,22 +77,65 @@ void MaterialManager::Clear()
 void MaterialManager::AddMaterial(Material* pMaterial)
 {
 	// If material already contained in MaterialManager, do nothing.
-	if (s_materials.emplace(pMaterial->GetName(), std::unique_ptr<Material>(pMaterial)).second == false)
+	if (s_pendingMaterials.find(pMaterial->GetName()) != s_pendingMaterials.end() || s_materials.emplace(pMaterial->GetName(), std::unique_ptr<Material>(pMaterial)).second == false)
 	{
 		LOG_WARN("Material with the name: {} already exists in MaterialManager!", pMaterial->GetName());
 		return;
 	}
 }
+/// <summary>
+/// Runs createMaterial() on the thread pool. The material is added once it is first requested or waited for.
+/// createMaterial must not access the MaterialManager.
+/// </summary>
+void MaterialManager::AddMaterialAsync(const std::string& name, std::function<Material*()> createMaterial)
+{
+	if (s_materials.find(name) != s_materials.end() || s_pendingMaterials.find(name) != s_pendingMaterials.end())
+	{
+		LOG_WARN("Material with the name: {} already exists in MaterialManager!", name);
+		return;
+	}
+	if (s_pendingMaterials.empty())
+		s_loadStart = std::chrono::steady_clock::now();
+	s_pendingMaterials.emplace(name, s_pThreadPool->Submit(std::move(createMaterial)).share());
+}
 Material* MaterialManager::GetMaterial(const std::string& name)
 {
 	auto it = s_materials.find(name);
 	if (it != s_materials.end())
 		return it->second.get();
+
+	// Only wait for the requested material, the others keep loading:
+	auto pending = s_pendingMaterials.find(name);
+	if (pending != s_pendingMaterials.end())
+		return FinishLoading(pending);
+
 	LOG_WARN("Material '{}' not found!", name);
 	return nullptr;
 }
+/// <summary>
+/// Handle to a material that may still be loading, e.g. to poll readiness with wait_for(0) instead of blocking.
+/// The future of an unknown material holds nullptr.
+/// </summary>
+std::shared_future<Material*> MaterialManager::GetMaterialFuture(const std::string& name)
+{
+	auto pending = s_pendingMaterials.find(name);
+	if (pending != s_pendingMaterials.end())
+		return pending->second;
+
+	std::promise<Material*> promise;
+	promise.set_value(GetMaterial(name));
+	return promise.get_future().share();
+}
+void MaterialManager::WaitForMaterials()
+{
+	while (!s_pendingMaterials.empty())
+		FinishLoading(s_pendingMaterials.begin());
+}
 void MaterialManager::DeleteMaterial(const std::string& name)
 {
+	auto pending = s_pendingMaterials.find(name);
+	if (pending != s_pendingMaterials.end())
+		FinishLoading(pending);
 	s_pContext->WaitDeviceIdle();
 	s_materials.erase(name);
 }
@@ -98,7 +145,26 @@ void MaterialManager::DeleteMaterial(const std::string& name)
 // Debugging:
 void MaterialManager::PrintAllMaterialNames()
 {
+	WaitForMaterials();
 	LOG_TRACE("Names of all managed materials:");
 	for (const auto& pair : s_materials)
 		LOG_TRACE(pair.first);
+}
+
+
+
+// Private methods:
+Material* MaterialManager::FinishLoading(std::unordered_map<std::string, std::shared_future<Material*>>::iterator it)
+{
+	Material* pMaterial = it->second.get();
+	s_materials.emplace(it->first, std::unique_ptr<Material>(pMaterial));
+	s_pendingMaterials.erase(it);
+
+	// Startup cost is dominated by pipeline creation, i.e. warm vs cold pipeline cache:
+	if (s_pendingMaterials.empty())
+	{
+		float duration = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - s_loadStart).count();
+		LOG_INFO("MaterialManager: all {} materials loaded after {:.1f} ms.", s_materials.size(), duration);
+	}
+	return pMaterial;
 }
\ No newline at end of file
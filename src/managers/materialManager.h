@@ -1,5 +1,8 @@
 #ifndef __INCLUDE_GUARD_materialManager_h__
 #define __INCLUDE_GUARD_materialManager_h__
+#include <chrono>
+#include <functional>
+#include <future>
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -7,12 +10,16 @@
 
 
 class Material;
+class ThreadPool;
 struct VulkanContext;
 
 
 
 /// <summary>
 /// Purely static class that takes care of lifetime of all Material objects.
+/// Materials are created on a thread pool (shader file reads, reflection and pipeline creation).
+/// GetMaterial(...) only waits for the requested material, so the first frame does not wait for unused ones.
+/// All methods must be called from the main thread.
 /// </summary>
 class MaterialManager
 {
@@ -20,18 +27,26 @@ private: // Members
     static bool s_isInitialized;
 	static VulkanContext* s_pContext;
     static std::unordered_map<std::string, std::unique_ptr<Material>> s_materials;
+	static std::unordered_map<std::string, std::shared_future<Material*>> s_pendingMaterials;
+	static std::unique_ptr<ThreadPool> s_pThreadPool;
+	static std::chrono::steady_clock::time_point s_loadStart;
 
 public: // Methods
     static void Init(VulkanContext* pContext);
 	static void Clear();
 
     static void AddMaterial(Material* pMaterial);
+	static void AddMaterialAsync(const std::string& name, std::function<Material*()> createMaterial);
     static Material* GetMaterial(const std::string& name);
+	static std::shared_future<Material*> GetMaterialFuture(const std::string& name);
+	static void WaitForMaterials();
     static void DeleteMaterial(const std::string& name);
 
     static void PrintAllMaterialNames();
 
 private: // Methods
+	static Material* FinishLoading(std::unordered_map<std::string, std::shared_future<Material*>>::iterator it);
+
     // Delete all constructors:
     MaterialManager() = delete;
     MaterialManager(const MaterialManager&) = delete;
@@ -2,6 +2,7 @@
 #include "logger.h"
 #include "mesh.h"
 #include "meshGenerator.h"
+#include "profiler.h"
 #include "vulkanContext.h"
 
 
@@ -18,6 +19,7 @@ void MeshManager::Init(VulkanContext* pContext)
 {
 	if (s_isInitialized)
 		return;
+	EMBER_PROFILE_SCOPE("MeshManager::Init");
 
 	s_isInitialized = true;
 	s_pContext = pContext;
@@ -1,5 +1,6 @@
 #include "renderPassManager.h"
 #include "logger.h"
+#include "profiler.h"
 #include "renderPass.h"
 #include "shadingRenderPass.h"
 #include "shadowRenderPass.h"
@@ -19,6 +20,7 @@ void RenderPassManager::Init(VulkanContext* pContext)
 {
 	if (s_isInitialized)
 		return;
+	EMBER_PROFILE_SCOPE("RenderPassManager::Init");
 
 	s_isInitialized = true;
 	RenderPassManager::s_pContext = pContext;
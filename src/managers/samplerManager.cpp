@@ -1,4 +1,5 @@
 #include "SamplerManager.h"
+#include "profiler.h"
 #include "sampler.h"
 #include "vulkanContext.h"
 #include "vulkanMacros.h"
@@ -17,6 +18,7 @@ void SamplerManager::Init(VulkanContext* pContext)
 {
 	if (s_isInitialized)
 		return;
+	EMBER_PROFILE_SCOPE("SamplerManager::Init");
 
 	s_isInitialized = true;
 	s_pContext = pContext;
@@ -1,4 +1,5 @@
 #include "textureManager.h"
+#include "profiler.h"
 #include "texture2d.h"
 #include "textureCube.h"
 #include "vulkanContext.h"
@@ -20,6 +21,7 @@ void TextureManager::Init(VulkanContext* pContext)
 {
 	if (s_isInitialized)
 		return;
+	EMBER_PROFILE_SCOPE("TextureManager::Init");
 
 	s_isInitialized = true;
 	s_pContext = pContext;
@@ -0,0 +1,243 @@
+#include "batch.h"
+#include "mathf.h"
+#include "simd.h"
+
+
+
+static_assert(sizeof(Float3) == 3 * sizeof(float), "mathf::batch requires tightly packed Float3.");
+
+
+
+// Private helpers:
+namespace
+{
+	// Calls simdKernel(x, y, z) on blocks of four elements and scalarKernel(Float3&) on the remainder:
+	template<typename SimdKernel, typename ScalarKernel>
+	void ForEach(std::span<Float3> vectors, SimdKernel simdKernel, ScalarKernel scalarKernel)
+	{
+		float* pData = reinterpret_cast<float*>(vectors.data());
+		size_t blockCount = vectors.size() / 4;
+		for (size_t block = 0; block < blockCount; block++)
+		{
+			float* pBlock = pData + 12 * block;
+			simd::Register x, y, z;
+			simd::Deinterleave3(simd::Load(pBlock), simd::Load(pBlock + 4), simd::Load(pBlock + 8), x, y, z);
+			simdKernel(x, y, z);
+			simd::Register r0, r1, r2;
+			simd::Interleave3(x, y, z, r0, r1, r2);
+			simd::Store(pBlock, r0);
+			simd::Store(pBlock + 4, r1);
+			simd::Store(pBlock + 8, r2);
+		}
+		for (size_t i = 4 * blockCount; i < vectors.size(); i++)
+			scalarKernel(vectors[i]);
+	}
+
+	// Same as ForEach, but with a second read only array of the same size:
+	template<typename SimdKernel, typename ScalarKernel>
+	void ForEachPair(std::span<Float3> vectors, std::span<const Float3> others, SimdKernel simdKernel, ScalarKernel scalarKernel)
+	{
+		float* pData = reinterpret_cast<float*>(vectors.data());
+		const float* pOther = reinterpret_cast<const float*>(others.data());
+		size_t count = std::min(vectors.size(), others.size());
+		size_t blockCount = count / 4;
+		for (size_t block = 0; block < blockCount; block++)
+		{
+			float* pBlock = pData + 12 * block;
+			const float* pOtherBlock = pOther + 12 * block;
+			simd::Register x, y, z, ox, oy, oz;
+			simd::Deinterleave3(simd::Load(pBlock), simd::Load(pBlock + 4), simd::Load(pBlock + 8), x, y, z);
+			simd::Deinterleave3(simd::Load(pOtherBlock), simd::Load(pOtherBlock + 4), simd::Load(pOtherBlock + 8), ox, oy, oz);
+			simdKernel(x, y, z, ox, oy, oz);
+			simd::Register r0, r1, r2;
+			simd::Interleave3(x, y, z, r0, r1, r2);
+			simd::Store(pBlock, r0);
+			simd::Store(pBlock + 4, r1);
+			simd::Store(pBlock + 8, r2);
+		}
+		for (size_t i = 4 * blockCount; i < count; i++)
+			scalarKernel(vectors[i], others[i]);
+	}
+}
+
+
+
+namespace mathf::batch
+{
+	// Component wise operations:
+	void Translate(std::span<Float3> points, const Float3& translation)
+	{
+		simd::Register tx = simd::Splat(translation.x);
+		simd::Register ty = simd::Splat(translation.y);
+		simd::Register tz = simd::Splat(translation.z);
+		ForEach(points,
+			[&](simd::Register& x, simd::Register& y, simd::Register& z)
+			{
+				x = simd::Add(x, tx);
+				y = simd::Add(y, ty);
+				z = simd::Add(z, tz);
+			},
+			[&](Float3& point) { point += translation; });
+	}
+	void Scale(std::span<Float3> vectors, const Float3& scale)
+	{
+		simd::Register sx = simd::Splat(scale.x);
+		simd::Register sy = simd::Splat(scale.y);
+		simd::Register sz = simd::Splat(scale.z);
+		ForEach(vectors,
+			[&](simd::Register& x, simd::Register& y, simd::Register& z)
+			{
+				x = simd::Mul(x, sx);
+				y = simd::Mul(y, sy);
+				z = simd::Mul(z, sz);
+			},
+			[&](Float3& vector) { vector = scale * vector; });
+	}
+	void Scale(std::span<Float3> vectors, float scale)
+	{
+		Scale(vectors, Float3(scale));
+	}
+	void Lerp(std::span<Float3> vectors, std::span<const Float3> targets, float t)
+	{
+		// vectors[i] += t * (targets[i] - vectors[i]):
+		simd::Register factor = simd::Splat(t);
+		ForEachPair(vectors, targets,
+			[&](simd::Register& x, simd::Register& y, simd::Register& z, simd::Register tx, simd::Register ty, simd::Register tz)
+			{
+				x = simd::MulAdd(factor, simd::Sub(tx, x), x);
+				y = simd::MulAdd(factor, simd::Sub(ty, y), y);
+				z = simd::MulAdd(factor, simd::Sub(tz, z), z);
+			},
+			[&](Float3& vector, const Float3& target) { vector = vector + t * (target - vector); });
+	}
+	void Normalize(std::span<Float3> vectors)
+	{
+		// Same convention as Float3::Normalize(), vectors with length <= EPSILON become zero:
+		simd::Register epsilon = simd::Splat(mathf::EPSILON);
+		simd::Register one = simd::Splat(1.0f);
+		ForEach(vectors,
+			[&](simd::Register& x, simd::Register& y, simd::Register& z)
+			{
+				simd::Register length = simd::Sqrt(simd::MulAdd(x, x, simd::MulAdd(y, y, simd::Mul(z, z))));
+				simd::Register invLength = simd::And(simd::Greater(length, epsilon), simd::Div(one, length));
+				x = simd::Mul(x, invLength);
+				y = simd::Mul(y, invLength);
+				z = simd::Mul(z, invLength);
+			},
+			[&](Float3& vector) { vector = vector.Normalize(); });
+	}
+	void ProjectOnPlanes(std::span<Float3> vectors, std::span<const Float3> unitNormals)
+	{
+		// vectors[i] -= Dot(vectors[i], unitNormals[i]) * unitNormals[i]:
+		ForEachPair(vectors, unitNormals,
+			[&](simd::Register& x, simd::Register& y, simd::Register& z, simd::Register nx, simd::Register ny, simd::Register nz)
+			{
+				simd::Register dot = simd::MulAdd(x, nx, simd::MulAdd(y, ny, simd::Mul(z, nz)));
+				x = simd::Sub(x, simd::Mul(dot, nx));
+				y = simd::Sub(y, simd::Mul(dot, ny));
+				z = simd::Sub(z, simd::Mul(dot, nz));
+			},
+			[&](Float3& vector, const Float3& unitNormal) { vector = vector - Float3::Dot(vector, unitNormal) * unitNormal; });
+	}
+
+
+
+	// Matrix transformations:
+	void Transform(std::span<Float3> vectors, const Float3x3& matrix)
+	{
+		simd::Register m[9];
+		for (int i = 0; i < 9; i++)
+			m[i] = simd::Splat(matrix[i]);
+		ForEach(vectors,
+			[&](simd::Register& x, simd::Register& y, simd::Register& z)
+			{
+				simd::Register rx = simd::MulAdd(m[0], x, simd::MulAdd(m[3], y, simd::Mul(m[6], z)));
+				simd::Register ry = simd::MulAdd(m[1], x, simd::MulAdd(m[4], y, simd::Mul(m[7], z)));
+				simd::Register rz = simd::MulAdd(m[2], x, simd::MulAdd(m[5], y, simd::Mul(m[8], z)));
+				x = rx;
+				y = ry;
+				z = rz;
+			},
+			[&](Float3& vector) { vector = matrix * vector; });
+	}
+	void TransformPoints(std::span<Float3> points, const Float4x4& matrix)
+	{
+		simd::Register m[15];
+		for (int i = 0; i < 15; i++)
+			m[i] = simd::Splat(matrix[i]);
+		ForEach(points,
+			[&](simd::Register& x, simd::Register& y, simd::Register& z)
+			{
+				simd::Register rx = simd::MulAdd(m[0], x, simd::MulAdd(m[4], y, simd::MulAdd(m[ 8], z, m[12])));
+				simd::Register ry = simd::MulAdd(m[1], x, simd::MulAdd(m[5], y, simd::MulAdd(m[ 9], z, m[13])));
+				simd::Register rz = simd::MulAdd(m[2], x, simd::MulAdd(m[6], y, simd::MulAdd(m[10], z, m[14])));
+				x = rx;
+				y = ry;
+				z = rz;
+			},
+			[&](Float3& point) { point = Float3(matrix * Float4(point, 1.0f)); });
+	}
+	void TransformDirections(std::span<Float3> directions, const Float4x4& matrix)
+	{
+		Transform(directions, Float3x3(matrix));
+	}
+
+
+
+	// Reductions:
+	void MinMax(std::span<const Float3> points, Float3& min, Float3& max)
+	{
+		if (points.empty())
+		{
+			min = max = Float3::zero;
+			return;
+		}
+
+		const float* pData = reinterpret_cast<const float*>(points.data());
+		size_t blockCount = points.size() / 4;
+		min = max = points[0];
+		if (blockCount > 0)
+		{
+			simd::Register minX = simd::Splat(min.x), minY = simd::Splat(min.y), minZ = simd::Splat(min.z);
+			simd::Register maxX = minX, maxY = minY, maxZ = minZ;
+			for (size_t block = 0; block < blockCount; block++)
+			{
+				const float* pBlock = pData + 12 * block;
+				simd::Register x, y, z;
+				simd::Deinterleave3(simd::Load(pBlock), simd::Load(pBlock + 4), simd::Load(pBlock + 8), x, y, z);
+				minX = simd::Min(minX, x); minY = simd::Min(minY, y); minZ = simd::Min(minZ, z);
+				maxX = simd::Max(maxX, x); maxY = simd::Max(maxY, y); maxZ = simd::Max(maxZ, z);
+			}
+			min = Float3(simd::HorizontalMin(minX), simd::HorizontalMin(minY), simd::HorizontalMin(minZ));
+			max = Float3(simd::HorizontalMax(maxX), simd::HorizontalMax(maxY), simd::HorizontalMax(maxZ));
+		}
+		for (size_t i = 4 * blockCount; i < points.size(); i++)
+		{
+			min = Float3::Min(min, points[i]);
+			max = Float3::Max(max, points[i]);
+		}
+	}
+	float MaxDistanceSq(std::span<const Float3> points, const Float3& point)
+	{
+		const float* pData = reinterpret_cast<const float*>(points.data());
+		size_t blockCount = points.size() / 4;
+		float maxDistanceSq = 0.0f;
+		if (blockCount > 0)
+		{
+			simd::Register px = simd::Splat(point.x), py = simd::Splat(point.y), pz = simd::Splat(point.z);
+			simd::Register maxDistance = simd::Splat(0.0f);
+			for (size_t block = 0; block < blockCount; block++)
+			{
+				const float* pBlock = pData + 12 * block;
+				simd::Register x, y, z;
+				simd::Deinterleave3(simd::Load(pBlock), simd::Load(pBlock + 4), simd::Load(pBlock + 8), x, y, z);
+				x = simd::Sub(x, px); y = simd::Sub(y, py); z = simd::Sub(z, pz);
+				maxDistance = simd::Max(maxDistance, simd::MulAdd(x, x, simd::MulAdd(y, y, simd::Mul(z, z))));
+			}
+			maxDistanceSq = simd::HorizontalMax(maxDistance);
+		}
+		for (size_t i = 4 * blockCount; i < points.size(); i++)
+			maxDistanceSq = mathf::Max(maxDistanceSq, Float3::DistanceSq(points[i], point));
+		return maxDistanceSq;
+	}
+}
\ No newline at end of file
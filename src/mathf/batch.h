@@ -0,0 +1,37 @@
+#ifndef __INCLUDE_GUARD_batch_h__
+#define __INCLUDE_GUARD_batch_h__
+#include <span>
+
+
+
+struct Float3;
+struct Float3x3;
+struct Float4x4;
+
+
+
+// Batched operations on arrays of Float3 (array of structures layout).
+// Blocks of four elements are converted to structure of arrays form and processed with simd.h, the remainder one by one.
+namespace mathf::batch
+{
+	// Component wise operations:
+	void Translate(std::span<Float3> points, const Float3& translation);
+	void Scale(std::span<Float3> vectors, const Float3& scale);
+	void Scale(std::span<Float3> vectors, float scale);
+	void Lerp(std::span<Float3> vectors, std::span<const Float3> targets, float t);
+	void Normalize(std::span<Float3> vectors);
+	void ProjectOnPlanes(std::span<Float3> vectors, std::span<const Float3> unitNormals);
+
+	// Matrix transformations:
+	void Transform(std::span<Float3> vectors, const Float3x3& matrix);
+	void TransformPoints(std::span<Float3> points, const Float4x4& matrix);			// w = 1
+	void TransformDirections(std::span<Float3> directions, const Float4x4& matrix);	// w = 0
+
+	// Reductions:
+	void MinMax(std::span<const Float3> points, Float3& min, Float3& max);
+	float MaxDistanceSq(std::span<const Float3> points, const Float3& point);
+}
+
+
+
+#endif // __INCLUDE_GUARD_batch_h__
\ No newline at end of file
@@ -9,19 +9,17 @@ Bounds::Bounds(const Float3& center, const Float3& extents) : center(center), ex
 Bounds::Bounds(const Bounds& bounds) : center(bounds.center), extents(bounds.extents) {}
 Bounds::Bounds(const Float3* const points)
 {
-	Float3 min = points[0];
-	Float3 max = points[0];
-	for (int i = 1; i < 8; i++)
-	{
-		min = Float3::Min(min, points[i]);
-		max = Float3::Max(max, points[i]);
-	}
+	Float3 min, max;
+	mathf::batch::MinMax(std::span<const Float3>(points, 8), min, max);
 	center = 0.5f * (max + min);
 	extents = 0.5f * (max - min);
 }
 Bounds::Bounds(const std::vector<Float3>& points)
 {
-	this->Bounds::Bounds(points.data());
+	Float3 min, max;
+	mathf::batch::MinMax(points, min, max);
+	center = 0.5f * (max + min);
+	extents = 0.5f * (max - min);
 }
 
 
@@ -81,6 +79,15 @@ void Bounds::SetMinMax(const Float3& min, const Float3& max)
 	center = 0.5f * (max + min);
 	extents = 0.5f * (max - min);
 }
+Bounds Bounds::Transform(const Float4x4& matrix) const
+{
+	// Arvo: the new extents are the old extents projected onto the absolute linear part of the matrix:
+	Float3 newCenter = Float3(matrix * Float4(center, 1.0f));
+	Float3 newExtents;
+	for (uint32_t i = 0; i < 3; i++)
+		newExtents[i] = mathf::Abs(matrix[Index2{ i, 0 }]) * extents.x + mathf::Abs(matrix[Index2{ i, 1 }]) * extents.y + mathf::Abs(matrix[Index2{ i, 2 }]) * extents.z;
+	return Bounds(newCenter, newExtents);
+}
 //float Bounds::SqrDistance(const Float3& point) const
 //{
 //
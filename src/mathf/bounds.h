@@ -6,6 +6,10 @@
 
 
 
+struct Float4x4;
+
+
+
 struct Bounds
 {
 public: // Members:
@@ -18,6 +22,7 @@ public: // Methods:
 	Bounds(const Bounds& bounds);
 	Bounds(const Float3* const points);
 	Bounds(const std::vector<Float3>& points);
+	Bounds& operator=(const Bounds& other) = default;
 
 	Float3 GetMin() const;
 	Float3 GetMax() const;
@@ -30,6 +35,7 @@ public: // Methods:
 	//bool IntersectRay(const Ray& ray);
 	//bool Intersects(const Bounds& bounds) const;
 	void SetMinMax(const Float3& min, const Float3& max);
+	Bounds Transform(const Float4x4& matrix) const;	// axis aligned bounds of the transformed box.
 	//float SqrDistance(const Float3& point) const;
 	std::string ToString() const;
 };
@@ -1,6 +1,7 @@
 #ifndef __INCLUDE_GUARD_float2_h__
 #define __INCLUDE_GUARD_float2_h__
 #include <string>
+#include <stdexcept>
 
 
 
@@ -16,16 +17,16 @@ public:
 	float x, y;
 
 	// Constructors:
-	Float2();
-	Float2(float xy);
-	Float2(float x, float y);
-	Float2(const Float2& xy);
+	constexpr Float2();
+	constexpr Float2(float xy);
+	constexpr Float2(float x, float y);
+	constexpr Float2(const Float2& xy) = default;
 	explicit Float2(const Float3& xy);
 	explicit Float2(const Float4& xy);
 	static Float2 Direction(float angle);
 
 	// Math operations:
-	float LengthSq() const;
+	constexpr float LengthSq() const;
 	float Length() const;
 	float Angle() const;
 	Float2 Normalize() const;
@@ -34,67 +35,273 @@ public:
 
 	// Static math operations:
 	static Float2 Abs(const Float2& a);
-	static float Dot(const Float2& a, const Float2& b);
-	static float Cross(const Float2& a, const Float2& b);
-	static float DistanceSq(const Float2& a, const Float2& b);
+	static constexpr float Dot(const Float2& a, const Float2& b);
+	static constexpr float Cross(const Float2& a, const Float2& b);
+	static constexpr float DistanceSq(const Float2& a, const Float2& b);
 	static float Distance(const Float2& a, const Float2& b);
 	static float Angle(const Float2& a, const Float2& b);
-	static Float2 Min(const Float2& a, const Float2& b);
-	static Float2 Max(const Float2& a, const Float2& b);
-	static Float2 Clamp(const Float2& value, const Float2& min, const Float2& max);
+	static constexpr Float2 Min(const Float2& a, const Float2& b);
+	static constexpr Float2 Max(const Float2& a, const Float2& b);
+	static constexpr Float2 Clamp(const Float2& value, const Float2& min, const Float2& max);
 
 	// Access:
-	float& operator[](int index);
-	float operator[](int index) const;
+	constexpr float& operator[](int index);
+	constexpr float operator[](int index) const;
 
 	// Assignment:
-	Float2& operator=(const Float2& other);
-	Float2& operator=(Float2&& other) noexcept;
+	constexpr Float2& operator=(const Float2& other) = default;
+	constexpr Float2& operator=(Float2&& other) noexcept = default;
 
 	// Addition:
-	Float2 operator+(const Float2& other) const;
-	Float2& operator+=(const Float2& other);
+	constexpr Float2 operator+(const Float2& other) const;
+	constexpr Float2& operator+=(const Float2& other);
 
 	// Substraction:
-	Float2 operator-(const Float2& other) const;
-	Float2& operator-=(const Float2& other);
-	Float2 operator-() const;
+	constexpr Float2 operator-(const Float2& other) const;
+	constexpr Float2& operator-=(const Float2& other);
+	constexpr Float2 operator-() const;
 
 	// Multiplication:
-	Float2 operator*(const Float2& other) const;
-	Float2& operator*=(const Float2& other);
-	Float2& operator*=(float scalar);
+	constexpr Float2 operator*(const Float2& other) const;
+	constexpr Float2& operator*=(const Float2& other);
+	constexpr Float2& operator*=(float scalar);
 
 	// Division:
-	Float2 operator/(const Float2& other) const;
-	Float2& operator/=(const Float2& other);
-	Float2 operator/(float scalar) const;
-	Float2& operator/=(float scalar);
+	constexpr Float2 operator/(const Float2& other) const;
+	constexpr Float2& operator/=(const Float2& other);
+	constexpr Float2 operator/(float scalar) const;
+	constexpr Float2& operator/=(float scalar);
 
 	// Comparison:
 	bool IsEpsilonEqual(const Float2& other) const;
-	bool operator==(const Float2& other) const;
-	bool operator!=(const Float2& other) const;
+	constexpr bool operator==(const Float2& other) const;
+	constexpr bool operator!=(const Float2& other) const;
 
 	// Friend functions:
-	friend Float2 operator*(float a, const Float2& b);
-	friend Float2 operator*(const Float2& a, float b);
+	friend constexpr Float2 operator*(float a, const Float2& b);
+	friend constexpr Float2 operator*(const Float2& a, float b);
 
 	// Logging:
 	std::string ToString() const;
 	friend std::ostream& operator<<(std::ostream& os, const Float2& value);
 
 	// Static members:
-	static Float2 zero;
-	static Float2 one;
-	static Float2 right;	// +x = ( 1, 0).
-	static Float2 left;		// -x = (-1, 0).
-	static Float2 up;		// +y = ( 0, 1).
-	static Float2 down;		// -y = ( 0,-1).
+	static const Float2 zero;
+	static const Float2 one;
+	static const Float2 right;	// +x = ( 1, 0).
+	static const Float2 left;	// -x = (-1, 0).
+	static const Float2 up;		// +y = ( 0, 1).
+	static const Float2 down;	// -y = ( 0,-1).
 };
 
 // Friend functions:
-Float2 operator/(float scalar, const Float2& vector);
+constexpr Float2 operator/(float scalar, const Float2& vector);
+
+
+
+// Inline definitions (hot arithmetic lives in the header so it can be inlined without LTO).
+// mathf.h is included after the declaration above, as it includes this header itself.
+#include "mathf.h"
+
+
+
+// Constructors:
+constexpr Float2::Float2() : x(0), y(0) {}
+constexpr Float2::Float2(float xy) : x(xy), y(xy) {}
+constexpr Float2::Float2(float x, float y) : x(x), y(y) {}
+
+
+
+// Math operations:
+constexpr float Float2::LengthSq() const
+{
+	return x * x + y * y;
+}
+inline float Float2::Length() const
+{
+	return mathf::Sqrt(LengthSq());
+}
+inline Float2 Float2::Normalize() const
+{
+	float length = Length();
+	if (length <= mathf::EPSILON)
+		return Float2(0.0f);
+	return Float2(x / length, y / length);
+}
+inline bool Float2::IsEpsilonZero() const
+{
+	return IsEpsilonEqual(Float2::zero);
+}
+
+
+
+// Static math operations:
+inline Float2 Float2::Abs(const Float2& a)
+{
+	return Float2(mathf::Abs(a.x), mathf::Abs(a.y));
+}
+constexpr float Float2::Dot(const Float2& a, const Float2& b)
+{
+	return a.x * b.x + a.y * b.y;
+}
+constexpr float Float2::Cross(const Float2& a, const Float2& b)
+{
+	return a.y * b.x - a.x * b.y;
+}
+constexpr float Float2::DistanceSq(const Float2& a, const Float2& b)
+{
+	return (a - b).LengthSq();
+}
+inline float Float2::Distance(const Float2& a, const Float2& b)
+{
+	return (a - b).Length();
+}
+constexpr Float2 Float2::Min(const Float2& a, const Float2& b)
+{
+	return Float2(mathf::Min(a.x, b.x), mathf::Min(a.y, b.y));
+}
+constexpr Float2 Float2::Max(const Float2& a, const Float2& b)
+{
+	return Float2(mathf::Max(a.x, b.x), mathf::Max(a.y, b.y));
+}
+constexpr Float2 Float2::Clamp(const Float2& value, const Float2& min, const Float2& max)
+{
+	return Float2(mathf::Clamp(value.x, min.x, max.x), mathf::Clamp(value.y, min.y, max.y));
+}
+
+
+
+// Access:
+constexpr float& Float2::operator[](int index)
+{
+	if (index == 0) return x;
+	if (index == 1) return y;
+	throw std::out_of_range("Float2 index out of range.");
+}
+constexpr float Float2::operator[](int index) const
+{
+	if (index == 0) return x;
+	if (index == 1) return y;
+	throw std::out_of_range("Float2 index out of range.");
+}
+
+
+
+// Addition:
+constexpr Float2 Float2::operator+(const Float2& other) const
+{
+	return Float2(x + other.x, y + other.y);
+}
+constexpr Float2& Float2::operator+=(const Float2& other)
+{
+	this->x += other.x;
+	this->y += other.y;
+	return *this;
+}
+
+
+
+// Substraction:
+constexpr Float2 Float2::operator-(const Float2& other) const
+{
+	return Float2(x - other.x, y - other.y);
+}
+constexpr Float2& Float2::operator-=(const Float2& other)
+{
+	this->x -= other.x;
+	this->y -= other.y;
+	return *this;
+}
+constexpr Float2 Float2::operator-() const
+{
+	return Float2(-x, -y);
+}
+
+
+
+// Multiplication:
+constexpr Float2 Float2::operator*(const Float2& other) const
+{
+	return Float2(x * other.x, y * other.y);
+}
+constexpr Float2& Float2::operator*=(const Float2& other)
+{
+	this->x *= other.x;
+	this->y *= other.y;
+	return *this;
+}
+constexpr Float2& Float2::operator*=(float scalar)
+{
+	x *= scalar;
+	y *= scalar;
+	return *this;
+}
+
+
+
+// Division:
+constexpr Float2 Float2::operator/(const Float2& other) const
+{
+	return Float2(x / other.x, y / other.y);
+}
+constexpr Float2& Float2::operator/=(const Float2& other)
+{
+	this->x /= other.x;
+	this->y /= other.y;
+	return *this;
+}
+constexpr Float2 Float2::operator/(float scalar) const
+{
+	return Float2(x / scalar, y / scalar);
+}
+constexpr Float2& Float2::operator/=(float scalar)
+{
+	x /= scalar;
+	y /= scalar;
+	return *this;
+}
+constexpr Float2 operator/(float scalar, const Float2& vector)
+{
+	return Float2(scalar / vector.x, scalar / vector.y);
+}
+
+
+
+// Comparison:
+inline bool Float2::IsEpsilonEqual(const Float2& other) const
+{
+	return mathf::Abs(x - other.x) < mathf::EPSILON && mathf::Abs(y - other.y) < mathf::EPSILON;
+}
+constexpr bool Float2::operator==(const Float2& other) const
+{
+	return x == other.x && y == other.y;
+}
+constexpr bool Float2::operator!=(const Float2& other) const
+{
+	return !(*this == other);
+}
+
+
+
+// Friend functions:
+constexpr Float2 operator*(float a, const Float2& b)
+{
+	return Float2(a * b.x, a * b.y);
+}
+constexpr Float2 operator*(const Float2& a, float b)
+{
+	return Float2(a.x * b, a.y * b);
+}
+
+
+
+// Static members:
+inline constexpr Float2 Float2::zero = Float2(0.0f);
+inline constexpr Float2 Float2::one = Float2(1.0f);
+inline constexpr Float2 Float2::right = Float2(1.0f, 0.0f);
+inline constexpr Float2 Float2::left = Float2(-1.0f, 0.0f);
+inline constexpr Float2 Float2::up = Float2(0.0f, 1.0f);
+inline constexpr Float2 Float2::down = Float2(0.0f, -1.0f);
 
 
 
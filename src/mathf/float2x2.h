@@ -2,6 +2,7 @@
 #define __INCLUDE_GUARD_float2x2_h__
 #include "mathf.h"
 #include <string>
+#include <stdexcept>
 
 
 
@@ -17,7 +18,7 @@ struct Float2x2
 	// xy yy   1  3    [1,0] [1,1]
 
 private:
-	Float2x2
+	constexpr Float2x2
 	(float xx, float xy,	// column 0
 	 float yx, float yy);	// column 1
 
@@ -26,24 +27,24 @@ public:
 	float data[4];
 
 	// Constructors:
-	Float2x2();
-	Float2x2(float value);
-	Float2x2(const float* const array);
-	Float2x2(const Float2x2& other);
+	constexpr Float2x2();
+	constexpr Float2x2(float value);
+	constexpr Float2x2(const float* const array);
+	constexpr Float2x2(const Float2x2& other) = default;
 
 	// Static constructors:
 	static Float2x2 Rows(const Float2& row0, const Float2& row1);
-	static Float2x2 Rows
+	static constexpr Float2x2 Rows
 	(float row0x, float row0y,
 	 float row1x, float row1y);
 	static Float2x2 Columns(const Float2& column0, const Float2& column1);
-	static Float2x2 Columns
+	static constexpr Float2x2 Columns
 	(float column0x, float column0y,
 	 float column1x, float column1y);
 
 	// Math operations:
-	Float2x2 Transpose() const;
-	float Determinant() const;
+	constexpr Float2x2 Transpose() const;
+	constexpr float Determinant() const;
 	Float2x2 Inverse() const;
 	Float2x2 Inverse(float det) const;
 	bool IsEpsilonZero() const;
@@ -52,45 +53,45 @@ public:
 	static Float2x2 Rotate(float radians);
 
 	// Access:
-	float& operator[](int index);
-	float operator[](int index) const;
-	float& operator[](const Index2& index);
-	float operator[](const Index2& index) const;
-	Float2 GetRow(int index) const;
-	Float2 GetColumn(int index) const;
+	constexpr float& operator[](int index);
+	constexpr float operator[](int index) const;
+	constexpr float& operator[](const Index2& index);
+	constexpr float operator[](const Index2& index) const;
+	constexpr Float2 GetRow(int index) const;
+	constexpr Float2 GetColumn(int index) const;
 
 	// Assignment:
-	Float2x2& operator=(const Float2x2& other);
-	Float2x2& operator=(Float2x2&& other) noexcept;
+	constexpr Float2x2& operator=(const Float2x2& other) = default;
+	constexpr Float2x2& operator=(Float2x2&& other) noexcept = default;
 
 	// Addition:
-	Float2x2 operator+(const Float2x2& other) const;
-	Float2x2& operator+=(const Float2x2& other);
+	constexpr Float2x2 operator+(const Float2x2& other) const;
+	constexpr Float2x2& operator+=(const Float2x2& other);
 
 	// Substraction:
-	Float2x2 operator-(const Float2x2& other) const;
-	Float2x2& operator-=(const Float2x2& other);
-	Float2x2 operator-() const;
+	constexpr Float2x2 operator-(const Float2x2& other) const;
+	constexpr Float2x2& operator-=(const Float2x2& other);
+	constexpr Float2x2 operator-() const;
 
 	// Multiplication:
-	Float2x2 operator*(const Float2x2& other) const;
-	Float2x2& operator*=(const Float2x2& other);
-	Float2x2& operator*=(float scalar);
+	constexpr Float2x2 operator*(const Float2x2& other) const;
+	constexpr Float2x2& operator*=(const Float2x2& other);
+	constexpr Float2x2& operator*=(float scalar);
 
 	// Division:
-	Float2x2 operator/(float scalar) const;
-	Float2x2& operator/=(float scalar);
+	constexpr Float2x2 operator/(float scalar) const;
+	constexpr Float2x2& operator/=(float scalar);
 
 	// Comparison:
 	bool IsEpsilonEqual(const Float2x2& other) const;
-	bool operator==(const Float2x2& other) const;
-	bool operator!=(const Float2x2& other) const;
+	constexpr bool operator==(const Float2x2& other) const;
+	constexpr bool operator!=(const Float2x2& other) const;
 
 	// Friend functions:
-	friend Float2x2 operator*(const Float2x2& a, float b);
-	friend Float2x2 operator*(float a, const Float2x2& b);
-	friend Float2 operator*(const Float2x2& a, const Float2& b);
-	friend Float2 operator*(const Float2& a, const Float2x2& b);
+	friend constexpr Float2x2 operator*(const Float2x2& a, float b);
+	friend constexpr Float2x2 operator*(float a, const Float2x2& b);
+	friend constexpr Float2 operator*(const Float2x2& a, const Float2& b);
+	friend constexpr Float2 operator*(const Float2& a, const Float2x2& b);
 
 	// Logging:
 	std::string ToString() const;
@@ -98,10 +99,257 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Float2x2& value);
 
 	// Static members:
-	static Float2x2 zero;		// zero matrix.
-	static Float2x2 identity;	// identity matrix.
+	static const Float2x2 zero;		// zero matrix.
+	static const Float2x2 identity;	// identity matrix.
 };
 
 
 
+// Inline definitions:
+// Constructors:
+constexpr Float2x2::Float2x2
+(float xx, float xy,	// column 0
+ float yx, float yy)	// column 1
+{
+	data[0] = xx; data[2] = yx;
+	data[1] = xy; data[3] = yy;
+}
+constexpr Float2x2::Float2x2()
+{
+	for (uint32_t i = 0; i < 4; i++)
+		data[i] = 0.0f;
+}
+constexpr Float2x2::Float2x2(float value)
+{
+	for (uint32_t i = 0; i < 4; i++)
+		data[i] = value;
+}
+constexpr Float2x2::Float2x2(const float* const array)
+{
+	for (uint32_t i = 0; i < 4; i++)
+		data[i] = array[i];
+}
+
+
+
+// Static constructors:
+constexpr Float2x2 Float2x2::Rows
+(float row0x, float row0y,
+ float row1x, float row1y)
+{
+	return Float2x2
+	(row0x, row1x,
+	 row0y, row1y);
+}
+constexpr Float2x2 Float2x2::Columns
+(float column0x, float column0y,
+ float column1x, float column1y)
+{
+	return Float2x2
+	(column0x, column0y,
+	 column1x, column1y);
+}
+
+
+
+// Math operations:
+constexpr Float2x2 Float2x2::Transpose() const
+{
+	return Float2x2
+	(data[0], data[2],
+	 data[1], data[3]);
+}
+constexpr float Float2x2::Determinant() const
+{
+	return data[0] * data[3] - data[1] * data[2];
+}
+inline bool Float2x2::IsEpsilonZero() const
+{
+	return IsEpsilonEqual(Float2x2::zero);
+}
+
+
+
+// Access:
+constexpr float& Float2x2::operator[](int index)
+{
+	if (index >= 0 && index < 4)
+		return data[index];
+	throw std::out_of_range("Float2x2 index out of range.");
+}
+constexpr float Float2x2::operator[](int index) const
+{
+	if (index >= 0 && index < 4)
+		return data[index];
+	throw std::out_of_range("Float2x2 index out of range.");
+}
+constexpr float& Float2x2::operator[](const Index2& index)
+{
+	if (index.i < 2 && index.j < 2)
+		return data[index.i + 2 * index.j];
+	throw std::out_of_range("Float2x2 index out of range.");
+}
+constexpr float Float2x2::operator[](const Index2& index) const
+{
+	if (index.i < 2 && index.j < 2)
+		return data[index.i + 2 * index.j];
+	throw std::out_of_range("Float2x2 index out of range.");
+}
+constexpr Float2 Float2x2::GetRow(int index) const
+{
+	if (index >= 0 && index < 2)
+		return Float2(data[index], data[index + 2]);
+	throw std::out_of_range("Float2x2 row index out of range.");
+}
+constexpr Float2 Float2x2::GetColumn(int index) const
+{
+	if (index >= 0 && index < 2)
+		return Float2(data[2 * index], data[2 * index + 1]);
+	throw std::out_of_range("Float2x2 column index out of range.");
+}
+
+
+
+// Addition:
+constexpr Float2x2 Float2x2::operator+(const Float2x2& other) const
+{
+	Float2x2 result;
+	for (uint32_t i = 0; i < 4; i++)
+		result.data[i] = data[i] + other.data[i];
+	return result;
+}
+constexpr Float2x2& Float2x2::operator+=(const Float2x2& other)
+{
+	for (uint32_t i = 0; i < 4; i++)
+		data[i] += other.data[i];
+	return *this;
+}
+
+
+
+// Substraction:
+constexpr Float2x2 Float2x2::operator-(const Float2x2& other) const
+{
+	Float2x2 result;
+	for (uint32_t i = 0; i < 4; i++)
+		result.data[i] = data[i] - other.data[i];
+	return result;
+}
+constexpr Float2x2& Float2x2::operator-=(const Float2x2& other)
+{
+	for (uint32_t i = 0; i < 4; i++)
+		data[i] -= other.data[i];
+	return *this;
+}
+constexpr Float2x2 Float2x2::operator-() const
+{
+	return Float2x2
+	(-data[0], -data[1],
+	 -data[2], -data[3]);
+}
+
+
+
+// Multiplication:
+constexpr Float2x2 Float2x2::operator*(const Float2x2& other) const
+{
+	Float2x2 result;
+	for (uint32_t i = 0; i < 2; i++)
+		for (uint32_t j = 0; j < 2; j++)
+			for (uint32_t k = 0; k < 2; k++)
+				result.data[i + 2 * j] += data[i + 2 * k] * other.data[k + 2 * j];
+	return result;
+}
+constexpr Float2x2& Float2x2::operator*=(const Float2x2& other)
+{
+	Float2x2 result = (*this) * other;
+	*this = result;
+	return *this;
+}
+constexpr Float2x2& Float2x2::operator*=(float scalar)
+{
+	for (uint32_t i = 0; i < 4; i++)
+		data[i] *= scalar;
+	return *this;
+}
+
+
+
+// Division:
+constexpr Float2x2 Float2x2::operator/(float scalar) const
+{
+	Float2x2 result;
+	for (uint32_t i = 0; i < 4; i++)
+		result.data[i] = data[i] / scalar;
+	return result;
+}
+constexpr Float2x2& Float2x2::operator/=(float scalar)
+{
+	for (uint32_t i = 0; i < 4; i++)
+		data[i] /= scalar;
+	return *this;
+}
+
+
+
+// Comparison:
+inline bool Float2x2::IsEpsilonEqual(const Float2x2& other) const
+{
+	for (uint32_t i = 0; i < 4; i++)
+		if (mathf::Abs(data[i] - other.data[i]) > mathf::EPSILON)
+			return false;
+	return true;
+}
+constexpr bool Float2x2::operator==(const Float2x2& other) const
+{
+	for (uint32_t i = 0; i < 4; i++)
+		if (data[i] != other.data[i])
+			return false;
+	return true;
+}
+constexpr bool Float2x2::operator!=(const Float2x2& other) const
+{
+	return !(*this == other);
+}
+
+
+
+// Friend functions:
+constexpr Float2x2 operator*(const Float2x2& a, float b)
+{
+	Float2x2 result;
+	for (uint32_t i = 0; i < 4; i++)
+		result.data[i] = a.data[i] * b;
+	return result;
+}
+constexpr Float2x2 operator*(float a, const Float2x2& b)
+{
+	Float2x2 result;
+	for (uint32_t i = 0; i < 4; i++)
+		result.data[i] = a * b.data[i];
+	return result;
+}
+constexpr Float2 operator*(const Float2x2& a, const Float2& b)
+{
+	return Float2
+	(a.data[0] * b.x + a.data[2] * b.y,
+	 a.data[1] * b.x + a.data[3] * b.y);
+}
+constexpr Float2 operator*(const Float2& a, const Float2x2& b)
+{
+	return Float2
+	(a.x * b.data[0] + a.y * b.data[1],
+	 a.x * b.data[2] + a.y * b.data[3]);
+}
+
+
+
+// Static members:
+inline constexpr Float2x2 Float2x2::zero = Float2x2(0.0f);
+inline constexpr Float2x2 Float2x2::identity = Float2x2
+(1.0f, 0.0f,
+ 0.0f, 1.0f);
+
+
+
 #endif // __INCLUDE_GUARD_float2x2_h__
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define __INCLUDE_GUARD_float2x3_h__
 #include "mathf.h"
 #include <string>
+#include <stdexcept>
 
 
 
@@ -20,7 +21,7 @@ struct Float2x3
 	// xy yy zy   1  3  5   [1,0] [1,1] [1,2]
 
 private:
-	Float2x3
+	constexpr Float2x3
 	(float xx, float xy,	// column 0
 	 float yx, float yy,	// column 1
 	 float zx, float zy);	// column 2
@@ -30,18 +31,18 @@ public:
 	float data[6];
 
 	// Constructors:
-	Float2x3();
-	Float2x3(float value);
-	Float2x3(const float* const array);
-	Float2x3(const Float2x3& other);
+	constexpr Float2x3();
+	constexpr Float2x3(float value);
+	constexpr Float2x3(const float* const array);
+	constexpr Float2x3(const Float2x3& other) = default;
 
 	// Static constructors:
 	static Float2x3 Rows(const Float3& row0, const Float3& row1);
-	static Float2x3 Rows
+	static constexpr Float2x3 Rows
 	(float row0x, float row0y, float row0z,
 	 float row1x, float row1y, float row1z);
 	static Float2x3 Columns(const Float2& column0, const Float2& column1, const Float2& column2);
-	static Float2x3 Columns
+	static constexpr Float2x3 Columns
 	(float column0x, float column0y,
 	 float column1x, float column1y,
 	 float column2x, float column2y);
@@ -52,43 +53,43 @@ public:
 	bool IsEpsilonZero() const;
 
 	// Access:
-	float& operator[](int index);
-	float operator[](int index) const;
-	float& operator[](const Index2& index);
-	float operator[](const Index2& index) const;
-	Float3 GetRow(int index) const;
-	Float2 GetColumn(int index) const;
+	constexpr float& operator[](int index);
+	constexpr float operator[](int index) const;
+	constexpr float& operator[](const Index2& index);
+	constexpr float operator[](const Index2& index) const;
+	constexpr Float3 GetRow(int index) const;
+	constexpr Float2 GetColumn(int index) const;
 	
 	// Assignment:
-	Float2x3& operator=(const Float2x3& other);
-	Float2x3& operator=(Float2x3&& other) noexcept;
+	constexpr Float2x3& operator=(const Float2x3& other) = default;
+	constexpr Float2x3& operator=(Float2x3&& other) noexcept = default;
 
 	// Addition:
-	Float2x3 operator+(const Float2x3& other) const;
-	Float2x3& operator+=(const Float2x3& other);
+	constexpr Float2x3 operator+(const Float2x3& other) const;
+	constexpr Float2x3& operator+=(const Float2x3& other);
 
 	// Substraction:
-	Float2x3 operator-(const Float2x3& other) const;
-	Float2x3& operator-=(const Float2x3& other);
-	Float2x3 operator-() const;
+	constexpr Float2x3 operator-(const Float2x3& other) const;
+	constexpr Float2x3& operator-=(const Float2x3& other);
+	constexpr Float2x3 operator-() const;
 
 	// Multiplication:
-	Float2x3& operator*=(float scalar);
+	constexpr Float2x3& operator*=(float scalar);
 
 	// Division:
-	Float2x3 operator/(float scalar) const;
-	Float2x3& operator/=(float scalar);
+	constexpr Float2x3 operator/(float scalar) const;
+	constexpr Float2x3& operator/=(float scalar);
 
 	// Comparison:
 	bool IsEpsilonEqual(const Float2x3& other) const;
-	bool operator==(const Float2x3& other) const;
-	bool operator!=(const Float2x3& other) const;
+	constexpr bool operator==(const Float2x3& other) const;
+	constexpr bool operator!=(const Float2x3& other) const;
 
 	// Friend functions:
-	friend Float2x3 operator*(const Float2x3& a, float b);
-	friend Float2x3 operator*(float a, const Float2x3& b);
-	friend Float2 operator*(const Float2x3& a, const Float3& b);
-	friend Float3 operator*(const Float2& a, const Float2x3& b);
+	friend constexpr Float2x3 operator*(const Float2x3& a, float b);
+	friend constexpr Float2x3 operator*(float a, const Float2x3& b);
+	friend constexpr Float2 operator*(const Float2x3& a, const Float3& b);
+	friend constexpr Float3 operator*(const Float2& a, const Float2x3& b);
 	friend Float2x2 operator*(const Float2x3& a, const Float3x2& b);
 	friend Float2x3 operator*(const Float2x3& a, const Float3x3& b);
 	friend Float2x3 operator*(const Float2x2& a, const Float2x3& b);
@@ -100,9 +101,234 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Float3x3& value);
 	
 	// Static members:
-	static Float2x3 zero;		// zero matrix.
+	static const Float2x3 zero;		// zero matrix.
 };
 
 
 
+// Inline definitions:
+// Constructors:
+constexpr Float2x3::Float2x3
+(float xx, float xy,	// column 0
+ float yx, float yy,	// column 1
+ float zx, float zy)	// column 2
+{
+	data[0] = xx; data[2] = yx; data[4] = zx;
+	data[1] = xy; data[3] = yy; data[5] = zy;
+}
+constexpr Float2x3::Float2x3()
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] = 0.0f;
+}
+constexpr Float2x3::Float2x3(float value)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] = value;
+}
+constexpr Float2x3::Float2x3(const float* const array)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] = array[i];
+}
+
+
+
+// Static constructors:
+constexpr Float2x3 Float2x3::Rows
+(float row0x, float row0y, float row0z,
+ float row1x, float row1y, float row1z)
+{
+	return Float2x3
+	(row0x, row1x,
+	 row0y, row1y,
+	 row0z, row1z);
+}
+constexpr Float2x3 Float2x3::Columns
+(float column0x, float column0y,
+ float column1x, float column1y,
+ float column2x, float column2y)
+{
+	return Float2x3
+	(column0x, column0y,
+	 column1x, column1y,
+	 column2x, column2y);
+}
+
+
+
+// Math operations:
+inline bool Float2x3::IsEpsilonZero() const
+{
+	return IsEpsilonEqual(Float2x3::zero);
+}
+
+
+
+// Access:
+constexpr float& Float2x3::operator[](int index)
+{
+	if (index >= 0 && index < 6)
+		return data[index];
+	throw std::out_of_range("Float2x3 index out of range.");
+}
+constexpr float Float2x3::operator[](int index) const
+{
+	if (index >= 0 && index < 6)
+		return data[index];
+	throw std::out_of_range("Float2x3 index out of range.");
+}
+constexpr float& Float2x3::operator[](const Index2& index)
+{
+	if (index.i < 2 && index.j < 3)
+		return data[index.i + 2 * index.j];
+	throw std::out_of_range("Float2x3 index out of range.");
+}
+constexpr float Float2x3::operator[](const Index2& index) const
+{
+	if (index.i < 2 && index.j < 3)
+		return data[index.i + 2 * index.j];
+	throw std::out_of_range("Float2x3 index out of range.");
+}
+constexpr Float3 Float2x3::GetRow(int index) const
+{
+	if (index >= 0 && index < 2)
+		return Float3(data[index], data[index + 2], data[index + 4]);
+	throw std::out_of_range("Float2x3 row index out of range.");
+}
+constexpr Float2 Float2x3::GetColumn(int index) const
+{
+	if (index >= 0 && index < 3)
+		return Float2(data[2 * index], data[2 * index + 1]);
+	throw std::out_of_range("Float2x3 column index out of range.");
+}
+
+
+
+// Addition:
+constexpr Float2x3 Float2x3::operator+(const Float2x3& other) const
+{
+	Float2x3 result;
+	for (uint32_t i = 0; i < 6; i++)
+		result.data[i] = data[i] + other.data[i];
+	return result;
+}
+constexpr Float2x3& Float2x3::operator+=(const Float2x3& other)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] += other.data[i];
+	return *this;
+}
+
+
+
+// Substraction:
+constexpr Float2x3 Float2x3::operator-(const Float2x3& other) const
+{
+	Float2x3 result;
+	for (uint32_t i = 0; i < 6; i++)
+		result.data[i] = data[i] - other.data[i];
+	return result;
+}
+constexpr Float2x3& Float2x3::operator-=(const Float2x3& other)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] -= other.data[i];
+	return *this;
+}
+constexpr Float2x3 Float2x3::operator-() const
+{
+	return Float2x3
+	(-data[0], -data[1],
+	 -data[2], -data[3],
+	 -data[4], -data[5]);
+}
+
+
+
+// Multiplication:
+constexpr Float2x3& Float2x3::operator*=(float scalar)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] *= scalar;
+	return *this;
+}
+
+
+
+// Division:
+constexpr Float2x3 Float2x3::operator/(float scalar) const
+{
+	Float2x3 result;
+	for (uint32_t i = 0; i < 6; i++)
+		result.data[i] = data[i] / scalar;
+	return result;
+}
+constexpr Float2x3& Float2x3::operator/=(float scalar)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] /= scalar;
+	return *this;
+}
+
+
+
+// Comparison:
+inline bool Float2x3::IsEpsilonEqual(const Float2x3& other) const
+{
+	for (uint32_t i = 0; i < 6; i++)
+		if (mathf::Abs(data[i] - other.data[i]) > mathf::EPSILON)
+			return false;
+	return true;
+}
+constexpr bool Float2x3::operator==(const Float2x3& other) const
+{
+	for (uint32_t i = 0; i < 6; i++)
+		if (data[i] != other.data[i])
+			return false;
+	return true;
+}
+constexpr bool Float2x3::operator!=(const Float2x3& other) const
+{
+	return !(*this == other);
+}
+
+
+
+// Friend functions:
+constexpr Float2x3 operator*(const Float2x3& a, float b)
+{
+	Float2x3 result;
+	for (uint32_t i = 0; i < 6; i++)
+		result.data[i] = a.data[i] * b;
+	return result;
+}
+constexpr Float2x3 operator*(float a, const Float2x3& b)
+{
+	Float2x3 result;
+	for (uint32_t i = 0; i < 6; i++)
+		result.data[i] = a * b.data[i];
+	return result;
+}
+constexpr Float2 operator*(const Float2x3& a, const Float3& b)
+{
+	return Float2
+	(a.data[0] * b.x + a.data[2] * b.y + a.data[4] * b.z,
+	 a.data[1] * b.x + a.data[3] * b.y + a.data[5] * b.z);
+}
+constexpr Float3 operator*(const Float2& a, const Float2x3& b)
+{
+	return Float3
+	(a.x * b.data[0] + a.y * b.data[1],
+	 a.x * b.data[2] + a.y * b.data[3],
+	 a.x * b.data[4] + a.y * b.data[5]);
+}
+
+
+
+// Static members:
+inline constexpr Float2x3 Float2x3::zero = Float2x3(0.0f);
+
+
+
 #endif // __INCLUDE_GUARD_float2x3_h__
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef __INCLUDE_GUARD_float3_h__
 #define __INCLUDE_GUARD_float3_h__
 #include <string>
+#include <stdexcept>
 
 
 
@@ -16,18 +17,18 @@ public:
 	float x, y, z;
 
 	// Constructors:
-	Float3();
-	Float3(float xyz);
-	Float3(float x, float y);
-	Float3(float x, float y, float z);
+	constexpr Float3();
+	constexpr Float3(float xyz);
+	constexpr Float3(float x, float y);
+	constexpr Float3(float x, float y, float z);
 	explicit Float3(const Float2& xy);
 	explicit Float3(const Float2& xy, float z);
-	Float3(const Float3& xyz);
+	constexpr Float3(const Float3& xyz) = default;
 	explicit Float3(const Float4& xyz);
 	static Float3 Direction(float theta, float phi);
 
 	// Math operations:
-	float LengthSq() const;
+	constexpr float LengthSq() const;
 	float Length() const;
 	float Theta() const;
 	float Phi() const;
@@ -38,51 +39,51 @@ public:
 
 	// Static math operations:
 	static Float3 Abs(const Float3& a);
-	static float Dot(const Float3& a, const Float3& b);
-	static Float3 Cross(const Float3& a, const Float3& b);
-	static float DistanceSq(const Float3& a, const Float3& b);
+	static constexpr float Dot(const Float3& a, const Float3& b);
+	static constexpr Float3 Cross(const Float3& a, const Float3& b);
+	static constexpr float DistanceSq(const Float3& a, const Float3& b);
 	static float Distance(const Float3& a, const Float3& b);
 	static float Angle(const Float3& a, const Float3& b);
-	static Float3 Min(const Float3& a, const Float3& b);
-	static Float3 Max(const Float3& a, const Float3& b);
-	static Float3 Clamp(const Float3& value, const Float3& min, const Float3& max);
+	static constexpr Float3 Min(const Float3& a, const Float3& b);
+	static constexpr Float3 Max(const Float3& a, const Float3& b);
+	static constexpr Float3 Clamp(const Float3& value, const Float3& min, const Float3& max);
 
 	// Access:
-	float& operator[](int index);
-	float operator[](int index) const;
+	constexpr float& operator[](int index);
+	constexpr float operator[](int index) const;
 
 	// Assignment:
-	Float3& operator=(const Float3& other);
-	Float3& operator=(Float3&& other) noexcept;
+	constexpr Float3& operator=(const Float3& other) = default;
+	constexpr Float3& operator=(Float3&& other) noexcept = default;
 
 	// Addition:
-	Float3 operator+(const Float3& other) const;
-	Float3& operator+=(const Float3& other);
+	constexpr Float3 operator+(const Float3& other) const;
+	constexpr Float3& operator+=(const Float3& other);
 
 	// Substraction:
-	Float3 operator-(const Float3& other) const;
-	Float3& operator-=(const Float3& other);
-	Float3 operator-() const;
+	constexpr Float3 operator-(const Float3& other) const;
+	constexpr Float3& operator-=(const Float3& other);
+	constexpr Float3 operator-() const;
 
 	// Multiplication:
-	Float3 operator*(const Float3& other) const;
-	Float3& operator*=(const Float3& other);
-	Float3 operator*(float scalar) const;
-	Float3& operator*=(float scalar);
+	constexpr Float3 operator*(const Float3& other) const;
+	constexpr Float3& operator*=(const Float3& other);
+	constexpr Float3 operator*(float scalar) const;
+	constexpr Float3& operator*=(float scalar);
 
 	// Division:
-	Float3 operator/(const Float3& other) const;
-	Float3& operator/=(const Float3& other);
-	Float3 operator/(float scalar) const;
-	Float3& operator/=(float scalar);
+	constexpr Float3 operator/(const Float3& other) const;
+	constexpr Float3& operator/=(const Float3& other);
+	constexpr Float3 operator/(float scalar) const;
+	constexpr Float3& operator/=(float scalar);
 
 	// Comparison:
 	bool IsEpsilonEqual(const Float3& other) const;
-	bool operator==(const Float3& other) const;
-	bool operator!=(const Float3& other) const;
+	constexpr bool operator==(const Float3& other) const;
+	constexpr bool operator!=(const Float3& other) const;
 
 	// Friend functions:
-	friend Float3 operator*(float a, const Float3& b);
+	friend constexpr Float3 operator*(float a, const Float3& b);
 
 	// Logging:
 	std::string ToString() const;
@@ -90,31 +91,265 @@ public:
 
 	// Static members:
 	// Numbers:
-	static Float3 zero;
-	static Float3 one;
+	static const Float3 zero;
+	static const Float3 one;
 
 	// Directions:
-	static Float3 right;	// +x = ( 1, 0, 0).
-	static Float3 left;		// -x = (-1, 0, 0).
-	static Float3 up;		// +y = ( 0, 1, 0).
-	static Float3 down;		// -y = ( 0,-1, 0).
-	static Float3 forward;	// +z = ( 0, 0, 1).
-	static Float3 backward;	// -z = ( 0, 0,-1).
+	static const Float3 right;		// +x = ( 1, 0, 0).
+	static const Float3 left;		// -x = (-1, 0, 0).
+	static const Float3 up;			// +y = ( 0, 1, 0).
+	static const Float3 down;		// -y = ( 0,-1, 0).
+	static const Float3 forward;	// +z = ( 0, 0, 1).
+	static const Float3 backward;	// -z = ( 0, 0,-1).
 
 	// Colors:
-	static Float3 white;	// ( 1, 1, 1).
-	static Float3 gray;		// ( 0.5, 0.5, 0.5).
-	static Float3 black;	// ( 0, 0, 0).
-	static Float3 red;		// ( 1, 0, 0).
-	static Float3 green;	// ( 0, 1, 0).
-	static Float3 blue;		// ( 0, 0, 1).
-	static Float3 yellow;	// ( 1, 1, 0).
-	static Float3 cyan;		// ( 0, 1, 1).
-	static Float3 magenta;	// ( 1, 0, 1).
+	static const Float3 white;		// ( 1, 1, 1).
+	static const Float3 gray;		// ( 0.5, 0.5, 0.5).
+	static const Float3 black;		// ( 0, 0, 0).
+	static const Float3 red;		// ( 1, 0, 0).
+	static const Float3 green;		// ( 0, 1, 0).
+	static const Float3 blue;		// ( 0, 0, 1).
+	static const Float3 yellow;		// ( 1, 1, 0).
+	static const Float3 cyan;		// ( 0, 1, 1).
+	static const Float3 magenta;	// ( 1, 0, 1).
 };
 
 // Friend functions:
-Float3 operator/(float scalar, const Float3& vector);
+constexpr Float3 operator/(float scalar, const Float3& vector);
+
+
+
+// Inline definitions (hot arithmetic lives in the header so it can be inlined without LTO).
+// mathf.h is included after the declaration above, as it includes this header itself.
+#include "mathf.h"
+
+
+
+// Constructors:
+constexpr Float3::Float3() : x(0), y(0), z(0) {}
+constexpr Float3::Float3(float xyz) : x(xyz), y(xyz), z(xyz) {}
+constexpr Float3::Float3(float x, float y) : x(x), y(y), z(0.0f) {}
+constexpr Float3::Float3(float x, float y, float z) : x(x), y(y), z(z) {}
+
+
+
+// Math operations:
+constexpr float Float3::LengthSq() const
+{
+	return x * x + y * y + z * z;
+}
+inline float Float3::Length() const
+{
+	return mathf::Sqrt(LengthSq());
+}
+inline Float3 Float3::Normalize() const
+{
+	float length = Length();
+	if (length <= mathf::EPSILON)
+		return Float3(0.0f);
+	return Float3(x / length, y / length, z / length);
+}
+inline bool Float3::IsEpsilonZero() const
+{
+	return IsEpsilonEqual(Float3::zero);
+}
+
+
+
+// Static math operations:
+inline Float3 Float3::Abs(const Float3& a)
+{
+	return Float3(mathf::Abs(a.x), mathf::Abs(a.y), mathf::Abs(a.z));
+}
+constexpr float Float3::Dot(const Float3& a, const Float3& b)
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+constexpr Float3 Float3::Cross(const Float3& a, const Float3& b)
+{
+	return Float3
+	(a.y * b.z - a.z * b.y,
+		a.z * b.x - a.x * b.z,
+		a.x * b.y - a.y * b.x);
+}
+constexpr float Float3::DistanceSq(const Float3& a, const Float3& b)
+{
+	return (a - b).LengthSq();
+}
+inline float Float3::Distance(const Float3& a, const Float3& b)
+{
+	return (a - b).Length();
+}
+constexpr Float3 Float3::Min(const Float3& a, const Float3& b)
+{
+	return Float3(mathf::Min(a.x, b.x), mathf::Min(a.y, b.y), mathf::Min(a.z, b.z));
+}
+constexpr Float3 Float3::Max(const Float3& a, const Float3& b)
+{
+	return Float3(mathf::Max(a.x, b.x), mathf::Max(a.y, b.y), mathf::Max(a.z, b.z));
+}
+constexpr Float3 Float3::Clamp(const Float3& value, const Float3& min, const Float3& max)
+{
+	return Float3(mathf::Clamp(value.x, min.x, max.x), mathf::Clamp(value.y, min.y, max.y), mathf::Clamp(value.z, min.z, max.z));
+}
+
+
+
+// Access:
+constexpr float& Float3::operator[](int index)
+{
+	if (index == 0) return x;
+	if (index == 1) return y;
+	if (index == 2) return z;
+	throw std::out_of_range("Float3 index out of range.");
+}
+constexpr float Float3::operator[](int index) const
+{
+	if (index == 0) return x;
+	if (index == 1) return y;
+	if (index == 2) return z;
+	throw std::out_of_range("Float3 index out of range.");
+}
+
+
+
+// Addition:
+constexpr Float3 Float3::operator+(const Float3& other) const
+{
+	return Float3(x + other.x, y + other.y, z + other.z);
+}
+constexpr Float3& Float3::operator+=(const Float3& other)
+{
+	this->x += other.x;
+	this->y += other.y;
+	this->z += other.z;
+	return *this;
+}
+
+
+
+// Substraction:
+constexpr Float3 Float3::operator-(const Float3& other) const
+{
+	return Float3(x - other.x, y - other.y, z - other.z);
+}
+constexpr Float3& Float3::operator-=(const Float3& other)
+{
+	this->x -= other.x;
+	this->y -= other.y;
+	this->z -= other.z;
+	return *this;
+}
+constexpr Float3 Float3::operator-() const
+{
+	return Float3(-x, -y, -z);
+}
+
+
+
+// Multiplication:
+constexpr Float3 Float3::operator*(const Float3& other) const
+{
+	return Float3(x * other.x, y * other.y, z * other.z);
+}
+constexpr Float3& Float3::operator*=(const Float3& other)
+{
+	this->x *= other.x;
+	this->y *= other.y;
+	this->z *= other.z;
+	return *this;
+}
+constexpr Float3 Float3::operator*(float scalar) const
+{
+	return Float3(x * scalar, y * scalar, z * scalar);
+}
+constexpr Float3& Float3::operator*=(float scalar)
+{
+	x *= scalar;
+	y *= scalar;
+	z *= scalar;
+	return *this;
+}
+
+
+
+// Division:
+constexpr Float3 Float3::operator/(const Float3& other) const
+{
+	return Float3(x / other.x, y / other.y, z / other.z);
+}
+constexpr Float3& Float3::operator/=(const Float3& other)
+{
+	this->x /= other.x;
+	this->y /= other.y;
+	this->z /= other.z;
+	return *this;
+}
+constexpr Float3 Float3::operator/(float scalar) const
+{
+	return Float3(x / scalar, y / scalar, z / scalar);
+}
+constexpr Float3& Float3::operator/=(float scalar)
+{
+	x /= scalar;
+	y /= scalar;
+	z /= scalar;
+	return *this;
+}
+constexpr Float3 operator/(float scalar, const Float3& vector)
+{
+	return Float3(scalar / vector.x, scalar / vector.y, scalar / vector.z);
+}
+
+
+
+// Comparison:
+inline bool Float3::IsEpsilonEqual(const Float3& other) const
+{
+	return mathf::Abs(x - other.x) < mathf::EPSILON && mathf::Abs(y - other.y) < mathf::EPSILON && mathf::Abs(z - other.z) < mathf::EPSILON;
+}
+constexpr bool Float3::operator==(const Float3& other) const
+{
+	return x == other.x && y == other.y && z == other.z;
+}
+constexpr bool Float3::operator!=(const Float3& other) const
+{
+	return !(*this == other);
+}
+
+
+
+// Friend functions:
+constexpr Float3 operator*(float a, const Float3& b)
+{
+	return Float3(a * b.x, a * b.y, a * b.z);
+}
+
+
+
+// Static members:
+// Numbers;
+inline constexpr Float3 Float3::zero		= Float3(0.0f);
+inline constexpr Float3 Float3::one			= Float3(1.0f);
+
+// Directions:
+inline constexpr Float3 Float3::right		= Float3(1.0f, 0.0f, 0.0f);
+inline constexpr Float3 Float3::left		= Float3(-1.0f, 0.0f, 0.0f);
+inline constexpr Float3 Float3::up			= Float3(0.0f, 1.0f, 0.0f);
+inline constexpr Float3 Float3::down		= Float3(0.0f, -1.0f, 0.0f);
+inline constexpr Float3 Float3::forward		= Float3(0.0f, 0.0f, 1.0f);
+inline constexpr Float3 Float3::backward	= Float3(0.0f, 0.0f, -1.0f);
+
+// Colors:
+inline constexpr Float3 Float3::white		= Float3(1.0f, 1.0f, 1.0f);
+inline constexpr Float3 Float3::gray		= Float3(0.5f, 0.5f, 0.5f);
+inline constexpr Float3 Float3::black		= Float3(0.0f, 0.0f, 0.0f);
+inline constexpr Float3 Float3::red			= Float3(1.0f, 0.0f, 0.0f);
+inline constexpr Float3 Float3::green		= Float3(0.0f, 1.0f, 0.0f);
+inline constexpr Float3 Float3::blue		= Float3(0.0f, 0.0f, 1.0f);
+inline constexpr Float3 Float3::yellow		= Float3(1.0f, 1.0f, 0.0f);
+inline constexpr Float3 Float3::cyan		= Float3(0.0f, 1.0f, 1.0f);
+inline constexpr Float3 Float3::magenta		= Float3(1.0f, 0.0f, 1.0f);
 
 
 
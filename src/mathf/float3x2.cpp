@@ -10,38 +10,6 @@
 
 
 
-// Constructors:
-Float3x2::Float3x2
-(float xx, float xy, float xz,	// column 0
- float yx, float yy, float yz)	// column 1
-{
-	data[0] = xx; data[3] = yx;
-	data[1] = xy; data[4] = yy;
-	data[2] = xz; data[5] = yz;
-}
-Float3x2::Float3x2()
-{
-	for (uint32_t i = 0; i < 6; i++)
-		data[i] = 0.0f;
-}
-Float3x2::Float3x2(float value)
-{
-	for (uint32_t i = 0; i < 6; i++)
-		data[i] = value;
-}
-Float3x2::Float3x2(const float* const array)
-{
-	for (uint32_t i = 0; i < 6; i++)
-		data[i] = array[i];
-}
-Float3x2::Float3x2(const Float3x2& other)
-{
-	for (uint32_t i = 0; i < 6; i++)
-		data[i] = other[i];
-}
-
-
-
 // Static constructors:
 Float3x2 Float3x2::Rows(const Float2& row0, const Float2& row1, const Float2& row2)
 {
@@ -49,29 +17,12 @@ Float3x2 Float3x2::Rows(const Float2& row0, const Float2& row1, const Float2& ro
 	(row0.x, row1.x, row2.x,
 	 row0.y, row1.y, row2.y);
 }
-Float3x2 Float3x2::Rows
-(float row0x, float row0y,
- float row1x, float row1y,
- float row2x, float row2y)
-{
-	return Float3x2
-	(row0x, row1x, row2x,
-	 row0y, row1y, row2y);
-}
 Float3x2 Float3x2::Columns(const Float3& column0, const Float3& column1)
 {
 	return Float3x2
 	(column0.x, column0.y, column0.z,
 	 column1.x, column1.y, column1.z);
 }
-Float3x2 Float3x2::Columns
-(float column0x, float column0y, float column0z,
- float column1x, float column1y, float column1z)
-{
-	return Float3x2
-	(column0x, column0y, column0z,
-	 column1x, column1y, column1z);
-}
 
 
 
@@ -87,192 +38,10 @@ Float2x3 Float3x2::LeftInverse() const
 	Float2x3 aT = this->Transpose();
 	return (aT * (*this)).Inverse() * aT;
 }
-bool Float3x2::IsEpsilonZero() const
-{
-	return IsEpsilonEqual(Float3x2::zero);
-}
-
-
-
-// Access:
-float& Float3x2::operator[](int index)
-{
-	if (index >= 0 && index < 6)
-		return data[index];
-	throw std::out_of_range("Float3x2 index out of range.");
-}
-float Float3x2::operator[](int index) const
-{
-	if (index >= 0 && index < 6)
-		return data[index];
-	throw std::out_of_range("Float3x2 index out of range.");
-}
-float& Float3x2::operator[](const Index2& index)
-{
-	if (index.i >= 0 && index.i < 3 && index.j >= 0 && index.j < 2)
-		return data[index.i + 3 * index.j];
-	throw std::out_of_range("Float3x2 index out of range.");
-}
-float Float3x2::operator[](const Index2& index) const
-{
-	if (index.i >= 0 && index.i < 3 && index.j >= 0 && index.j < 2)
-		return data[index.i + 3 * index.j];
-	throw std::out_of_range("Float3x2 index out of range.");
-}
-Float2 Float3x2::GetRow(int index) const
-{
-	if (index >= 0 && index < 3)
-		return Float2(data[index], data[index + 3]);
-	throw std::out_of_range("Float3x2 row index out of range.");
-}
-Float3 Float3x2::GetColumn(int index) const
-{
-	if (index >= 0 && index < 2)
-		return Float3(data[3 * index], data[3 * index + 1], data[3 * index + 2]);
-	throw std::out_of_range("Float3x2 column index out of range.");
-}
-
-
-
-// Assignment:
-Float3x2& Float3x2::operator=(const Float3x2& other)
-{
-	if (this != &other)
-	{
-		for (uint32_t i = 0; i < 6; i++)
-			data[i] = other[i];
-	}
-	return *this;
-}
-Float3x2& Float3x2::operator=(Float3x2&& other) noexcept
-{
-	if (this != &other)
-	{
-		for (uint32_t i = 0; i < 6; i++)
-			data[i] = other[i];
-	}
-	return *this;
-}
-
-
-
-// Addition:
-Float3x2 Float3x2::operator+(const Float3x2& other) const
-{
-	Float3x2 result;
-	for (uint32_t i = 0; i < 6; i++)
-		result[i] = data[i] + other[i];
-	return result;
-}
-Float3x2& Float3x2::operator+=(const Float3x2& other)
-{
-	for (uint32_t i = 0; i < 6; i++)
-		data[i] += other[i];
-	return *this;
-}
-
-
-
-// Substraction:
-Float3x2 Float3x2::operator-(const Float3x2& other) const
-{
-	Float3x2 result;
-	for (uint32_t i = 0; i < 6; i++)
-		result[i] = data[i] - other[i];
-	return result;
-}
-Float3x2& Float3x2::operator-=(const Float3x2& other)
-{
-	for (uint32_t i = 0; i < 6; i++)
-		data[i] -= other[i];
-	return *this;
-}
-Float3x2 Float3x2::operator-() const
-{
-	return Float3x2
-	(-data[0], -data[1], -data[2],
-	 -data[3], -data[4], -data[5]);
-}
-
-
-
-// Multiplication:
-Float3x2& Float3x2::operator*=(float scalar)
-{
-	for (uint32_t i = 0; i < 6; i++)
-		data[i] *= scalar;
-	return *this;
-}
-
-
-
-// Division:
-Float3x2 Float3x2::operator/(float scalar) const
-{
-	Float3x2 result;
-	for (uint32_t i = 0; i < 6; i++)
-		result[i] = data[i] / scalar;
-	return result;
-}
-Float3x2& Float3x2::operator/=(float scalar)
-{
-	for (uint32_t i = 0; i < 6; i++)
-		data[i] /= scalar;
-	return *this;
-}
-
-
-
-// Comparison:
-bool Float3x2::IsEpsilonEqual(const Float3x2& other) const
-{
-	for (uint32_t i = 0; i < 6; i++)
-		if (mathf::Abs(data[i] - other[i]) > mathf::EPSILON)
-			return false;
-	return true;
-}
-bool Float3x2::operator==(const Float3x2& other) const
-{
-	for (uint32_t i = 0; i < 6; i++)
-		if (data[i] != other[i])
-			return false;
-	return true;
-}
-bool Float3x2::operator!=(const Float3x2& other) const
-{
-	return !(*this == other);
-}
 
 
 
 // Friend functions:
-Float3x2 operator*(const Float3x2& a, float b)
-{
-	Float3x2 result;
-	for (uint32_t i = 0; i < 6; i++)
-		result[i] = a[i] * b;
-	return result;
-}
-Float3x2 operator*(float a, const Float3x2& b)
-{
-	Float3x2 result;
-	for (uint32_t i = 0; i < 6; i++)
-		result[i] = a * b[i];
-	return result;
-}
-Float3 operator*(const Float3x2& a, const Float2& b)
-{
-	return Float3
-	(a[0] * b.x + a[3] * b.y,
-	 a[1] * b.x + a[4] * b.y,
-	 a[2] * b.x + a[5] * b.y);
-}
-Float2 operator*(const Float3& a, const Float3x2& b)
-{
-	return Float2
-	(a.x * b[0] + a.y * b[1] + a.z * b[2],
-	 a.x * b[3] + a.y * b[4] + a.z * b[5]);
-}
 Float3x2 operator*(const Float3x2& a, const Float2x2& b)
 {
 	Float3x2 result;
@@ -315,9 +84,4 @@ std::ostream& operator<<(std::ostream& os, const Float3x2& value)
 {
 	os << value.ToString();
 	return os;
-}
-
-
-
-// Static members:
-Float3x2 Float3x2::zero = Float3x2(0.0f);
\ No newline at end of file
+}
\ No newline at end of file
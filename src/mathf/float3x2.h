@@ -2,6 +2,7 @@
 #define __INCLUDE_GUARD_float3x2_h__
 #include "mathf.h"
 #include <string>
+#include <stdexcept>
 
 
 
@@ -21,7 +22,7 @@ struct Float3x2
 	// xz yz   2  5   [2,0] [2,1]
 
 private:
-	Float3x2
+	constexpr Float3x2
 	(float xx, float xy, float xz,	// column 0
 	 float yx, float yy, float yz);	// column 1
 
@@ -30,19 +31,19 @@ public:
 	float data[6];
 
 	// Constructors:
-	Float3x2();
-	Float3x2(float value);
-	Float3x2(const float* const array);
-	Float3x2(const Float3x2& other);
+	constexpr Float3x2();
+	constexpr Float3x2(float value);
+	constexpr Float3x2(const float* const array);
+	constexpr Float3x2(const Float3x2& other) = default;
 
 	// Static constructors:
 	static Float3x2 Rows(const Float2& row0, const Float2& row1, const Float2& row2);
-	static Float3x2 Rows
+	static constexpr Float3x2 Rows
 	(float row0x, float row0y,
 	 float row1x, float row1y,
 	 float row2x, float row2y);
 	static Float3x2 Columns(const Float3& column0, const Float3& column1);
-	static Float3x2 Columns
+	static constexpr Float3x2 Columns
 	(float column0x, float column0y, float column0z,
 	 float column1x, float column1y, float column1z);
 
@@ -52,43 +53,43 @@ public:
 	bool IsEpsilonZero() const;
 	
 	// Access:
-	float& operator[](int index);
-	float operator[](int index) const;
-	float& operator[](const Index2& index);
-	float operator[](const Index2& index) const;
-	Float2 GetRow(int index) const;
-	Float3 GetColumn(int index) const;
+	constexpr float& operator[](int index);
+	constexpr float operator[](int index) const;
+	constexpr float& operator[](const Index2& index);
+	constexpr float operator[](const Index2& index) const;
+	constexpr Float2 GetRow(int index) const;
+	constexpr Float3 GetColumn(int index) const;
 
 	// Assignment:
-	Float3x2& operator=(const Float3x2& other);
-	Float3x2& operator=(Float3x2&& other) noexcept;
+	constexpr Float3x2& operator=(const Float3x2& other) = default;
+	constexpr Float3x2& operator=(Float3x2&& other) noexcept = default;
 
 	// Addition:
-	Float3x2 operator+(const Float3x2& other) const;
-	Float3x2& operator+=(const Float3x2& other);
+	constexpr Float3x2 operator+(const Float3x2& other) const;
+	constexpr Float3x2& operator+=(const Float3x2& other);
 
 	// Substraction:
-	Float3x2 operator-(const Float3x2& other) const;
-	Float3x2& operator-=(const Float3x2& other);
-	Float3x2 operator-() const;
+	constexpr Float3x2 operator-(const Float3x2& other) const;
+	constexpr Float3x2& operator-=(const Float3x2& other);
+	constexpr Float3x2 operator-() const;
 
 	// Multiplication:
-	Float3x2& operator*=(float scalar);
+	constexpr Float3x2& operator*=(float scalar);
 
 	// Division:
-	Float3x2 operator/(float scalar) const;
-	Float3x2& operator/=(float scalar);
+	constexpr Float3x2 operator/(float scalar) const;
+	constexpr Float3x2& operator/=(float scalar);
 	
 	// Comparison:
 	bool IsEpsilonEqual(const Float3x2& other) const;
-	bool operator==(const Float3x2& other) const;
-	bool operator!=(const Float3x2& other) const;
+	constexpr bool operator==(const Float3x2& other) const;
+	constexpr bool operator!=(const Float3x2& other) const;
 	
 	// Friend functions:
-	friend Float3x2 operator*(const Float3x2& a, float b);
-	friend Float3x2 operator*(float a, const Float3x2& b);
-	friend Float3 operator*(const Float3x2& a, const Float2& b);
-	friend Float2 operator*(const Float3& a, const Float3x2& b);
+	friend constexpr Float3x2 operator*(const Float3x2& a, float b);
+	friend constexpr Float3x2 operator*(float a, const Float3x2& b);
+	friend constexpr Float3 operator*(const Float3x2& a, const Float2& b);
+	friend constexpr Float2 operator*(const Float3& a, const Float3x2& b);
 	friend Float3x2 operator*(const Float3x2& a, const Float2x2& b);
 	friend Float3x2 operator*(const Float3x3& a, const Float3x2& b);
 	
@@ -98,9 +99,231 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Float3x3& value);
 
 	// Static members:
-	static Float3x2 zero;		// zero matrix.
+	static const Float3x2 zero;		// zero matrix.
 };
 
 
 
+// Inline definitions:
+// Constructors:
+constexpr Float3x2::Float3x2
+(float xx, float xy, float xz,	// column 0
+ float yx, float yy, float yz)	// column 1
+{
+	data[0] = xx; data[3] = yx;
+	data[1] = xy; data[4] = yy;
+	data[2] = xz; data[5] = yz;
+}
+constexpr Float3x2::Float3x2()
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] = 0.0f;
+}
+constexpr Float3x2::Float3x2(float value)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] = value;
+}
+constexpr Float3x2::Float3x2(const float* const array)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] = array[i];
+}
+
+
+
+// Static constructors:
+constexpr Float3x2 Float3x2::Rows
+(float row0x, float row0y,
+ float row1x, float row1y,
+ float row2x, float row2y)
+{
+	return Float3x2
+	(row0x, row1x, row2x,
+	 row0y, row1y, row2y);
+}
+constexpr Float3x2 Float3x2::Columns
+(float column0x, float column0y, float column0z,
+ float column1x, float column1y, float column1z)
+{
+	return Float3x2
+	(column0x, column0y, column0z,
+	 column1x, column1y, column1z);
+}
+
+
+
+// Math operations:
+inline bool Float3x2::IsEpsilonZero() const
+{
+	return IsEpsilonEqual(Float3x2::zero);
+}
+
+
+
+// Access:
+constexpr float& Float3x2::operator[](int index)
+{
+	if (index >= 0 && index < 6)
+		return data[index];
+	throw std::out_of_range("Float3x2 index out of range.");
+}
+constexpr float Float3x2::operator[](int index) const
+{
+	if (index >= 0 && index < 6)
+		return data[index];
+	throw std::out_of_range("Float3x2 index out of range.");
+}
+constexpr float& Float3x2::operator[](const Index2& index)
+{
+	if (index.i < 3 && index.j < 2)
+		return data[index.i + 3 * index.j];
+	throw std::out_of_range("Float3x2 index out of range.");
+}
+constexpr float Float3x2::operator[](const Index2& index) const
+{
+	if (index.i < 3 && index.j < 2)
+		return data[index.i + 3 * index.j];
+	throw std::out_of_range("Float3x2 index out of range.");
+}
+constexpr Float2 Float3x2::GetRow(int index) const
+{
+	if (index >= 0 && index < 3)
+		return Float2(data[index], data[index + 3]);
+	throw std::out_of_range("Float3x2 row index out of range.");
+}
+constexpr Float3 Float3x2::GetColumn(int index) const
+{
+	if (index >= 0 && index < 2)
+		return Float3(data[3 * index], data[3 * index + 1], data[3 * index + 2]);
+	throw std::out_of_range("Float3x2 column index out of range.");
+}
+
+
+
+// Addition:
+constexpr Float3x2 Float3x2::operator+(const Float3x2& other) const
+{
+	Float3x2 result;
+	for (uint32_t i = 0; i < 6; i++)
+		result.data[i] = data[i] + other.data[i];
+	return result;
+}
+constexpr Float3x2& Float3x2::operator+=(const Float3x2& other)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] += other.data[i];
+	return *this;
+}
+
+
+
+// Substraction:
+constexpr Float3x2 Float3x2::operator-(const Float3x2& other) const
+{
+	Float3x2 result;
+	for (uint32_t i = 0; i < 6; i++)
+		result.data[i] = data[i] - other.data[i];
+	return result;
+}
+constexpr Float3x2& Float3x2::operator-=(const Float3x2& other)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] -= other.data[i];
+	return *this;
+}
+constexpr Float3x2 Float3x2::operator-() const
+{
+	return Float3x2
+	(-data[0], -data[1], -data[2],
+	 -data[3], -data[4], -data[5]);
+}
+
+
+
+// Multiplication:
+constexpr Float3x2& Float3x2::operator*=(float scalar)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] *= scalar;
+	return *this;
+}
+
+
+
+// Division:
+constexpr Float3x2 Float3x2::operator/(float scalar) const
+{
+	Float3x2 result;
+	for (uint32_t i = 0; i < 6; i++)
+		result.data[i] = data[i] / scalar;
+	return result;
+}
+constexpr Float3x2& Float3x2::operator/=(float scalar)
+{
+	for (uint32_t i = 0; i < 6; i++)
+		data[i] /= scalar;
+	return *this;
+}
+
+
+
+// Comparison:
+inline bool Float3x2::IsEpsilonEqual(const Float3x2& other) const
+{
+	for (uint32_t i = 0; i < 6; i++)
+		if (mathf::Abs(data[i] - other.data[i]) > mathf::EPSILON)
+			return false;
+	return true;
+}
+constexpr bool Float3x2::operator==(const Float3x2& other) const
+{
+	for (uint32_t i = 0; i < 6; i++)
+		if (data[i] != other.data[i])
+			return false;
+	return true;
+}
+constexpr bool Float3x2::operator!=(const Float3x2& other) const
+{
+	return !(*this == other);
+}
+
+
+
+// Friend functions:
+constexpr Float3x2 operator*(const Float3x2& a, float b)
+{
+	Float3x2 result;
+	for (uint32_t i = 0; i < 6; i++)
+		result.data[i] = a.data[i] * b;
+	return result;
+}
+constexpr Float3x2 operator*(float a, const Float3x2& b)
+{
+	Float3x2 result;
+	for (uint32_t i = 0; i < 6; i++)
+		result.data[i] = a * b.data[i];
+	return result;
+}
+constexpr Float3 operator*(const Float3x2& a, const Float2& b)
+{
+	return Float3
+	(a.data[0] * b.x + a.data[3] * b.y,
+	 a.data[1] * b.x + a.data[4] * b.y,
+	 a.data[2] * b.x + a.data[5] * b.y);
+}
+constexpr Float2 operator*(const Float3& a, const Float3x2& b)
+{
+	return Float2
+	(a.x * b.data[0] + a.y * b.data[1] + a.z * b.data[2],
+	 a.x * b.data[3] + a.y * b.data[4] + a.z * b.data[5]);
+}
+
+
+
+// Static members:
+inline constexpr Float3x2 Float3x2::zero = Float3x2(0.0f);
+
+
+
 #endif // __INCLUDE_GUARD_float3x2_h__
\ No newline at end of file
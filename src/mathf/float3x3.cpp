@@ -11,35 +11,6 @@
 
 
 // Constructors:
-Float3x3::Float3x3
-(float xx, float xy, float xz,	// column 0
- float yx, float yy, float yz,	// column 1
- float zx, float zy, float zz)	// column 2
-{
-	data[0] = xx; data[3] = yx; data[6] = zx;
-	data[1] = xy; data[4] = yy; data[7] = zy;
-	data[2] = xz; data[5] = yz; data[8] = zz;
-}
-Float3x3::Float3x3()
-{
-	for (uint32_t i = 0; i < 9; i++)
-		data[i] = 0.0f;
-}
-Float3x3::Float3x3(float value)
-{
-	for (uint32_t i = 0; i < 9; i++)
-		data[i] = value;
-}
-Float3x3::Float3x3(const float* const array)
-{
-	for (uint32_t i = 0; i < 9; i++)
-		data[i] = array[i];
-}
-Float3x3::Float3x3(const Float3x3& other)
-{
-	for (uint32_t i = 0; i < 9; i++)
-		data[i] = other[i];
-}
 Float3x3::Float3x3(const Float4x4& other)
 {
 	data[0] = other[0]; data[3] = other[4]; data[6] = other[8];
@@ -57,16 +28,6 @@ Float3x3 Float3x3::Rows(const Float3& row0, const Float3& row1, const Float3& ro
 	 row0.y, row1.y, row2.y,
 	 row0.z, row1.z, row2.z);
 }
-Float3x3 Float3x3::Rows
-(float row0x, float row0y, float row0z,
- float row1x, float row1y, float row1z,
- float row2x, float row2y, float row2z)
-{
-	return Float3x3
-	(row0x, row1x, row2x,
-	 row0y, row1y, row2y,
-	 row0z, row1z, row2z);
-}
 Float3x3 Float3x3::Columns(const Float3& column0, const Float3& column1, const Float3& column2)
 {
 	return Float3x3
@@ -74,33 +35,10 @@ Float3x3 Float3x3::Columns(const Float3& column0, const Float3& column1, const F
 	 column1.x, column1.y, column1.z,
 	 column2.x, column2.y, column2.z);
 }
-Float3x3 Float3x3::Columns
-(float column0x, float column0y, float column0z,
- float column1x, float column1y, float column1z,
- float column2x, float column2y, float column2z)
-{
-	return Float3x3
-	(column0x, column0y, column0z,
-	 column1x, column1y, column1z,
-	 column2x, column2y, column2z);
-}
 
 
 
 // Math operations:
-Float3x3 Float3x3::Transpose() const
-{
-	return Float3x3
-	(data[0], data[3], data[6],
-	 data[1], data[4], data[7],
-	 data[2], data[5], data[8]);
-}
-float Float3x3::Determinant() const
-{
-	return data[0] * (data[4] * data[8] - data[5] * data[7])
-	 	 - data[1] * (data[3] * data[8] - data[5] * data[6])
-	 	 + data[2] * (data[3] * data[7] - data[4] * data[6]);
-}
 Float3x3 Float3x3::Inverse() const
 {
 	float det = Determinant();
@@ -129,10 +67,6 @@ Float3x3 Float3x3::Inverse(float det) const
 		(data[0] * data[4] - data[1] * data[3]) * invDet
 	);
 }
-bool Float3x3::IsEpsilonZero() const
-{
-	return IsEpsilonEqual(Float3x3::zero);
-}
 
 
 
@@ -190,7 +124,9 @@ Float3x3 Float3x3::RotateFromTo(const Float3& from, const Float3& to)
 {
 	Float3 f = from.Normalize();
 	Float3 t = to.Normalize();
-	Float3 axis = Float3::Cross(f, t).Normalize();
+	Float3 axis = Float3::Cross(f, t);
+	if (axis.IsEpsilonZero())	// parallel or antiparallel, any axis orthogonal to from works.
+		axis = geometry3d::GetOrhtogonalVector(f);
 	float angle = Float3::Angle(f, t);
 	return Rotate(axis, angle);
 }
@@ -219,205 +155,6 @@ Float3x3 Float3x3::RotateThreeLeg(const Float3& forwardOld, const Float3& forwar
 
 
 
-// Access:
-float& Float3x3::operator[](int index)
-{
-	if (index >= 0 && index < 9)
-		return data[index];
-	throw std::out_of_range("Float3x3 index out of range.");
-}
-float Float3x3::operator[](int index) const
-{
-	if (index >= 0 && index < 9)
-		return data[index];
-	throw std::out_of_range("Float3x3 index out of range.");
-}
-float& Float3x3::operator[](const Index2& index)
-{
-	if (index.i >= 0 && index.i < 3 && index.j >= 0 && index.j < 3)
-		return data[index.i + 3 * index.j];
-	throw std::out_of_range("Float3x3 index out of range.");
-}
-float Float3x3::operator[](const Index2& index) const
-{
-	if (index.i >= 0 && index.i < 3 && index.j >= 0 && index.j < 3)
-		return data[index.i + 3 * index.j];
-	throw std::out_of_range("Float3x3 index out of range.");
-}
-Float3 Float3x3::GetRow(int index) const
-{
-	if (index >= 0 && index < 3)
-		return Float3(data[index], data[index + 3], data[index + 6]);
-	throw std::out_of_range("Float3x3 row index out of range.");
-}
-Float3 Float3x3::GetColumn(int index) const
-{
-	if (index >= 0 && index < 3)
-		return Float3(data[3 * index], data[3 * index + 1], data[3 * index + 2]);
-	throw std::out_of_range("Float3x3 column index out of range.");
-}
-
-
-
-// Assignment:
-Float3x3& Float3x3::operator=(const Float3x3& other)
-{
-	if (this != &other)
-	{
-		for (uint32_t i = 0; i < 9; i++)
-			data[i] = other[i];
-	}
-	return *this;
-}
-Float3x3& Float3x3::operator=(Float3x3&& other) noexcept
-{
-	if (this != &other)
-	{
-		for (uint32_t i = 0; i < 9; i++)
-			data[i] = other[i];
-	}
-	return *this;
-}
-
-
-
-// Addition:
-Float3x3 Float3x3::operator+(const Float3x3& other) const
-{
-	Float3x3 result;
-	for (uint32_t i = 0; i < 9; i++)
-		result[i] = data[i] + other[i];
-	return result;
-}
-Float3x3& Float3x3::operator+=(const Float3x3& other)
-{
-	for (uint32_t i = 0; i < 9; i++)
-		data[i] += other[i];
-	return *this;
-}
-
-
-
-// Substraction:
-Float3x3 Float3x3::operator-(const Float3x3& other) const
-{
-	Float3x3 result;
-	for (uint32_t i = 0; i < 9; i++)
-		result[i] = data[i] - other[i];
-	return result;
-}
-Float3x3& Float3x3::operator-=(const Float3x3& other)
-{
-	for (uint32_t i = 0; i < 9; i++)
-		data[i] -= other[i];
-	return *this;
-}
-Float3x3 Float3x3::operator-() const
-{
-	return Float3x3
-	(-data[0], -data[1], -data[2],
-	 -data[3], -data[4], -data[5],
-	 -data[6], -data[7], -data[8]);
-}
-
-
-
-// Multiplication:
-Float3x3 Float3x3::operator*(const Float3x3& other) const
-{
-	Float3x3 result;
-	for (uint32_t i = 0; i < 3; i++)
-		for (uint32_t j = 0; j < 3; j++)
-			for (uint32_t k = 0; k < 3; k++)
-				result[{i, j}] += (*this)[{i, k}] * other[{k, j}];
-	return result;
-}
-Float3x3& Float3x3::operator*=(const Float3x3& other)
-{
-	Float3x3 result = (*this) * other;
-	*this = result;
-	return *this;
-}
-Float3x3& Float3x3::operator*=(float scalar)
-{
-	for (uint32_t i = 0; i < 9; i++)
-		data[i] *= scalar;
-	return *this;
-}
-
-
-
-// Division:
-Float3x3 Float3x3::operator/(float scalar) const
-{
-	Float3x3 result;
-	for (uint32_t i = 0; i < 9; i++)
-		result[i] = data[i] / scalar;
-	return result;
-}
-Float3x3& Float3x3::operator/=(float scalar)
-{
-	for (uint32_t i = 0; i < 9; i++)
-		data[i] /= scalar;
-	return *this;
-}
-
-
-
-// Comparison:
-bool Float3x3::IsEpsilonEqual(const Float3x3& other) const
-{
-	for (uint32_t i = 0; i < 9; i++)
-		if (mathf::Abs(data[i] - other[i]) > mathf::EPSILON)
-			return false;
-	return true;
-}
-bool Float3x3::operator==(const Float3x3& other) const
-{
-	for (uint32_t i = 0; i < 9; i++)
-		if (data[i] != other[i])
-			return false;
-	return true;
-}
-bool Float3x3::operator!=(const Float3x3& other) const
-{
-	return !(*this == other);
-}
-
-
-
-// Friend functions:
-Float3x3 operator*(const Float3x3& a, float b)
-{
-	Float3x3 result;
-	for (uint32_t i = 0; i < 9; i++)
-		result[i] = a[i] * b;
-	return result;
-}
-Float3x3 operator*(float a, const Float3x3& b)
-{
-	Float3x3 result;
-	for (uint32_t i = 0; i < 9; i++)
-		result[i] = a * b[i];
-	return result;
-}
-Float3 operator*(const Float3x3& a, const Float3& b)
-{
-	return Float3
-	(a[0] * b.x + a[3] * b.y + a[6] * b.z,
-	 a[1] * b.x + a[4] * b.y + a[7] * b.z,
-	 a[2] * b.x + a[5] * b.y + a[8] * b.z);
-}
-Float3 operator*(const Float3& a, const Float3x3& b)
-{
-	return Float3
-	(a.x * b[0] + a.y * b[1] + a.z * b[2],
-	 a.x * b[3] + a.y * b[4] + a.z * b[5],
-	 a.x * b[6] + a.y * b[7] + a.z * b[8]);
-}
-
-
-
 // Logging:
 std::string Float3x3::ToString() const
 {
@@ -440,13 +177,4 @@ std::ostream& operator<<(std::ostream& os, const Float3x3& value)
 {
 	os << value.ToString();
 	return os;
-}
-
-
-
-// Static members:
-Float3x3 Float3x3::zero = Float3x3(0.0f);
-Float3x3 Float3x3::identity = Float3x3
-(1.0f, 0.0f, 0.0f,
- 0.0f, 1.0f, 0.0f,
- 0.0f, 0.0f, 1.0f);
\ No newline at end of file
+}
\ No newline at end of file
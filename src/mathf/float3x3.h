@@ -2,6 +2,7 @@
 #define __INCLUDE_GUARD_float3x3_h__
 #include "mathf.h"
 #include <string>
+#include <stdexcept>
 
 
 
@@ -20,7 +21,7 @@ struct Float3x3
 	// xz yz zz   2  5  8   [2,0] [2,1] [2,2]
 
 private:
-	Float3x3
+	constexpr Float3x3
 	(float xx, float xy, float xz,	// column 0
 	 float yx, float yy, float yz,	// column 1
 	 float zx, float zy, float zz);	// column 2
@@ -30,27 +31,27 @@ public:
 	float data[9];
 
 	// Constructors:
-	Float3x3();
-	Float3x3(float value);
-	Float3x3(const float* const array);
-	Float3x3(const Float3x3& other);
+	constexpr Float3x3();
+	constexpr Float3x3(float value);
+	constexpr Float3x3(const float* const array);
+	constexpr Float3x3(const Float3x3& other) = default;
 	explicit Float3x3(const Float4x4& other);
 
 	// Static constructors:
 	static Float3x3 Rows(const Float3& row0, const Float3& row1, const Float3& row2);
-	static Float3x3 Rows
+	static constexpr Float3x3 Rows
 	(float row0x, float row0y, float row0z,
 	 float row1x, float row1y, float row1z,
 	 float row2x, float row2y, float row2z);
 	static Float3x3 Columns(const Float3& column0, const Float3& column1, const Float3& column2);
-	static Float3x3 Columns
+	static constexpr Float3x3 Columns
 	(float column0x, float column0y, float column0z,
 	 float column1x, float column1y, float column1z,
 	 float column2x, float column2y, float column2z);
 
 	// Math operations:
-	Float3x3 Transpose() const;
-	float Determinant() const;
+	constexpr Float3x3 Transpose() const;
+	constexpr float Determinant() const;
 	Float3x3 Inverse() const;
 	Float3x3 Inverse(float det) const;
 	bool IsEpsilonZero() const;
@@ -65,45 +66,45 @@ public:
 	static Float3x3 RotateThreeLeg(const Float3& forwardOld, const Float3& forwardNew, const Float3& otherOld, const Float3& otherNew);
 
 	// Access:
-	float& operator[](int index);
-	float operator[](int index) const;
-	float& operator[](const Index2& index);
-	float operator[](const Index2& index) const;
-	Float3 GetRow(int index) const;
-	Float3 GetColumn(int index) const;
+	constexpr float& operator[](int index);
+	constexpr float operator[](int index) const;
+	constexpr float& operator[](const Index2& index);
+	constexpr float operator[](const Index2& index) const;
+	constexpr Float3 GetRow(int index) const;
+	constexpr Float3 GetColumn(int index) const;
 
 	// Assignment:
-	Float3x3& operator=(const Float3x3& other);
-	Float3x3& operator=(Float3x3&& other) noexcept;
+	constexpr Float3x3& operator=(const Float3x3& other) = default;
+	constexpr Float3x3& operator=(Float3x3&& other) noexcept = default;
 
 	// Addition:
-	Float3x3 operator+(const Float3x3& other) const;
-	Float3x3& operator+=(const Float3x3& other);
+	constexpr Float3x3 operator+(const Float3x3& other) const;
+	constexpr Float3x3& operator+=(const Float3x3& other);
 
 	// Substraction:
-	Float3x3 operator-(const Float3x3& other) const;
-	Float3x3& operator-=(const Float3x3& other);
-	Float3x3 operator-() const;
+	constexpr Float3x3 operator-(const Float3x3& other) const;
+	constexpr Float3x3& operator-=(const Float3x3& other);
+	constexpr Float3x3 operator-() const;
 
 	// Multiplication:
-	Float3x3 operator*(const Float3x3& other) const;
-	Float3x3& operator*=(const Float3x3& other);
-	Float3x3& operator*=(float scalar);
+	constexpr Float3x3 operator*(const Float3x3& other) const;
+	constexpr Float3x3& operator*=(const Float3x3& other);
+	constexpr Float3x3& operator*=(float scalar);
 
 	// Division:
-	Float3x3 operator/(float scalar) const;
-	Float3x3& operator/=(float scalar);
+	constexpr Float3x3 operator/(float scalar) const;
+	constexpr Float3x3& operator/=(float scalar);
 
 	// Comparison:
 	bool IsEpsilonEqual(const Float3x3& other) const;
-	bool operator==(const Float3x3& other) const;
-	bool operator!=(const Float3x3& other) const;
+	constexpr bool operator==(const Float3x3& other) const;
+	constexpr bool operator!=(const Float3x3& other) const;
 
 	// Friend functions:
-	friend Float3x3 operator*(const Float3x3& a, float b);
-	friend Float3x3 operator*(float a, const Float3x3& b);
-	friend Float3 operator*(const Float3x3& a, const Float3& b);
-	friend Float3 operator*(const Float3& a, const Float3x3& b);
+	friend constexpr Float3x3 operator*(const Float3x3& a, float b);
+	friend constexpr Float3x3 operator*(float a, const Float3x3& b);
+	friend constexpr Float3 operator*(const Float3x3& a, const Float3& b);
+	friend constexpr Float3 operator*(const Float3& a, const Float3x3& b);
 
 	// Logging:
 	std::string ToString() const;
@@ -111,10 +112,270 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Float3x3& value);
 
 	// Static members:
-	static Float3x3 zero;		// zero matrix.
-	static Float3x3 identity;	// identity matrix.
+	static const Float3x3 zero;		// zero matrix.
+	static const Float3x3 identity;	// identity matrix.
 };
 
 
 
+// Inline definitions:
+// Constructors:
+constexpr Float3x3::Float3x3
+(float xx, float xy, float xz,	// column 0
+ float yx, float yy, float yz,	// column 1
+ float zx, float zy, float zz)	// column 2
+{
+	data[0] = xx; data[3] = yx; data[6] = zx;
+	data[1] = xy; data[4] = yy; data[7] = zy;
+	data[2] = xz; data[5] = yz; data[8] = zz;
+}
+constexpr Float3x3::Float3x3()
+{
+	for (uint32_t i = 0; i < 9; i++)
+		data[i] = 0.0f;
+}
+constexpr Float3x3::Float3x3(float value)
+{
+	for (uint32_t i = 0; i < 9; i++)
+		data[i] = value;
+}
+constexpr Float3x3::Float3x3(const float* const array)
+{
+	for (uint32_t i = 0; i < 9; i++)
+		data[i] = array[i];
+}
+
+
+
+// Static constructors:
+constexpr Float3x3 Float3x3::Rows
+(float row0x, float row0y, float row0z,
+ float row1x, float row1y, float row1z,
+ float row2x, float row2y, float row2z)
+{
+	return Float3x3
+	(row0x, row1x, row2x,
+	 row0y, row1y, row2y,
+	 row0z, row1z, row2z);
+}
+constexpr Float3x3 Float3x3::Columns
+(float column0x, float column0y, float column0z,
+ float column1x, float column1y, float column1z,
+ float column2x, float column2y, float column2z)
+{
+	return Float3x3
+	(column0x, column0y, column0z,
+	 column1x, column1y, column1z,
+	 column2x, column2y, column2z);
+}
+
+
+
+// Math operations:
+constexpr Float3x3 Float3x3::Transpose() const
+{
+	return Float3x3
+	(data[0], data[3], data[6],
+	 data[1], data[4], data[7],
+	 data[2], data[5], data[8]);
+}
+constexpr float Float3x3::Determinant() const
+{
+	return data[0] * (data[4] * data[8] - data[5] * data[7])
+	 	 - data[1] * (data[3] * data[8] - data[5] * data[6])
+	 	 + data[2] * (data[3] * data[7] - data[4] * data[6]);
+}
+inline bool Float3x3::IsEpsilonZero() const
+{
+	return IsEpsilonEqual(Float3x3::zero);
+}
+
+
+
+// Access:
+constexpr float& Float3x3::operator[](int index)
+{
+	if (index >= 0 && index < 9)
+		return data[index];
+	throw std::out_of_range("Float3x3 index out of range.");
+}
+constexpr float Float3x3::operator[](int index) const
+{
+	if (index >= 0 && index < 9)
+		return data[index];
+	throw std::out_of_range("Float3x3 index out of range.");
+}
+constexpr float& Float3x3::operator[](const Index2& index)
+{
+	if (index.i < 3 && index.j < 3)
+		return data[index.i + 3 * index.j];
+	throw std::out_of_range("Float3x3 index out of range.");
+}
+constexpr float Float3x3::operator[](const Index2& index) const
+{
+	if (index.i < 3 && index.j < 3)
+		return data[index.i + 3 * index.j];
+	throw std::out_of_range("Float3x3 index out of range.");
+}
+constexpr Float3 Float3x3::GetRow(int index) const
+{
+	if (index >= 0 && index < 3)
+		return Float3(data[index], data[index + 3], data[index + 6]);
+	throw std::out_of_range("Float3x3 row index out of range.");
+}
+constexpr Float3 Float3x3::GetColumn(int index) const
+{
+	if (index >= 0 && index < 3)
+		return Float3(data[3 * index], data[3 * index + 1], data[3 * index + 2]);
+	throw std::out_of_range("Float3x3 column index out of range.");
+}
+
+
+
+// Addition:
+constexpr Float3x3 Float3x3::operator+(const Float3x3& other) const
+{
+	Float3x3 result;
+	for (uint32_t i = 0; i < 9; i++)
+		result.data[i] = data[i] + other.data[i];
+	return result;
+}
+constexpr Float3x3& Float3x3::operator+=(const Float3x3& other)
+{
+	for (uint32_t i = 0; i < 9; i++)
+		data[i] += other.data[i];
+	return *this;
+}
+
+
+
+// Substraction:
+constexpr Float3x3 Float3x3::operator-(const Float3x3& other) const
+{
+	Float3x3 result;
+	for (uint32_t i = 0; i < 9; i++)
+		result.data[i] = data[i] - other.data[i];
+	return result;
+}
+constexpr Float3x3& Float3x3::operator-=(const Float3x3& other)
+{
+	for (uint32_t i = 0; i < 9; i++)
+		data[i] -= other.data[i];
+	return *this;
+}
+constexpr Float3x3 Float3x3::operator-() const
+{
+	return Float3x3
+	(-data[0], -data[1], -data[2],
+	 -data[3], -data[4], -data[5],
+	 -data[6], -data[7], -data[8]);
+}
+
+
+
+// Multiplication:
+constexpr Float3x3 Float3x3::operator*(const Float3x3& other) const
+{
+	Float3x3 result;
+	for (uint32_t i = 0; i < 3; i++)
+		for (uint32_t j = 0; j < 3; j++)
+			for (uint32_t k = 0; k < 3; k++)
+				result.data[i + 3 * j] += data[i + 3 * k] * other.data[k + 3 * j];
+	return result;
+}
+constexpr Float3x3& Float3x3::operator*=(const Float3x3& other)
+{
+	Float3x3 result = (*this) * other;
+	*this = result;
+	return *this;
+}
+constexpr Float3x3& Float3x3::operator*=(float scalar)
+{
+	for (uint32_t i = 0; i < 9; i++)
+		data[i] *= scalar;
+	return *this;
+}
+
+
+
+// Division:
+constexpr Float3x3 Float3x3::operator/(float scalar) const
+{
+	Float3x3 result;
+	for (uint32_t i = 0; i < 9; i++)
+		result.data[i] = data[i] / scalar;
+	return result;
+}
+constexpr Float3x3& Float3x3::operator/=(float scalar)
+{
+	for (uint32_t i = 0; i < 9; i++)
+		data[i] /= scalar;
+	return *this;
+}
+
+
+
+// Comparison:
+inline bool Float3x3::IsEpsilonEqual(const Float3x3& other) const
+{
+	for (uint32_t i = 0; i < 9; i++)
+		if (mathf::Abs(data[i] - other.data[i]) > mathf::EPSILON)
+			return false;
+	return true;
+}
+constexpr bool Float3x3::operator==(const Float3x3& other) const
+{
+	for (uint32_t i = 0; i < 9; i++)
+		if (data[i] != other.data[i])
+			return false;
+	return true;
+}
+constexpr bool Float3x3::operator!=(const Float3x3& other) const
+{
+	return !(*this == other);
+}
+
+
+
+// Friend functions:
+constexpr Float3x3 operator*(const Float3x3& a, float b)
+{
+	Float3x3 result;
+	for (uint32_t i = 0; i < 9; i++)
+		result.data[i] = a.data[i] * b;
+	return result;
+}
+constexpr Float3x3 operator*(float a, const Float3x3& b)
+{
+	Float3x3 result;
+	for (uint32_t i = 0; i < 9; i++)
+		result.data[i] = a * b.data[i];
+	return result;
+}
+constexpr Float3 operator*(const Float3x3& a, const Float3& b)
+{
+	return Float3
+	(a.data[0] * b.x + a.data[3] * b.y + a.data[6] * b.z,
+	 a.data[1] * b.x + a.data[4] * b.y + a.data[7] * b.z,
+	 a.data[2] * b.x + a.data[5] * b.y + a.data[8] * b.z);
+}
+constexpr Float3 operator*(const Float3& a, const Float3x3& b)
+{
+	return Float3
+	(a.x * b.data[0] + a.y * b.data[1] + a.z * b.data[2],
+	 a.x * b.data[3] + a.y * b.data[4] + a.z * b.data[5],
+	 a.x * b.data[6] + a.y * b.data[7] + a.z * b.data[8]);
+}
+
+
+
+// Static members:
+inline constexpr Float3x3 Float3x3::zero = Float3x3(0.0f);
+inline constexpr Float3x3 Float3x3::identity = Float3x3
+(1.0f, 0.0f, 0.0f,
+ 0.0f, 1.0f, 0.0f,
+ 0.0f, 0.0f, 1.0f);
+
+
+
 #endif // __INCLUDE_GUARD_float3x3_h__
\ No newline at end of file
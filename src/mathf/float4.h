@@ -1,6 +1,7 @@
 #ifndef __INCLUDE_GUARD_float4_h__
 #define __INCLUDE_GUARD_float4_h__
 #include <string>
+#include <stdexcept>
 
 
 
@@ -16,68 +17,68 @@ public:
 	float x, y, z, w;
 
 	// Constructors:
-	Float4();
-	Float4(float xyzw);
-	Float4(float x, float y);
-	Float4(float x, float y, float z);
-	Float4(float x, float y, float z, float w);
+	constexpr Float4();
+	constexpr Float4(float xyzw);
+	constexpr Float4(float x, float y);
+	constexpr Float4(float x, float y, float z);
+	constexpr Float4(float x, float y, float z, float w);
 	explicit Float4(const Float2& xy);
 	explicit Float4(const Float2& xy, float z);
 	explicit Float4(const Float2& xy, float z, float w);
 	explicit Float4(const Float2& xy, Float2 zw);
 	explicit Float4(const Float3& xyz);
 	explicit Float4(const Float3& xyz, float w);
-	Float4(const Float4& xyzw);
+	constexpr Float4(const Float4& xyzw) = default;
 	static Float4 Direction(float theta, float phi);
 
 	// Math operations:
-	float LengthSq() const;
+	constexpr float LengthSq() const;
 	float Length() const;
 	bool IsEpsilonZero() const;
 
 	// Static math operations:
 	static Float4 Abs(const Float4& a);
-	static Float4 Min(const Float4& a, const Float4& b);
-	static Float4 Max(const Float4& a, const Float4& b);
-	static Float4 Clamp(const Float4& value, const Float4& min, const Float4& max);
+	static constexpr Float4 Min(const Float4& a, const Float4& b);
+	static constexpr Float4 Max(const Float4& a, const Float4& b);
+	static constexpr Float4 Clamp(const Float4& value, const Float4& min, const Float4& max);
 
 	// Access:
-	float& operator[](int index);
-	float operator[](int index) const;
+	constexpr float& operator[](int index);
+	constexpr float operator[](int index) const;
 	Float3 xyz() const;
 
 	// Assignment:
-	Float4& operator=(const Float4& other);
-	Float4& operator=(Float4&& other) noexcept;
+	constexpr Float4& operator=(const Float4& other) = default;
+	constexpr Float4& operator=(Float4&& other) noexcept = default;
 
 	// Addition:
-	Float4 operator+(const Float4& other) const;
-	Float4& operator+=(const Float4& other);
+	constexpr Float4 operator+(const Float4& other) const;
+	constexpr Float4& operator+=(const Float4& other);
 
 	// Substraction:
-	Float4 operator-(const Float4& other) const;
-	Float4& operator-=(const Float4& other);
-	Float4 operator-() const;
+	constexpr Float4 operator-(const Float4& other) const;
+	constexpr Float4& operator-=(const Float4& other);
+	constexpr Float4 operator-() const;
 
 	// Multiplication:
-	Float4 operator*(const Float4& other) const;
-	Float4& operator*=(const Float4& other);
-	Float4 operator*(float scalar) const;
-	Float4& operator*=(float scalar);
+	constexpr Float4 operator*(const Float4& other) const;
+	constexpr Float4& operator*=(const Float4& other);
+	constexpr Float4 operator*(float scalar) const;
+	constexpr Float4& operator*=(float scalar);
 
 	// Division:
-	Float4 operator/(const Float4& other) const;
-	Float4& operator/=(const Float4& other);
-	Float4 operator/(float scalar) const;
-	Float4& operator/=(float scalar);
+	constexpr Float4 operator/(const Float4& other) const;
+	constexpr Float4& operator/=(const Float4& other);
+	constexpr Float4 operator/(float scalar) const;
+	constexpr Float4& operator/=(float scalar);
 
 	// Comparison:
 	bool IsEpsilonEqual(const Float4& other) const;
-	bool operator==(const Float4& other) const;
-	bool operator!=(const Float4& other) const;
+	constexpr bool operator==(const Float4& other) const;
+	constexpr bool operator!=(const Float4& other) const;
 
 	// Friend functions:
-	friend Float4 operator*(float a, const Float4& b);
+	friend constexpr Float4 operator*(float a, const Float4& b);
 
 	// Logging:
 	std::string ToString() const;
@@ -85,33 +86,252 @@ public:
 
 	// Static members:
 	// Numbers:
-	static Float4 zero;
-	static Float4 one;
+	static const Float4 zero;
+	static const Float4 one;
 
 	// Directions:
-	static Float4 right;	// +x = ( 1, 0, 0, 0).
-	static Float4 left;		// -x = (-1, 0, 0, 0).
-	static Float4 up;		// +y = ( 0, 1, 0, 0).
-	static Float4 down;		// -y = ( 0,-1, 0, 0).
-	static Float4 forward;	// +z = ( 0, 0, 1, 0).
-	static Float4 backward;	// -z = ( 0, 0,-1, 0).
-	static Float4 in;		// +w = ( 0, 0, 0, 1).
-	static Float4 out;		// -w = ( 0, 0, 0,-1).
+	static const Float4 right;		// +x = ( 1, 0, 0, 0).
+	static const Float4 left;		// -x = (-1, 0, 0, 0).
+	static const Float4 up;			// +y = ( 0, 1, 0, 0).
+	static const Float4 down;		// -y = ( 0,-1, 0, 0).
+	static const Float4 forward;	// +z = ( 0, 0, 1, 0).
+	static const Float4 backward;	// -z = ( 0, 0,-1, 0).
+	static const Float4 in;			// +w = ( 0, 0, 0, 1).
+	static const Float4 out;		// -w = ( 0, 0, 0,-1).
 
 	// Colors:
-	static Float4 white;	// ( 1, 1, 1, 1).
-	static Float4 gray;		// ( 0.5, 0.5, 0.5, 1).
-	static Float4 black;	// ( 0, 0, 0, 1).
-	static Float4 red;		// ( 1, 0, 0, 1).
-	static Float4 green;	// ( 0, 1, 0, 1).
-	static Float4 blue;		// ( 0, 0, 1, 1).
-	static Float4 yellow;	// ( 1, 1, 0, 1).
-	static Float4 cyan;		// ( 0, 1, 1, 1).
-	static Float4 magenta;	// ( 1, 0, 1, 1).
+	static const Float4 white;		// ( 1, 1, 1, 1).
+	static const Float4 gray;		// ( 0.5, 0.5, 0.5, 1).
+	static const Float4 black;		// ( 0, 0, 0, 1).
+	static const Float4 red;		// ( 1, 0, 0, 1).
+	static const Float4 green;		// ( 0, 1, 0, 1).
+	static const Float4 blue;		// ( 0, 0, 1, 1).
+	static const Float4 yellow;		// ( 1, 1, 0, 1).
+	static const Float4 cyan;		// ( 0, 1, 1, 1).
+	static const Float4 magenta;	// ( 1, 0, 1, 1).
 };
 
 // Friend functions:
-Float4 operator/(float scalar, const Float4& vector);
+constexpr Float4 operator/(float scalar, const Float4& vector);
+
+
+
+// Inline definitions (hot arithmetic lives in the header so it can be inlined without LTO).
+// mathf.h is included after the declaration above, as it includes this header itself.
+#include "mathf.h"
+
+
+
+// Constructors:
+constexpr Float4::Float4() : x(0), y(0), z(0), w(0) {}
+constexpr Float4::Float4(float xyzw) : x(xyzw), y(xyzw), z(xyzw), w(xyzw) {}
+constexpr Float4::Float4(float x, float y) : x(x), y(y), z(0.0f), w(0.0f) {}
+constexpr Float4::Float4(float x, float y, float z) : x(x), y(y), z(z), w(0.0f) {}
+constexpr Float4::Float4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+
+
+// Math operations:
+constexpr float Float4::LengthSq() const
+{
+	return x * x + y * y + z * z + w * w;
+}
+inline float Float4::Length() const
+{
+	return mathf::Sqrt(LengthSq());
+}
+inline bool Float4::IsEpsilonZero() const
+{
+	return IsEpsilonEqual(Float4::zero);
+}
+
+
+
+// Static math operations:
+inline Float4 Float4::Abs(const Float4& a)
+{
+	return Float4(mathf::Abs(a.x), mathf::Abs(a.y), mathf::Abs(a.z), mathf::Abs(a.w));
+}
+constexpr Float4 Float4::Min(const Float4& a, const Float4& b)
+{
+	return Float4(mathf::Min(a.x, b.x), mathf::Min(a.y, b.y), mathf::Min(a.z, b.z), mathf::Min(a.w, b.w));
+}
+constexpr Float4 Float4::Max(const Float4& a, const Float4& b)
+{
+	return Float4(mathf::Max(a.x, b.x), mathf::Max(a.y, b.y), mathf::Max(a.z, b.z), mathf::Max(a.w, b.w));
+}
+constexpr Float4 Float4::Clamp(const Float4& value, const Float4& min, const Float4& max)
+{
+	return Float4(mathf::Clamp(value.x, min.x, max.x), mathf::Clamp(value.y, min.y, max.y), mathf::Clamp(value.z, min.z, max.z), mathf::Clamp(value.w, min.w, max.w));
+}
+
+
+
+// Access:
+constexpr float& Float4::operator[](int index)
+{
+	if (index == 0) return x;
+	if (index == 1) return y;
+	if (index == 2) return z;
+	if (index == 3) return w;
+	throw std::out_of_range("Float4 index out of range.");
+}
+constexpr float Float4::operator[](int index) const
+{
+	if (index == 0) return x;
+	if (index == 1) return y;
+	if (index == 2) return z;
+	if (index == 3) return w;
+	throw std::out_of_range("Float4 index out of range.");
+}
+
+
+
+// Addition:
+constexpr Float4 Float4::operator+(const Float4& other) const
+{
+	return Float4(x + other.x, y + other.y, z + other.z, w + other.w);
+}
+constexpr Float4& Float4::operator+=(const Float4& other)
+{
+	this->x += other.x;
+	this->y += other.y;
+	this->z += other.z;
+	this->w += other.w;
+	return *this;
+}
+
+
+
+// Substraction:
+constexpr Float4 Float4::operator-(const Float4& other) const
+{
+	return Float4(x - other.x, y - other.y, z - other.z, w - other.w);
+}
+constexpr Float4& Float4::operator-=(const Float4& other)
+{
+	this->x -= other.x;
+	this->y -= other.y;
+	this->z -= other.z;
+	this->w -= other.w;
+	return *this;
+}
+constexpr Float4 Float4::operator-() const
+{
+	return Float4(-x, -y, -z, -w);
+}
+
+
+
+// Multiplication:
+constexpr Float4 Float4::operator*(const Float4& other) const
+{
+	return Float4(x * other.x, y * other.y, z * other.z, w * other.w);
+}
+constexpr Float4& Float4::operator*=(const Float4& other)
+{
+	this->x *= other.x;
+	this->y *= other.y;
+	this->z *= other.z;
+	this->w *= other.w;
+	return *this;
+}
+constexpr Float4 Float4::operator*(float scalar) const
+{
+	return Float4(x * scalar, y * scalar, z * scalar, w * scalar);
+}
+constexpr Float4& Float4::operator*=(float scalar)
+{
+	x *= scalar;
+	y *= scalar;
+	z *= scalar;
+	w *= scalar;
+	return *this;
+}
+
+
+
+// Division:
+constexpr Float4 Float4::operator/(const Float4& other) const
+{
+	return Float4(x / other.x, y / other.y, z / other.z, w / other.w);
+}
+constexpr Float4& Float4::operator/=(const Float4& other)
+{
+	this->x /= other.x;
+	this->y /= other.y;
+	this->z /= other.z;
+	this->w /= other.w;
+	return *this;
+}
+constexpr Float4 Float4::operator/(float scalar) const
+{
+	return Float4(x / scalar, y / scalar, z / scalar, w / scalar);
+}
+constexpr Float4& Float4::operator/=(float scalar)
+{
+	x /= scalar;
+	y /= scalar;
+	z /= scalar;
+	w /= scalar;
+	return *this;
+}
+constexpr Float4 operator/(float scalar, const Float4& vector)
+{
+	return Float4(scalar / vector.x, scalar / vector.y, scalar / vector.z, scalar / vector.w);
+}
+
+
+
+// Comparison:
+inline bool Float4::IsEpsilonEqual(const Float4& other) const
+{
+	return mathf::Abs(x - other.x) < mathf::EPSILON && mathf::Abs(y - other.y) < mathf::EPSILON && mathf::Abs(z - other.z) < mathf::EPSILON && mathf::Abs(w - other.w) < mathf::EPSILON;
+}
+constexpr bool Float4::operator==(const Float4& other) const
+{
+	return x == other.x && y == other.y && z == other.z && w == other.w;
+}
+constexpr bool Float4::operator!=(const Float4& other) const
+{
+	return !(*this == other);
+}
+
+
+
+// Friend functions:
+constexpr Float4 operator*(float a, const Float4& b)
+{
+	return Float4(a * b.x, a * b.y, a * b.z, a * b.w);
+}
+
+
+
+// Static members:
+// Numbers;
+inline constexpr Float4 Float4::zero		= Float4(0.0f);
+inline constexpr Float4 Float4::one			= Float4(1.0f);
+
+// Directions:
+inline constexpr Float4 Float4::right		= Float4(1.0f, 0.0f, 0.0f, 0.0f);
+inline constexpr Float4 Float4::left		= Float4(-1.0f, 0.0f, 0.0f, 0.0f);
+inline constexpr Float4 Float4::up			= Float4(0.0f, 1.0f, 0.0f, 0.0f);
+inline constexpr Float4 Float4::down		= Float4(0.0f, -1.0f, 0.0f, 0.0f);
+inline constexpr Float4 Float4::forward		= Float4(0.0f, 0.0f, 1.0f, 0.0f);
+inline constexpr Float4 Float4::backward	= Float4(0.0f, 0.0f, -1.0f, 0.0f);
+inline constexpr Float4 Float4::in			= Float4(0.0f, 0.0f, 0.0f, 1.0f);
+inline constexpr Float4 Float4::out			= Float4(0.0f, 0.0f, 0.0f, -1.0f);
+
+// Colors:
+inline constexpr Float4 Float4::white		= Float4(1.0f, 1.0f, 1.0f, 1.0f);
+inline constexpr Float4 Float4::gray		= Float4(0.5f, 0.5f, 0.5f, 1.0f);
+inline constexpr Float4 Float4::black		= Float4(0.0f, 0.0f, 0.0f, 1.0f);
+inline constexpr Float4 Float4::red			= Float4(1.0f, 0.0f, 0.0f, 1.0f);
+inline constexpr Float4 Float4::green		= Float4(0.0f, 1.0f, 0.0f, 1.0f);
+inline constexpr Float4 Float4::blue		= Float4(0.0f, 0.0f, 1.0f, 1.0f);
+inline constexpr Float4 Float4::yellow		= Float4(1.0f, 1.0f, 0.0f, 1.0f);
+inline constexpr Float4 Float4::cyan		= Float4(0.0f, 1.0f, 1.0f, 1.0f);
+inline constexpr Float4 Float4::magenta		= Float4(1.0f, 0.0f, 1.0f, 1.0f);
 
 
 
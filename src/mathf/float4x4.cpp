@@ -2,39 +2,23 @@
 #include "float4.h"
 #include "float3x3.h"
 #include "logger.h"
+#include "simd.h"
 #include "uint3.h"
 #include <stdexcept>
 #include <sstream>
 
 
 
+// Active backend:
+#ifdef MATHF_SIMD_SCALAR
+namespace backend = float4x4Kernels::scalar;
+#else
+namespace backend = float4x4Kernels::simd;
+#endif
+
+
+
 // Constructors:
-Float4x4::Float4x4
-(float xx, float xy, float xz, float xw,	// column 0
- float yx, float yy, float yz, float yw,	// column 1
- float zx, float zy, float zz, float zw,	// column 2
- float wx, float wy, float wz, float ww)	// column 3
-{
-	data[0] = xx; data[4] = yx; data[ 8] = zx; data[12] = wx;
-	data[1] = xy; data[5] = yy; data[ 9] = zy; data[13] = wy;
-	data[2] = xz; data[6] = yz; data[10] = zz; data[14] = wz;
-	data[3] = xw; data[7] = yw; data[11] = zw; data[15] = ww;
-}
-Float4x4::Float4x4()
-{
-	for (uint32_t i = 0; i < 16; i++)
-		data[i] = 0.0f;
-}
-Float4x4::Float4x4(float value)
-{
-	for (uint32_t i = 0; i < 16; i++)
-		data[i] = value;
-}
-Float4x4::Float4x4(const float* const array)
-{
-	for (uint32_t i = 0; i < 16; i++)
-		data[i] = array[i];
-}
 Float4x4::Float4x4(const Float3x3& other)
 {
 	data[0] = other[0]; data[4] = other[3]; data[ 8] = other[6]; data[12] = 0.0f;
@@ -42,11 +26,6 @@ Float4x4::Float4x4(const Float3x3& other)
 	data[2] = other[2]; data[6] = other[5]; data[10] = other[8]; data[14] = 0.0f;
 	data[3] =     0.0f; data[7] =     0.0f; data[11] =     0.0f; data[15] = 1.0f;
 }
-Float4x4::Float4x4(const Float4x4& other)
-{
-	for (uint32_t i = 0; i < 16; i++)
-		data[i] = other[i];
-}
 
 
 
@@ -59,18 +38,6 @@ Float4x4 Float4x4::Rows(const Float4& row0, const Float4& row1, const Float4& ro
 	 row0.z, row1.z, row2.z, row3.z,
 	 row0.w, row1.w, row2.w, row3.w);
 }
-Float4x4 Float4x4::Rows
-(float row0x, float row0y, float row0z, float row0w,
- float row1x, float row1y, float row1z, float row1w,
- float row2x, float row2y, float row2z, float row2w,
- float row3x, float row3y, float row3z, float row3w)
-{
-	return Float4x4
-	(row0x, row1x, row2x, row3x,
-	 row0y, row1y, row2y, row3y,
-	 row0z, row1z, row2z, row3z,
-	 row0w, row1w, row2w, row3w);
-}
 Float4x4 Float4x4::Columns(const Float4& column0, const Float4& column1, const Float4& column2, const Float4& column3)
 {
 	return Float4x4
@@ -79,36 +46,13 @@ Float4x4 Float4x4::Columns(const Float4& column0, const Float4& column1, const F
 	 column2.x, column2.y, column2.z, column2.w,
 	 column3.x, column3.y, column3.z, column3.w);
 }
-Float4x4 Float4x4::Columns
-(float column0x, float column0y, float column0z, float column0w,
- float column1x, float column1y, float column1z, float column1w,
- float column2x, float column2y, float column2z, float column2w,
- float column3x, float column3y, float column3z, float column3w)
-{
-	return Float4x4
-	(column0x, column0y, column0z, column0w,
-	 column1x, column1y, column1z, column1w,
-	 column2x, column2y, column2z, column2w,
-	 column3x, column3y, column3z, column3w);
-}
 
 
 
 // Math operations:
 Float4x4 Float4x4::Transpose()
 {
-	return Float4x4
-	(data[0], data[4], data[8], data[12],
-	 data[1], data[5], data[9], data[13],
-	 data[2], data[6], data[10], data[14],
-	 data[3], data[7], data[11], data[15]);
-}
-float Float4x4::Determinant() const
-{
-	return data[0] * (data[5] * (data[10] * data[15] - data[11] * data[14]) - data[6] * (data[9] * data[15] - data[11] * data[13]) + data[7] * (data[9] * data[14] - data[10] * data[13]))
-		- data[1] * (data[4] * (data[10] * data[15] - data[11] * data[14]) - data[6] * (data[8] * data[15] - data[11] * data[12]) + data[7] * (data[8] * data[14] - data[10] * data[12]))
-		+ data[2] * (data[4] * (data[9] * data[15] - data[11] * data[13]) - data[5] * (data[8] * data[15] - data[11] * data[12]) + data[7] * (data[8] * data[13] - data[9] * data[12]))
-		- data[3] * (data[4] * (data[9] * data[14] - data[10] * data[13]) - data[5] * (data[8] * data[14] - data[10] * data[12]) + data[6] * (data[8] * data[13] - data[9] * data[12]));
+	return backend::Transpose(*this);
 }
 Float4x4 Float4x4::Inverse() const
 {
@@ -122,33 +66,25 @@ Float4x4 Float4x4::Inverse(float det) const
 		LOG_WARN("Float4x4::Inverse(), determinant is zero.");
 			return Float4x4::zero;
 	}
-	float invDet = 1.0f / det;
-	return Float4x4::Columns
-	(// column 0:
-		(data[5] * (data[10] * data[15] - data[11] * data[14]) - data[6] * (data[9] * data[15] - data[11] * data[13]) + data[7] * (data[9] * data[14] - data[10] * data[13])) * invDet,
-		-(data[1] * (data[10] * data[15] - data[11] * data[14]) - data[2] * (data[9] * data[15] - data[11] * data[13]) + data[3] * (data[9] * data[14] - data[10] * data[13])) * invDet,
-		(data[1] * (data[6] * data[15] - data[7] * data[14]) - data[2] * (data[5] * data[15] - data[7] * data[13]) + data[3] * (data[5] * data[14] - data[6] * data[13])) * invDet,
-		-(data[1] * (data[6] * data[11] - data[7] * data[10]) - data[2] * (data[5] * data[11] - data[7] * data[9]) + data[3] * (data[5] * data[10] - data[6] * data[9])) * invDet,
-		// column 1:
-		-(data[4] * (data[10] * data[15] - data[11] * data[14]) - data[6] * (data[8] * data[15] - data[11] * data[12]) + data[7] * (data[8] * data[14] - data[10] * data[12])) * invDet,
-		(data[0] * (data[10] * data[15] - data[11] * data[14]) - data[2] * (data[8] * data[15] - data[11] * data[12]) + data[3] * (data[8] * data[14] - data[10] * data[12])) * invDet,
-		-(data[0] * (data[6] * data[15] - data[7] * data[14]) - data[2] * (data[4] * data[15] - data[7] * data[12]) + data[3] * (data[4] * data[14] - data[6] * data[12])) * invDet,
-		(data[0] * (data[6] * data[11] - data[7] * data[10]) - data[2] * (data[4] * data[11] - data[7] * data[8]) + data[3] * (data[4] * data[10] - data[6] * data[8])) * invDet,
-		// column 2:
-		(data[4] * (data[9] * data[15] - data[11] * data[13]) - data[5] * (data[8] * data[15] - data[11] * data[12]) + data[7] * (data[8] * data[13] - data[9] * data[12])) * invDet,
-		-(data[0] * (data[9] * data[15] - data[11] * data[13]) - data[1] * (data[8] * data[15] - data[11] * data[12]) + data[3] * (data[8] * data[13] - data[9] * data[12])) * invDet,
-		(data[0] * (data[5] * data[15] - data[7] * data[13]) - data[1] * (data[4] * data[15] - data[7] * data[12]) + data[3] * (data[4] * data[13] - data[5] * data[12])) * invDet,
-		-(data[0] * (data[5] * data[11] - data[7] * data[9]) - data[1] * (data[4] * data[11] - data[7] * data[8]) + data[3] * (data[4] * data[9] - data[5] * data[8])) * invDet,
-		// column 3:
-		-(data[4] * (data[9] * data[14] - data[10] * data[13]) - data[5] * (data[8] * data[14] - data[10] * data[12]) + data[6] * (data[8] * data[13] - data[9] * data[12])) * invDet,
-		(data[0] * (data[9] * data[14] - data[10] * data[13]) - data[1] * (data[8] * data[14] - data[10] * data[12]) + data[2] * (data[8] * data[13] - data[9] * data[12])) * invDet,
-		-(data[0] * (data[5] * data[14] - data[6] * data[13]) - data[1] * (data[4] * data[14] - data[6] * data[12]) + data[2] * (data[4] * data[13] - data[5] * data[12])) * invDet,
-		(data[0] * (data[5] * data[10] - data[6] * data[9]) - data[1] * (data[4] * data[10] - data[6] * data[8]) + data[2] * (data[4] * data[9] - data[5] * data[8])) * invDet
-	);
-}
-bool Float4x4::IsEpsilonZero() const
-{
-	return IsEpsilonEqual(Float4x4::zero);
+	return backend::Adjugate(*this) * (1.0f / det);
+}
+Float4x4 Float4x4::InverseAffine() const
+{
+	// (A t; 0 1)^-1 = (A^-1  -A^-1*t; 0 1):
+	Float3x3 linear = Float3x3(*this);
+	float det = linear.Determinant();
+	if (det == 0.0f)
+	{
+		LOG_WARN("Float4x4::InverseAffine(), determinant is zero.");
+		return Float4x4::zero;
+	}
+	Float3x3 linearInverse = linear.Inverse(det);
+	Float3 translation = -(linearInverse * GetTranslation());
+	Float4x4 result = Float4x4(linearInverse);
+	result[12] = translation.x;
+	result[13] = translation.y;
+	result[14] = translation.z;
+	return result;
 }
 
 
@@ -270,9 +206,12 @@ Float4x4 Float4x4::Scale(float scale)
 }
 Float4x4 Float4x4::TRS(const Float3& position, const Float3x3& rotationMatrix, const Float3& scale)
 {
-	Float4x4 T = Translate(position);
-	Float4x4 S = Scale(scale);
-	return T * Float4x4(rotationMatrix) * S;
+	// T * R * S = (R columns scaled by S, translation in last column):
+	return Float4x4
+	(rotationMatrix[0] * scale.x, rotationMatrix[1] * scale.x, rotationMatrix[2] * scale.x, 0.0f,
+	 rotationMatrix[3] * scale.y, rotationMatrix[4] * scale.y, rotationMatrix[5] * scale.y, 0.0f,
+	 rotationMatrix[6] * scale.z, rotationMatrix[7] * scale.z, rotationMatrix[8] * scale.z, 0.0f,
+	 position.x, position.y, position.z, 1.0f);
 }
 Float4x4 Float4x4::TRS(const Float3& position, const Float4x4& rotationMatrix, const Float3& scale)
 {
@@ -280,6 +219,27 @@ Float4x4 Float4x4::TRS(const Float3& position, const Float4x4& rotationMatrix, c
 	Float4x4 S = Scale(scale);
 	return T * rotationMatrix * S;
 }
+Float4x4 Float4x4::InverseTRS(const Float3& position, const Float3x3& rotationMatrix, const Float3& scale)
+{
+	// (T * R * S)^-1 = S^-1 * R^T * T^-1:
+	if (scale.x == 0.0f || scale.y == 0.0f || scale.z == 0.0f)
+	{
+		LOG_WARN("Float4x4::InverseTRS(), scale is zero.");
+		return Float4x4::zero;
+	}
+	Float3 invScale = Float3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+	const float* r = rotationMatrix.data;
+	float xx = r[0] * invScale.x; float yx = r[1] * invScale.x; float zx = r[2] * invScale.x;
+	float xy = r[3] * invScale.y; float yy = r[4] * invScale.y; float zy = r[5] * invScale.y;
+	float xz = r[6] * invScale.z; float yz = r[7] * invScale.z; float zz = r[8] * invScale.z;
+	return Float4x4
+	(xx, xy, xz, 0.0f,
+	 yx, yy, yz, 0.0f,
+	 zx, zy, zz, 0.0f,
+	 -(xx * position.x + yx * position.y + zx * position.z),
+	 -(xy * position.x + yy * position.y + zy * position.z),
+	 -(xz * position.x + yz * position.y + zz * position.z), 1.0f);
+}
 Float4x4 Float4x4::Perspective(float fov, float aspectRatio, float nearClip, float farClip)
 {
 	float tanHalfFov = mathf::Tan(0.5f * fov);
@@ -313,50 +273,18 @@ Float4x4 Float4x4::Orthographic(float left, float right, float bottom, float top
 
 
 // Access:
-float& Float4x4::operator[](int index)
-{
-	if (index >= 0 && index < 16)
-		return data[index];
-	throw std::out_of_range("Float4x4 index out of range.");
-}
-float Float4x4::operator[](int index) const
-{
-	if (index >= 0 && index < 16)
-		return data[index];
-	throw std::out_of_range("Float4x4 index out of range.");
-}
-float& Float4x4::operator[](const Index2& index)
-{
-	if (index.i >= 0 && index.i < 4 && index.j >= 0 && index.j < 4)
-		return data[index.i + 4 * index.j];
-	throw std::out_of_range("Float4x4 index out of range.");
-}
-float Float4x4::operator[](const Index2& index) const
-{
-	if (index.i >= 0 && index.i < 4 && index.j >= 0 && index.j < 4)
-		return data[index.i + 4 * index.j];
-	throw std::out_of_range("Float4x4 index out of range.");
-}
-Float4 Float4x4::GetRow(int index) const
-{
-	if (index >= 0 && index < 4)
-		return Float4(data[index], data[index + 4], data[index + 8], data[index + 12]);
-	throw std::out_of_range("Float4x4 row index out of range.");
-}
-Float4 Float4x4::GetColumn(int index) const
-{
-	if (index >= 0 && index < 4)
-		return Float4(data[4 * index], data[4 * index + 1], data[4 * index + 2], data[4 * index + 3]);
-	throw std::out_of_range("Float4x4 column index out of range.");
-}
-Float3 Float4x4::GetTranslation() const
-{
-	return Float3(data[12], data[13], data[14]);
-}
 Float3 Float4x4::GetScale() const
 {
 	return Float3(GetColumn(0).Length(), GetColumn(1).Length(), GetColumn(2).Length());
 }
+Float3 Float4x4::GetSignedScale() const
+{
+	// A mirroring matrix is no rotation times positive scale, so the mirroring is moved into scale.x:
+	Float3 scale = GetScale();
+	if (Float3x3(*this).Determinant() < 0.0f)
+		scale.x = -scale.x;
+	return scale;
+}
 Float3x3 Float4x4::GetRotation3x3() const
 {
 	return GetRotation3x3(GetScale());
@@ -375,9 +303,10 @@ Float4x4 Float4x4::GetRotation4x4(float scale) const
 }
 Float3x3 Float4x4::GetRotation3x3(Float3 scale) const
 {
-	Float3 column0 = Float3(data[0] / scale.x, data[1] / scale.y, data[ 2] / scale.z).Normalize();
-	Float3 column1 = Float3(data[4] / scale.x, data[5] / scale.y, data[ 6] / scale.z).Normalize();
-	Float3 column2 = Float3(data[8] / scale.x, data[9] / scale.y, data[10] / scale.z).Normalize();
+	// Column i of the linear part is rotation column i times scale[i]:
+	Float3 column0 = (Float3(data[0], data[1], data[ 2]) / scale.x).Normalize();
+	Float3 column1 = (Float3(data[4], data[5], data[ 6]) / scale.y).Normalize();
+	Float3 column2 = (Float3(data[8], data[9], data[10]) / scale.z).Normalize();
 	return Float3x3::Columns
 	(column0.x, column0.y, column0.z,
 	 column1.x, column1.y, column1.z,
@@ -390,79 +319,10 @@ Float4x4 Float4x4::GetRotation4x4(Float3 scale) const
 
 
 
-// Assignment:
-Float4x4& Float4x4::operator=(const Float4x4& other)
-{
-	if (this != &other)
-	{
-		for (uint32_t i = 0; i < 16; i++)
-			data[i] = other[i];
-	}
-	return *this;
-}
-Float4x4& Float4x4::operator=(Float4x4&& other) noexcept
-{
-	if (this != &other)
-	{
-		for (uint32_t i = 0; i < 16; i++)
-			data[i] = other[i];
-	}
-	return *this;
-}
-
-
-
-// Addition:
-Float4x4 Float4x4::operator+(const Float4x4& other) const
-{
-	Float4x4 result;
-	for (uint32_t i = 0; i < 16; i++)
-		result[i] = data[i] + other[i];
-	return result;
-}
-Float4x4& Float4x4::operator+=(const Float4x4& other)
-{
-	for (uint32_t i = 0; i < 16; i++)
-		data[i] += other[i];
-	return *this;
-}
-
-
-
-// Substraction:
-Float4x4 Float4x4::operator-(const Float4x4& other) const
-{
-	Float4x4 result;
-	for (uint32_t i = 0; i < 16; i++)
-		result[i] = data[i] - other[i];
-	return result;
-}
-Float4x4& Float4x4::operator-=(const Float4x4& other)
-{
-	for (uint32_t i = 0; i < 16; i++)
-		data[i] -= other[i];
-	return *this;
-}
-Float4x4 Float4x4::operator-() const
-{
-	return Float4x4
-	(-data[ 0], -data[ 1], -data[ 2], -data[ 3],
-	 -data[ 4], -data[ 5], -data[ 6], -data[ 7],
-	 -data[ 8], -data[ 9], -data[10], -data[11],
-	 -data[12], -data[13], -data[14], -data[15]);
-}
-
-
-
 // Multiplication:
 Float4x4 Float4x4::operator*(const Float4x4& other) const
 {
-	Float4x4 result;
-	for (uint32_t i = 0; i < 4; i++)
-		for (uint32_t j = 0; j < 4; j++)
-			for (uint32_t k = 0; k < 4; k++)
-				result[{i, j}] += (*this)[{i, k}] * other[{k, j}];
-	return result;
+	return backend::Multiply(*this, other);
 }
 Float4x4& Float4x4::operator*=(const Float4x4& other)
 {
@@ -470,84 +330,13 @@ Float4x4& Float4x4::operator*=(const Float4x4& other)
 	*this = result;
 	return *this;
 }
-Float4x4& Float4x4::operator*=(float scalar)
-{
-	for (uint32_t i = 0; i < 16; i++)
-		data[i] *= scalar;
-	return *this;
-}
-
-
-
-// Division:
-Float4x4 Float4x4::operator/(float scalar) const
-{
-	Float4x4 result;
-	for (uint32_t i = 0; i < 16; i++)
-		result[i] = data[i] / scalar;
-	return result;
-}
-Float4x4& Float4x4::operator/=(float scalar)
-{
-	for (uint32_t i = 0; i < 16; i++)
-		data[i] /= scalar;
-	return *this;
-}
-
-
-
-// Comparison:
-bool Float4x4::IsEpsilonEqual(const Float4x4& other) const
-{
-	for (uint32_t i = 0; i < 16; i++)
-		if (std::fabs(data[i] - other[i]) > mathf::EPSILON)
-			return false;
-	return true;
-}
-bool Float4x4::operator==(const Float4x4& other) const
-{
-	for (uint32_t i = 0; i < 16; i++)
-		if (data[i] != other[i])
-			return false;
-	return true;
-}
-bool Float4x4::operator!=(const Float4x4& other) const
-{
-	return !(*this == other);
-}
 
 
 
 // Friend functions:
-Float4x4 operator*(const Float4x4& a, float b)
-{
-	Float4x4 result;
-	for (uint32_t i = 0; i < 16; i++)
-		result[i] = a[i] * b;
-	return result;
-}
-Float4x4 operator*(float a, const Float4x4& b)
-{
-	Float4x4 result;
-	for (uint32_t i = 0; i < 16; i++)
-		result[i] = a * b[i];
-	return result;
-}
 Float4 operator*(const Float4x4& a, const Float4& b)
 {
-	return Float4
-	(a[0] * b.x + a[4] * b.y + a[ 8] * b.z + a[12] * b.w,
-	 a[1] * b.x + a[5] * b.y + a[ 9] * b.z + a[13] * b.w,
-	 a[2] * b.x + a[6] * b.y + a[10] * b.z + a[14] * b.w,
-	 a[3] * b.x + a[7] * b.y + a[11] * b.z + a[15] * b.w);
-}
-Float4 operator*(const Float4& a, const Float4x4& b)
-{
-	return Float4
-	(a.x * b[ 0] + a.y * b[ 1] + a.z * b[ 2] + a.w * b[ 3],
-	 a.x * b[ 4] + a.y * b[ 5] + a.z * b[ 6] + a.w * b[ 7],
-	 a.x * b[ 8] + a.y * b[ 9] + a.z * b[10] + a.w * b[11],
-	 a.x * b[12] + a.y * b[13] + a.z * b[14] + a.w * b[15]);
+	return backend::Multiply(a, b);
 }
 
 
@@ -580,10 +369,150 @@ std::ostream& operator<<(std::ostream& os, const Float4x4& value)
 
 
 
-// Static members:
-Float4x4 Float4x4::zero = Float4x4(0.0f);
-Float4x4 Float4x4::identity = Float4x4
-(1.0f, 0.0f, 0.0f, 0.0f,
- 0.0f, 1.0f, 0.0f, 0.0f,
- 0.0f, 0.0f, 1.0f, 0.0f,
- 0.0f, 0.0f, 0.0f, 1.0f);
\ No newline at end of file
+// Scalar kernels:
+namespace float4x4Kernels::scalar
+{
+	Float4x4 Multiply(const Float4x4& a, const Float4x4& b)
+	{
+		Float4x4 result;
+		for (uint32_t i = 0; i < 4; i++)
+			for (uint32_t j = 0; j < 4; j++)
+				for (uint32_t k = 0; k < 4; k++)
+					result[{i, j}] += a[{i, k}] * b[{k, j}];
+		return result;
+	}
+	Float4 Multiply(const Float4x4& a, const Float4& b)
+	{
+		return Float4
+		(a[0] * b.x + a[4] * b.y + a[ 8] * b.z + a[12] * b.w,
+		 a[1] * b.x + a[5] * b.y + a[ 9] * b.z + a[13] * b.w,
+		 a[2] * b.x + a[6] * b.y + a[10] * b.z + a[14] * b.w,
+		 a[3] * b.x + a[7] * b.y + a[11] * b.z + a[15] * b.w);
+	}
+	Float4x4 Transpose(const Float4x4& matrix)
+	{
+		const float* data = matrix.data;
+		return Float4x4::Rows
+		(data[0], data[1], data[2], data[3],
+		 data[4], data[5], data[6], data[7],
+		 data[8], data[9], data[10], data[11],
+		 data[12], data[13], data[14], data[15]);
+	}
+	Float4x4 Adjugate(const Float4x4& matrix)
+	{
+		const float* data = matrix.data;
+		return Float4x4::Columns
+		(// column 0:
+			(data[5] * (data[10] * data[15] - data[11] * data[14]) - data[6] * (data[9] * data[15] - data[11] * data[13]) + data[7] * (data[9] * data[14] - data[10] * data[13])),
+			-(data[1] * (data[10] * data[15] - data[11] * data[14]) - data[2] * (data[9] * data[15] - data[11] * data[13]) + data[3] * (data[9] * data[14] - data[10] * data[13])),
+			(data[1] * (data[6] * data[15] - data[7] * data[14]) - data[2] * (data[5] * data[15] - data[7] * data[13]) + data[3] * (data[5] * data[14] - data[6] * data[13])),
+			-(data[1] * (data[6] * data[11] - data[7] * data[10]) - data[2] * (data[5] * data[11] - data[7] * data[9]) + data[3] * (data[5] * data[10] - data[6] * data[9])),
+			// column 1:
+			-(data[4] * (data[10] * data[15] - data[11] * data[14]) - data[6] * (data[8] * data[15] - data[11] * data[12]) + data[7] * (data[8] * data[14] - data[10] * data[12])),
+			(data[0] * (data[10] * data[15] - data[11] * data[14]) - data[2] * (data[8] * data[15] - data[11] * data[12]) + data[3] * (data[8] * data[14] - data[10] * data[12])),
+			-(data[0] * (data[6] * data[15] - data[7] * data[14]) - data[2] * (data[4] * data[15] - data[7] * data[12]) + data[3] * (data[4] * data[14] - data[6] * data[12])),
+			(data[0] * (data[6] * data[11] - data[7] * data[10]) - data[2] * (data[4] * data[11] - data[7] * data[8]) + data[3] * (data[4] * data[10] - data[6] * data[8])),
+			// column 2:
+			(data[4] * (data[9] * data[15] - data[11] * data[13]) - data[5] * (data[8] * data[15] - data[11] * data[12]) + data[7] * (data[8] * data[13] - data[9] * data[12])),
+			-(data[0] * (data[9] * data[15] - data[11] * data[13]) - data[1] * (data[8] * data[15] - data[11] * data[12]) + data[3] * (data[8] * data[13] - data[9] * data[12])),
+			(data[0] * (data[5] * data[15] - data[7] * data[13]) - data[1] * (data[4] * data[15] - data[7] * data[12]) + data[3] * (data[4] * data[13] - data[5] * data[12])),
+			-(data[0] * (data[5] * data[11] - data[7] * data[9]) - data[1] * (data[4] * data[11] - data[7] * data[8]) + data[3] * (data[4] * data[9] - data[5] * data[8])),
+			// column 3:
+			-(data[4] * (data[9] * data[14] - data[10] * data[13]) - data[5] * (data[8] * data[14] - data[10] * data[12]) + data[6] * (data[8] * data[13] - data[9] * data[12])),
+			(data[0] * (data[9] * data[14] - data[10] * data[13]) - data[1] * (data[8] * data[14] - data[10] * data[12]) + data[2] * (data[8] * data[13] - data[9] * data[12])),
+			-(data[0] * (data[5] * data[14] - data[6] * data[13]) - data[1] * (data[4] * data[14] - data[6] * data[12]) + data[2] * (data[4] * data[13] - data[5] * data[12])),
+			(data[0] * (data[5] * data[10] - data[6] * data[9]) - data[1] * (data[4] * data[10] - data[6] * data[8]) + data[2] * (data[4] * data[9] - data[5] * data[8]))
+		);
+	}
+}
+
+
+
+// Simd kernels:
+namespace float4x4Kernels::simd
+{
+	Float4x4 Multiply(const Float4x4& a, const Float4x4& b)
+	{
+		::simd::Register a0 = ::simd::Load(a.data + 0);
+		::simd::Register a1 = ::simd::Load(a.data + 4);
+		::simd::Register a2 = ::simd::Load(a.data + 8);
+		::simd::Register a3 = ::simd::Load(a.data + 12);
+
+		// Column j of the result is a linear combination of the columns of a:
+		Float4x4 result;
+		for (uint32_t j = 0; j < 4; j++)
+		{
+			const float* bColumn = b.data + 4 * j;
+			::simd::Register column = ::simd::Mul(a0, ::simd::Splat(bColumn[0]));
+			column = ::simd::MulAdd(a1, ::simd::Splat(bColumn[1]), column);
+			column = ::simd::MulAdd(a2, ::simd::Splat(bColumn[2]), column);
+			column = ::simd::MulAdd(a3, ::simd::Splat(bColumn[3]), column);
+			::simd::Store(result.data + 4 * j, column);
+		}
+		return result;
+	}
+	Float4 Multiply(const Float4x4& a, const Float4& b)
+	{
+		::simd::Register result = ::simd::Mul(::simd::Load(a.data + 0), ::simd::Splat(b.x));
+		result = ::simd::MulAdd(::simd::Load(a.data + 4), ::simd::Splat(b.y), result);
+		result = ::simd::MulAdd(::simd::Load(a.data + 8), ::simd::Splat(b.z), result);
+		result = ::simd::MulAdd(::simd::Load(a.data + 12), ::simd::Splat(b.w), result);
+		float values[4];
+		::simd::Store(values, result);
+		return Float4(values[0], values[1], values[2], values[3]);
+	}
+	Float4x4 Transpose(const Float4x4& matrix)
+	{
+		::simd::Register c0 = ::simd::Load(matrix.data + 0);
+		::simd::Register c1 = ::simd::Load(matrix.data + 4);
+		::simd::Register c2 = ::simd::Load(matrix.data + 8);
+		::simd::Register c3 = ::simd::Load(matrix.data + 12);
+		::simd::Transpose(c0, c1, c2, c3);
+		Float4x4 result;
+		::simd::Store(result.data + 0, c0);
+		::simd::Store(result.data + 4, c1);
+		::simd::Store(result.data + 8, c2);
+		::simd::Store(result.data + 12, c3);
+		return result;
+	}
+	Float4x4 Adjugate(const Float4x4& matrix)
+	{
+		// Cross product formulation (Lengyel), the xyz lanes of each column hold the upper 3x3 part, the w lanes the bottom row:
+		::simd::Register a = ::simd::Load(matrix.data + 0);
+		::simd::Register b = ::simd::Load(matrix.data + 4);
+		::simd::Register c = ::simd::Load(matrix.data + 8);
+		::simd::Register d = ::simd::Load(matrix.data + 12);
+		::simd::Register x = ::simd::Swizzle<3, 3, 3, 3>(a);
+		::simd::Register y = ::simd::Swizzle<3, 3, 3, 3>(b);
+		::simd::Register z = ::simd::Swizzle<3, 3, 3, 3>(c);
+		::simd::Register w = ::simd::Swizzle<3, 3, 3, 3>(d);
+
+		::simd::Register s = ::simd::Cross3(a, b);
+		::simd::Register t = ::simd::Cross3(c, d);
+		::simd::Register u = ::simd::Sub(::simd::Mul(a, y), ::simd::Mul(b, x));
+		::simd::Register v = ::simd::Sub(::simd::Mul(c, w), ::simd::Mul(d, z));
+
+		// Rows of the adjugate, w lanes are patched below:
+		float rows[4][4];
+		::simd::Store(rows[0], ::simd::MulAdd(t, y, ::simd::Cross3(b, v)));
+		::simd::Store(rows[1], ::simd::Sub(::simd::Cross3(v, a), ::simd::Mul(t, x)));
+		::simd::Store(rows[2], ::simd::MulAdd(s, w, ::simd::Cross3(d, u)));
+		::simd::Store(rows[3], ::simd::Sub(::simd::Cross3(u, c), ::simd::Mul(s, z)));
+		rows[0][3] = -::simd::Dot3(b, t);
+		rows[1][3] = ::simd::Dot3(a, t);
+		rows[2][3] = -::simd::Dot3(d, s);
+		rows[3][3] = ::simd::Dot3(c, s);
+
+		::simd::Register r0 = ::simd::Load(rows[0]);
+		::simd::Register r1 = ::simd::Load(rows[1]);
+		::simd::Register r2 = ::simd::Load(rows[2]);
+		::simd::Register r3 = ::simd::Load(rows[3]);
+		::simd::Transpose(r0, r1, r2, r3);
+		Float4x4 result;
+		::simd::Store(result.data + 0, r0);
+		::simd::Store(result.data + 4, r1);
+		::simd::Store(result.data + 8, r2);
+		::simd::Store(result.data + 12, r3);
+		return result;
+	}
+}
\ No newline at end of file
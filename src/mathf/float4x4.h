@@ -2,6 +2,7 @@
 #define __INCLUDE_GUARD_float4x4_h__
 #include "mathf.h"
 #include <string>
+#include <stdexcept>
 
 
 
@@ -22,7 +23,7 @@ struct Float4x4
 	// xw yw zw ww   3  7  11 15   [3,0] [3,1] [3,2] [3,3]
 
 private:
-	Float4x4
+	constexpr Float4x4
 	(float xx, float xy, float xz, float xw,	// column 0
 	 float yx, float yy, float yz, float yw,	// column 1
 	 float zx, float zy, float zz, float zw,	// column 2
@@ -33,21 +34,21 @@ public:
 	float data[16];
 
 	// Constructors:
-	Float4x4();
-	Float4x4(float value);
-	Float4x4(const float* const array);
+	constexpr Float4x4();
+	constexpr Float4x4(float value);
+	constexpr Float4x4(const float* const array);
 	explicit Float4x4(const Float3x3& other);
-	Float4x4(const Float4x4& other);
+	constexpr Float4x4(const Float4x4& other) = default;
 
 	// Static constructors:
 	static Float4x4 Rows(const Float4& row0, const Float4& row1, const Float4& row2, const Float4& row3);
-	static Float4x4 Rows
+	static constexpr Float4x4 Rows
 	(float row0x, float row0y, float row0z, float row0w,
 	 float row1x, float row1y, float row1z, float row1w,
 	 float row2x, float row2y, float row2z, float row2w,
 	 float row3x, float row3y, float row3z, float row3w);
 	static Float4x4 Columns(const Float4& column0, const Float4& column1, const Float4& column2, const Float4& column3);
-	static Float4x4 Columns
+	static constexpr Float4x4 Columns
 	(float column0x, float column0y, float column0z, float column0w,
 	 float column1x, float column1y, float column1z, float column1w,
 	 float column2x, float column2y, float column2z, float column2w,
@@ -55,9 +56,10 @@ public:
 
 	// Math operations:
 	Float4x4 Transpose();
-	float Determinant() const;
+	constexpr float Determinant() const;
 	Float4x4 Inverse() const;
 	Float4x4 Inverse(float det) const;
+	Float4x4 InverseAffine() const;	// only valid if the bottom row is (0,0,0,1).
 	bool IsEpsilonZero() const;
 
 	// Static math operations:
@@ -73,18 +75,20 @@ public:
 	static Float4x4 Scale(float scale);
 	static Float4x4 TRS(const Float3& position, const Float3x3& rotationMatrix, const Float3& scale);
 	static Float4x4 TRS(const Float3& position, const Float4x4& rotationMatrix, const Float3& scale);
+	static Float4x4 InverseTRS(const Float3& position, const Float3x3& rotationMatrix, const Float3& scale);
 	static Float4x4 Perspective(float fov, float aspectRatio, float nearClip, float farClip);
 	static Float4x4 Orthographic(float left, float right, float bottom, float top, float nearClip, float farClip);
 
 	// Access:
-	float& operator[](int index);
-	float operator[](int index) const;
-	float& operator[](const Index2& index);
-	float operator[](const Index2& index) const;
-	Float4 GetRow(int index) const;
-	Float4 GetColumn(int index) const;
-	Float3 GetTranslation() const;
+	constexpr float& operator[](int index);
+	constexpr float operator[](int index) const;
+	constexpr float& operator[](const Index2& index);
+	constexpr float operator[](const Index2& index) const;
+	constexpr Float4 GetRow(int index) const;
+	constexpr Float4 GetColumn(int index) const;
+	constexpr Float3 GetTranslation() const;
 	Float3 GetScale() const;
+	Float3 GetSignedScale() const;	// like GetScale(), but x is negative if the matrix mirrors (negative determinant).
 	Float3x3 GetRotation3x3() const;
 	Float4x4 GetRotation4x4() const;
 	Float3x3 GetRotation3x3(Float3 scale) const;
@@ -93,37 +97,37 @@ public:
 	Float4x4 GetRotation4x4(float scale) const;
 
 	// Assignment:
-	Float4x4& operator=(const Float4x4& other);
-	Float4x4& operator=(Float4x4&& other) noexcept;
+	constexpr Float4x4& operator=(const Float4x4& other) = default;
+	constexpr Float4x4& operator=(Float4x4&& other) noexcept = default;
 
 	// Addition:
-	Float4x4 operator+(const Float4x4& other) const;
-	Float4x4& operator+=(const Float4x4& other);
+	constexpr Float4x4 operator+(const Float4x4& other) const;
+	constexpr Float4x4& operator+=(const Float4x4& other);
 
 	// Substraction:
-	Float4x4 operator-(const Float4x4& other) const;
-	Float4x4& operator-=(const Float4x4& other);
-	Float4x4 operator-() const;
+	constexpr Float4x4 operator-(const Float4x4& other) const;
+	constexpr Float4x4& operator-=(const Float4x4& other);
+	constexpr Float4x4 operator-() const;
 
 	// Multiplication:
 	Float4x4 operator*(const Float4x4& other) const;
 	Float4x4& operator*=(const Float4x4& other);
-	Float4x4& operator*=(float scalar);
+	constexpr Float4x4& operator*=(float scalar);
 
 	// Division:
-	Float4x4 operator/(float scalar) const;
-	Float4x4& operator/=(float scalar);
+	constexpr Float4x4 operator/(float scalar) const;
+	constexpr Float4x4& operator/=(float scalar);
 
 	// Comparison:
 	bool IsEpsilonEqual(const Float4x4& other) const;
-	bool operator==(const Float4x4& other) const;
-	bool operator!=(const Float4x4& other) const;
+	constexpr bool operator==(const Float4x4& other) const;
+	constexpr bool operator!=(const Float4x4& other) const;
 
 	// Friend functions:
-	friend Float4x4 operator*(const Float4x4& a, float b);
-	friend Float4x4 operator*(float a, const Float4x4& b);
+	friend constexpr Float4x4 operator*(const Float4x4& a, float b);
+	friend constexpr Float4x4 operator*(float a, const Float4x4& b);
 	friend Float4 operator*(const Float4x4& a, const Float4& b);
-	friend Float4 operator*(const Float4& a, const Float4x4& b);
+	friend constexpr Float4 operator*(const Float4& a, const Float4x4& b);
 
 	// Logging:
 	std::string ToString() const;
@@ -131,10 +135,277 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Float4x4& value);
 
 	// Static members:
-	static Float4x4 zero;		// zero matrix.
-	static Float4x4 identity;	// identity matrix.
+	static const Float4x4 zero;		// zero matrix.
+	static const Float4x4 identity;	// identity matrix.
 };
 
 
 
+// Backend kernels behind the Float4x4 operators:
+// scalar = reference implementation, simd = implementation on top of simd.h.
+namespace float4x4Kernels
+{
+	namespace scalar
+	{
+		Float4x4 Multiply(const Float4x4& a, const Float4x4& b);
+		Float4 Multiply(const Float4x4& a, const Float4& b);
+		Float4x4 Transpose(const Float4x4& matrix);
+		Float4x4 Adjugate(const Float4x4& matrix);
+	}
+	namespace simd
+	{
+		Float4x4 Multiply(const Float4x4& a, const Float4x4& b);
+		Float4 Multiply(const Float4x4& a, const Float4& b);
+		Float4x4 Transpose(const Float4x4& matrix);
+		Float4x4 Adjugate(const Float4x4& matrix);
+	}
+}
+
+
+
+// Inline definitions:
+// Constructors:
+constexpr Float4x4::Float4x4
+(float xx, float xy, float xz, float xw,	// column 0
+ float yx, float yy, float yz, float yw,	// column 1
+ float zx, float zy, float zz, float zw,	// column 2
+ float wx, float wy, float wz, float ww)	// column 3
+{
+	data[0] = xx; data[4] = yx; data[ 8] = zx; data[12] = wx;
+	data[1] = xy; data[5] = yy; data[ 9] = zy; data[13] = wy;
+	data[2] = xz; data[6] = yz; data[10] = zz; data[14] = wz;
+	data[3] = xw; data[7] = yw; data[11] = zw; data[15] = ww;
+}
+constexpr Float4x4::Float4x4()
+{
+	for (uint32_t i = 0; i < 16; i++)
+		data[i] = 0.0f;
+}
+constexpr Float4x4::Float4x4(float value)
+{
+	for (uint32_t i = 0; i < 16; i++)
+		data[i] = value;
+}
+constexpr Float4x4::Float4x4(const float* const array)
+{
+	for (uint32_t i = 0; i < 16; i++)
+		data[i] = array[i];
+}
+
+
+
+// Static constructors:
+constexpr Float4x4 Float4x4::Rows
+(float row0x, float row0y, float row0z, float row0w,
+ float row1x, float row1y, float row1z, float row1w,
+ float row2x, float row2y, float row2z, float row2w,
+ float row3x, float row3y, float row3z, float row3w)
+{
+	return Float4x4
+	(row0x, row1x, row2x, row3x,
+	 row0y, row1y, row2y, row3y,
+	 row0z, row1z, row2z, row3z,
+	 row0w, row1w, row2w, row3w);
+}
+constexpr Float4x4 Float4x4::Columns
+(float column0x, float column0y, float column0z, float column0w,
+ float column1x, float column1y, float column1z, float column1w,
+ float column2x, float column2y, float column2z, float column2w,
+ float column3x, float column3y, float column3z, float column3w)
+{
+	return Float4x4
+	(column0x, column0y, column0z, column0w,
+	 column1x, column1y, column1z, column1w,
+	 column2x, column2y, column2z, column2w,
+	 column3x, column3y, column3z, column3w);
+}
+
+
+
+// Math operations:
+constexpr float Float4x4::Determinant() const
+{
+	return data[0] * (data[5] * (data[10] * data[15] - data[11] * data[14]) - data[6] * (data[9] * data[15] - data[11] * data[13]) + data[7] * (data[9] * data[14] - data[10] * data[13]))
+		- data[1] * (data[4] * (data[10] * data[15] - data[11] * data[14]) - data[6] * (data[8] * data[15] - data[11] * data[12]) + data[7] * (data[8] * data[14] - data[10] * data[12]))
+		+ data[2] * (data[4] * (data[9] * data[15] - data[11] * data[13]) - data[5] * (data[8] * data[15] - data[11] * data[12]) + data[7] * (data[8] * data[13] - data[9] * data[12]))
+		- data[3] * (data[4] * (data[9] * data[14] - data[10] * data[13]) - data[5] * (data[8] * data[14] - data[10] * data[12]) + data[6] * (data[8] * data[13] - data[9] * data[12]));
+}
+inline bool Float4x4::IsEpsilonZero() const
+{
+	return IsEpsilonEqual(Float4x4::zero);
+}
+
+
+
+// Access:
+constexpr float& Float4x4::operator[](int index)
+{
+	if (index >= 0 && index < 16)
+		return data[index];
+	throw std::out_of_range("Float4x4 index out of range.");
+}
+constexpr float Float4x4::operator[](int index) const
+{
+	if (index >= 0 && index < 16)
+		return data[index];
+	throw std::out_of_range("Float4x4 index out of range.");
+}
+constexpr float& Float4x4::operator[](const Index2& index)
+{
+	if (index.i < 4 && index.j < 4)
+		return data[index.i + 4 * index.j];
+	throw std::out_of_range("Float4x4 index out of range.");
+}
+constexpr float Float4x4::operator[](const Index2& index) const
+{
+	if (index.i < 4 && index.j < 4)
+		return data[index.i + 4 * index.j];
+	throw std::out_of_range("Float4x4 index out of range.");
+}
+constexpr Float4 Float4x4::GetRow(int index) const
+{
+	if (index >= 0 && index < 4)
+		return Float4(data[index], data[index + 4], data[index + 8], data[index + 12]);
+	throw std::out_of_range("Float4x4 row index out of range.");
+}
+constexpr Float4 Float4x4::GetColumn(int index) const
+{
+	if (index >= 0 && index < 4)
+		return Float4(data[4 * index], data[4 * index + 1], data[4 * index + 2], data[4 * index + 3]);
+	throw std::out_of_range("Float4x4 column index out of range.");
+}
+constexpr Float3 Float4x4::GetTranslation() const
+{
+	return Float3(data[12], data[13], data[14]);
+}
+
+
+
+// Addition:
+constexpr Float4x4 Float4x4::operator+(const Float4x4& other) const
+{
+	Float4x4 result;
+	for (uint32_t i = 0; i < 16; i++)
+		result.data[i] = data[i] + other.data[i];
+	return result;
+}
+constexpr Float4x4& Float4x4::operator+=(const Float4x4& other)
+{
+	for (uint32_t i = 0; i < 16; i++)
+		data[i] += other.data[i];
+	return *this;
+}
+
+
+
+// Substraction:
+constexpr Float4x4 Float4x4::operator-(const Float4x4& other) const
+{
+	Float4x4 result;
+	for (uint32_t i = 0; i < 16; i++)
+		result.data[i] = data[i] - other.data[i];
+	return result;
+}
+constexpr Float4x4& Float4x4::operator-=(const Float4x4& other)
+{
+	for (uint32_t i = 0; i < 16; i++)
+		data[i] -= other.data[i];
+	return *this;
+}
+constexpr Float4x4 Float4x4::operator-() const
+{
+	return Float4x4
+	(-data[ 0], -data[ 1], -data[ 2], -data[ 3],
+	 -data[ 4], -data[ 5], -data[ 6], -data[ 7],
+	 -data[ 8], -data[ 9], -data[10], -data[11],
+	 -data[12], -data[13], -data[14], -data[15]);
+}
+
+
+
+// Multiplication:
+constexpr Float4x4& Float4x4::operator*=(float scalar)
+{
+	for (uint32_t i = 0; i < 16; i++)
+		data[i] *= scalar;
+	return *this;
+}
+
+
+
+// Division:
+constexpr Float4x4 Float4x4::operator/(float scalar) const
+{
+	Float4x4 result;
+	for (uint32_t i = 0; i < 16; i++)
+		result.data[i] = data[i] / scalar;
+	return result;
+}
+constexpr Float4x4& Float4x4::operator/=(float scalar)
+{
+	for (uint32_t i = 0; i < 16; i++)
+		data[i] /= scalar;
+	return *this;
+}
+
+
+
+// Comparison:
+inline bool Float4x4::IsEpsilonEqual(const Float4x4& other) const
+{
+	for (uint32_t i = 0; i < 16; i++)
+		if (mathf::Abs(data[i] - other.data[i]) > mathf::EPSILON)
+			return false;
+	return true;
+}
+constexpr bool Float4x4::operator==(const Float4x4& other) const
+{
+	for (uint32_t i = 0; i < 16; i++)
+		if (data[i] != other.data[i])
+			return false;
+	return true;
+}
+constexpr bool Float4x4::operator!=(const Float4x4& other) const
+{
+	return !(*this == other);
+}
+
+
+
+// Friend functions:
+constexpr Float4x4 operator*(const Float4x4& a, float b)
+{
+	Float4x4 result;
+	for (uint32_t i = 0; i < 16; i++)
+		result.data[i] = a.data[i] * b;
+	return result;
+}
+constexpr Float4x4 operator*(float a, const Float4x4& b)
+{
+	Float4x4 result;
+	for (uint32_t i = 0; i < 16; i++)
+		result.data[i] = a * b.data[i];
+	return result;
+}
+constexpr Float4 operator*(const Float4& a, const Float4x4& b)
+{
+	return Float4
+	(a.x * b.data[ 0] + a.y * b.data[ 1] + a.z * b.data[ 2] + a.w * b.data[ 3],
+	 a.x * b.data[ 4] + a.y * b.data[ 5] + a.z * b.data[ 6] + a.w * b.data[ 7],
+	 a.x * b.data[ 8] + a.y * b.data[ 9] + a.z * b.data[10] + a.w * b.data[11],
+	 a.x * b.data[12] + a.y * b.data[13] + a.z * b.data[14] + a.w * b.data[15]);
+}
+
+
+
+// Static members:
+inline constexpr Float4x4 Float4x4::zero = Float4x4(0.0f);
+inline constexpr Float4x4 Float4x4::identity = Float4x4
+(1.0f, 0.0f, 0.0f, 0.0f,
+ 0.0f, 1.0f, 0.0f, 0.0f,
+ 0.0f, 0.0f, 1.0f, 0.0f,
+ 0.0f, 0.0f, 0.0f, 1.0f);
+
+
+
 #endif // __INCLUDE_GUARD_float4x4_h__
\ No newline at end of file
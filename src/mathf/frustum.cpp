@@ -0,0 +1,136 @@
+#include "frustum.h"
+#include "mathf.h"
+#include "simd.h"
+#include <algorithm>
+#include <cfloat>
+
+
+
+// Constructors:
+Frustum::Frustum()
+{
+	// Degenerate planes that contain everything:
+	for (uint32_t i = 0; i < 6; i++)
+		planes[i] = Float4(0.0f, 0.0f, 0.0f, 1.0f);
+}
+Frustum::Frustum(const Float4x4& viewProjectionMatrix)
+{
+	// Gribb/Hartmann plane extraction. The near plane uses the -w <= z convention of
+	// Float4x4::Perspective/Orthographic, which is conservative for a 0 <= z clip range as well:
+	Float4 row0 = viewProjectionMatrix.GetRow(0);
+	Float4 row1 = viewProjectionMatrix.GetRow(1);
+	Float4 row2 = viewProjectionMatrix.GetRow(2);
+	Float4 row3 = viewProjectionMatrix.GetRow(3);
+	planes[0] = row3 + row0;
+	planes[1] = row3 - row0;
+	planes[2] = row3 + row1;
+	planes[3] = row3 - row1;
+	planes[4] = row3 + row2;
+	planes[5] = row3 - row2;
+
+	for (uint32_t i = 0; i < 6; i++)
+	{
+		float length = Float3(planes[i]).Length();
+		if (length <= mathf::EPSILON)
+			planes[i] = Float4(0.0f, 0.0f, 0.0f, 1.0f);
+		else
+			planes[i] /= length;
+	}
+}
+
+
+
+// Public methods:
+bool Frustum::Contains(const Float3& point) const
+{
+	for (uint32_t i = 0; i < 6; i++)
+		if (planes[i].x * point.x + planes[i].y * point.y + planes[i].z * point.z + planes[i].w < 0.0f)
+			return false;
+	return true;
+}
+bool Frustum::Intersects(const Float3& center, float radius) const
+{
+	for (uint32_t i = 0; i < 6; i++)
+		if (planes[i].x * center.x + planes[i].y * center.y + planes[i].z * center.z + planes[i].w < -radius)
+			return false;
+	return true;
+}
+bool Frustum::Intersects(const Bounds& bounds) const
+{
+	// Box is outside if its vertex furthest along the plane normal is outside:
+	for (uint32_t i = 0; i < 6; i++)
+	{
+		float distance = planes[i].x * bounds.center.x + planes[i].y * bounds.center.y + planes[i].z * bounds.center.z + planes[i].w;
+		float radius = mathf::Abs(planes[i].x) * bounds.extents.x + mathf::Abs(planes[i].y) * bounds.extents.y + mathf::Abs(planes[i].z) * bounds.extents.z;
+		if (distance + radius < 0.0f)
+			return false;
+	}
+	return true;
+}
+uint32_t Frustum::Intersects(std::span<const Bounds> bounds, std::span<uint8_t> results) const
+{
+	// Plane coefficients broadcast once, absolute values for the projected box radius:
+	simd::Register planeX[6], planeY[6], planeZ[6], planeW[6];
+	simd::Register absPlaneX[6], absPlaneY[6], absPlaneZ[6];
+	for (uint32_t i = 0; i < 6; i++)
+	{
+		planeX[i] = simd::Splat(planes[i].x);
+		planeY[i] = simd::Splat(planes[i].y);
+		planeZ[i] = simd::Splat(planes[i].z);
+		planeW[i] = simd::Splat(planes[i].w);
+		absPlaneX[i] = simd::Splat(mathf::Abs(planes[i].x));
+		absPlaneY[i] = simd::Splat(mathf::Abs(planes[i].y));
+		absPlaneZ[i] = simd::Splat(mathf::Abs(planes[i].z));
+	}
+
+	// Four boxes per iteration in structure of arrays form:
+	uint32_t intersectionCount = 0;
+	size_t count = std::min(bounds.size(), results.size());
+	size_t blockCount = count / 4;
+	for (size_t block = 0; block < blockCount; block++)
+	{
+		float cx[4], cy[4], cz[4], ex[4], ey[4], ez[4];
+		for (size_t k = 0; k < 4; k++)
+		{
+			const Bounds& box = bounds[4 * block + k];
+			cx[k] = box.center.x; cy[k] = box.center.y; cz[k] = box.center.z;
+			ex[k] = box.extents.x; ey[k] = box.extents.y; ez[k] = box.extents.z;
+		}
+		simd::Register centerX = simd::Load(cx), centerY = simd::Load(cy), centerZ = simd::Load(cz);
+		simd::Register extentX = simd::Load(ex), extentY = simd::Load(ey), extentZ = simd::Load(ez);
+
+		// Smallest signed distance of the furthest box vertex over all planes, negative = outside:
+		simd::Register minDistance = simd::Splat(FLT_MAX);
+		for (uint32_t i = 0; i < 6; i++)
+		{
+			simd::Register distance = simd::MulAdd(planeX[i], centerX, simd::MulAdd(planeY[i], centerY, simd::MulAdd(planeZ[i], centerZ, planeW[i])));
+			simd::Register radius = simd::MulAdd(absPlaneX[i], extentX, simd::MulAdd(absPlaneY[i], extentY, simd::Mul(absPlaneZ[i], extentZ)));
+			minDistance = simd::Min(minDistance, simd::Add(distance, radius));
+		}
+
+		float distances[4];
+		simd::Store(distances, minDistance);
+		for (size_t k = 0; k < 4; k++)
+		{
+			results[4 * block + k] = distances[k] >= 0.0f;
+			intersectionCount += results[4 * block + k];
+		}
+	}
+	for (size_t i = 4 * blockCount; i < count; i++)
+	{
+		results[i] = Intersects(bounds[i]);
+		intersectionCount += results[i];
+	}
+	return intersectionCount;
+}
+Frustum Frustum::ExtrudeNearPlane() const
+{
+	// Objects in front of the near plane can still cast shadows into the volume (depth clamping):
+	Frustum extruded = *this;
+	extruded.planes[4] = Float4(0.0f, 0.0f, 0.0f, 1.0f);
+	return extruded;
+}
+std::string Frustum::ToString() const
+{
+	return "Frustum(left: " + planes[0].ToString() + ", right: " + planes[1].ToString() + ", bottom: " + planes[2].ToString() + ", top: " + planes[3].ToString() + ", near: " + planes[4].ToString() + ", far: " + planes[5].ToString() + ")";
+}
\ No newline at end of file
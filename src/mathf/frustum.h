@@ -0,0 +1,39 @@
+#ifndef __INCLUDE_GUARD_frustum_h__
+#define __INCLUDE_GUARD_frustum_h__
+#include "float4.h"
+#include <span>
+#include <string>
+
+
+
+struct Bounds;
+struct Float3;
+struct Float4x4;
+
+
+
+/// <summary>
+/// Six inward facing planes (normal.xyz, distance) extracted from a view projection matrix.
+/// A point p is inside a plane if dot(normal, p) + distance >= 0.
+/// All tests are conservative: objects that are reported outside are guaranteed to be invisible.
+/// </summary>
+struct Frustum
+{
+public: // Members:
+	Float4 planes[6];	// left, right, bottom, top, near, far.
+
+public: // Methods:
+	Frustum();
+	Frustum(const Float4x4& viewProjectionMatrix);
+
+	bool Contains(const Float3& point) const;
+	bool Intersects(const Float3& center, float radius) const;
+	bool Intersects(const Bounds& bounds) const;
+	uint32_t Intersects(std::span<const Bounds> bounds, std::span<uint8_t> results) const;	// results[i] = 1 if bounds[i] intersects, returns number of intersections.
+	Frustum ExtrudeNearPlane() const;	// same frustum without near plane, i.e. extended infinitely towards the viewer.
+	std::string ToString() const;
+};
+
+
+
+#endif // __INCLUDE_GUARD_frustum_h__
\ No newline at end of file
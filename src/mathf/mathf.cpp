@@ -6,34 +6,6 @@
 namespace mathf
 {
 	// Basic math:
-	float Abs(float value)
-	{
-		return fabsf(value);
-	}
-	float Clamp(float value, float min, float max)
-	{
-		if (value < min)
-			return min;
-		if (value > max)
-			return max;
-		return value;
-	}
-	float Max(float a, float b)
-	{
-		return a > b ? a : b;
-	}
-	float Min(float a, float b)
-	{
-		return a < b ? a : b;
-	}
-	float Sign(float value)
-	{// value > 0.0f -> 1.0f, value < 0.0f -> -1.0f, value == 0.0f -> 0.0f
-		return (0.0f < value) - (value < 0.0f);
-	}
-	float Sqrt(float vlaue)
-	{
-		return sqrtf(vlaue);
-	}
 	template<int N>
 	float Factorial()
 	{
@@ -1,6 +1,7 @@
 #ifndef __INCLUDE_GUARD_mathf_h__
 #define __INCLUDE_GUARD_mathf_h__
 #include <stdint.h>
+#include <cmath>
 
 
 
@@ -38,13 +39,35 @@ namespace mathf
 	constexpr float SQRT3 = 1.73205080756887729353f;
 	constexpr float SQRT3_INV = 0.57735026918962576451f;
 
-	// Basic math:
-	float Abs(float value);
-	float Clamp(float value, float min, float max);
-	float Max(float a, float b);
-	float Min(float a, float b);
-	float Sign(float value);
-	float Sqrt(float value);
+	// Basic math (inline, as the vector types use them in their header definitions):
+	inline float Abs(float value)
+	{
+		return std::fabs(value);
+	}
+	constexpr float Clamp(float value, float min, float max)
+	{
+		if (value < min)
+			return min;
+		if (value > max)
+			return max;
+		return value;
+	}
+	constexpr float Max(float a, float b)
+	{
+		return a > b ? a : b;
+	}
+	constexpr float Min(float a, float b)
+	{
+		return a < b ? a : b;
+	}
+	constexpr float Sign(float value)
+	{// value > 0.0f -> 1.0f, value < 0.0f -> -1.0f, value == 0.0f -> 0.0f
+		return (float)((0.0f < value) - (value < 0.0f));
+	}
+	inline float Sqrt(float value)
+	{
+		return std::sqrt(value);
+	}
 	float Factorial(int n);
 
 	// Trigonometry:
@@ -72,11 +95,16 @@ namespace mathf
 #include "float3x2.h"
 #include "float3x3.h"
 #include "float4x4.h"
+#include "quaternion.h"
 
 // Geometry:
 #include "bounds.h"
+#include "frustum.h"
 #include "geometry3d.h"
 
+// Batch processing:
+#include "batch.h"
+
 // Random:
 #include "emberRandom.h"
 #endif // __INCLUDE_GUARD_mathf_h__
\ No newline at end of file
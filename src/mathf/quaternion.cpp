@@ -0,0 +1,326 @@
+#include "quaternion.h"
+#include "float3.h"
+#include "float3x3.h"
+#include "float4x4.h"
+#include "geometry3d.h"
+#include "logger.h"
+#include "simd.h"
+#include "uint3.h"
+#include <sstream>
+
+
+
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "quaternionKernels::simd requires tightly packed Quaternion.");
+
+
+
+// Active backend:
+#ifdef MATHF_SIMD_SCALAR
+namespace backend = quaternionKernels::scalar;
+#else
+namespace backend = quaternionKernels::simd;
+#endif
+
+
+
+// Constructors:
+Quaternion::Quaternion(const Float3x3& rotationMatrix)
+{
+	// Shepperd's method, branch on the largest diagonal term for numerical stability:
+	float m00 = rotationMatrix[Index2{ 0, 0 }]; float m01 = rotationMatrix[Index2{ 0, 1 }]; float m02 = rotationMatrix[Index2{ 0, 2 }];
+	float m10 = rotationMatrix[Index2{ 1, 0 }]; float m11 = rotationMatrix[Index2{ 1, 1 }]; float m12 = rotationMatrix[Index2{ 1, 2 }];
+	float m20 = rotationMatrix[Index2{ 2, 0 }]; float m21 = rotationMatrix[Index2{ 2, 1 }]; float m22 = rotationMatrix[Index2{ 2, 2 }];
+	float trace = m00 + m11 + m22;
+	if (trace > 0.0f)
+	{
+		float s = 2.0f * mathf::Sqrt(1.0f + trace);
+		x = (m21 - m12) / s;
+		y = (m02 - m20) / s;
+		z = (m10 - m01) / s;
+		w = 0.25f * s;
+	}
+	else if (m00 > m11 && m00 > m22)
+	{
+		float s = 2.0f * mathf::Sqrt(1.0f + m00 - m11 - m22);
+		x = 0.25f * s;
+		y = (m01 + m10) / s;
+		z = (m02 + m20) / s;
+		w = (m21 - m12) / s;
+	}
+	else if (m11 > m22)
+	{
+		float s = 2.0f * mathf::Sqrt(1.0f + m11 - m00 - m22);
+		x = (m01 + m10) / s;
+		y = 0.25f * s;
+		z = (m12 + m21) / s;
+		w = (m02 - m20) / s;
+	}
+	else
+	{
+		float s = 2.0f * mathf::Sqrt(1.0f + m22 - m00 - m11);
+		x = (m02 + m20) / s;
+		y = (m12 + m21) / s;
+		z = 0.25f * s;
+		w = (m10 - m01) / s;
+	}
+	*this = Normalize();
+}
+Quaternion::Quaternion(const Float4x4& rotationMatrix) : Quaternion(Float3x3(rotationMatrix)) {}
+
+
+
+// Static constructors:
+Quaternion Quaternion::RotateX(float angle)
+{
+	float halfAngle = 0.5f * angle;
+	return Quaternion(mathf::Sin(halfAngle), 0.0f, 0.0f, mathf::Cos(halfAngle));
+}
+Quaternion Quaternion::RotateY(float angle)
+{
+	float halfAngle = 0.5f * angle;
+	return Quaternion(0.0f, mathf::Sin(halfAngle), 0.0f, mathf::Cos(halfAngle));
+}
+Quaternion Quaternion::RotateZ(float angle)
+{
+	float halfAngle = 0.5f * angle;
+	return Quaternion(0.0f, 0.0f, mathf::Sin(halfAngle), mathf::Cos(halfAngle));
+}
+Quaternion Quaternion::Rotate(const Float3& axis, float angle)
+{
+	float halfAngle = 0.5f * angle;
+	float s = mathf::Sin(halfAngle);
+	Float3 normalizedAxis = axis.Normalize();
+	return Quaternion(s * normalizedAxis.x, s * normalizedAxis.y, s * normalizedAxis.z, mathf::Cos(halfAngle));
+}
+Quaternion Quaternion::Rotate(const Float3& angles, const Uint3& rotationOrder, CoordinateSystem rotationSystem)
+{
+	Quaternion rot[3] = { RotateX(angles.x), RotateY(angles.y), RotateZ(angles.z) };
+	if (rotationSystem == CoordinateSystem::local)
+		return rot[rotationOrder.x] * rot[rotationOrder.y] * rot[rotationOrder.z];
+	// (rotationSystem == CoordinateSystem::World)
+	return rot[rotationOrder.z] * rot[rotationOrder.y] * rot[rotationOrder.x];
+}
+Quaternion Quaternion::RotateFromTo(const Float3& from, const Float3& to)
+{
+	Float3 f = from.Normalize();
+	Float3 t = to.Normalize();
+	Float3 axis = Float3::Cross(f, t);
+	if (axis.IsEpsilonZero())	// parallel or antiparallel, any axis orthogonal to from works.
+		axis = geometry3d::GetOrhtogonalVector(f);
+	float angle = Float3::Angle(f, t);
+	return Rotate(axis, angle);
+}
+
+
+
+// Math operations:
+Quaternion Quaternion::Normalize() const
+{
+	return backend::Normalize(*this);
+}
+Quaternion Quaternion::Inverse() const
+{
+	float lengthSq = LengthSq();
+	if (lengthSq == 0.0f)
+	{
+		LOG_WARN("Quaternion::Inverse(), length is zero.");
+		return Quaternion(0.0f, 0.0f, 0.0f, 0.0f);
+	}
+	Quaternion conjugate = Conjugate();
+	float invLengthSq = 1.0f / lengthSq;
+	return Quaternion(conjugate.x * invLengthSq, conjugate.y * invLengthSq, conjugate.z * invLengthSq, conjugate.w * invLengthSq);
+}
+Float3x3 Quaternion::ToFloat3x3() const
+{
+	float xx = x * x; float yy = y * y; float zz = z * z;
+	float xy = x * y; float xz = x * z; float yz = y * z;
+	float wx = w * x; float wy = w * y; float wz = w * z;
+	return Float3x3::Rows
+	(1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz), 2.0f * (xz + wy),
+	 2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx),
+	 2.0f * (xz - wy), 2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy));
+}
+Float4x4 Quaternion::ToFloat4x4() const
+{
+	return Float4x4(ToFloat3x3());
+}
+bool Quaternion::IsEpsilonIdentity() const
+{
+	// q and -q represent the same rotation:
+	return mathf::Abs(w) > 1.0f - mathf::EPSILON && mathf::Abs(x) < mathf::EPSILON && mathf::Abs(y) < mathf::EPSILON && mathf::Abs(z) < mathf::EPSILON;
+}
+
+
+
+// Static math operations:
+Quaternion Quaternion::Nlerp(const Quaternion& a, const Quaternion& b, float t)
+{
+	return backend::Nlerp(a, b, t);
+}
+Quaternion Quaternion::Slerp(const Quaternion& a, const Quaternion& b, float t)
+{
+	return backend::Slerp(a, b, t);
+}
+
+
+
+// Multiplication:
+Quaternion Quaternion::operator*(const Quaternion& other) const
+{
+	return backend::Multiply(*this, other);
+}
+Quaternion& Quaternion::operator*=(const Quaternion& other)
+{
+	*this = backend::Multiply(*this, other);
+	return *this;
+}
+Float3 Quaternion::operator*(const Float3& vector) const
+{
+	// v' = v + w * t + u x t, with u = (x, y, z) and t = 2 * (u x v):
+	Float3 u(x, y, z);
+	Float3 t = 2.0f * Float3::Cross(u, vector);
+	return vector + w * t + Float3::Cross(u, t);
+}
+
+
+
+// Comparison:
+bool Quaternion::IsEpsilonEqual(const Quaternion& other) const
+{
+	return mathf::Abs(x - other.x) < mathf::EPSILON && mathf::Abs(y - other.y) < mathf::EPSILON && mathf::Abs(z - other.z) < mathf::EPSILON && mathf::Abs(w - other.w) < mathf::EPSILON;
+}
+
+
+
+// Logging:
+std::string Quaternion::ToString() const
+{
+	std::ostringstream oss;
+	oss << "(" << x << ", " << y << ", " << z << ", " << w << ")";
+	return oss.str();
+}
+std::ostream& operator<<(std::ostream& os, const Quaternion& value)
+{
+	os << value.ToString();
+	return os;
+}
+
+
+
+// Scalar kernels:
+namespace quaternionKernels::scalar
+{
+	Quaternion Multiply(const Quaternion& a, const Quaternion& b)
+	{
+		return Quaternion
+		(a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+		 a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+		 a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+		 a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+	}
+	Quaternion Normalize(const Quaternion& q)
+	{
+		float length = q.Length();
+		if (length <= mathf::EPSILON)
+			return Quaternion::identity;
+		float invLength = 1.0f / length;
+		return Quaternion(q.x * invLength, q.y * invLength, q.z * invLength, q.w * invLength);
+	}
+	Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t)
+	{
+		// Take the shorter arc, q and -q represent the same rotation:
+		float sign = Quaternion::Dot(a, b) < 0.0f ? -1.0f : 1.0f;
+		float s0 = 1.0f - t;
+		float s1 = sign * t;
+		return Normalize(Quaternion(s0 * a.x + s1 * b.x, s0 * a.y + s1 * b.y, s0 * a.z + s1 * b.z, s0 * a.w + s1 * b.w));
+	}
+	Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t)
+	{
+		float cosTheta = Quaternion::Dot(a, b);
+		float sign = 1.0f;
+		if (cosTheta < 0.0f)
+		{
+			cosTheta = -cosTheta;
+			sign = -1.0f;
+		}
+		// Nearly parallel, sin(theta) -> 0, fall back to normalized linear interpolation:
+		if (cosTheta > 1.0f - mathf::EPSILON)
+			return Nlerp(a, b, t);
+		float theta = mathf::Acos(cosTheta);
+		float invSinTheta = 1.0f / mathf::Sin(theta);
+		float s0 = mathf::Sin((1.0f - t) * theta) * invSinTheta;
+		float s1 = sign * mathf::Sin(t * theta) * invSinTheta;
+		return Quaternion(s0 * a.x + s1 * b.x, s0 * a.y + s1 * b.y, s0 * a.z + s1 * b.z, s0 * a.w + s1 * b.w);
+	}
+}
+
+
+
+// Simd kernels:
+namespace quaternionKernels::simd
+{
+	Quaternion Multiply(const Quaternion& a, const Quaternion& b)
+	{
+		// Hamilton product as a.w * b plus three sign flipped swizzles of b scaled by a.x, a.y, a.z:
+		static const float signsX[4] = { 1.0f, -1.0f, 1.0f, -1.0f };
+		static const float signsY[4] = { 1.0f, 1.0f, -1.0f, -1.0f };
+		static const float signsZ[4] = { -1.0f, 1.0f, 1.0f, -1.0f };
+		::simd::Register signX = ::simd::Load(signsX);
+		::simd::Register signY = ::simd::Load(signsY);
+		::simd::Register signZ = ::simd::Load(signsZ);
+		::simd::Register qa = ::simd::Load(&a.x);
+		::simd::Register qb = ::simd::Load(&b.x);
+		::simd::Register result = ::simd::Mul(::simd::Swizzle<3, 3, 3, 3>(qa), qb);
+		result = ::simd::MulAdd(::simd::Mul(::simd::Swizzle<0, 0, 0, 0>(qa), signX), ::simd::Swizzle<3, 2, 1, 0>(qb), result);
+		result = ::simd::MulAdd(::simd::Mul(::simd::Swizzle<1, 1, 1, 1>(qa), signY), ::simd::Swizzle<2, 3, 0, 1>(qb), result);
+		result = ::simd::MulAdd(::simd::Mul(::simd::Swizzle<2, 2, 2, 2>(qa), signZ), ::simd::Swizzle<1, 0, 3, 2>(qb), result);
+		Quaternion q;
+		::simd::Store(&q.x, result);
+		return q;
+	}
+	Quaternion Normalize(const Quaternion& q)
+	{
+		::simd::Register value = ::simd::Load(&q.x);
+		::simd::Register length = ::simd::Sqrt(::simd::Dot4(value, value));
+		float values[4];
+		::simd::Store(values, length);
+		if (values[0] <= mathf::EPSILON)
+			return Quaternion::identity;
+		Quaternion result;
+		::simd::Store(&result.x, ::simd::Div(value, length));
+		return result;
+	}
+	Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t)
+	{
+		// Take the shorter arc, q and -q represent the same rotation:
+		float sign = Quaternion::Dot(a, b) < 0.0f ? -1.0f : 1.0f;
+		::simd::Register qa = ::simd::Load(&a.x);
+		::simd::Register qb = ::simd::Load(&b.x);
+		::simd::Register result = ::simd::MulAdd(qb, ::simd::Splat(sign * t), ::simd::Mul(qa, ::simd::Splat(1.0f - t)));
+		Quaternion q;
+		::simd::Store(&q.x, result);
+		return Normalize(q);
+	}
+	Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t)
+	{
+		float cosTheta = Quaternion::Dot(a, b);
+		float sign = 1.0f;
+		if (cosTheta < 0.0f)
+		{
+			cosTheta = -cosTheta;
+			sign = -1.0f;
+		}
+		// Nearly parallel, sin(theta) -> 0, fall back to normalized linear interpolation:
+		if (cosTheta > 1.0f - mathf::EPSILON)
+			return Nlerp(a, b, t);
+		float theta = mathf::Acos(cosTheta);
+		float invSinTheta = 1.0f / mathf::Sin(theta);
+		float s0 = mathf::Sin((1.0f - t) * theta) * invSinTheta;
+		float s1 = sign * mathf::Sin(t * theta) * invSinTheta;
+		::simd::Register qa = ::simd::Load(&a.x);
+		::simd::Register qb = ::simd::Load(&b.x);
+		Quaternion q;
+		::simd::Store(&q.x, ::simd::MulAdd(qb, ::simd::Splat(s1), ::simd::Mul(qa, ::simd::Splat(s0))));
+		return q;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#ifndef __INCLUDE_GUARD_quaternion_h__
+#define __INCLUDE_GUARD_quaternion_h__
+#include "mathf.h"
+#include <string>
+#include <stdexcept>
+
+
+
+struct Float3;
+struct Float3x3;
+struct Float4x4;
+struct Uint3;
+
+
+
+/// <summary>
+/// Unit quaternion q = (x, y, z, w) = (sin(a/2) * axis, cos(a/2)), representing a rotation by angle a around axis.
+/// Composition follows the matrix convention: (q1 * q2) rotates by q2 first, then by q1,
+/// so Quaternion(m1) * Quaternion(m2) == Quaternion(m1 * m2).
+/// </summary>
+struct Quaternion
+{
+public:
+	// Members:
+	float x, y, z, w;
+
+	// Constructors:
+	constexpr Quaternion();
+	constexpr Quaternion(float x, float y, float z, float w);
+	constexpr Quaternion(const Quaternion& other) = default;
+	explicit Quaternion(const Float3x3& rotationMatrix);
+	explicit Quaternion(const Float4x4& rotationMatrix);
+
+	// Static constructors:
+	static Quaternion RotateX(float angle);
+	static Quaternion RotateY(float angle);
+	static Quaternion RotateZ(float angle);
+	static Quaternion Rotate(const Float3& axis, float angle);
+	static Quaternion Rotate(const Float3& angles, const Uint3& rotationOrder = Uint3(1, 0, 2), CoordinateSystem rotationSystem = CoordinateSystem::local);
+	static Quaternion RotateFromTo(const Float3& from, const Float3& to);
+
+	// Math operations:
+	constexpr float LengthSq() const;
+	float Length() const;
+	Quaternion Normalize() const;
+	constexpr Quaternion Conjugate() const;
+	Quaternion Inverse() const;
+	Float3x3 ToFloat3x3() const;
+	Float4x4 ToFloat4x4() const;
+	bool IsEpsilonIdentity() const;
+
+	// Static math operations:
+	static constexpr float Dot(const Quaternion& a, const Quaternion& b);
+	static Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t);
+	static Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t);
+
+	// Access:
+	constexpr float& operator[](int index);
+	constexpr float operator[](int index) const;
+
+	// Assignment:
+	constexpr Quaternion& operator=(const Quaternion& other) = default;
+	constexpr Quaternion& operator=(Quaternion&& other) noexcept = default;
+
+	// Negation:
+	constexpr Quaternion operator-() const;
+
+	// Multiplication:
+	Quaternion operator*(const Quaternion& other) const;
+	Quaternion& operator*=(const Quaternion& other);
+	Float3 operator*(const Float3& vector) const;
+
+	// Comparison:
+	bool IsEpsilonEqual(const Quaternion& other) const;
+	constexpr bool operator==(const Quaternion& other) const;
+	constexpr bool operator!=(const Quaternion& other) const;
+
+	// Logging:
+	std::string ToString() const;
+	friend std::ostream& operator<<(std::ostream& os, const Quaternion& value);
+
+	// Static members:
+	static const Quaternion identity;	// (0, 0, 0, 1).
+};
+
+
+
+// Backend kernels behind the Quaternion operations:
+// scalar = reference implementation, simd = implementation on top of simd.h.
+namespace quaternionKernels
+{
+	namespace scalar
+	{
+		Quaternion Multiply(const Quaternion& a, const Quaternion& b);
+		Quaternion Normalize(const Quaternion& q);
+		Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t);
+		Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t);
+	}
+	namespace simd
+	{
+		Quaternion Multiply(const Quaternion& a, const Quaternion& b);
+		Quaternion Normalize(const Quaternion& q);
+		Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t);
+		Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t);
+	}
+}
+
+
+
+// Inline definitions:
+// Constructors:
+constexpr Quaternion::Quaternion() : x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
+constexpr Quaternion::Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+
+
+// Math operations:
+constexpr float Quaternion::LengthSq() const
+{
+	return x * x + y * y + z * z + w * w;
+}
+inline float Quaternion::Length() const
+{
+	return mathf::Sqrt(LengthSq());
+}
+constexpr Quaternion Quaternion::Conjugate() const
+{
+	return Quaternion(-x, -y, -z, w);
+}
+
+
+
+// Static math operations:
+constexpr float Quaternion::Dot(const Quaternion& a, const Quaternion& b)
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+
+
+// Access:
+constexpr float& Quaternion::operator[](int index)
+{
+	if (index == 0) return x;
+	if (index == 1) return y;
+	if (index == 2) return z;
+	if (index == 3) return w;
+	throw std::out_of_range("Quaternion index out of range.");
+}
+constexpr float Quaternion::operator[](int index) const
+{
+	if (index == 0) return x;
+	if (index == 1) return y;
+	if (index == 2) return z;
+	if (index == 3) return w;
+	throw std::out_of_range("Quaternion index out of range.");
+}
+
+
+
+// Negation:
+constexpr Quaternion Quaternion::operator-() const
+{
+	return Quaternion(-x, -y, -z, -w);
+}
+
+
+
+// Comparison:
+constexpr bool Quaternion::operator==(const Quaternion& other) const
+{
+	return x == other.x && y == other.y && z == other.z && w == other.w;
+}
+constexpr bool Quaternion::operator!=(const Quaternion& other) const
+{
+	return !(*this == other);
+}
+
+
+
+// Static members:
+inline constexpr Quaternion Quaternion::identity = Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+
+
+
+#endif // __INCLUDE_GUARD_quaternion_h__
\ No newline at end of file
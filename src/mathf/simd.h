@@ -0,0 +1,185 @@
+#ifndef __INCLUDE_GUARD_simd_h__
+#define __INCLUDE_GUARD_simd_h__
+#include <algorithm>
+#include <cmath>
+
+
+
+// Feature toggle macros:
+//#define MATHF_FORCE_SCALAR    // enabled = scalar emulation of the simd registers, disabled = best available instruction set
+
+
+
+// Compile time backend selection:
+#if !defined(MATHF_FORCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define MATHF_SIMD_SSE
+	#include <immintrin.h>
+	#if defined(__FMA__) || defined(__AVX2__)
+		#define MATHF_SIMD_FMA
+	#endif
+#elif !defined(MATHF_FORCE_SCALAR) && (defined(__aarch64__) || defined(_M_ARM64))
+	#define MATHF_SIMD_NEON
+	#include <arm_neon.h>
+#else
+	#define MATHF_SIMD_SCALAR
+#endif
+
+
+
+// Thin 4-wide float register abstraction.
+// All kernels are written against these functions only, so adding a new instruction set means implementing this block once.
+namespace simd
+{
+#if defined(MATHF_SIMD_SSE)
+	using Register = __m128;
+
+	inline Register Load(const float* pData) { return _mm_loadu_ps(pData); }
+	inline void Store(float* pData, Register a) { _mm_storeu_ps(pData, a); }
+	inline Register Splat(float value) { return _mm_set1_ps(value); }
+	inline Register Add(Register a, Register b) { return _mm_add_ps(a, b); }
+	inline Register Sub(Register a, Register b) { return _mm_sub_ps(a, b); }
+	inline Register Mul(Register a, Register b) { return _mm_mul_ps(a, b); }
+	inline Register Div(Register a, Register b) { return _mm_div_ps(a, b); }
+	inline Register Sqrt(Register a) { return _mm_sqrt_ps(a); }
+	inline Register Min(Register a, Register b) { return _mm_min_ps(a, b); }
+	inline Register Max(Register a, Register b) { return _mm_max_ps(a, b); }
+	inline Register Greater(Register a, Register b) { return _mm_cmpgt_ps(a, b); }
+	inline Register And(Register mask, Register a) { return _mm_and_ps(mask, a); }
+	#if defined(MATHF_SIMD_FMA)
+	inline Register MulAdd(Register a, Register b, Register c) { return _mm_fmadd_ps(a, b, c); }
+	#else
+	inline Register MulAdd(Register a, Register b, Register c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+	#endif
+	template<int x, int y, int z, int w>
+	inline Register Swizzle(Register a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(w, z, y, x)); }
+	template<int x, int y, int z, int w>
+	inline Register Shuffle(Register a, Register b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x)); }
+	inline void Transpose(Register& r0, Register& r1, Register& r2, Register& r3) { _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+
+#elif defined(MATHF_SIMD_NEON)
+	using Register = float32x4_t;
+
+	inline Register Load(const float* pData) { return vld1q_f32(pData); }
+	inline void Store(float* pData, Register a) { vst1q_f32(pData, a); }
+	inline Register Splat(float value) { return vdupq_n_f32(value); }
+	inline Register Add(Register a, Register b) { return vaddq_f32(a, b); }
+	inline Register Sub(Register a, Register b) { return vsubq_f32(a, b); }
+	inline Register Mul(Register a, Register b) { return vmulq_f32(a, b); }
+	inline Register Div(Register a, Register b) { return vdivq_f32(a, b); }
+	inline Register Sqrt(Register a) { return vsqrtq_f32(a); }
+	inline Register Min(Register a, Register b) { return vminq_f32(a, b); }
+	inline Register Max(Register a, Register b) { return vmaxq_f32(a, b); }
+	inline Register Greater(Register a, Register b) { return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+	inline Register And(Register mask, Register a) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(mask), vreinterpretq_u32_f32(a))); }
+	inline Register MulAdd(Register a, Register b, Register c) { return vfmaq_f32(c, a, b); }
+	template<int x, int y, int z, int w>
+	inline Register Swizzle(Register a)
+	{
+		Register result = vdupq_n_f32(vgetq_lane_f32(a, x));
+		result = vsetq_lane_f32(vgetq_lane_f32(a, y), result, 1);
+		result = vsetq_lane_f32(vgetq_lane_f32(a, z), result, 2);
+		return vsetq_lane_f32(vgetq_lane_f32(a, w), result, 3);
+	}
+	template<int x, int y, int z, int w>
+	inline Register Shuffle(Register a, Register b)
+	{
+		Register result = vdupq_n_f32(vgetq_lane_f32(a, x));
+		result = vsetq_lane_f32(vgetq_lane_f32(a, y), result, 1);
+		result = vsetq_lane_f32(vgetq_lane_f32(b, z), result, 2);
+		return vsetq_lane_f32(vgetq_lane_f32(b, w), result, 3);
+	}
+	inline void Transpose(Register& r0, Register& r1, Register& r2, Register& r3)
+	{
+		float32x4x2_t t01 = vtrnq_f32(r0, r1);
+		float32x4x2_t t23 = vtrnq_f32(r2, r3);
+		r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+		r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+		r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+		r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+	}
+
+#else
+	struct Register
+	{
+		float v[4];
+	};
+
+	inline Register Load(const float* pData) { return Register{ pData[0], pData[1], pData[2], pData[3] }; }
+	inline void Store(float* pData, Register a) { pData[0] = a.v[0]; pData[1] = a.v[1]; pData[2] = a.v[2]; pData[3] = a.v[3]; }
+	inline Register Splat(float value) { return Register{ value, value, value, value }; }
+	inline Register Add(Register a, Register b) { return Register{ a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] }; }
+	inline Register Sub(Register a, Register b) { return Register{ a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] }; }
+	inline Register Mul(Register a, Register b) { return Register{ a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] }; }
+	inline Register Div(Register a, Register b) { return Register{ a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] }; }
+	inline Register Sqrt(Register a) { return Register{ std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3]) }; }
+	inline Register Min(Register a, Register b) { return Register{ std::min(a.v[0], b.v[0]), std::min(a.v[1], b.v[1]), std::min(a.v[2], b.v[2]), std::min(a.v[3], b.v[3]) }; }
+	inline Register Max(Register a, Register b) { return Register{ std::max(a.v[0], b.v[0]), std::max(a.v[1], b.v[1]), std::max(a.v[2], b.v[2]), std::max(a.v[3], b.v[3]) }; }
+	inline Register Greater(Register a, Register b) { return Register{ a.v[0] > b.v[0] ? 1.0f : 0.0f, a.v[1] > b.v[1] ? 1.0f : 0.0f, a.v[2] > b.v[2] ? 1.0f : 0.0f, a.v[3] > b.v[3] ? 1.0f : 0.0f }; }
+	inline Register And(Register mask, Register a) { return Register{ mask.v[0] != 0.0f ? a.v[0] : 0.0f, mask.v[1] != 0.0f ? a.v[1] : 0.0f, mask.v[2] != 0.0f ? a.v[2] : 0.0f, mask.v[3] != 0.0f ? a.v[3] : 0.0f }; }
+	inline Register MulAdd(Register a, Register b, Register c) { return Add(Mul(a, b), c); }
+	template<int x, int y, int z, int w>
+	inline Register Swizzle(Register a) { return Register{ a.v[x], a.v[y], a.v[z], a.v[w] }; }
+	template<int x, int y, int z, int w>
+	inline Register Shuffle(Register a, Register b) { return Register{ a.v[x], a.v[y], b.v[z], b.v[w] }; }
+	inline void Transpose(Register& r0, Register& r1, Register& r2, Register& r3)
+	{
+		Register t0 = { r0.v[0], r1.v[0], r2.v[0], r3.v[0] };
+		Register t1 = { r0.v[1], r1.v[1], r2.v[1], r3.v[1] };
+		Register t2 = { r0.v[2], r1.v[2], r2.v[2], r3.v[2] };
+		Register t3 = { r0.v[3], r1.v[3], r2.v[3], r3.v[3] };
+		r0 = t0; r1 = t1; r2 = t2; r3 = t3;
+	}
+#endif
+
+	// Backend independent helpers:
+	inline Register Cross3(Register a, Register b)
+	{
+		// Only xyz lanes are meaningful, w lane is undefined.
+		Register aYzx = Swizzle<1, 2, 0, 3>(a);
+		Register bYzx = Swizzle<1, 2, 0, 3>(b);
+		return Swizzle<1, 2, 0, 3>(Sub(Mul(a, bYzx), Mul(aYzx, b)));
+	}
+	inline float Dot3(Register a, Register b)
+	{
+		float result[4];
+		Store(result, Mul(a, b));
+		return result[0] + result[1] + result[2];
+	}
+	inline Register Dot4(Register a, Register b)
+	{
+		// Result is broadcast to all four lanes.
+		Register product = Mul(a, b);
+		Register sum = Add(product, Swizzle<1, 0, 3, 2>(product));
+		return Add(sum, Swizzle<2, 3, 0, 1>(sum));
+	}
+	inline float HorizontalMin(Register a)
+	{
+		float values[4];
+		Store(values, a);
+		return std::min(std::min(values[0], values[1]), std::min(values[2], values[3]));
+	}
+	inline float HorizontalMax(Register a)
+	{
+		float values[4];
+		Store(values, a);
+		return std::max(std::max(values[0], values[1]), std::max(values[2], values[3]));
+	}
+
+	// Four interleaved xyz triplets (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) to/from structure of arrays (x0 x1 x2 x3 | y0.. | z0..):
+	inline void Deinterleave3(Register r0, Register r1, Register r2, Register& x, Register& y, Register& z)
+	{
+		x = Shuffle<0, 1, 0, 2>(Shuffle<0, 3, 0, 0>(r0, r0), Shuffle<2, 2, 1, 1>(r1, r2));
+		y = Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 0, 0>(r0, r1), Shuffle<3, 3, 2, 2>(r1, r2));
+		z = Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 1, 1>(r0, r1), Shuffle<0, 0, 3, 3>(r2, r2));
+	}
+	inline void Interleave3(Register x, Register y, Register z, Register& r0, Register& r1, Register& r2)
+	{
+		r0 = Shuffle<0, 2, 0, 2>(Shuffle<0, 0, 0, 0>(x, y), Shuffle<0, 0, 1, 1>(z, x));
+		r1 = Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 1, 1>(y, z), Shuffle<2, 2, 2, 2>(x, y));
+		r2 = Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 3, 3>(z, x), Shuffle<3, 3, 3, 3>(y, z));
+	}
+}
+
+
+
+#endif // __INCLUDE_GUARD_simd_h__
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "shadingPipeline.h"
+#include "frameData.h"
 #include "mesh.h"
 #include "renderPass.h"
 #include "renderPassManager.h"
@@ -56,8 +57,10 @@ void ShadingPipeline::CreatePipelineLayout(const std::vector<VkDescriptorSetLayo
 
     // Pipeline layout:
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
-    pipelineLayoutCreateInfo.setLayoutCount = 1;
-    pipelineLayoutCreateInfo.pSetLayouts = &m_descriptorSetLayout;
+    // Set 0 = global FrameData, set 1 = per object resources:
+    VkDescriptorSetLayout descriptorSetLayouts[2] = { FrameData::GetVkDescriptorSetLayout(), m_descriptorSetLayout };
+    pipelineLayoutCreateInfo.setLayoutCount = 2;
+    pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts;
     pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
     pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
     vkCreatePipelineLayout(m_pContext->GetVkDevice(), &pipelineLayoutCreateInfo, nullptr, &m_pipelineLayout);
@@ -182,5 +185,5 @@ void ShadingPipeline::CreatePipeline(const VkShaderModule& vertexShaderModule, c
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;       // can be used to create a new pipeline based on an existing one
 	pipelineInfo.basePipelineIndex = -1;					// do not inherit from existing pipeline
 
-    VKA(vkCreateGraphicsPipelines(m_pContext->GetVkDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+    VKA(vkCreateGraphicsPipelines(m_pContext->GetVkDevice(), m_pContext->GetVkPipelineCache(), 1, &pipelineInfo, nullptr, &m_pipeline));
 }
\ No newline at end of file
@@ -42,7 +42,7 @@ void ShadingRenderPass::CreateRenderPass()
 	std::array<VkAttachmentDescription, 3> attachments{};
 	{
 		// Multisampled color attachment description:
-		attachments[0].format = m_pContext->pSurface->GetVkSurfaceFormatKHR().format;
+		attachments[0].format = m_pContext->GetRenderFormat();
 		attachments[0].samples = m_pContext->msaaSamples;							// multisampling count
 		attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;					// clear framebuffer to black before rendering
 		attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;				// no need to store multisampls after render
@@ -62,14 +62,14 @@ void ShadingRenderPass::CreateRenderPass()
 		attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
 		// Color resolve attachment description: (resolve multisampled fragments)
-		attachments[2].format = m_pContext->pSurface->GetVkSurfaceFormatKHR().format;
+		attachments[2].format = m_pContext->GetRenderFormat();
 		attachments[2].samples = VK_SAMPLE_COUNT_1_BIT;
 		attachments[2].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 		attachments[2].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 		attachments[2].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 		attachments[2].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 		attachments[2].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-		attachments[2].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;	// rdy for presenting
+		attachments[2].finalLayout = m_pContext->IsHeadless() ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;	// rdy for presenting or readback
 	}
 
 	// Attachment references:
@@ -125,12 +125,12 @@ void ShadingRenderPass::CreateMsaaImage()
 	VkImageCreateInfo* pImageInfo = new VkImageCreateInfo();
 	pImageInfo->sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 	pImageInfo->imageType = VK_IMAGE_TYPE_2D;
-	pImageInfo->extent.width = m_pContext->pSurface->GetCurrentExtent().width;
-	pImageInfo->extent.height = m_pContext->pSurface->GetCurrentExtent().height;
+	pImageInfo->extent.width = m_pContext->GetRenderExtent().width;
+	pImageInfo->extent.height = m_pContext->GetRenderExtent().height;
 	pImageInfo->extent.depth = 1;
 	pImageInfo->mipLevels = 1;
 	pImageInfo->arrayLayers = 1;
-	pImageInfo->format = m_pContext->pSurface->GetVkSurfaceFormatKHR().format;
+	pImageInfo->format = m_pContext->GetRenderFormat();
 	pImageInfo->tiling = VK_IMAGE_TILING_OPTIMAL;
 	pImageInfo->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 	pImageInfo->usage = VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
@@ -158,8 +158,8 @@ void ShadingRenderPass::CreateDepthImage()
 	VkImageCreateInfo* pImageInfo = new VkImageCreateInfo();
 	pImageInfo->sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 	pImageInfo->imageType = VK_IMAGE_TYPE_2D;
-	pImageInfo->extent.width = m_pContext->pSurface->GetCurrentExtent().width;
-	pImageInfo->extent.height = m_pContext->pSurface->GetCurrentExtent().height;
+	pImageInfo->extent.width = m_pContext->GetRenderExtent().width;
+	pImageInfo->extent.height = m_pContext->GetRenderExtent().height;
 	pImageInfo->extent.depth = 1;
 	pImageInfo->mipLevels = 1;
 	pImageInfo->arrayLayers = 1;
@@ -206,8 +206,9 @@ void ShadingRenderPass::CreateDepthImage()
 }
 void ShadingRenderPass::CreateFrameBuffers()
 {
-	size_t size = m_pContext->pSwapchain->GetImages().size();
-	VkExtent2D extent = m_pContext->pSurface->GetCurrentExtent();
+	const std::vector<VkImageView>& targetImageViews = m_pContext->GetRenderTargetImageViews();
+	size_t size = targetImageViews.size();
+	VkExtent2D extent = m_pContext->GetRenderExtent();
 	m_framebuffers.resize(size);
 	std::array<VkImageView, 3> attachments;
 
@@ -216,7 +217,7 @@ void ShadingRenderPass::CreateFrameBuffers()
 		// order of attachments is important!
 		attachments[0] = m_msaaImage->GetVkImageView();
 		attachments[1] = m_depthImage->GetVkImageView();
-		attachments[2] = m_pContext->pSwapchain->GetImageViews()[i];
+		attachments[2] = targetImageViews[i];
 
 		VkFramebufferCreateInfo framebufferInfo = { VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO };
 		framebufferInfo.renderPass = m_renderPass;
@@ -1,12 +1,14 @@
 #include "shadowPipeline.h"
+#include "frameData.h"
 #include "mesh.h"
+#include "pointShadowPushConstant.h"
 #include "renderPass.h"
 #include "renderPassManager.h"
 #include "shadowPushConstant.h"
-#include "shadowRenderPass.h"
 #include "spirvReflect.h"
 #include "vulkanContext.h"
 #include "vulkanMacros.h"
+#include <algorithm>
 
 
 
@@ -50,12 +52,14 @@ void ShadowPipeline::CreatePipelineLayout(const std::vector<VkDescriptorSetLayou
     VkPushConstantRange pushConstantRange = {};
     pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
     pushConstantRange.offset = 0;
-    pushConstantRange.size = sizeof(ShadowPushConstant);
+    pushConstantRange.size = static_cast<uint32_t>(std::max(sizeof(ShadowPushConstant), sizeof(PointShadowPushConstant)));
 
     // Pipeline layout:
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
-    pipelineLayoutCreateInfo.setLayoutCount = 1;
-    pipelineLayoutCreateInfo.pSetLayouts = &m_descriptorSetLayout;
+    // Set 0 = global FrameData (point light data of the single pass point light shadows), set 1 = per object resources:
+    VkDescriptorSetLayout descriptorSetLayouts[2] = { FrameData::GetVkDescriptorSetLayout(), m_descriptorSetLayout };
+    pipelineLayoutCreateInfo.setLayoutCount = 2;
+    pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts;
     pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
     pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
     vkCreatePipelineLayout(m_pContext->GetVkDevice(), &pipelineLayoutCreateInfo, nullptr, &m_pipelineLayout);
@@ -79,22 +83,10 @@ void ShadowPipeline::CreatePipeline(const VkShaderModule& vertexShaderModule, co
     VkPipelineInputAssemblyStateCreateInfo inputAssemblyState = { VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO };
     inputAssemblyState.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
 
-    // Viewports and scissors:
-    VkViewport viewport = {};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = static_cast<float>(ShadowRenderPass::s_shadowMapWidth);
-    viewport.height = static_cast<float>(ShadowRenderPass::s_shadowMapHeight);
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-    VkRect2D scissor = {};
-    scissor.offset = { 0, 0 };
-    scissor.extent = VkExtent2D{ ShadowRenderPass::s_shadowMapWidth, ShadowRenderPass::s_shadowMapHeight };
+    // Viewports and scissors are dynamic, every shadow map is rendered into its own tile of the shadow atlas:
     VkPipelineViewportStateCreateInfo viewportState = { VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO };
     viewportState.viewportCount = 1;
-    viewportState.pViewports = &viewport;
     viewportState.scissorCount = 1;
-    viewportState.pScissors = &scissor;
 
     // Rasterization:
     VkPipelineRasterizationStateCreateInfo rasterizationState = { VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO };
@@ -137,6 +129,12 @@ void ShadowPipeline::CreatePipeline(const VkShaderModule& vertexShaderModule, co
     VkPipelineColorBlendStateCreateInfo colorBlendState = { VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO };
     colorBlendState.attachmentCount = 0;	// no color blending for shadow mapping
 
+    // Dynamic states, can be changed without recreating the pipeline:
+    std::vector<VkDynamicState> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+    VkPipelineDynamicStateCreateInfo dynamicState = { VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO };
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicState.pDynamicStates = dynamicStates.data();
+
     VkGraphicsPipelineCreateInfo pipelineInfo = { VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO };
     pipelineInfo.stageCount = 1;								// only vertex shaders
     pipelineInfo.pStages = &vertexShaderStageInfo;				// shader stages pointer (only vertex shader)
@@ -147,12 +145,12 @@ void ShadowPipeline::CreatePipeline(const VkShaderModule& vertexShaderModule, co
     pipelineInfo.pMultisampleState = &multisampleState;			// Multisampling
     pipelineInfo.pDepthStencilState = &depthState;			// Depth and stencil testing
     pipelineInfo.pColorBlendState = &colorBlendState;			// Color blending
-    pipelineInfo.pDynamicState = nullptr;						// no dynamic states	
+    pipelineInfo.pDynamicState = &dynamicState;				// Dynamic states
     pipelineInfo.layout = m_pipelineLayout;
     pipelineInfo.renderPass = RenderPassManager::GetRenderPass("shadowRenderPass")->GetVkRenderPass();
     pipelineInfo.subpass = 0;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
     pipelineInfo.basePipelineIndex = -1;
 
-    VKA(vkCreateGraphicsPipelines(m_pContext->GetVkDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+    VKA(vkCreateGraphicsPipelines(m_pContext->GetVkDevice(), m_pContext->GetVkPipelineCache(), 1, &pipelineInfo, nullptr, &m_pipeline));
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "shadowRenderPass.h"
+#include "logger.h"
 #include "macros.h"
+#include "shadowCascade.h"
 #include "texture2d.h"
 #include "vmaImage.h"
 #include "vulkanContext.h"
@@ -8,16 +10,16 @@
 
 
 // static members:
-uint32_t ShadowRenderPass::s_shadowMapWidth = 1024;
-uint32_t ShadowRenderPass::s_shadowMapHeight = 1024;
-uint32_t ShadowRenderPass::s_layerCount = MAX_D_LIGHTS + MAX_S_LIGHTS + 6 * MAX_P_LIGHTS;
+VkFormat ShadowRenderPass::s_shadowMapFormat = VK_FORMAT_D32_SFLOAT;
+uint32_t ShadowRenderPass::s_shadowMapCount = ShadowCascadeSolver::s_maxCascadeCount * MAX_D_LIGHTS + MAX_S_LIGHTS + 6 * MAX_P_LIGHTS;
 
 
 
 // Constructor/Destructor:
-ShadowRenderPass::ShadowRenderPass(VulkanContext* pContext)
+ShadowRenderPass::ShadowRenderPass(VulkanContext* pContext) : m_atlas(ShadowAtlas::s_minAtlasSize)
 {
 	m_pContext = pContext;
+	m_underusedFrames = 0;
 
 	CreateShadowMapTexture();
 	CreateRenderpass();
@@ -31,10 +33,51 @@ ShadowRenderPass::~ShadowRenderPass()
 
 
 // Public methods:
+/// <summary>
+/// Assigns an atlas tile to every request. If the requests need a larger atlas, or have fit into a smaller one for
+/// s_shrinkFrameCount frames, the atlas is recreated, which waits for the device to be idle and invalidates all tiles.
+/// Returns true in that case, descriptors and framebuffers referring to the old atlas must be updated.
+/// </summary>
+bool ShadowRenderPass::AllocateTiles(std::vector<ShadowTileRequest>& requests)
+{
+	// Shrinking waits a while, so lights that come and go do not recreate the atlas every few frames:
+	uint32_t requiredSize = ShadowAtlas::GetRequiredSize(requests);
+	uint32_t size = m_atlas.GetSize();
+	m_underusedFrames = requiredSize < size ? m_underusedFrames + 1 : 0;
+	bool resize = requiredSize > size || m_underusedFrames >= s_shrinkFrameCount;
+	if (resize)
+	{
+		LOG_TRACE("Shadow atlas {} from {} to {} texels.", requiredSize > size ? "grows" : "shrinks", size, requiredSize);
+		m_underusedFrames = 0;
+		m_pContext->WaitDeviceIdle();
+		DestroyFramebuffers();
+		m_atlas.Reset(requiredSize);
+		CreateShadowMapTexture();
+		CreateFramebuffers();
+	}
+	m_atlas.Allocate(requests);
+	return resize;
+}
+
+
+
+// Getters:
 Texture2d* const ShadowRenderPass::GetShadowMaps() const
 {
 	return m_shadowMaps.get();
 }
+ShadowAtlas& ShadowRenderPass::GetAtlas()
+{
+	return m_atlas;
+}
+const ShadowAtlas& ShadowRenderPass::GetAtlas() const
+{
+	return m_atlas;
+}
+uint32_t ShadowRenderPass::GetAtlasSize() const
+{
+	return m_atlas.GetSize();
+}
 
 
 
@@ -47,18 +90,18 @@ void ShadowRenderPass::CreateShadowMapTexture()
 	pSubresourceRange->baseMipLevel = 0;
 	pSubresourceRange->levelCount = 1;
 	pSubresourceRange->baseArrayLayer = 0;
-	pSubresourceRange->layerCount = s_layerCount;
+	pSubresourceRange->layerCount = 1;
 
 	// Image info:
 	VkImageCreateInfo* pImageInfo = new VkImageCreateInfo();
 	pImageInfo->sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 	pImageInfo->imageType = VK_IMAGE_TYPE_2D;
-	pImageInfo->extent.width = s_shadowMapWidth;
-	pImageInfo->extent.height = s_shadowMapHeight;
+	pImageInfo->extent.width = m_atlas.GetSize();
+	pImageInfo->extent.height = m_atlas.GetSize();
 	pImageInfo->extent.depth = 1;
 	pImageInfo->mipLevels = 1;
-	pImageInfo->arrayLayers = s_layerCount;
-	pImageInfo->format = m_shadowMapFormat;
+	pImageInfo->arrayLayers = 1;
+	pImageInfo->format = s_shadowMapFormat;
 	pImageInfo->tiling = VK_IMAGE_TILING_OPTIMAL;
 	pImageInfo->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 	pImageInfo->usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
@@ -74,19 +117,20 @@ void ShadowRenderPass::CreateShadowMapTexture()
 	pAllocationInfo->preferredFlags = 0;
 
 	VmaImage* image = new VmaImage(m_pContext, pImageInfo, pAllocationInfo, pSubresourceRange);
+	image->TransitionLayoutUndefinedToShaderRead();	// layout the render pass expects, tiles are cleared when rendered
 	m_shadowMaps = std::make_unique<Texture2d>(m_pContext, image, "shadowMaps");
 }
 void ShadowRenderPass::CreateRenderpass()
 {
 	// Attachment description:
 	VkAttachmentDescription attachment = {};
-	attachment.format = m_shadowMapFormat;
+	attachment.format = s_shadowMapFormat;
 	attachment.samples = VK_SAMPLE_COUNT_1_BIT;
-	attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;					// clear framebuffer to black before rendering
+	attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;						// keep cached tiles, rendered tiles are cleared individually
 	attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;					// store for later render passes
 	attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;			// do not use stencils
 	attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;		// do not use stencils
-	attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;				// we don't care about initial layout of the image
+	attachment.initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;	// read by the shading pass of the previous frame
 	attachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;	// will be read in a shader
 
 	// Attachment reference:
@@ -117,9 +161,15 @@ void ShadowRenderPass::CreateFramebuffers()
 		framebufferInfo.renderPass = m_renderPass;
 		framebufferInfo.attachmentCount = 1;
 		framebufferInfo.pAttachments = &m_shadowMaps->GetVmaImage()->GetVkImageView();
-		framebufferInfo.width = s_shadowMapWidth;
-		framebufferInfo.height = s_shadowMapHeight;
-		framebufferInfo.layers = s_layerCount;
+		framebufferInfo.width = m_atlas.GetSize();
+		framebufferInfo.height = m_atlas.GetSize();
+		framebufferInfo.layers = 1;
 		vkCreateFramebuffer(m_pContext->GetVkDevice(), &framebufferInfo, nullptr, &m_framebuffers[i]);
 	}
+}
+void ShadowRenderPass::DestroyFramebuffers()
+{
+	for (VkFramebuffer framebuffer : m_framebuffers)
+		vkDestroyFramebuffer(m_pContext->GetVkDevice(), framebuffer, nullptr);
+	m_framebuffers.clear();
 }
\ No newline at end of file
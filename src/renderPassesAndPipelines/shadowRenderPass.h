@@ -1,6 +1,7 @@
 #ifndef __INCLUDE_GUARD_shadowRenderPass_h__
 #define __INCLUDE_GUARD_shadowRenderPass_h__
 #include "renderPass.h"
+#include "shadowAtlas.h"
 #include <memory>
 #include <vulkan/vulkan.h>
 
@@ -14,28 +15,39 @@ struct VulkanContext;
 
 /// <summary>
 /// Shadow render pass.
-/// Executed once for every light source.
+/// All shadow maps are tiles of a single depth texture (shadow atlas), each rendered with its own viewport.
+/// The atlas is loaded, not cleared, so tiles that are not rendered in a frame keep their content.
+/// The atlas starts at ShadowAtlas::s_minAtlasSize and grows with the requested tiles up to ShadowAtlas::s_maxAtlasSize.
+/// It shrinks again once the requests have fit into a smaller atlas for s_shrinkFrameCount consecutive frames.
 /// </summary>
 class ShadowRenderPass : public RenderPass
 {
 private: // Members:
 	std::unique_ptr<Texture2d> m_shadowMaps;
-	VkFormat m_shadowMapFormat = VK_FORMAT_D32_SFLOAT;
+	ShadowAtlas m_atlas;
+	uint32_t m_underusedFrames;	// consecutive frames in which the requests fit into a smaller atlas
+	static constexpr uint32_t s_shrinkFrameCount = 300;
 
 public: // Members:
-	static uint32_t s_shadowMapWidth;
-	static uint32_t s_shadowMapHeight;
-	static uint32_t s_layerCount;
+	static VkFormat s_shadowMapFormat;	// VK_FORMAT_D32_SFLOAT or VK_FORMAT_D16_UNORM, must be set before the render pass is created
+	static uint32_t s_shadowMapCount;	// maximum number of shadow maps (atlas tiles) per frame
 
 public: // Methods:
 	ShadowRenderPass(VulkanContext* pContext);
 	~ShadowRenderPass();
+	bool AllocateTiles(std::vector<ShadowTileRequest>& requests);
+
+	// Getters:
 	Texture2d* const GetShadowMaps() const;
+	ShadowAtlas& GetAtlas();
+	const ShadowAtlas& GetAtlas() const;
+	uint32_t GetAtlasSize() const;
 
 private: // Methods:
 	void CreateShadowMapTexture();
 	void CreateRenderpass();
 	void CreateFramebuffers();
+	void DestroyFramebuffers();
 };
 
 
@@ -0,0 +1,276 @@
+#include "frameData.h"
+#include "camera.h"
+#include "directionalLight.h"
+#include "pointLight.h"
+#include "renderPassManager.h"
+#include "sampler.h"
+#include "samplerManager.h"
+#include "scene.h"
+#include "shadowRenderPass.h"
+#include "spotLight.h"
+#include "texture2d.h"
+#include "vmaBuffer.h"
+#include "vmaImage.h"
+#include "vulkanContext.h"
+#include "vulkanMacros.h"
+#include <array>
+#include <cstring>
+
+
+
+// Static members:
+bool FrameData::s_isInitialized = false;
+VulkanContext* FrameData::s_pContext;
+VkDescriptorSetLayout FrameData::s_descriptorSetLayout = VK_NULL_HANDLE;
+std::vector<VkDescriptorSet> FrameData::s_descriptorSets;
+std::vector<std::unique_ptr<VmaBuffer>> FrameData::s_cameraBuffers;
+std::vector<std::unique_ptr<VmaBuffer>> FrameData::s_lightBuffers;
+std::vector<CameraData*> FrameData::s_pCameraData;
+std::vector<LightData*> FrameData::s_pLightData;
+
+
+
+// Initialization and cleanup:
+void FrameData::Init(VulkanContext* pContext)
+{
+	if (s_isInitialized)
+		return;
+
+	s_isInitialized = true;
+	s_pContext = pContext;
+
+	CreateDescriptorSetLayout();
+	CreateBuffers();
+	CreateDescriptorSets();
+}
+void FrameData::Clear()
+{
+	s_pContext->WaitDeviceIdle();
+	s_pCameraData.clear();
+	s_pLightData.clear();
+	s_cameraBuffers.clear();
+	s_lightBuffers.clear();
+	s_descriptorSets.clear();	// freed together with the descriptor pool
+	vkDestroyDescriptorSetLayout(s_pContext->GetVkDevice(), s_descriptorSetLayout, nullptr);
+	s_descriptorSetLayout = VK_NULL_HANDLE;
+	s_isInitialized = false;
+}
+
+
+
+// Per frame update:
+/// <summary>
+/// Writes camera and light data of the active scene into the buffers of the current frameIndex.
+/// Light matrices are computed once here instead of once per draw call.
+/// Shadow atlas tiles must already be rendered for this frame, reused tiles are sampled with the matrix they were rendered with.
+/// </summary>
+void FrameData::Update(Scene* pScene)
+{
+	uint32_t frameIndex = s_pContext->frameIndex;
+	const ShadowAtlas& shadowAtlas = dynamic_cast<ShadowRenderPass*>(RenderPassManager::GetRenderPass("shadowRenderPass"))->GetAtlas();
+	auto getShadowMatrix = [&shadowAtlas](const void* pLight, uint32_t face, const Float4x4& worldToClipMatrix)
+	{
+		const ShadowTileContent* pContent = shadowAtlas.GetContent(pLight, face);
+		return pContent != nullptr ? pContent->worldToClipMatrix : worldToClipMatrix;
+	};
+
+	Camera* pCamera = pScene->GetActiveCamera();
+	CameraData cameraData = {};
+	cameraData.viewMatrix = pCamera->GetViewMatrix();
+	cameraData.projMatrix = pCamera->GetProjectionMatrix();
+	cameraData.worldToClipMatrix = cameraData.projMatrix * cameraData.viewMatrix;
+	memcpy(s_pCameraData[frameIndex], &cameraData, sizeof(CameraData));
+
+	// Unused light slots stay zero, i.e. black:
+	LightData lightData = {};
+	const std::array<DirectionalLight*, MAX_D_LIGHTS>& directionalLights = pScene->GetDirectionalLights();
+	for (uint32_t i = 0; i < MAX_D_LIGHTS; i++)
+		if (directionalLights[i] != nullptr)
+		{
+			// Same views as VulkanRenderer::CollectShadowViews(), one per solved cascade or the light's own projection:
+			DirectionalLightData& data = lightData.directionalLightData[i];
+			uint32_t cascadeCount = directionalLights[i]->GetSolvedShadowCascadeCount();
+			if (cascadeCount == 0)
+			{
+				data.cascadeCount = 1;
+				data.worldToClipMatrix[0] = getShadowMatrix(directionalLights[i], 0, directionalLights[i]->GetProjectionMatrix() * directionalLights[i]->GetViewMatrix());
+				data.shadowAtlasRect[0] = shadowAtlas.GetUvRect(directionalLights[i], 0);
+			}
+			else
+			{
+				data.cascadeCount = cascadeCount;
+				for (uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; cascadeIndex++)
+				{
+					data.worldToClipMatrix[cascadeIndex] = getShadowMatrix(directionalLights[i], cascadeIndex, directionalLights[i]->GetShadowCascade(cascadeIndex).worldToClipMatrix);
+					data.shadowAtlasRect[cascadeIndex] = shadowAtlas.GetUvRect(directionalLights[i], cascadeIndex);
+				}
+			}
+			data.direction = directionalLights[i]->GetDirection();
+			data.colorIntensity = directionalLights[i]->GetColorIntensity();
+		}
+	const std::array<SpotLight*, MAX_S_LIGHTS>& spotLights = pScene->GetSpotLights();
+	for (uint32_t i = 0; i < MAX_S_LIGHTS; i++)
+		if (spotLights[i] != nullptr)
+		{
+			SpotLightData& data = lightData.spotLightData[i];
+			data.worldToClipMatrix = getShadowMatrix(spotLights[i], 0, spotLights[i]->GetProjectionMatrix() * spotLights[i]->GetViewMatrix());
+			data.position = spotLights[i]->GetPosition();
+			data.colorIntensity = spotLights[i]->GetColorIntensity();
+			data.blendStartEnd = spotLights[i]->GetBlendStartEnd();
+			data.shadowAtlasRect = shadowAtlas.GetUvRect(spotLights[i], 0);
+		}
+	const std::array<PointLight*, MAX_P_LIGHTS>& pointLights = pScene->GetPointLights();
+	for (uint32_t i = 0; i < MAX_P_LIGHTS; i++)
+		if (pointLights[i] != nullptr)
+		{
+			PointLightData& data = lightData.pointLightData[i];
+			Float4x4 projectionMatrix = pointLights[i]->GetProjectionMatrix();
+			for (uint32_t faceIndex = 0; faceIndex < 6; faceIndex++)
+			{
+				data.worldToClipMatrix[faceIndex] = getShadowMatrix(pointLights[i], faceIndex, projectionMatrix * pointLights[i]->GetViewMatrix(faceIndex));
+				data.shadowAtlasRect[faceIndex] = shadowAtlas.GetUvRect(pointLights[i], faceIndex);
+			}
+			data.position = pointLights[i]->GetPosition();
+			data.colorIntensity = pointLights[i]->GetColorIntensity();
+		}
+	memcpy(s_pLightData[frameIndex], &lightData, sizeof(LightData));
+}
+/// <summary>
+/// Points the descriptor sets of all frames to the current shadow atlas. Only call while the device is idle.
+/// </summary>
+void FrameData::UpdateShadowMapDescriptors()
+{
+	ShadowRenderPass* pShadowRenderPass = dynamic_cast<ShadowRenderPass*>(RenderPassManager::GetRenderPass("shadowRenderPass"));
+	VkDescriptorImageInfo imageInfo = {};
+	imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	imageInfo.imageView = pShadowRenderPass->GetShadowMaps()->GetVmaImage()->GetVkImageView();
+
+	for (uint32_t frameIndex = 0; frameIndex < s_pContext->framesInFlight; frameIndex++)
+	{
+		VkWriteDescriptorSet descriptorWrite = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+		descriptorWrite.dstSet = s_descriptorSets[frameIndex];
+		descriptorWrite.dstBinding = 3;
+		descriptorWrite.dstArrayElement = 0;
+		descriptorWrite.descriptorCount = 1;
+		descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		descriptorWrite.pImageInfo = &imageInfo;
+		vkUpdateDescriptorSets(s_pContext->GetVkDevice(), 1, &descriptorWrite, 0, nullptr);
+	}
+}
+
+
+
+// Getters:
+const VkDescriptorSetLayout& FrameData::GetVkDescriptorSetLayout()
+{
+	return s_descriptorSetLayout;
+}
+const VkDescriptorSet* const FrameData::GetDescriptorSets(uint32_t frameIndex)
+{
+	return &s_descriptorSets[frameIndex];
+}
+
+
+
+// Private methods:
+void FrameData::CreateDescriptorSetLayout()
+{
+	// Must match the register(xN, space0) declarations in frameData.hlsli:
+	std::array<VkDescriptorSetLayoutBinding, 4> bindings = {};
+	VkDescriptorType types[4] = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_SAMPLER, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE };
+	for (uint32_t i = 0; i < bindings.size(); i++)
+	{
+		bindings[i].binding = i;
+		bindings[i].descriptorType = types[i];
+		bindings[i].descriptorCount = 1;
+		bindings[i].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+		bindings[i].pImmutableSamplers = nullptr;
+	}
+
+	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+	descriptorSetLayoutCreateInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+	descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+	VKA(vkCreateDescriptorSetLayout(s_pContext->GetVkDevice(), &descriptorSetLayoutCreateInfo, nullptr, &s_descriptorSetLayout));
+}
+void FrameData::CreateBuffers()
+{
+	// Persistently mapped uniform buffers, one pair per frame in flight:
+	auto createBuffer = [](uint64_t size, void*& pMappedData)
+	{
+		VkBufferCreateInfo* pBufferInfo = new VkBufferCreateInfo();
+		pBufferInfo->sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		pBufferInfo->size = size;
+		pBufferInfo->usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+		pBufferInfo->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VmaAllocationCreateInfo* pAllocInfo = new VmaAllocationCreateInfo();
+		pAllocInfo->usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+		pAllocInfo->flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+		pAllocInfo->requiredFlags = 0;
+		pAllocInfo->preferredFlags = 0;
+
+		std::unique_ptr<VmaBuffer> buffer = std::make_unique<VmaBuffer>(s_pContext, pBufferInfo, pAllocInfo);
+		VmaAllocationInfo info;
+		vmaGetAllocationInfo(s_pContext->GetVmaAllocator(), buffer->GetVmaAllocation(), &info);
+		pMappedData = info.pMappedData;
+		memset(pMappedData, 0, size);
+		return buffer;
+	};
+
+	for (uint32_t frameIndex = 0; frameIndex < s_pContext->framesInFlight; frameIndex++)
+	{
+		void* pCameraData;
+		void* pLightData;
+		s_cameraBuffers.push_back(createBuffer(sizeof(CameraData), pCameraData));
+		s_lightBuffers.push_back(createBuffer(sizeof(LightData), pLightData));
+		s_pCameraData.push_back(static_cast<CameraData*>(pCameraData));
+		s_pLightData.push_back(static_cast<LightData*>(pLightData));
+	}
+}
+void FrameData::CreateDescriptorSets()
+{
+	std::vector<VkDescriptorSetLayout> layouts(s_pContext->framesInFlight, s_descriptorSetLayout);	// same layout for all frames
+
+	VkDescriptorSetAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+	allocInfo.descriptorPool = s_pContext->GetVkDescriptorPool();
+	allocInfo.descriptorSetCount = s_pContext->framesInFlight;
+	allocInfo.pSetLayouts = layouts.data();
+	s_descriptorSets.resize(s_pContext->framesInFlight);
+	VKA(vkAllocateDescriptorSets(s_pContext->GetVkDevice(), &allocInfo, s_descriptorSets.data()));
+
+	// Buffers and sampler never change, so the sets are written once. The shadow atlas is rewritten when it grows:
+	for (uint32_t frameIndex = 0; frameIndex < s_pContext->framesInFlight; frameIndex++)
+	{
+		VkDescriptorBufferInfo cameraBufferInfo = {};
+		cameraBufferInfo.buffer = s_cameraBuffers[frameIndex]->GetVkBuffer();
+		cameraBufferInfo.offset = 0;
+		cameraBufferInfo.range = sizeof(CameraData);
+
+		VkDescriptorBufferInfo lightBufferInfo = {};
+		lightBufferInfo.buffer = s_lightBuffers[frameIndex]->GetVkBuffer();
+		lightBufferInfo.offset = 0;
+		lightBufferInfo.range = sizeof(LightData);
+
+		VkDescriptorImageInfo samplerInfo = {};
+		samplerInfo.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		samplerInfo.sampler = SamplerManager::GetSampler("shadowSampler")->GetVkSampler();
+
+		std::array<VkWriteDescriptorSet, 3> descriptorWrites = {};
+		for (uint32_t i = 0; i < descriptorWrites.size(); i++)
+		{
+			descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrites[i].dstSet = s_descriptorSets[frameIndex];
+			descriptorWrites[i].dstBinding = i;
+			descriptorWrites[i].dstArrayElement = 0;
+			descriptorWrites[i].descriptorCount = 1;
+		}
+		descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorWrites[0].pBufferInfo = &cameraBufferInfo;
+		descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		descriptorWrites[1].pBufferInfo = &lightBufferInfo;
+		descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+		descriptorWrites[2].pImageInfo = &samplerInfo;
+		vkUpdateDescriptorSets(s_pContext->GetVkDevice(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+	}
+	UpdateShadowMapDescriptors();
+}
\ No newline at end of file
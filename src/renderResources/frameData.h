@@ -0,0 +1,108 @@
+#ifndef __INCLUDE_GUARD_frameData_h__
+#define __INCLUDE_GUARD_frameData_h__
+#include "macros.h"
+#include "mathf.h"
+#include "shadowCascade.h"
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+
+
+class Scene;
+class VmaBuffer;
+struct VulkanContext;
+
+
+
+// Mirrors of the cbuffers in frameData.hlsli, padded to the hlsl cbuffer packing rules:
+struct CameraData
+{
+	Float4x4 viewMatrix;
+	Float4x4 projMatrix;
+	Float4x4 worldToClipMatrix;
+};
+struct DirectionalLightData
+{
+	Float4x4 worldToClipMatrix[ShadowCascadeSolver::s_maxCascadeCount];
+	Float3 direction;
+	uint32_t cascadeCount;
+	Float4 colorIntensity;
+	Float4 shadowAtlasRect[ShadowCascadeSolver::s_maxCascadeCount];
+};
+struct SpotLightData
+{
+	Float4x4 worldToClipMatrix;
+	Float3 position;
+	float padding0;
+	Float4 colorIntensity;
+	Float2 blendStartEnd;
+	float padding1[2];
+	Float4 shadowAtlasRect;
+};
+struct PointLightData
+{
+	Float4x4 worldToClipMatrix[6];
+	Float3 position;
+	float padding0;
+	Float4 colorIntensity;
+	Float4 shadowAtlasRect[6];
+};
+struct LightData
+{
+	DirectionalLightData directionalLightData[MAX_D_LIGHTS];
+	SpotLightData spotLightData[MAX_S_LIGHTS];
+	PointLightData pointLightData[MAX_P_LIGHTS];
+};
+static_assert(sizeof(CameraData) == 192);
+static_assert(sizeof(DirectionalLightData) == 352);
+static_assert(sizeof(SpotLightData) == 128);
+static_assert(sizeof(PointLightData) == 512);
+
+
+
+/// <summary>
+/// Purely static class that owns the global descriptor set (set 0, space0 in hlsl).
+/// Camera and light data are written once per frame and shared by all draw calls,
+/// per object descriptor sets (set 1) only carry model dependent data.
+/// </summary>
+class FrameData
+{
+public: // Members
+
+private: // Members
+	static bool s_isInitialized;
+	static VulkanContext* s_pContext;
+	static VkDescriptorSetLayout s_descriptorSetLayout;
+	static std::vector<VkDescriptorSet> s_descriptorSets;
+	static std::vector<std::unique_ptr<VmaBuffer>> s_cameraBuffers;
+	static std::vector<std::unique_ptr<VmaBuffer>> s_lightBuffers;
+	static std::vector<CameraData*> s_pCameraData;
+	static std::vector<LightData*> s_pLightData;
+
+public: // Methods
+	static void Init(VulkanContext* pContext);
+	static void Clear();
+
+	static void Update(Scene* pScene);
+	static void UpdateShadowMapDescriptors();
+
+	// Getters:
+	static const VkDescriptorSetLayout& GetVkDescriptorSetLayout();
+	static const VkDescriptorSet* const GetDescriptorSets(uint32_t frameIndex);
+
+private: // Methods
+	static void CreateDescriptorSetLayout();
+	static void CreateBuffers();
+	static void CreateDescriptorSets();
+
+	// Delete all constructors:
+	FrameData() = delete;
+	FrameData(const FrameData&) = delete;
+	FrameData& operator=(const FrameData&) = delete;
+	~FrameData() = delete;
+};
+
+
+
+#endif // __INCLUDE_GUARD_frameData_h__
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "instanceData.h"
+
+
+
+// Constructors:
+InstanceData::InstanceData()
+{
+	this->modelMatrix = Float4x4::identity;
+	this->normalMatrix = Float4x4::identity;
+	this->color = Float4::one;
+}
+InstanceData::InstanceData(const Float4x4& modelMatrix, const Float4x4& normalMatrix, const Float4& color)
+{
+	this->modelMatrix = modelMatrix;
+	this->normalMatrix = normalMatrix;
+	this->color = color;
+}
+
+
+
+// Public methods:
+std::string InstanceData::ToString()
+{
+	std::string output = "InstanceData:\n";
+	output += "Model Matrix: " + modelMatrix.ToString() + "\n";
+	output += "Normal Matrix: " + normalMatrix.ToString() + "\n";
+	output += "Color: " + color.ToString() + "\n";
+	return output;
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef __INCLUDE_GUARD_instanceData_h__
+#define __INCLUDE_GUARD_instanceData_h__
+#include "mathf.h"
+#include <string>
+
+
+
+/// <summary>
+/// Per instance data of instanced draw calls, must match InstanceData in instanceData.hlsli.
+/// Stored in a StorageBuffer (std430 layout), one entry per instance.
+/// </summary>
+struct InstanceData
+{
+public:
+	alignas(16) Float4x4 modelMatrix;
+	alignas(16) Float4x4 normalMatrix;
+	alignas(16) Float4 color;
+
+public:
+	InstanceData();
+	InstanceData(const Float4x4& modelMatrix, const Float4x4& normalMatrix, const Float4& color);
+	std::string ToString();
+};
+static_assert(sizeof(InstanceData) == 144, "InstanceData must match the std430 layout of the shader struct.");
+
+
+
+#endif // __INCLUDE_GUARD_instanceData_h__
\ No newline at end of file
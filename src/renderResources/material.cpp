@@ -7,6 +7,7 @@
 #include "spirvReflect.h"
 #include "vmaBuffer.h"
 #include "vulkanContext.h"
+#include <algorithm>
 #include <fstream>
 
 
@@ -74,6 +75,10 @@ Material::Material(VulkanContext* pContext, Type type, const std::string& name,
 		// Create pipeline:
 		m_pPipeline = std::make_unique<SkyboxPipeline>(m_pContext, vertexCode, fragmentCode, m_pDescriptorBoundResources->descriptorSetLayoutBindings, m_pVertexInputDescriptions.get());
 	}
+
+	// Instanced shaders read their per instance data from a StructuredBuffer named 'instanceData':
+	const std::vector<std::string>& names = m_pDescriptorBoundResources->descriptorSetBindingNames;
+	m_supportsInstancing = std::find(names.begin(), names.end(), "instanceData") != names.end();
 }
 Material::~Material()
 {
@@ -133,6 +138,10 @@ const VkDeviceSize* const Material::GetMeshOffsets(Mesh* pMesh)
 	}
 	return m_meshOffsets.data();
 }
+bool Material::SupportsInstancing() const
+{
+	return m_supportsInstancing;
+}
 VulkanContext* const Material::GetContext() const
 {
 	return m_pContext;
@@ -158,10 +167,14 @@ void Material::PrintBindings() const
 		std::string descriptorType;
 		if ((int)descriptorSetLayoutBinding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
 			descriptorType = "VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER";
+		else if ((int)descriptorSetLayoutBinding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+			descriptorType = "VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC";
 		else if ((int)descriptorSetLayoutBinding.descriptorType == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE)
 			descriptorType = "VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE";
 		else if ((int)descriptorSetLayoutBinding.descriptorType == VK_DESCRIPTOR_TYPE_SAMPLER)
 			descriptorType = "VK_DESCRIPTOR_TYPE_SAMPLER";
+		else if ((int)descriptorSetLayoutBinding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+			descriptorType = "VK_DESCRIPTOR_TYPE_STORAGE_BUFFER";
 
 		output += "  BindingName: " + m_pDescriptorBoundResources->descriptorSetBindingNames[i] + "\n";
 		output += "  Binding: " + std::to_string(descriptorSetLayoutBinding.binding) + "\n";
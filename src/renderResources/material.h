@@ -45,6 +45,7 @@ private: // Members:
 	Type m_type;
 	std::string m_name;
 	RenderQueue m_renderQueue;
+	bool m_supportsInstancing;
 	std::unique_ptr<Pipeline> m_pPipeline;
 	std::unique_ptr<DescriptorBoundResources> m_pDescriptorBoundResources;
 	std::unique_ptr<VertexInputDescriptions> m_pVertexInputDescriptions;
@@ -66,6 +67,7 @@ public: // Methods:
 	const VertexInputDescriptions* const GetVertexInputDescriptions() const;
 	const VkBuffer* const GetMeshBuffers(Mesh* pMesh);
 	const VkDeviceSize* const GetMeshOffsets(Mesh* pMesh);
+	bool SupportsInstancing() const;
 	VulkanContext* const GetContext() const;
 
 	// Debugging:
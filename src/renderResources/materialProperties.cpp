@@ -3,18 +3,20 @@
 #include "material.h"
 #include "mathf.h"
 #include "pipeline.h"
-#include "renderPassManager.h"
+#include "profiler.h"
 #include "sampler.h"
 #include "samplerManager.h"
-#include "shadowRenderPass.h"
 #include "spirvReflect.h"
+#include "storageBuffer.h"
 #include "texture2d.h"
 #include "textureManager.h"
 #include "uniformBuffer.h"
+#include "uniformRingBuffer.h"
 #include "vmaBuffer.h"
 #include "vmaImage.h"
 #include "vulkanContext.h"
 #include "vulkanMacros.h"
+#include <algorithm>
 #include <iostream>
 
 
@@ -26,10 +28,9 @@ MaterialProperties::MaterialProperties(Material* pMaterial)
 	m_pContext = pMaterial->GetContext();
 
 	// Create resource bindings and uniform buffer update logic for each frameInFlight:
-	m_uniformBufferMaps = std::vector<std::unordered_map<std::string, ResourceBinding<std::shared_ptr<UniformBuffer>>>>(m_pContext->framesInFlight);
 	m_samplerMaps = std::vector<std::unordered_map<std::string, ResourceBinding<Sampler*>>>(m_pContext->framesInFlight);
 	m_texture2dMaps = std::vector<std::unordered_map<std::string, ResourceBinding<Texture2d*>>>(m_pContext->framesInFlight);
-	m_updateUniformBuffer = std::vector<std::unordered_map<std::string, bool>>(m_pContext->framesInFlight);
+	m_storageBufferMaps = std::vector<std::unordered_map<std::string, ResourceBinding<std::shared_ptr<StorageBuffer>>>>(m_pContext->framesInFlight);
 
 	for (uint32_t frameIndex = 0; frameIndex < m_pContext->framesInFlight; frameIndex++)
 	{
@@ -41,21 +42,33 @@ MaterialProperties::MaterialProperties(Material* pMaterial)
 			uint32_t binding = descriptorSetLayoutBinding.binding;
 			const std::string& name = descriptorBoundResources->descriptorSetBindingNames[i];
 
-			if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
-				InitUniformBufferResourceBinding(name, binding, frameIndex);
+			if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+				InitUniformBufferResourceBinding(name, binding);
 			else if (type == VK_DESCRIPTOR_TYPE_SAMPLER)
 				InitSamplerResourceBinding(name, binding, SamplerManager::GetSampler("colorSampler"), frameIndex);
 			else if (type == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE)
 				InitTexture2dResourceBinding(name, binding, TextureManager::GetTexture2d("white"), frameIndex);
+			else if (type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+				InitStorageBufferResourceBinding(name, binding, frameIndex);
 		}
 	}
 	InitStagingMaps();
+
+	// Uniform blocks are streamed into the UniformRingBuffer and bound with dynamic offsets:
+	m_uniformDataSize = 0;
+	for (auto& [_, resourceBinding] : m_uniformBufferMap)
+	{
+		m_dynamicUniformBuffers.push_back(resourceBinding);
+		m_uniformDataSize += UniformRingBuffer::GetAlignedSize(resourceBinding.resource->GetSize());
+	}
+	std::sort(m_dynamicUniformBuffers.begin(), m_dynamicUniformBuffers.end(), [](const auto& a, const auto& b) { return a.binding < b.binding; });
+	m_dynamicOffsets = std::vector<std::vector<uint32_t>>(m_pContext->framesInFlight, std::vector<uint32_t>(m_dynamicUniformBuffers.size(), 0));
+	m_ringBufferGenerations.resize(m_pContext->framesInFlight);
+	for (uint32_t frameIndex = 0; frameIndex < m_pContext->framesInFlight; frameIndex++)
+		m_ringBufferGenerations[frameIndex] = UniformRingBuffer::GetGeneration(frameIndex);
 	InitDescriptorSets();
 
 	// Set default values:
-	ShadowRenderPass* pShadowRenderPass = dynamic_cast<ShadowRenderPass*>(RenderPassManager::GetRenderPass("shadowRenderPass"));
-	SetSampler("shadowSampler", SamplerManager::GetSampler("shadowSampler"));
-	SetTexture2d("shadowMaps", pShadowRenderPass->GetShadowMaps());
 	SetTexture2d("normalMap", TextureManager::GetTexture2d("defaultNormalMap"));
 	SetValue("SurfaceProperties", "scaleOffset", Float4(1.0f, 1.0f, 1.0f, 1.0f));
 	SetValue("SurfaceProperties", "diffuseColor", Float4(1.0f, 1.0f, 1.0f, 1.0f));
@@ -73,33 +86,54 @@ MaterialProperties::~MaterialProperties()
 // Public methods:
 void MaterialProperties::UpdateShaderData()
 {
-	// Stream uniform buffer data from host memory to GPU only for current frameIndex:
-	for (auto& [name, resourceBinding] : m_uniformBufferMaps[m_pContext->frameIndex])
+	EMBER_PROFILE_SCOPE("MaterialProperties::UpdateShaderData");
+	// Bump allocate uniform buffer data of the current frameIndex, reserved up front so all blocks end up in the same VkBuffer:
+	uint32_t frameIndex = m_pContext->frameIndex;
+	if (!m_dynamicUniformBuffers.empty())
 	{
-		if (m_updateUniformBuffer[m_pContext->frameIndex].at(name))
+		UniformRingBuffer::Reserve(m_uniformDataSize);
+		for (uint32_t i = 0; i < m_dynamicUniformBuffers.size(); i++)
 		{
-			resourceBinding.resource->UpdateBuffer();
-			m_updateUniformBuffer[m_pContext->frameIndex].at(name) = false;
+			const std::shared_ptr<UniformBuffer>& uniformBuffer = m_dynamicUniformBuffers[i].resource;
+			m_dynamicOffsets[frameIndex][i] = UniformRingBuffer::Allocate(uniformBuffer->GetHostData(), uniformBuffer->GetSize());
+		}
+
+		// Only rewrite the descriptors when the ring buffer has grown:
+		if (m_ringBufferGenerations[frameIndex] != UniformRingBuffer::GetGeneration(frameIndex))
+		{
+			m_ringBufferGenerations[frameIndex] = UniformRingBuffer::GetGeneration(frameIndex);
+			for (const ResourceBinding<std::shared_ptr<UniformBuffer>>& resourceBinding : m_dynamicUniformBuffers)
+				UpdateDescriptorSet(frameIndex, resourceBinding);
 		}
 	}
 
 	// Change the pointer the descriptor set points at to the new sampler:
-	for (auto& [name, resourceBinding] : m_samplerMaps[m_pContext->frameIndex])
+	for (auto& [name, resourceBinding] : m_samplerMaps[frameIndex])
 	{
 		if (resourceBinding.resource != m_samplerStagingMap.at(name))
 		{
 			resourceBinding.resource = m_samplerStagingMap.at(name);
-			UpdateDescriptorSet(m_pContext->frameIndex, resourceBinding);
+			UpdateDescriptorSet(frameIndex, resourceBinding);
 		}
 	}
 
 	// Change the pointer the descriptor set points at to the new texture2d:
-	for (auto& [name, resourceBinding] : m_texture2dMaps[m_pContext->frameIndex])
+	for (auto& [name, resourceBinding] : m_texture2dMaps[frameIndex])
 	{
 		if (resourceBinding.resource != m_texture2dStagingMap.at(name))
 		{
 			resourceBinding.resource = m_texture2dStagingMap.at(name);
-			UpdateDescriptorSet(m_pContext->frameIndex, resourceBinding);
+			UpdateDescriptorSet(frameIndex, resourceBinding);
+		}
+	}
+
+	// Change the pointer the descriptor set points at to the new storage buffer:
+	for (auto& [name, resourceBinding] : m_storageBufferMaps[frameIndex])
+	{
+		if (resourceBinding.resource != m_storageBufferStagingMap.at(name))
+		{
+			resourceBinding.resource = m_storageBufferStagingMap.at(name);
+			UpdateDescriptorSet(frameIndex, resourceBinding);
 		}
 	}
 }
@@ -107,6 +141,13 @@ const std::vector<VkDescriptorSet>& MaterialProperties::GetDescriptorSets() cons
 {
 	return m_descriptorSets;
 }
+/// <summary>
+/// Offsets into the UniformRingBuffer, one per uniform block in binding order, written by UpdateShaderData().
+/// </summary>
+const std::vector<uint32_t>& MaterialProperties::GetDynamicOffsets(uint32_t frameIndex) const
+{
+	return m_dynamicOffsets[frameIndex];
+}
 
 
 
@@ -115,54 +156,30 @@ const std::vector<VkDescriptorSet>& MaterialProperties::GetDescriptorSets() cons
 template<typename T>
 void MaterialProperties::SetValue(const std::string& blockName, const std::string& memberName, const T& value)
 {
-	auto it = m_uniformBufferMaps[0].find(blockName);
-	if (it != m_uniformBufferMaps[0].end())
-	{// blockname exists => set value for all frames:
-		for (uint32_t frameIndex = 0; frameIndex < m_pContext->framesInFlight; frameIndex++)
-		{
-			if (m_uniformBufferMaps[frameIndex].at(blockName).resource->SetValue(memberName, value))
-				m_updateUniformBuffer[frameIndex].at(blockName) = true;
-		}
-	}
+	auto it = m_uniformBufferMap.find(blockName);
+	if (it != m_uniformBufferMap.end())
+		it->second.resource->SetValue(memberName, value);
 }
 template<typename T>
 void MaterialProperties::SetValue(const std::string& blockName, const std::string& arrayName, uint32_t arrayIndex, const T& value)
 {
-	auto it = m_uniformBufferMaps[0].find(blockName);
-	if (it != m_uniformBufferMaps[0].end())
-	{// blockname exists => set value for all frames:
-		for (uint32_t frameIndex = 0; frameIndex < m_pContext->framesInFlight; frameIndex++)
-		{
-			if (m_uniformBufferMaps[frameIndex].at(blockName).resource->SetValue(arrayName, arrayIndex, value))
-				m_updateUniformBuffer[frameIndex].at(blockName) = true;
-		}
-	}
+	auto it = m_uniformBufferMap.find(blockName);
+	if (it != m_uniformBufferMap.end())
+		it->second.resource->SetValue(arrayName, arrayIndex, value);
 }
 template<typename T>
 void MaterialProperties::SetValue(const std::string& blockName, const std::string& arrayName, uint32_t arrayIndex, const std::string& memberName, const T& value)
 {
-	auto it = m_uniformBufferMaps[0].find(blockName);
-	if (it != m_uniformBufferMaps[0].end())
-	{// blockname exists => set value for all frames:
-		for (uint32_t frameIndex = 0; frameIndex < m_pContext->framesInFlight; frameIndex++)
-		{
-			if (m_uniformBufferMaps[frameIndex].at(blockName).resource->SetValue(arrayName, arrayIndex, memberName, value))
-				m_updateUniformBuffer[frameIndex].at(blockName) = true;
-		}
-	}
+	auto it = m_uniformBufferMap.find(blockName);
+	if (it != m_uniformBufferMap.end())
+		it->second.resource->SetValue(arrayName, arrayIndex, memberName, value);
 }
 template<typename T>
 void MaterialProperties::SetValue(const std::string& blockName, const std::string& arrayName, uint32_t arrayIndex, const std::string& subArrayName, uint32_t subArrayIndex, const T& value)
 {
-	auto it = m_uniformBufferMaps[0].find(blockName);
-	if (it != m_uniformBufferMaps[0].end())
-	{// blockname exists => set value for all frames:
-		for (uint32_t frameIndex = 0; frameIndex < m_pContext->framesInFlight; frameIndex++)
-		{
-			if (m_uniformBufferMaps[frameIndex].at(blockName).resource->SetValue(arrayName, arrayIndex, subArrayName, subArrayIndex, value))
-				m_updateUniformBuffer[frameIndex].at(blockName) = true;
-		}
-	}
+	auto it = m_uniformBufferMap.find(blockName);
+	if (it != m_uniformBufferMap.end())
+		it->second.resource->SetValue(arrayName, arrayIndex, subArrayName, subArrayIndex, value);
 }
 
 // Sampler setters:
@@ -187,43 +204,54 @@ void MaterialProperties::SetTexture2d(const std::string& name, Texture2d* pTextu
 	it->second = pTexture2d;
 }
 
+// StorageBuffer setters:
+void MaterialProperties::SetStorageBuffer(const std::string& name, const std::shared_ptr<StorageBuffer>& pStorageBuffer)
+{
+	// If storage buffer with 'name' doesnt exist, skip:
+	auto it = m_storageBufferStagingMap.find(name);
+	if (it == m_storageBufferStagingMap.end() || it->second == pStorageBuffer)
+		return;
+
+	it->second = pStorageBuffer;
+}
+
 
 
 // Uniform Buffer Getters:
 template<typename T>
 T MaterialProperties::GetValue(const std::string& blockName, const std::string& memberName) const
 {
-	auto it = m_uniformBufferMaps[0].find(blockName);
-	if (it != m_uniformBufferMaps[0].end())
+	auto it = m_uniformBufferMap.find(blockName);
+	if (it != m_uniformBufferMap.end())
 		return it->second.resource->GetValue<T>(memberName);
 	return T();
 }
 template<typename T>
 T MaterialProperties::GetValue(const std::string& blockName, const std::string& arrayName, uint32_t arrayIndex) const
 {
-	auto it = m_uniformBufferMaps[0].find(blockName);
-	if (it != m_uniformBufferMaps[0].end())
+	auto it = m_uniformBufferMap.find(blockName);
+	if (it != m_uniformBufferMap.end())
 		return it->second.resource->GetValue<T>(arrayName, arrayIndex);
 	return T();
 }
 template<typename T>
 T MaterialProperties::GetValue(const std::string& blockName, const std::string& arrayName, uint32_t arrayIndex, const std::string& memberName) const
 {
-	auto it = m_uniformBufferMaps[0].find(blockName);
-	if (it != m_uniformBufferMaps[0].end())
+	auto it = m_uniformBufferMap.find(blockName);
+	if (it != m_uniformBufferMap.end())
 		return it->second.resource->GetValue<T>(arrayName, arrayIndex, memberName);
 	return T();
 }
 template<typename T>
 T MaterialProperties::GetValue(const std::string& blockName, const std::string& arrayName, uint32_t arrayIndex, const std::string& subArrayName, uint32_t subArrayIndex) const
 {
-	auto it = m_uniformBufferMaps[0].find(blockName);
-	if (it != m_uniformBufferMaps[0].end())
+	auto it = m_uniformBufferMap.find(blockName);
+	if (it != m_uniformBufferMap.end())
 		return it->second.resource->GetValue<T>(arrayName, arrayIndex, subArrayName, subArrayIndex);
 	return T();
 }
 
-// Sampler and Texture2d getters:
+// Sampler, Texture2d and StorageBuffer getters:
 Sampler* MaterialProperties::GetSampler(const std::string& name) const
 {
 	auto it = m_samplerMaps[m_pContext->frameIndex].find(name);
@@ -238,6 +266,13 @@ Texture2d* MaterialProperties::GetTexture2d(const std::string& name) const
 		return it->second.resource;
 	return nullptr;
 }
+StorageBuffer* MaterialProperties::GetStorageBuffer(const std::string& name) const
+{
+	auto it = m_storageBufferMaps[m_pContext->frameIndex].find(name);
+	if (it != m_storageBufferMaps[m_pContext->frameIndex].end())
+		return it->second.resource.get();
+	return nullptr;
+}
 
 
 
@@ -249,12 +284,12 @@ void MaterialProperties::Print(const std::string& name) const
 }
 void MaterialProperties::PrintMaps() const
 {
+	LOG_INFO("UniformBufferMap:");
+	for (const auto& [name, resourceBinding] : m_uniformBufferMap)
+		LOG_TRACE("binding: {}, bindingName: {}", resourceBinding.binding, name);
+
 	for (uint32_t frameIndex = 0; frameIndex < m_pContext->framesInFlight; frameIndex++)
 	{
-		LOG_INFO("UniformBufferMaps[{}]:", frameIndex);
-		for (const auto& [name, resourceBinding] : m_uniformBufferMaps[frameIndex])
-			LOG_TRACE("binding: {}, bindingName: {}", resourceBinding.binding, name);
-
 		LOG_INFO("SamplerMaps[{}]:", frameIndex);
 		for (const auto& [name, resourceBinding] : m_samplerMaps[frameIndex])
 			LOG_TRACE("binding: {}, bindingName: {}, samplerName: {}", resourceBinding.binding, name, resourceBinding.resource->GetName());
@@ -271,19 +306,17 @@ void MaterialProperties::PrintMaps() const
 
 // Private methods:
 // Initializers:
-void MaterialProperties::InitUniformBufferResourceBinding(const std::string& name, uint32_t binding, uint32_t frameIndex)
+void MaterialProperties::InitUniformBufferResourceBinding(const std::string& name, uint32_t binding)
 {
-	auto it = m_uniformBufferMaps[frameIndex].find(name);
-	if (it == m_uniformBufferMaps[frameIndex].end())
+	// Host data is shared by all frames, only the ring buffer offsets are per frame:
+	auto it = m_uniformBufferMap.find(name);
+	if (it == m_uniformBufferMap.end())
 	{
 		const DescriptorBoundResources* const descriptorBoundResources = m_pMaterial->GetDescriptorBoundResources();
 		UniformBufferBlock* pUniformBufferBlock = descriptorBoundResources->uniformBufferBlockMap.at(name);
 
-		std::shared_ptr<UniformBuffer> uniformBuffer = std::make_shared<UniformBuffer>(m_pContext, pUniformBufferBlock);
-		m_uniformBufferMaps[frameIndex].emplace(name, ResourceBinding<std::shared_ptr<UniformBuffer>>(uniformBuffer, binding));
-
-		for (uint32_t frameIndex = 0; frameIndex < m_pContext->framesInFlight; frameIndex++)
-			m_updateUniformBuffer[frameIndex].emplace(name, true);
+		std::shared_ptr<UniformBuffer> uniformBuffer = std::make_shared<UniformBuffer>(pUniformBufferBlock);
+		m_uniformBufferMap.emplace(name, ResourceBinding<std::shared_ptr<UniformBuffer>>(uniformBuffer, binding));
 	}
 }
 void MaterialProperties::InitSamplerResourceBinding(const std::string& name, uint32_t binding, Sampler* pSampler, uint32_t frameIndex)
@@ -298,24 +331,35 @@ void MaterialProperties::InitTexture2dResourceBinding(const std::string& name, u
 	if (it == m_texture2dMaps[frameIndex].end())
 		m_texture2dMaps[frameIndex].emplace(name, ResourceBinding<Texture2d*>(pTexture2d, binding));
 }
+void MaterialProperties::InitStorageBufferResourceBinding(const std::string& name, uint32_t binding, uint32_t frameIndex)
+{
+	// There is no default storage buffer, the descriptor is written once a buffer has been set via SetStorageBuffer:
+	auto it = m_storageBufferMaps[frameIndex].find(name);
+	if (it == m_storageBufferMaps[frameIndex].end())
+		m_storageBufferMaps[frameIndex].emplace(name, ResourceBinding<std::shared_ptr<StorageBuffer>>(nullptr, binding));
+}
 void MaterialProperties::InitStagingMaps()
 {
 	for (auto& [name, resourceBinding] : m_samplerMaps[0])
 		m_samplerStagingMap.emplace(name, resourceBinding.resource);
 	for (auto& [name, resourceBinding] : m_texture2dMaps[0])
 		m_texture2dStagingMap.emplace(name, resourceBinding.resource);
+	for (auto& [name, resourceBinding] : m_storageBufferMaps[0])
+		m_storageBufferStagingMap.emplace(name, resourceBinding.resource);
 }
 void MaterialProperties::InitDescriptorSets()
 {
 	CreateDescriptorSets();
 	for (uint32_t frameIndex = 0; frameIndex < m_pContext->framesInFlight; frameIndex++)
 	{
-		for (auto& [_, resourceBinding] : m_uniformBufferMaps[frameIndex])
+		for (const ResourceBinding<std::shared_ptr<UniformBuffer>>& resourceBinding : m_dynamicUniformBuffers)
 			UpdateDescriptorSet(frameIndex, resourceBinding);
 		for (auto& [_, resourceBinding] : m_samplerMaps[frameIndex])
 			UpdateDescriptorSet(frameIndex, resourceBinding);
 		for (auto& [_, resourceBinding] : m_texture2dMaps[frameIndex])
 			UpdateDescriptorSet(frameIndex, resourceBinding);
+		for (auto& [_, resourceBinding] : m_storageBufferMaps[frameIndex])
+			UpdateDescriptorSet(frameIndex, resourceBinding);
 	}
 }
 
@@ -336,8 +380,9 @@ void MaterialProperties::CreateDescriptorSets()
 }
 void MaterialProperties::UpdateDescriptorSet(uint32_t frameIndex, ResourceBinding<std::shared_ptr<UniformBuffer>> uniformBufferResourceBinding)
 {
+	// Offset within the ring buffer is supplied as dynamic offset at bind time:
 	VkDescriptorBufferInfo bufferInfo = {};
-	bufferInfo.buffer = uniformBufferResourceBinding.resource->GetVmaBuffer()->GetVkBuffer();
+	bufferInfo.buffer = UniformRingBuffer::GetVkBuffer(frameIndex);
 	bufferInfo.offset = 0;
 	bufferInfo.range = uniformBufferResourceBinding.resource->GetSize();
 
@@ -345,7 +390,7 @@ void MaterialProperties::UpdateDescriptorSet(uint32_t frameIndex, ResourceBindin
 	descriptorWrite.dstSet = m_descriptorSets[frameIndex];
 	descriptorWrite.dstBinding = uniformBufferResourceBinding.binding;
 	descriptorWrite.dstArrayElement = 0;
-	descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 	descriptorWrite.descriptorCount = 1;
 	descriptorWrite.pBufferInfo = &bufferInfo;
 	descriptorWrite.pImageInfo = nullptr;
@@ -390,6 +435,28 @@ void MaterialProperties::UpdateDescriptorSet(uint32_t frameIndex, ResourceBindin
 
 	vkUpdateDescriptorSets(m_pContext->GetVkDevice(), 1, &descriptorWrite, 0, nullptr);
 }
+void MaterialProperties::UpdateDescriptorSet(uint32_t frameIndex, ResourceBinding<std::shared_ptr<StorageBuffer>> storageBufferResourceBinding)
+{
+	if (storageBufferResourceBinding.resource == nullptr)
+		return;
+
+	VkDescriptorBufferInfo bufferInfo = {};
+	bufferInfo.buffer = storageBufferResourceBinding.resource->GetVmaBuffer()->GetVkBuffer();
+	bufferInfo.offset = 0;
+	bufferInfo.range = storageBufferResourceBinding.resource->GetSize();
+
+	VkWriteDescriptorSet descriptorWrite = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+	descriptorWrite.dstSet = m_descriptorSets[frameIndex];
+	descriptorWrite.dstBinding = storageBufferResourceBinding.binding;
+	descriptorWrite.dstArrayElement = 0;
+	descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	descriptorWrite.descriptorCount = 1;
+	descriptorWrite.pBufferInfo = &bufferInfo;
+	descriptorWrite.pImageInfo = nullptr;
+	descriptorWrite.pTexelBufferView = nullptr;
+
+	vkUpdateDescriptorSets(m_pContext->GetVkDevice(), 1, &descriptorWrite, 0, nullptr);
+}
 
 
 
@@ -10,6 +10,7 @@
 
 class Material;
 class Sampler;
+class StorageBuffer;
 class Texture2d;
 class UniformBuffer;
 struct VulkanContext;
@@ -29,6 +30,7 @@ struct ResourceBinding
 /// Each MaterialProperties instance is customized for a specific Material.
 /// MaterialProperties construction is expensive, do not create them in an update loop.
 /// MaterialProperties own UniformBuffer pointers, Sampler and Texture2d pointers are owned by associated Managers.
+/// Uniform blocks are bound as dynamic uniform buffers, see GetDynamicOffsets().
 /// </summary>
 class MaterialProperties
 {
@@ -36,13 +38,19 @@ private: // Members:
 	Material* m_pMaterial;
 	VulkanContext* m_pContext;
 	std::vector<VkDescriptorSet> m_descriptorSets;
-	std::vector<std::unordered_map<std::string, ResourceBinding<std::shared_ptr<UniformBuffer>>>> m_uniformBufferMaps;
+	std::unordered_map<std::string, ResourceBinding<std::shared_ptr<UniformBuffer>>> m_uniformBufferMap;
 	std::vector<std::unordered_map<std::string, ResourceBinding<Sampler*>>> m_samplerMaps;
 	std::vector<std::unordered_map<std::string, ResourceBinding<Texture2d*>>> m_texture2dMaps;
-	// UniformBuffer does not need stagingMap, as it contains a host and device buffer, where the host buffer is the staging buffer.
+	std::vector<std::unordered_map<std::string, ResourceBinding<std::shared_ptr<StorageBuffer>>>> m_storageBufferMaps;
+	// UniformBuffer does not need stagingMap, its host data is copied into the UniformRingBuffer every frame.
 	std::unordered_map<std::string, Sampler*> m_samplerStagingMap;
 	std::unordered_map<std::string, Texture2d*> m_texture2dStagingMap;
-	std::vector<std::unordered_map<std::string, bool>> m_updateUniformBuffer;
+	std::unordered_map<std::string, std::shared_ptr<StorageBuffer>> m_storageBufferStagingMap;
+	// Uniform blocks sorted by binding, the order in which vkCmdBindDescriptorSets consumes dynamic offsets:
+	std::vector<ResourceBinding<std::shared_ptr<UniformBuffer>>> m_dynamicUniformBuffers;
+	std::vector<std::vector<uint32_t>> m_dynamicOffsets;
+	std::vector<uint64_t> m_ringBufferGenerations;	// UniformRingBuffer generation the descriptor set of each frame points at.
+	uint64_t m_uniformDataSize;						// aligned size of all uniform blocks.
 
 public: // Methods:
 	// Constructors/Destructor:
@@ -51,6 +59,7 @@ public: // Methods:
 
 	void UpdateShaderData();
 	const std::vector<VkDescriptorSet>& GetDescriptorSets() const;
+	const std::vector<uint32_t>& GetDynamicOffsets(uint32_t frameIndex) const;
 
 	// Uniform Buffer Setters:
 	template<typename T>
@@ -63,6 +72,7 @@ public: // Methods:
 	void SetValue(const std::string& blockName, const std::string& arrayName, uint32_t arrayIndex, const std::string& subArrayName, uint32_t subArrayIndex, const T& value);
 	void SetSampler(const std::string& name, Sampler* pSampler);
 	void SetTexture2d(const std::string& name, Texture2d* pTexture2d);
+	void SetStorageBuffer(const std::string& name, const std::shared_ptr<StorageBuffer>& pStorageBuffer);
 
 	// Uniform Buffer Getters:
 	template<typename T>
@@ -74,9 +84,10 @@ public: // Methods:
 	template<typename T>
 	T GetValue(const std::string& blockName, const std::string& arrayName, uint32_t arrayIndex, const std::string& subArrayName, uint32_t subArrayIndex) const;
 
-	// Sampler and Texture2d Getters:
+	// Sampler, Texture2d and StorageBuffer Getters:
 	Sampler* GetSampler(const std::string& name) const;
 	Texture2d* GetTexture2d(const std::string& name) const;
+	StorageBuffer* GetStorageBuffer(const std::string& name) const;
 
 	// Debugging:
 	void Print(const std::string& name) const;
@@ -84,9 +95,10 @@ public: // Methods:
 
 private: // Methods:
 	// Initializers:
-	void InitUniformBufferResourceBinding(const std::string& name, uint32_t binding, uint32_t frameIndex);
+	void InitUniformBufferResourceBinding(const std::string& name, uint32_t binding);
 	void InitSamplerResourceBinding(const std::string& name, uint32_t binding, Sampler* pSampler, uint32_t frameIndex);
 	void InitTexture2dResourceBinding(const std::string& name, uint32_t binding, Texture2d* pTexture2d, uint32_t frameIndex);
+	void InitStorageBufferResourceBinding(const std::string& name, uint32_t binding, uint32_t frameIndex);
 	void InitStagingMaps();
 	void InitDescriptorSets();
 
@@ -95,6 +107,7 @@ private: // Methods:
 	void UpdateDescriptorSet(uint32_t frameIndex, ResourceBinding<std::shared_ptr<UniformBuffer>> samplerResourceBinding);
 	void UpdateDescriptorSet(uint32_t frameIndex, ResourceBinding<Sampler*> samplerResourceBinding);
 	void UpdateDescriptorSet(uint32_t frameIndex, ResourceBinding<Texture2d*> texture2dResourceBinding);
+	void UpdateDescriptorSet(uint32_t frameIndex, ResourceBinding<std::shared_ptr<StorageBuffer>> storageBufferResourceBinding);
 };
 
 
@@ -1,7 +1,11 @@
 #include "mesh.h"
 #include "logger.h"
+#include "profiler.h"
+#include "uploadManager.h"
 #include "vmaBuffer.h"
 #include "vulkanContext.h"
+#include "vulkanMacros.h"
+#include <cstring>
 
 
 
@@ -20,8 +24,17 @@ Mesh::~Mesh()
 // Public methods:
 void Mesh::Load(VulkanContext* pContext)
 {
-	UpdateVertexBuffer(pContext);
-	UpdateIndexBuffer(pContext);
+	if (m_usage == Usage::staticDraw)
+	{
+		UpdateVertexBuffer(pContext);
+		UpdateIndexBuffer(pContext);
+	}
+	else
+	{
+		UpdateFrameVertexBuffers(pContext);
+		UpdateFrameIndexBuffers(pContext);
+	}
+	m_version++;
 	m_verticesUpdated = false;
 	m_indicesUpdated = false;
 	m_isLoaded = true;
@@ -31,6 +44,10 @@ void Mesh::Unload()
 	// Call destructors and set ptr to nullptrs:
 	m_vertexBuffer.reset();
 	m_indexBuffer.reset();
+	m_frameVertexBuffers.clear();
+	m_frameIndexBuffers.clear();
+	m_staleVertexBuffers = 0;
+	m_staleIndexBuffers = 0;
 	m_verticesUpdated = false;
 	m_indicesUpdated = false;
 	m_isLoaded = false;
@@ -43,11 +60,21 @@ void Mesh::SetName(const std::string& name)
 {
 	m_name = name;
 }
+void Mesh::SetUsage(Usage usage)
+{
+	if (m_isLoaded && usage != m_usage)
+	{
+		LOG_WARN("Mesh::SetUsage() mesh '{}' is already loaded, its usage can only be changed before the first upload.", m_name);
+		return;
+	}
+	m_usage = usage;
+}
 void Mesh::SetPositions(const std::vector<Float3>& positions)
 {
 	m_vertexCount = static_cast<uint32_t>(positions.size());
 	m_positions = positions;
 	m_verticesUpdated = true;
+	m_boundsUpdated = true;
 }
 void Mesh::SetNormals(const std::vector<Float3>& normals)
 {
@@ -116,6 +143,7 @@ void Mesh::MovePositions(std::vector<Float3>& positions)
 	m_vertexCount = static_cast<uint32_t>(positions.size());
 	m_positions = std::move(positions);
 	m_verticesUpdated = true;
+	m_boundsUpdated = true;
 }
 void Mesh::MoveNormals(std::vector<Float3>& normals)
 {
@@ -175,6 +203,17 @@ std::string Mesh::GetName() const
 {
 	return m_name;
 }
+Mesh::Usage Mesh::GetUsage() const
+{
+	return m_usage;
+}
+/// <summary>
+/// Changes whenever new vertex or index data is sent to the gpu, e.g. to detect deformed shadow casters.
+/// </summary>
+uint64_t Mesh::GetVersion() const
+{
+	return m_version;
+}
 uint32_t Mesh::GetVertexCount() const
 {
 	return m_vertexCount;
@@ -185,6 +224,8 @@ uint32_t Mesh::GetTriangleCount() const
 }
 std::vector<Float3>& Mesh::GetPositions()
 {
+	// Caller may modify positions through the reference:
+	m_boundsUpdated = true;
 	if (m_positions.size() != m_vertexCount)
 		m_positions.resize(m_vertexCount, Float3::zero);
 	return m_positions;
@@ -221,6 +262,18 @@ uint32_t* Mesh::GetTrianglesUnrolled()
 {
 	return reinterpret_cast<uint32_t*>(m_triangles.data());
 }
+const Bounds& Mesh::GetBounds()
+{
+	if (m_boundsUpdated)
+		UpdateBounds();
+	return m_bounds;
+}
+Float4 Mesh::GetBoundingSphere()
+{
+	if (m_boundsUpdated)
+		UpdateBounds();
+	return Float4(m_bounds.center, m_boundingRadius);
+}
 uint32_t Mesh::GetSizeOfPositions() const
 {
 	return m_vertexCount * sizeof(Float3);
@@ -269,27 +322,67 @@ VkDeviceSize Mesh::GetUVsOffset() const
 {
 	return GetSizeOfPositions() + GetSizeOfNormals() + GetSizeOfTangents() + GetSizeOfColors();
 }
+/// <summary>
+/// For dynamicDraw/streamDraw meshes this is the buffer of the current frameIndex.
+/// Only call it once the fence of the current frameIndex has been waited on, as it may be written to.
+/// </summary>
 VmaBuffer* Mesh::GetVertexBuffer(VulkanContext* pContext)
 {
 	if (!m_isLoaded)
 		Load(pContext);
+	if (m_usage == Usage::staticDraw)
+	{
+		if (m_verticesUpdated)
+		{
+			UpdateVertexBuffer(pContext);
+			m_verticesUpdated = false;
+			m_version++;
+		}
+		return m_vertexBuffer.get();
+	}
+
+	// Frame buffers catch up on missed updates when their frameIndex comes around:
 	if (m_verticesUpdated)
 	{
-		UpdateVertexBuffer(pContext);
+		UpdateFrameVertexBuffers(pContext);
 		m_verticesUpdated = false;
+		m_version++;
 	}
-	return m_vertexBuffer.get();
+	uint32_t frameIndex = pContext->frameIndex;
+	if (m_staleVertexBuffers & (1u << frameIndex))
+		WriteFrameVertexBuffer(pContext, frameIndex);
+	return m_frameVertexBuffers[frameIndex].get();
 }
+/// <summary>
+/// For dynamicDraw/streamDraw meshes this is the buffer of the current frameIndex.
+/// Only call it once the fence of the current frameIndex has been waited on, as it may be written to.
+/// </summary>
 VmaBuffer* Mesh::GetIndexBuffer(VulkanContext* pContext)
 {
 	if (!m_isLoaded)
 		Load(pContext);
-	if (m_indicesUpdated && pContext != nullptr)
+	if (m_usage == Usage::staticDraw)
 	{
-		UpdateIndexBuffer(pContext);
+		if (m_indicesUpdated && pContext != nullptr)
+		{
+			UpdateIndexBuffer(pContext);
+			m_indicesUpdated = false;
+			m_version++;
+		}
+		return m_indexBuffer.get();
+	}
+
+	// Frame buffers catch up on missed updates when their frameIndex comes around:
+	if (m_indicesUpdated)
+	{
+		UpdateFrameIndexBuffers(pContext);
 		m_indicesUpdated = false;
+		m_version++;
 	}
-	return m_indexBuffer.get();
+	uint32_t frameIndex = pContext->frameIndex;
+	if (m_staleIndexBuffers & (1u << frameIndex))
+		WriteFrameIndexBuffer(pContext, frameIndex);
+	return m_frameIndexBuffers[frameIndex].get();
 }
 bool Mesh::IsLoaded()
 {
@@ -298,6 +391,7 @@ bool Mesh::IsLoaded()
 Mesh* Mesh::GetCopy(const std::string& newName)
 {
 	Mesh* copy = new Mesh(newName);
+	copy->SetUsage(m_usage);
 	copy->SetPositions(m_positions);
 	copy->SetNormals(m_normals);
 	copy->SetTangents(m_tangents);
@@ -312,9 +406,9 @@ Mesh* Mesh::GetCopy(const std::string& newName)
 // Mesh transformations (changes *this!):
 Mesh* Mesh::Translate(const Float3& translation)
 {
-	for (Float3& position : m_positions)
-		position += translation;
+	mathf::batch::Translate(m_positions, translation);
 	m_verticesUpdated = true;
+	m_boundsUpdated = true;
 	return this;
 }
 Mesh* Mesh::Rotate(const Float3x3& rotation)
@@ -322,33 +416,18 @@ Mesh* Mesh::Rotate(const Float3x3& rotation)
 	bool hasNormals = m_normals.size() == m_vertexCount;
 	bool hasTangents = m_tangents.size() == m_vertexCount;
 
-	for (uint32_t i = 0; i < m_vertexCount; i++)
-	{
-		m_positions[i] = rotation * m_positions[i];
-		if (hasNormals)
-			m_normals[i] = rotation * m_normals[i];
-		if (hasTangents)
-			m_tangents[i] = rotation * m_tangents[i];
-	}
+	mathf::batch::Transform(m_positions, rotation);
+	if (hasNormals)
+		mathf::batch::Transform(m_normals, rotation);
+	if (hasTangents)
+		mathf::batch::Transform(m_tangents, rotation);
 	m_verticesUpdated = true;
+	m_boundsUpdated = true;
 	return this;
 }
 Mesh* Mesh::Rotate(const Float4x4& rotation)
 {
-	Float3x3 rotation3x3 = Float3x3(rotation);
-	bool hasNormals = m_normals.size() == m_vertexCount;
-	bool hasTangents = m_tangents.size() == m_vertexCount;
-
-	for (uint32_t i = 0; i < m_vertexCount; i++)
-	{
-		m_positions[i] = rotation3x3 * m_positions[i];
-		if (hasNormals)
-			m_normals[i] = rotation3x3 * m_normals[i];
-		if (hasTangents)
-			m_tangents[i] = rotation3x3 * m_tangents[i];
-	}
-	m_verticesUpdated = true;
-	return this;
+	return Rotate(Float3x3(rotation));
 }
 Mesh* Mesh::Scale(const Float3& scale)
 {
@@ -356,15 +435,19 @@ Mesh* Mesh::Scale(const Float3& scale)
 	bool hasNormals = m_normals.size() == m_vertexCount;
 	bool hasTangents = m_tangents.size() == m_vertexCount;
 
-	for (uint32_t i = 0; i < m_vertexCount; i++)
+	mathf::batch::Scale(m_positions, scale);
+	if (hasNormals)
 	{
-		m_positions[i] = scale * m_positions[i];
-		if (hasNormals)
-			m_normals[i] = (invScale * m_normals[i]).Normalize();
-		if (hasTangents)
-			m_tangents[i] = (invScale * m_tangents[i]).Normalize();
+		mathf::batch::Scale(m_normals, invScale);
+		mathf::batch::Normalize(m_normals);
+	}
+	if (hasTangents)
+	{
+		mathf::batch::Scale(m_tangents, invScale);
+		mathf::batch::Normalize(m_tangents);
 	}
 	m_verticesUpdated = true;
+	m_boundsUpdated = true;
 	return this;
 }
 Mesh* Mesh::Scale(float scale)
@@ -471,14 +554,19 @@ Mesh* Mesh::Spherify(float factor, float radius)
 	bool hasNormals = m_normals.size() == m_vertexCount;
 	bool hasTangents = m_tangents.size() == m_vertexCount;
 
-	for (uint32_t i = 0; i < m_vertexCount; i++)
+	std::vector<Float3> sphereNormals = m_positions;
+	mathf::batch::Normalize(sphereNormals);
+	mathf::batch::Lerp(m_positions, sphereNormals, factor);
+	mathf::batch::Scale(m_positions, radius);
+	if (hasNormals)
 	{
-		Float3 sphereNormal = m_positions[i].Normalize();
-		m_positions[i] = radius * (m_positions[i] + factor * (sphereNormal - m_positions[i]));
-		if (hasNormals)
-			m_normals[i] = (m_normals[i] + factor * (sphereNormal - m_normals[i])).Normalize();
-		if (hasTangents)
-			m_tangents[i] = geometry3d::PointToPlaneProjection(m_tangents[i], Float3::zero, m_normals[i]).Normalize();
+		mathf::batch::Lerp(m_normals, sphereNormals, factor);
+		mathf::batch::Normalize(m_normals);
+	}
+	if (hasTangents)
+	{
+		mathf::batch::ProjectOnPlanes(m_tangents, m_normals);
+		mathf::batch::Normalize(m_tangents);
 	}
 
 	// Update mesh data (forces bool updates and logic):
@@ -692,6 +780,7 @@ std::string Mesh::ToString()
 #ifdef RESIZEABLE_BAR // No staging buffer:
 void Mesh::UpdateVertexBuffer(VulkanContext* pContext)
 {
+	EMBER_PROFILE_SCOPE("Mesh::UpdateVertexBuffer");
 	// Set zero values if vectors not set:
 	if (m_normals.size() != m_vertexCount)
 		m_normals.resize(m_vertexCount, Float3::zero);
@@ -737,6 +826,7 @@ void Mesh::UpdateVertexBuffer(VulkanContext* pContext)
 #else // With Staging buffer:
 void Mesh::UpdateVertexBuffer(VulkanContext* pContext)
 {
+	EMBER_PROFILE_SCOPE("Mesh::UpdateVertexBuffer");
 	// Set zero values if vectors not set:
 	if (m_normals.size() != m_vertexCount)
 		m_normals.resize(m_vertexCount, Float3::zero);
@@ -748,8 +838,11 @@ void Mesh::UpdateVertexBuffer(VulkanContext* pContext)
 		m_uvs.resize(m_vertexCount, Float4::zero);
 
 	uint64_t size = GetVertexBufferSize();
-	if (m_isLoaded)	// wait for previous render calls to finish if mesh could be in use already
+	if (m_isLoaded)	// wait for previous render calls and uploads to finish if mesh could be in use already
+	{
+		UploadManager::Flush();
 		vkQueueWaitIdle(pContext->pLogicalDevice->GetGraphicsQueue().queue);
+	}
 
 	// Resize buffer if necessary:
 	if (m_vertexBuffer == nullptr || size != m_vertexBuffer->GetSize())
@@ -769,28 +862,18 @@ void Mesh::UpdateVertexBuffer(VulkanContext* pContext)
 		m_vertexBuffer = std::make_unique<VmaBuffer>(pContext, pBufferInfo, pAllocInfo);
 	}
 
-	// Load data into staging buffer:
-	std::vector<void*> bufferPointers =
-	{ static_cast<void*>(m_positions.data()),
-	  static_cast<void*>(m_normals.data()),
-	  static_cast<void*>(m_tangents.data()),
-	  static_cast<void*>(m_colors.data()),
-	  static_cast<void*>(m_uvs.data())};
-	std::vector<uint64_t> bufferSizes =
-	{ static_cast<uint64_t>(GetSizeOfPositions()),
-	  static_cast<uint64_t>(GetSizeOfNormals()),
-	  static_cast<uint64_t>(GetSizeOfTangents()),
-	  static_cast<uint64_t>(GetSizeOfColors()),
-	  static_cast<uint64_t>(GetSizeOfUVs())};
-	VmaBuffer stagingBuffer = VmaBuffer::StagingBuffer(pContext, bufferSizes, bufferPointers);
-
-	// Copy data from staging to vertex buffer:
-	VmaBuffer::CopyBufferToBuffer(pContext, &stagingBuffer, m_vertexBuffer.get(), size, pContext->pLogicalDevice->GetGraphicsQueue());
+	// Queue copies of positions, normals, tangents, colors, uvs, submitted with the next upload batch:
+	UploadManager::UploadBuffer(m_vertexBuffer.get(), GetPositionsOffset(), m_positions.data(), GetSizeOfPositions());
+	UploadManager::UploadBuffer(m_vertexBuffer.get(), GetNormalsOffset(), m_normals.data(), GetSizeOfNormals());
+	UploadManager::UploadBuffer(m_vertexBuffer.get(), GetTangentsOffset(), m_tangents.data(), GetSizeOfTangents());
+	UploadManager::UploadBuffer(m_vertexBuffer.get(), GetColorsOffset(), m_colors.data(), GetSizeOfColors());
+	UploadManager::UploadBuffer(m_vertexBuffer.get(), GetUVsOffset(), m_uvs.data(), GetSizeOfUVs());
 }
 #endif
 #ifdef RESIZEABLE_BAR // No staging buffer:
 void Mesh::UpdateIndexBuffer(VulkanContext* pContext)
 {
+	EMBER_PROFILE_SCOPE("Mesh::UpdateIndexBuffer");
 	uint64_t size = GetSizeOfTriangles();
 	if (m_isLoaded)	// wait for previous render calls to finish if mesh could be in use already
 		vkQueueWaitIdle(pContext->pLogicalDevice->GetGraphicsQueue().queue);
@@ -822,9 +905,13 @@ void Mesh::UpdateIndexBuffer(VulkanContext* pContext)
 #else // With Staging buffer:
 void Mesh::UpdateIndexBuffer(VulkanContext* pContext)
 {
+	EMBER_PROFILE_SCOPE("Mesh::UpdateIndexBuffer");
 	uint64_t size = GetSizeOfTriangles();
-	if (m_isLoaded)	// wait for previous render calls to finish if mesh could be in use already
+	if (m_isLoaded)	// wait for previous render calls and uploads to finish if mesh could be in use already
+	{
+		UploadManager::Flush();
 		vkQueueWaitIdle(pContext->pLogicalDevice->GetGraphicsQueue().queue);
+	}
 
 	// Resize buffer if necessary:
 	if (m_indexBuffer == nullptr || size != m_indexBuffer->GetSize())
@@ -844,10 +931,104 @@ void Mesh::UpdateIndexBuffer(VulkanContext* pContext)
 		m_indexBuffer = std::make_unique<VmaBuffer>(pContext, pBufferInfo, pAllocInfo);
 	}
 
-	// Load data into staging buffer:
-	VmaBuffer stagingBuffer = VmaBuffer::StagingBuffer(pContext, size, GetTrianglesUnrolled());
+	// Queue copy of triangle indexes, submitted with the next upload batch:
+	UploadManager::UploadBuffer(m_indexBuffer.get(), 0, GetTrianglesUnrolled(), size);
+}
+#endif
+/// <summary>
+/// Resizes the frame vertex buffers if necessary and marks all of them as stale, no data is copied yet.
+/// </summary>
+void Mesh::UpdateFrameVertexBuffers(VulkanContext* pContext)
+{
+	EMBER_PROFILE_SCOPE("Mesh::UpdateFrameVertexBuffers");
+	// Set zero values if vectors not set:
+	if (m_normals.size() != m_vertexCount)
+		m_normals.resize(m_vertexCount, Float3::zero);
+	if (m_tangents.size() != m_vertexCount)
+		m_tangents.resize(m_vertexCount, Float3::zero);
+	if (m_colors.size() != m_vertexCount)
+		m_colors.resize(m_vertexCount, Float4::zero);
+	if (m_uvs.size() != m_vertexCount)
+		m_uvs.resize(m_vertexCount, Float4::zero);
 
-	// Copy data from staging to vertex buffer:
-	VmaBuffer::CopyBufferToBuffer(pContext, &stagingBuffer, m_indexBuffer.get(), size, pContext->pLogicalDevice->GetGraphicsQueue());
+	// Only a change of the vertex count has to wait for frames in flight:
+	uint64_t size = GetVertexBufferSize();
+	if (m_frameVertexBuffers.empty() || size != m_frameVertexBuffers[0]->GetSize())
+	{
+		if (m_isLoaded)
+			vkQueueWaitIdle(pContext->pLogicalDevice->GetGraphicsQueue().queue);
+		CreateFrameBuffers(pContext, m_frameVertexBuffers, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+	}
+	m_staleVertexBuffers = (1u << pContext->framesInFlight) - 1;
+}
+/// <summary>
+/// Resizes the frame index buffers if necessary and marks all of them as stale, no data is copied yet.
+/// </summary>
+void Mesh::UpdateFrameIndexBuffers(VulkanContext* pContext)
+{
+	EMBER_PROFILE_SCOPE("Mesh::UpdateFrameIndexBuffers");
+	uint64_t size = GetSizeOfTriangles();
+	if (m_frameIndexBuffers.empty() || size != m_frameIndexBuffers[0]->GetSize())
+	{
+		if (m_isLoaded)
+			vkQueueWaitIdle(pContext->pLogicalDevice->GetGraphicsQueue().queue);
+		CreateFrameBuffers(pContext, m_frameIndexBuffers, size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+	}
+	m_staleIndexBuffers = (1u << pContext->framesInFlight) - 1;
+}
+void Mesh::WriteFrameVertexBuffer(VulkanContext* pContext, uint32_t frameIndex)
+{
+	EMBER_PROFILE_SCOPE("Mesh::WriteFrameVertexBuffer");
+	VmaAllocation allocation = m_frameVertexBuffers[frameIndex]->GetVmaAllocation();
+	VmaAllocationInfo info;
+	vmaGetAllocationInfo(pContext->GetVmaAllocator(), allocation, &info);
+	char* pData = static_cast<char*>(info.pMappedData);
+	memcpy(pData + GetPositionsOffset(), m_positions.data(), GetSizeOfPositions());
+	memcpy(pData + GetNormalsOffset(), m_normals.data(), GetSizeOfNormals());
+	memcpy(pData + GetTangentsOffset(), m_tangents.data(), GetSizeOfTangents());
+	memcpy(pData + GetColorsOffset(), m_colors.data(), GetSizeOfColors());
+	memcpy(pData + GetUVsOffset(), m_uvs.data(), GetSizeOfUVs());
+	VKA(vmaFlushAllocation(pContext->GetVmaAllocator(), allocation, 0, VK_WHOLE_SIZE));	// memory may not be host coherent
+	m_staleVertexBuffers &= ~(1u << frameIndex);
+}
+void Mesh::WriteFrameIndexBuffer(VulkanContext* pContext, uint32_t frameIndex)
+{
+	EMBER_PROFILE_SCOPE("Mesh::WriteFrameIndexBuffer");
+	VmaAllocation allocation = m_frameIndexBuffers[frameIndex]->GetVmaAllocation();
+	VmaAllocationInfo info;
+	vmaGetAllocationInfo(pContext->GetVmaAllocator(), allocation, &info);
+	memcpy(info.pMappedData, GetTrianglesUnrolled(), GetSizeOfTriangles());
+	VKA(vmaFlushAllocation(pContext->GetVmaAllocator(), allocation, 0, VK_WHOLE_SIZE));	// memory may not be host coherent
+	m_staleIndexBuffers &= ~(1u << frameIndex);
+}
+/// <summary>
+/// One persistently mapped buffer per frame in flight. dynamicDraw prefers device local memory that is host visible
+/// (resizable BAR), as the data is read by several passes per frame. streamDraw data is read a few times only and stays in host memory.
+/// </summary>
+void Mesh::CreateFrameBuffers(VulkanContext* pContext, std::vector<std::unique_ptr<VmaBuffer>>& buffers, uint64_t size, VkBufferUsageFlags usage)
+{
+	buffers.resize(pContext->framesInFlight);
+	for (std::unique_ptr<VmaBuffer>& buffer : buffers)
+	{
+		VkBufferCreateInfo* pBufferInfo = new VkBufferCreateInfo();
+		pBufferInfo->sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		pBufferInfo->size = size;
+		pBufferInfo->usage = usage;
+		pBufferInfo->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VmaAllocationCreateInfo* pAllocInfo = new VmaAllocationCreateInfo();
+		pAllocInfo->usage = (m_usage == Usage::dynamicDraw) ? VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE : VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+		pAllocInfo->flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+		pAllocInfo->requiredFlags = 0;
+		pAllocInfo->preferredFlags = 0;
+
+		buffer = std::make_unique<VmaBuffer>(pContext, pBufferInfo, pAllocInfo);
+	}
 }
-#endif
\ No newline at end of file
+void Mesh::UpdateBounds()
+{
+	// Bounding sphere is centered on the box, which is tighter than the box half diagonal for most meshes:
+	m_bounds = Bounds(m_positions);
+	m_boundingRadius = mathf::Sqrt(mathf::batch::MaxDistanceSq(m_positions, m_bounds.center));
+	m_boundsUpdated = false;
+}
\ No newline at end of file
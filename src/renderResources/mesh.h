@@ -19,24 +19,47 @@ struct VulkanContext;
 /// Normalization of normals and tangets must be done manually if they are not computed with ComputeNormals()/ComputeTangents().
 /// Mesh class does not guarantee validity of the mesh data.
 /// Static meshes should be stored as pointers in the static MeshManager class.
+/// The usage hint decides how modified vertex and index data reaches the gpu, see Mesh::Usage.
 /// </summary>
 class Mesh
 {
+public: // Enums:
+	/// <summary>
+	/// staticDraw:	device local buffers, filled by the UploadManager. Modifying a loaded mesh waits for the graphics queue to idle. <para/>
+	/// dynamicDraw:	one host visible buffer per frame in flight, preferably device local. Modified data is copied into the buffer of the current frame, without waiting. <para/>
+	/// streamDraw:	like dynamicDraw, but in host memory, for data that is rewritten every frame and read only a few times.
+	/// </summary>
+	enum class Usage
+	{
+		staticDraw,
+		dynamicDraw,
+		streamDraw
+	};
+
 private: // Members:
 	std::string m_name;
+	Usage m_usage = Usage::staticDraw;
 	bool m_isLoaded = false;
 	bool m_verticesUpdated = false;
 	bool m_indicesUpdated = false;
+	bool m_boundsUpdated = true;
 	uint32_t m_vertexCount = 0;
 	uint32_t m_triangleCount = 0;
 	std::unique_ptr<VmaBuffer> m_vertexBuffer;
 	std::unique_ptr<VmaBuffer> m_indexBuffer;
+	std::vector<std::unique_ptr<VmaBuffer>> m_frameVertexBuffers;	// dynamicDraw/streamDraw, one per frame in flight
+	std::vector<std::unique_ptr<VmaBuffer>> m_frameIndexBuffers;	// dynamicDraw/streamDraw, one per frame in flight
+	uint32_t m_staleVertexBuffers = 0;	// bit mask of frame buffers that miss the latest vertex data
+	uint32_t m_staleIndexBuffers = 0;	// bit mask of frame buffers that miss the latest index data
+	uint64_t m_version = 0;	// incremented whenever vertex or index data is sent to the gpu
 	std::vector<Float3> m_positions;
 	std::vector<Float3> m_normals;
 	std::vector<Float3> m_tangents;
 	std::vector<Float4> m_colors;
 	std::vector<Float4> m_uvs;
 	std::vector<Uint3> m_triangles;
+	Bounds m_bounds;
+	float m_boundingRadius = 0.0f;
 
 public: // Methods:
 	Mesh(const std::string& name = "");
@@ -52,6 +75,7 @@ public: // Methods:
 	
 	// Setters:
 	void SetName(const std::string& name);
+	void SetUsage(Usage usage);
 	void SetPositions(const std::vector<Float3>& positions);
 	void SetNormals(const std::vector<Float3>& normals);
 	void SetTangents(const std::vector<Float3>& tangents);
@@ -70,6 +94,8 @@ public: // Methods:
 
 	// Getters:
 	std::string GetName() const;
+	Usage GetUsage() const;
+	uint64_t GetVersion() const;
 	uint32_t GetVertexCount() const;
 	uint32_t GetTriangleCount() const;
 	std::vector<Float3>& GetPositions();
@@ -79,6 +105,8 @@ public: // Methods:
 	std::vector<Float4>& GetUVs();
 	std::vector<Uint3>& GetTriangles();
 	uint32_t* GetTrianglesUnrolled();
+	const Bounds& GetBounds();
+	Float4 GetBoundingSphere();	// xyz = center, w = radius, in local space.
 	uint32_t GetSizeOfPositions() const;
 	uint32_t GetSizeOfNormals() const;
 	uint32_t GetSizeOfTangents() const;
@@ -117,6 +145,12 @@ public: // Methods:
 private: // Methods:
 	void UpdateVertexBuffer(VulkanContext* pContext);
 	void UpdateIndexBuffer(VulkanContext* pContext);
+	void UpdateFrameVertexBuffers(VulkanContext* pContext);
+	void UpdateFrameIndexBuffers(VulkanContext* pContext);
+	void WriteFrameVertexBuffer(VulkanContext* pContext, uint32_t frameIndex);
+	void WriteFrameIndexBuffer(VulkanContext* pContext, uint32_t frameIndex);
+	void CreateFrameBuffers(VulkanContext* pContext, std::vector<std::unique_ptr<VmaBuffer>>& buffers, uint64_t size, VkBufferUsageFlags usage);
+	void UpdateBounds();
 };
 
 
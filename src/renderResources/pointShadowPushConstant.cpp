@@ -0,0 +1,23 @@
+#include "pointShadowPushConstant.h"
+
+
+
+// Constructor:
+PointShadowPushConstant::PointShadowPushConstant(const Float4x4& localToWorldMatrix, uint32_t pointLightIndex, uint32_t faceIndices)
+{
+	this->localToWorldMatrix = localToWorldMatrix;
+	this->pointLightIndex = pointLightIndex;
+	this->faceIndices = faceIndices;
+}
+
+
+
+// Public methods:
+std::string PointShadowPushConstant::ToString()
+{
+	std::string output = "PointShadowPushConstant:\n";
+	output += "LocalToWorldMatrix: " + localToWorldMatrix.ToString() + "\n";
+	output += "PointLightIndex: " + std::to_string(pointLightIndex) + "\n";
+	output += "FaceIndices: " + std::to_string(faceIndices) + "\n";
+	return output;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef __INCLUDE_GUARD_pointShadowPushConstant_h__
+#define __INCLUDE_GUARD_pointShadowPushConstant_h__
+#include "mathf.h"
+#include <string>
+
+
+
+/// <summary>
+/// Size limit for push constants is 128 bytes.
+/// Push constant of the single pass point light shadow draws. The cube face matrices and atlas tiles
+/// are read from the point light data in FrameData, instance i renders face (faceIndices >> 4 * i) & 0xF.
+/// </summary>
+struct PointShadowPushConstant
+{
+public: // Members:
+	alignas(16) Float4x4 localToWorldMatrix;
+	alignas(4) uint32_t pointLightIndex;
+	alignas(4) uint32_t faceIndices;
+
+public: // Methods:
+	PointShadowPushConstant(const Float4x4& localToWorldMatrix, uint32_t pointLightIndex, uint32_t faceIndices);
+	std::string ToString();
+};
+
+
+
+#endif // __INCLUDE_GUARD_pointShadowPushConstant_h__
\ No newline at end of file
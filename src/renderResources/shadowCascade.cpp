@@ -1,139 +1,114 @@
 #include "shadowCascade.h"
-#include "camera.h"
-#include "emberEngine.h"
-
-
-
-// static members:
-Float4 ShadowCascade::s_frustumCorners_Clip[8] =
-{
-	Float4(-1, -1, -1, 1),
-	Float4(-1, -1,  1, 1),
-	Float4(-1,  1, -1, 1),
-	Float4(-1,  1,  1, 1),
-	Float4(1, -1, -1, 1),
-	Float4(1, -1,  1, 1),
-	Float4(1,  1, -1, 1),
-	Float4(1,  1,  1, 1)
-};
-
-
-
-// Constructor:
-ShadowCascade::ShadowCascade(Camera* const pCamera, const Float3& direction_World, float nearDepth, float farDepth, float worldHeight)
-{
-	m_pCamera = pCamera;
-	m_direction_World = direction_World;
-
-	ComputeSubFrustumCorners_World(nearDepth, farDepth);
-	Float3 subFrustumCenter_World = SubFrustumCenter_World();
-	// Add 1 to world height to compensate the near clip plane of 1.
-	m_position_World = ComputeLightPosition_World(worldHeight + 1.0f);
-	ComputeSubFrustumCorners_LightLocal(m_position_World, direction_World);
-
-	// Construct bounding box that encapsulates the sub frustum corners and the light source in light local space:
-	Bounds bounds = Bounds(m_subFrustumCorners_LightLocal);
-	bounds.Encapsulate(Float3::zero);	// light source itself.
-	m_width = bounds.GetSize().x;
-	m_height = bounds.GetSize().y;
-	m_farClip = bounds.GetSize().z;
-
-	Graphics::DrawBounds(Float4x4::identity, bounds);
-	Graphics::DrawSphere(Float3::zero, 0.5f, Float4::green);
-	for (int i = 0; i < 8; i++)
-		Graphics::DrawSphere(m_subFrustumCorners_LightLocal[i], 0.5f, Float4::red);
-}
+#include <algorithm>
+#include <cmath>
 
 
 
 // Public methods:
-Float3 ShadowCascade::GetPosition() const
-{
-	return m_position_World;
-}
-Float3 ShadowCascade::GetDirection() const
-{
-	return m_direction_World;
-}
-Float4x4 ShadowCascade::GetLightLocalToWorldMatrix() const
+/// <summary>
+/// Splits the camera frustum between nearClip and min(maxShadowDistance, farClip) into cascadeCount slices.
+/// pSplits holds the cascadeCount - 1 inner split positions as fractions of that distance.
+/// lightDirection points from the light towards the scene, see DirectionalLight::GetDirection().
+/// </summary>
+void ShadowCascadeSolver::Solve(const Float4x4& cameraLocalToWorldMatrix, float fov, float aspectRatio, float nearClip, float farClip,
+	const Float3& lightDirection, uint32_t cascadeCount, const float* pSplits, float maxShadowDistance, uint32_t shadowMapSize,
+	std::array<ShadowCascade, s_maxCascadeCount>& cascades)
 {
-	return m_lightLocalToWorldMatrix;
-}
-Float4x4 ShadowCascade::GetProjectionMatrix() const
-{
-	float left = -m_width / 2.0f;
-	float right = m_width / 2.0f;
-	float bottom = -m_height / 2.0f;
-	float top = m_height / 2.0f;
-	return Float4x4::Orthographic(left, right, bottom, top, m_nearClip, m_farClip);
-}
-
-
-// Private methods:
-void ShadowCascade::ComputeSubFrustumCorners_World(float nearDepth, float farDepth)
-{
-	Float4x4 clipToCameraLocalMatrix = m_pCamera->GetProjectionMatrix().Inverse();
-	Float4x4 cameraLocalToWorldMatrix = m_pCamera->GetTransform()->GetLocalToWorldMatrix();
-
-	Float3 frustumCorners_World[8];
-	for (uint32_t i = 0; i < 8; i++)
+	cascadeCount = std::clamp(cascadeCount, 1u, s_maxCascadeCount);
+	float shadowDistance = mathf::Max(mathf::Min(maxShadowDistance, farClip), nearClip);
+
+	// Camera frustum edges, a corner at view distance d is cameraPosition + d * corner ray:
+	float tanHalfFovY = mathf::Tan(0.5f * fov);
+	float tanHalfFovX = aspectRatio * tanHalfFovY;
+	Float3 cameraPosition = Float3(cameraLocalToWorldMatrix.GetColumn(3));
+	Float3 cameraRight = Float3(cameraLocalToWorldMatrix.GetColumn(0));
+	Float3 cameraUp = Float3(cameraLocalToWorldMatrix.GetColumn(1));
+	Float3 cameraForward = -Float3(cameraLocalToWorldMatrix.GetColumn(2));	// cameras look along their local -z axis
+	Float3 cornerRays[4] =
+	{
+		cameraForward - tanHalfFovX * cameraRight - tanHalfFovY * cameraUp,
+		cameraForward + tanHalfFovX * cameraRight - tanHalfFovY * cameraUp,
+		cameraForward - tanHalfFovX * cameraRight + tanHalfFovY * cameraUp,
+		cameraForward + tanHalfFovX * cameraRight + tanHalfFovY * cameraUp
+	};
+
+	// Light space basis, looking along -z. Depends on the light direction only, so texel snapping is stable:
+	Float3 lightZ = -lightDirection.Normalize();
+	Float3 helperUp = mathf::Abs(lightZ.y) < 0.99f ? Float3::up : Float3::forward;
+	Float3 lightX = Float3::Cross(helperUp, lightZ).Normalize();
+	Float3 lightY = Float3::Cross(lightZ, lightX);
+	Float4x4 viewMatrix = Float4x4::Rows
+	(lightX.x, lightX.y, lightX.z, 0.0f,
+	 lightY.x, lightY.y, lightY.z, 0.0f,
+	 lightZ.x, lightZ.y, lightZ.z, 0.0f,
+	 0.0f, 0.0f, 0.0f, 1.0f);
+
+	// Camera position and corner rays in light space (depth = -z), slice corners are then cheap multiply adds:
+	auto toLight = [&](const Float3& vector) { return Float3(Float3::Dot(vector, lightX), Float3::Dot(vector, lightY), -Float3::Dot(vector, lightZ)); };
+	Float3 cameraPosition_Light = toLight(cameraPosition);
+	Float3 cornerRays_Light[4] = { toLight(cornerRays[0]), toLight(cornerRays[1]), toLight(cornerRays[2]), toLight(cornerRays[3]) };
+
+	// Squared distance of the corners to the view axis per unit view distance:
+	float cornerSlopeSq = tanHalfFovX * tanHalfFovX + tanHalfFovY * tanHalfFovY;
+	float nearDistance = nearClip;
+	for (uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; cascadeIndex++)
 	{
-		Float4 frustumCorners_CameraLocal = clipToCameraLocalMatrix * s_frustumCorners_Clip[i];
-		frustumCorners_CameraLocal /= frustumCorners_CameraLocal.w;
-		frustumCorners_World[i] = Float3(cameraLocalToWorldMatrix * frustumCorners_CameraLocal);
+		float farDistance = (cascadeIndex + 1 < cascadeCount) ? mathf::Clamp(pSplits[cascadeIndex] * shadowDistance, nearDistance, shadowDistance) : shadowDistance;
+
+		// Smallest sphere around the slice, its center lies on the view axis and is equally far from the near and far corners:
+		float centerDistance = mathf::Min(0.5f * (nearDistance + farDistance) * (1.0f + cornerSlopeSq), farDistance);
+		float radius = mathf::Sqrt((farDistance - centerDistance) * (farDistance - centerDistance) + farDistance * farDistance * cornerSlopeSq);
+		radius = std::ceil(radius * 16.0f) / 16.0f;	// float noise must not change the texel size
+
+		// Snap the sphere center to whole texels in light space:
+		Float3 center_Light = toLight(cameraPosition + centerDistance * cameraForward);
+		float texelSize = 2.0f * radius / static_cast<float>(shadowMapSize);
+		float texelsPerUnit = 1.0f / texelSize;
+		float centerX = std::floor(center_Light.x * texelsPerUnit) * texelSize;
+		float centerY = std::floor(center_Light.y * texelsPerUnit) * texelSize;
+		float centerDepth = center_Light.z;
+
+		// Float4x4::Orthographic(centerX -+ radius, centerY -+ radius, centerDepth - 3 * radius, centerDepth + radius) and projection * view,
+		// written out directly as the view is a pure rotation. The near plane lies one diameter in front of the sphere,
+		// so the sphere itself maps to clip depth [0,1], the range that is rasterized and sampled:
+		ShadowCascade& cascade = cascades[cascadeIndex];
+		float scale = 1.0f / radius;
+		float depthScale = 0.5f * scale;
+		float nearDepth = centerDepth - radius;
+		cascade.viewMatrix = viewMatrix;
+		cascade.projectionMatrix = Float4x4::Rows
+		(scale, 0.0f, 0.0f, -scale * centerX,
+		 0.0f, scale, 0.0f, -scale * centerY,
+		 0.0f, 0.0f, -depthScale, -depthScale * nearDepth,
+		 0.0f, 0.0f, 0.0f, 1.0f);
+		cascade.worldToClipMatrix = Float4x4::Rows
+		(scale * lightX.x, scale * lightX.y, scale * lightX.z, -scale * centerX,
+		 scale * lightY.x, scale * lightY.y, scale * lightY.z, -scale * centerY,
+		 -depthScale * lightZ.x, -depthScale * lightZ.y, -depthScale * lightZ.z, -depthScale * nearDepth,
+		 0.0f, 0.0f, 0.0f, 1.0f);
+		cascade.nearDistance = nearDistance;
+		cascade.farDistance = farDistance;
+
+		// Light space bounds of the 8 slice corners, clamped to the snapped square. Casters in front of the slice still throw shadows into it:
+		Float3 min = Float3(centerX + radius, centerY + radius, centerDepth + radius);
+		Float3 max = Float3(centerX - radius, centerY - radius, centerDepth - radius);
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			Float3 nearCorner_Light = cameraPosition_Light + nearDistance * cornerRays_Light[i];
+			Float3 farCorner_Light = cameraPosition_Light + farDistance * cornerRays_Light[i];
+			min = Float3::Min(min, Float3::Min(nearCorner_Light, farCorner_Light));
+			max = Float3::Max(max, Float3::Max(nearCorner_Light, farCorner_Light));
+		}
+		min = Float3::Max(min, Float3(centerX - radius, centerY - radius, centerDepth - radius));
+		max = Float3::Min(max, Float3(centerX + radius, centerY + radius, centerDepth + radius));
+		max = Float3::Max(max, min + Float3(1e-3f));	// zero sized slices would make the projection singular
+		cascade.casterFrustum.planes[0] = Float4(lightX, -min.x);
+		cascade.casterFrustum.planes[1] = Float4(-lightX, max.x);
+		cascade.casterFrustum.planes[2] = Float4(lightY, -min.y);
+		cascade.casterFrustum.planes[3] = Float4(-lightY, max.y);
+		cascade.casterFrustum.planes[4] = Float4(0.0f, 0.0f, 0.0f, 1.0f);	// no near plane
+		cascade.casterFrustum.planes[5] = Float4(lightZ, max.z);
+
+		nearDistance = farDistance;
 	}
-
-	// Sub frustum corners in camera space:
-	// nearDepth, farDepth  [0,1] are the percentile splits of the camera frustum.
-	m_subFrustumCorners_World[0] = frustumCorners_World[0] + nearDepth * (frustumCorners_World[1] - frustumCorners_World[0]);
-	m_subFrustumCorners_World[1] = frustumCorners_World[0] + farDepth  * (frustumCorners_World[1] - frustumCorners_World[0]);
-	m_subFrustumCorners_World[2] = frustumCorners_World[2] + nearDepth * (frustumCorners_World[3] - frustumCorners_World[2]);
-	m_subFrustumCorners_World[3] = frustumCorners_World[2] + farDepth  * (frustumCorners_World[3] - frustumCorners_World[2]);
-	m_subFrustumCorners_World[4] = frustumCorners_World[4] + nearDepth * (frustumCorners_World[5] - frustumCorners_World[4]);
-	m_subFrustumCorners_World[5] = frustumCorners_World[4] + farDepth  * (frustumCorners_World[5] - frustumCorners_World[4]);
-	m_subFrustumCorners_World[6] = frustumCorners_World[6] + nearDepth * (frustumCorners_World[7] - frustumCorners_World[6]);
-	m_subFrustumCorners_World[7] = frustumCorners_World[6] + farDepth  * (frustumCorners_World[7] - frustumCorners_World[6]);
-
-	for (uint32_t i = 0; i < 8; i++)
-		Graphics::DrawSphere(m_subFrustumCorners_World[i], 0.5f, Float4::blue);
-}
-Float3 ShadowCascade::SubFrustumCenter_World() const
-{
-	Float3 subFrustumCenter_World = Float3::zero;
-	for (uint32_t i = 0; i < 8; i++)
-		subFrustumCenter_World += m_subFrustumCorners_World[i];
-	return subFrustumCenter_World / 8.0f;
-}
-Float3 ShadowCascade::ComputeLightPosition_World(float worldHeight) const
-{
-	// This is wrong!
-	// Correct way: (needs Float2x3/Float3x2 (?) implementation)
-	// -Project all 8 sub frumstum corners to a plane that is perpendicular to the light direction.
-	// -Compute xy-Coordinates of all 8 projected points in coordinate system of the plane.
-	//  right = (1,0) is given by m_pCamera->GetTransform()->GetRight()
-	//  up = (0,1) is given by the cross product of the light direction and the right vector.
-	// -Compute min and max of the xy points.
-	// -Compute center of the min-max rectangle.
-	// -Transform this center point back to 3d space.
-	// -Compute LinePlaneIntersection from this point to the plane with normal (0,0,1) and support (0,0,worldHeight).
-	// -This is the light position.
-	Float3 centerProjection = Float3::zero;
-	for (uint32_t i = 0; i < 8; i++)
-		centerProjection += geometry3d::PointToPlaneProjection(m_subFrustumCorners_World[i], Float3::zero, -m_direction_World);
-	centerProjection /= 8.0f;
-
-	Float3 planeNormal = Float3::up;
-	Float3 planeSupport = worldHeight * Float3::up;
-	return geometry3d::LinePlaneIntersection(centerProjection, m_direction_World, planeSupport, planeNormal);
-}
-void ShadowCascade::ComputeSubFrustumCorners_LightLocal(const Float3& position_World, const Float3& direction_World)
-{
-	// Transform sub frustum corners to local space of shadow cascade light source:
-	Float3 cameraRight = m_pCamera->GetTransform()->GetRight();
-	Float4x4 posMatrix = Float4x4::Translate(position_World);
-	Float4x4 rotMatrix = Float4x4::RotateThreeLeg(Float3::forward, -direction_World, Float3::right, cameraRight);
-	m_lightLocalToWorldMatrix = posMatrix * rotMatrix;
-	Float4x4 worldToLightLocalMatrix = m_lightLocalToWorldMatrix.Inverse();
-	for (uint32_t i = 0; i < 8; i++)
-		m_subFrustumCorners_LightLocal[i] = Float3(worldToLightLocalMatrix * Float4(m_subFrustumCorners_World[i], 1.0f));
 }
\ No newline at end of file
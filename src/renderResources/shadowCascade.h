@@ -1,41 +1,48 @@
 #ifndef __INCLUDE_GUARD_shadowCascade_h__
 #define __INCLUDE_GUARD_shadowCascade_h__
 #include "mathf.h"
+#include <array>
 
 
 
-class Camera;
+/// <summary>
+/// One cascade of a directional light shadow, i.e. the light view projection that covers
+/// the camera frustum slice between nearDistance and farDistance (camera view distances).
+/// </summary>
+struct ShadowCascade
+{
+	Float4x4 viewMatrix;			// world to light rotation, the light space origin is the world origin
+	Float4x4 projectionMatrix;		// orthographic, bounding square of the slice snapped to shadow map texels
+	Float4x4 worldToClipMatrix;		// projection * view
+	Frustum casterFrustum;			// tight bounds of the slice in light space, extruded towards the light
+	float nearDistance;
+	float farDistance;
+};
 
 
 
-class ShadowCascade
+/// <summary>
+/// Allocation free cascade solver for directional light shadows, all cascades are written into a fixed array.
+/// Every cascade covers the bounding sphere of its camera frustum slice. The sphere radius does not depend on the
+/// camera orientation and its center is snapped to shadow map texels, so the shadows do not shimmer when the camera moves.
+/// Casters are culled against the tighter light space bounds of the slice instead of the whole sphere.
+/// </summary>
+class ShadowCascadeSolver
 {
-private: // Members:
-	static Float4 s_frustumCorners_Clip[8];
-	Camera* m_pCamera;
-	Float3 m_position_World;
-	Float3 m_direction_World;
-	Float4x4 m_lightLocalToWorldMatrix;
-	float m_width;
-	float m_height;
-	float m_nearClip = 1.0f;
-	float m_farClip;
-	Float3 m_subFrustumCorners_World[8];
-	Float3 m_subFrustumCorners_LightLocal[8];
+public: // Members:
+	static constexpr uint32_t s_maxCascadeCount = 4;
 
 public: // Methods:
-	ShadowCascade(Camera* const pCamera, const Float3& direction_World, float nearDepth, float farDepth, float worldHeight);
-	Float3 GetPosition() const;
-	Float3 GetDirection() const;
-	Float4x4 GetLightLocalToWorldMatrix() const;
-	Float4x4 GetProjectionMatrix() const;
-
+	static void Solve(const Float4x4& cameraLocalToWorldMatrix, float fov, float aspectRatio, float nearClip, float farClip,
+		const Float3& lightDirection, uint32_t cascadeCount, const float* pSplits, float maxShadowDistance, uint32_t shadowMapSize,
+		std::array<ShadowCascade, s_maxCascadeCount>& cascades);
 
 private: // Methods:
-	void ComputeSubFrustumCorners_World(float nearDepth, float farDepth);
-	Float3 SubFrustumCenter_World() const;
-	Float3 ComputeLightPosition_World(float worldHeight) const;
-	void ComputeSubFrustumCorners_LightLocal(const Float3& position_World, const Float3& direction_World);
+	// Delete all constructors:
+	ShadowCascadeSolver() = delete;
+	ShadowCascadeSolver(const ShadowCascadeSolver&) = delete;
+	ShadowCascadeSolver& operator=(const ShadowCascadeSolver&) = delete;
+	~ShadowCascadeSolver() = delete;
 };
 
 
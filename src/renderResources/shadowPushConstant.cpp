@@ -3,10 +3,9 @@
 
 
 // Constructor:
-ShadowPushConstant::ShadowPushConstant(int shadowMapIndex, const Float4x4& localToClipMatrix)
+ShadowPushConstant::ShadowPushConstant(const Float4x4& localToClipMatrix)
 {
 	this->localToClipMatrix = localToClipMatrix;
-	this->shadowMapIndex = shadowMapIndex;
 }
 
 
@@ -15,7 +14,6 @@ ShadowPushConstant::ShadowPushConstant(int shadowMapIndex, const Float4x4& local
 std::string ShadowPushConstant::ToString()
 {
 	std::string output = "ShadowPushConstant:\n";
-	output += "ShadowMapIndex: " + std::to_string(shadowMapIndex) + "\n";
 	output += "LocalToClipMatrix: " + localToClipMatrix.ToString() + "\n";
 	return output;
 }
\ No newline at end of file
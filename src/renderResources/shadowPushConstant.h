@@ -12,11 +12,10 @@
 struct ShadowPushConstant
 {
 public: // Members:
-	alignas(4) int shadowMapIndex;
 	alignas(16) Float4x4 localToClipMatrix;
 
 public: // Methods:
-	ShadowPushConstant(int shadowMapIndex, const Float4x4& localToClipMatrix);
+	ShadowPushConstant(const Float4x4& localToClipMatrix);
 	std::string ToString();
 };
 
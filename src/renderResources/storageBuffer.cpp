@@ -0,0 +1,63 @@
+#include "storageBuffer.h"
+#include "logger.h"
+#include "vmaBuffer.h"
+#include "vulkanContext.h"
+#include <cstring>
+
+
+
+// Constructor/Destructor:
+StorageBuffer::StorageBuffer(VulkanContext* pContext, uint64_t size)
+{
+	m_pContext = pContext;
+	m_size = size;
+
+	// Create buffer:
+	VkBufferCreateInfo* pBufferInfo = new VkBufferCreateInfo();
+	pBufferInfo->sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	pBufferInfo->size = m_size;
+	pBufferInfo->usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+	pBufferInfo->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	VmaAllocationCreateInfo* pAllocInfo = new VmaAllocationCreateInfo();
+	pAllocInfo->usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+	pAllocInfo->flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+	pAllocInfo->requiredFlags = 0;
+	pAllocInfo->preferredFlags = 0;
+
+	m_buffer = std::make_shared<VmaBuffer>(m_pContext, pBufferInfo, pAllocInfo);
+
+	// Get deviceData pointer:
+	VmaAllocationInfo info;
+	vmaGetAllocationInfo(m_pContext->GetVmaAllocator(), m_buffer->GetVmaAllocation(), &info);
+	m_pDeviceData = info.pMappedData;
+}
+StorageBuffer::~StorageBuffer()
+{
+	m_pContext->WaitDeviceIdle();
+}
+
+
+
+// Public methods:
+void StorageBuffer::UpdateBuffer(const void* pData, uint64_t offset, uint64_t size)
+{
+	if (offset + size > m_size)
+	{
+		LOG_WARN("StorageBuffer::UpdateBuffer() out of range: offset {} + size {} > buffer size {}.", offset, size, m_size);
+		return;
+	}
+	memcpy(static_cast<char*>(m_pDeviceData) + offset, pData, size);
+}
+
+
+
+// Getters:
+uint64_t StorageBuffer::GetSize() const
+{
+	return m_size;
+}
+const std::shared_ptr<VmaBuffer>& StorageBuffer::GetVmaBuffer() const
+{
+	return m_buffer;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef __INCLUDE_GUARD_storageBuffer_h__
+#define __INCLUDE_GUARD_storageBuffer_h__
+#include "vk_mem_alloc.h"
+#include <vulkan/vulkan.h>
+#include <memory>
+
+
+
+class VmaBuffer;
+struct VulkanContext;
+
+
+
+/// <summary>
+/// Persistently mapped, host visible storage buffer (StructuredBuffer in HLSL).
+/// Unlike UniformBuffer there is no reflected layout, data is written as raw bytes.
+/// </summary>
+class StorageBuffer
+{
+private: // Members:
+	std::shared_ptr<VmaBuffer> m_buffer;
+	void* m_pDeviceData;
+	uint64_t m_size;
+	VulkanContext* m_pContext;
+
+public: // Methods:
+	StorageBuffer(VulkanContext* pContext, uint64_t size);
+	~StorageBuffer();
+
+	void UpdateBuffer(const void* pData, uint64_t offset, uint64_t size);
+
+	// Getters:
+	uint64_t GetSize() const;
+	const std::shared_ptr<VmaBuffer>& GetVmaBuffer() const;
+};
+
+
+
+#endif // __INCLUDE_GUARD_storageBuffer_h__
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "logger.h"
 #include "texture2d.h"
 #include "stb_image.h"
-#include "vmaBuffer.h"
+#include "uploadManager.h"
 #include "vmaImage.h"
 #include "vulkanContext.h"
 
@@ -40,10 +40,6 @@ Texture2d::Texture2d(VulkanContext* pContext, const std::filesystem::path& fileP
 	if (!pPixels)
 		throw std::runtime_error("Failed to load texture image!");
 
-	// Create staging buffer:
-	uint64_t bufferSize = 4 * m_width * m_height;
-	VmaBuffer stagingBuffer = VmaBuffer::StagingBuffer(m_pContext, bufferSize, pPixels);
-
 	// Define subresource range:
 	VkImageSubresourceRange* pSubresourceRange = new VkImageSubresourceRange();
 	pSubresourceRange->aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -52,8 +48,10 @@ Texture2d::Texture2d(VulkanContext* pContext, const std::filesystem::path& fileP
 	pSubresourceRange->baseArrayLayer = 0;
 	pSubresourceRange->layerCount = 1;
 
+	// Mipmaps are generated by the upload:
+	uint64_t bufferSize = 4 * m_width * m_height;
 	CreateImage(pSubresourceRange, m_width, m_height, format, (VkImageCreateFlagBits)0);
-	TransitionImageLayoutWithMipMapping(pSubresourceRange, stagingBuffer);
+	UploadManager::UploadImage(m_pImage.get(), pPixels, bufferSize);
 	stbi_image_free(pPixels);
 }
 Texture2d::~Texture2d()
@@ -114,17 +112,4 @@ void Texture2d::CreateImage(VkImageSubresourceRange* pSubresourceRange, uint32_t
 	pAllocInfo->preferredFlags = 0;
 
 	m_pImage = std::make_unique<VmaImage>(m_pContext, pImageInfo, pAllocInfo, pSubresourceRange);
-}
-void Texture2d::TransitionImageLayout(VkImageSubresourceRange* pSubresourceRange, VmaBuffer& stagingBuffer)
-{
-	m_pImage->TransitionLayoutUndefinedToTransfer();
-	VmaBuffer::CopyBufferToImage(m_pContext, &stagingBuffer, m_pImage.get(), m_pContext->pLogicalDevice->GetTransferQueue(), pSubresourceRange->layerCount);
-	m_pImage->TransitionLayoutTransferToShaderRead();
-}
-void Texture2d::TransitionImageLayoutWithMipMapping(VkImageSubresourceRange* pSubresourceRange, VmaBuffer& stagingBuffer)
-{
-	m_pImage->TransitionLayoutUndefinedToTransfer();
-	VmaBuffer::CopyBufferToImage(m_pContext, &stagingBuffer, m_pImage.get(), m_pContext->pLogicalDevice->GetTransferQueue(), pSubresourceRange->layerCount);
-	m_pImage->HandoffTransferToGraphicsQueue();
-	m_pImage->GenerateMipmaps(pSubresourceRange->levelCount);
 }
\ No newline at end of file
@@ -8,7 +8,6 @@
 
 
 struct VulkanContext;
-class VmaBuffer;
 class VmaImage;
 
 
@@ -38,8 +37,6 @@ public: // Methods:
 protected: // Methods:
 	Texture2d();
 	void CreateImage(VkImageSubresourceRange* pSubresourceRange, uint32_t width, uint32_t height, VkFormat format, VkImageCreateFlagBits imageFlags);
-	void TransitionImageLayout(VkImageSubresourceRange* pSubresourceRange, VmaBuffer& stagingBuffer);
-	void TransitionImageLayoutWithMipMapping(VkImageSubresourceRange* pSubresourceRange, VmaBuffer& stagingBuffer);
 };
 
 
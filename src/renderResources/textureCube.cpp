@@ -1,7 +1,7 @@
 // needs to be defined before including stb_image.h, but may not be in the header file!
 #include "textureCube.h"
 #include "stb_image.h"
-#include "vmaBuffer.h"
+#include "uploadManager.h"
 #include "vmaImage.h"
 #include "vulkanContext.h"
 #include <array>
@@ -49,9 +49,6 @@ TextureCube::TextureCube(VulkanContext* pContext, const std::filesystem::path& f
 		stbi_image_free(pPixels);
 	}
 	
-	// Create staging buffer:
-	VmaBuffer stagingBuffer = VmaBuffer::StagingBuffer(m_pContext, bufferSize, pFacePixels);
-	
 	// Define subresource range:
 	VkImageSubresourceRange* pSubresourceRange = new VkImageSubresourceRange();
 	pSubresourceRange->aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -61,7 +58,7 @@ TextureCube::TextureCube(VulkanContext* pContext, const std::filesystem::path& f
 	pSubresourceRange->layerCount = 6;
 	
 	CreateImage(pSubresourceRange, width, height, format, VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT);
-	TransitionImageLayout(pSubresourceRange, stagingBuffer);
+	UploadManager::UploadImage(m_pImage.get(), pFacePixels, bufferSize);
 	delete[] pFacePixels;
 }
 TextureCube::~TextureCube()
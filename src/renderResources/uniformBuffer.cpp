@@ -1,50 +1,20 @@
 #include "uniformBuffer.h"
-#include "vulkanContext.h"
-#include "vmaBuffer.h"
 #include "spirvReflect.h"
+#include <cstring>
 
 
 
 // Constructor/Destructor:
-UniformBuffer::UniformBuffer(VulkanContext* pContext, UniformBufferBlock* pUniformBufferBlock)
+UniformBuffer::UniformBuffer(UniformBufferBlock* pUniformBufferBlock)
 {
-	m_pContext = pContext;
 	m_pUniformBufferBlock = pUniformBufferBlock;
 
-	// Create buffer:
-	VkBufferCreateInfo* pBufferInfo = new VkBufferCreateInfo();
-	pBufferInfo->sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-	pBufferInfo->size = m_pUniformBufferBlock->size;
-	pBufferInfo->usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-	pBufferInfo->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-	VmaAllocationCreateInfo* pAllocInfo = new VmaAllocationCreateInfo();
-	pAllocInfo->usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
-	pAllocInfo->flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
-	pAllocInfo->requiredFlags = 0; 
-	pAllocInfo->preferredFlags = 0;
-
-	m_buffer = std::make_shared<VmaBuffer>(m_pContext, pBufferInfo, pAllocInfo);
-
-	// Get deviceData pointer:
-	VmaAllocationInfo info;
-	vmaGetAllocationInfo(m_pContext->GetVmaAllocator(), m_buffer->GetVmaAllocation(), &info);
-	m_pDeviceData = info.pMappedData;
-
 	// Allocate host data:
 	m_hostData.resize(m_pUniformBufferBlock->size);
 }
 UniformBuffer::~UniformBuffer()
 {
-	m_pContext->WaitDeviceIdle();
-}
-
 
-
-// Public methods:
-void UniformBuffer::UpdateBuffer()
-{
-	memcpy(m_pDeviceData, m_hostData.data(), m_hostData.size());
 }
 
 
@@ -54,9 +24,9 @@ uint32_t UniformBuffer::GetSize() const
 {
 	return m_pUniformBufferBlock->size;
 }
-const std::shared_ptr<VmaBuffer>& UniformBuffer::GetVmaBuffer() const
+const void* UniformBuffer::GetHostData() const
 {
-	return m_buffer;
+	return m_hostData.data();
 }
 template<typename T>
 T UniformBuffer::GetValue(const std::string& memberName) const
@@ -1,37 +1,31 @@
 #ifndef __INCLUDE_GUARD_uniformBuffer_h__
 #define __INCLUDE_GUARD_uniformBuffer_h__
-#include "vk_mem_alloc.h"
-#include <vulkan/vulkan.h>
-#include <memory>
 #include <string>
 #include <vector>
 
 
 
 struct UniformBufferBlock;
-class VmaBuffer;
-struct VulkanContext;
 
 
 
+/// <summary>
+/// Host side copy of a reflected cbuffer. There is no device buffer per UniformBuffer,
+/// MaterialProperties copies the host data into the UniformRingBuffer of the current frame.
+/// </summary>
 class UniformBuffer
 {
 private: // Members:
-	std::shared_ptr<VmaBuffer> m_buffer;
-	void* m_pDeviceData;
 	std::vector<char> m_hostData;
 	UniformBufferBlock* m_pUniformBufferBlock;
-	VulkanContext* m_pContext;
 
 public: // Methods:
-	UniformBuffer(VulkanContext* pContext, UniformBufferBlock* pUniformBufferBlock);
+	UniformBuffer(UniformBufferBlock* pUniformBufferBlock);
 	~UniformBuffer();
 
-	void UpdateBuffer();
-
 	// Getters:
 	uint32_t GetSize() const;
-	const std::shared_ptr<VmaBuffer>& GetVmaBuffer() const;
+	const void* GetHostData() const;
 	template<typename T>
 	T GetValue(const std::string& memberName) const;
 	template<typename T>
@@ -0,0 +1,145 @@
+#include "uniformRingBuffer.h"
+#include "logger.h"
+#include "vmaBuffer.h"
+#include "vulkanContext.h"
+#include "vulkanMacros.h"
+#include <algorithm>
+#include <cstring>
+
+
+
+// Static members:
+bool UniformRingBuffer::s_isInitialized = false;
+VulkanContext* UniformRingBuffer::s_pContext;
+uint64_t UniformRingBuffer::s_alignment = 256;
+std::vector<UniformRingBuffer::FrameBuffer> UniformRingBuffer::s_frameBuffers;
+
+
+
+// Initialization and cleanup:
+void UniformRingBuffer::Init(VulkanContext* pContext)
+{
+	if (s_isInitialized)
+		return;
+
+	s_isInitialized = true;
+	s_pContext = pContext;
+
+	// Dynamic offsets must be multiples of minUniformBufferOffsetAlignment:
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(s_pContext->GetVkPhysicalDevice(), &properties);
+	s_alignment = std::max<uint64_t>(properties.limits.minUniformBufferOffsetAlignment, 16);
+
+	s_frameBuffers.resize(s_pContext->framesInFlight);
+	for (FrameBuffer& frameBuffer : s_frameBuffers)
+	{
+		frameBuffer.generation = 0;
+		CreateBuffer(frameBuffer, s_initialCapacity);
+		frameBuffer.allocatedBytes = 0;
+	}
+}
+void UniformRingBuffer::Clear()
+{
+	s_pContext->WaitDeviceIdle();
+	s_frameBuffers.clear();
+	s_isInitialized = false;
+}
+
+
+
+// Per frame allocation:
+void UniformRingBuffer::Reset()
+{
+	FrameBuffer& frameBuffer = s_frameBuffers[s_pContext->frameIndex];
+	frameBuffer.head = 0;
+	frameBuffer.allocatedBytes = 0;
+	frameBuffer.retiredBuffers.clear();
+}
+/// <summary>
+/// Guarantees that the next allocations with a total aligned size of up to 'size' end up in the same VkBuffer.
+/// If the current buffer is too small it is retired until the next Reset() and replaced by a larger one.
+/// </summary>
+void UniformRingBuffer::Reserve(uint64_t size)
+{
+	FrameBuffer& frameBuffer = s_frameBuffers[s_pContext->frameIndex];
+	if (frameBuffer.head + size <= frameBuffer.capacity)
+		return;
+
+	uint64_t capacity = frameBuffer.capacity;
+	while (capacity < size)
+		capacity *= 2;
+	capacity *= 2;
+	LOG_TRACE("UniformRingBuffer for frameIndex {} grows from {} to {} bytes.", s_pContext->frameIndex, frameBuffer.capacity, capacity);
+
+	frameBuffer.retiredBuffers.push_back(std::move(frameBuffer.buffer));
+	CreateBuffer(frameBuffer, capacity);
+}
+/// <summary>
+/// Copies 'size' bytes into the buffer of the current frameIndex and returns the dynamic offset of the copy.
+/// </summary>
+uint32_t UniformRingBuffer::Allocate(const void* pData, uint64_t size)
+{
+	uint64_t alignedSize = GetAlignedSize(size);
+	Reserve(alignedSize);
+
+	FrameBuffer& frameBuffer = s_frameBuffers[s_pContext->frameIndex];
+	uint64_t offset = frameBuffer.head;
+	memcpy(frameBuffer.pData + offset, pData, size);
+	frameBuffer.head += alignedSize;
+	frameBuffer.allocatedBytes += size;
+	return static_cast<uint32_t>(offset);
+}
+
+
+
+// Getters:
+uint64_t UniformRingBuffer::GetAlignedSize(uint64_t size)
+{
+	return (size + s_alignment - 1) / s_alignment * s_alignment;
+}
+const VkBuffer& UniformRingBuffer::GetVkBuffer(uint32_t frameIndex)
+{
+	return s_frameBuffers[frameIndex].buffer->GetVkBuffer();
+}
+/// <summary>
+/// Changes whenever the buffer of the given frameIndex is replaced. Descriptor sets pointing at an older generation must be rewritten.
+/// </summary>
+uint64_t UniformRingBuffer::GetGeneration(uint32_t frameIndex)
+{
+	return s_frameBuffers[frameIndex].generation;
+}
+/// <summary>
+/// Uniform data bytes copied into the buffer of the current frameIndex since its last Reset(), without alignment padding.
+/// </summary>
+uint64_t UniformRingBuffer::GetAllocatedBytes()
+{
+	return s_frameBuffers[s_pContext->frameIndex].allocatedBytes;
+}
+
+
+
+// Private methods:
+void UniformRingBuffer::CreateBuffer(FrameBuffer& frameBuffer, uint64_t capacity)
+{
+	VkBufferCreateInfo* pBufferInfo = new VkBufferCreateInfo();
+	pBufferInfo->sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	pBufferInfo->size = capacity;
+	pBufferInfo->usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+	pBufferInfo->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	VmaAllocationCreateInfo* pAllocInfo = new VmaAllocationCreateInfo();
+	pAllocInfo->usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+	pAllocInfo->flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+	pAllocInfo->requiredFlags = 0;
+	pAllocInfo->preferredFlags = 0;
+
+	frameBuffer.buffer = std::make_unique<VmaBuffer>(s_pContext, pBufferInfo, pAllocInfo);
+	frameBuffer.capacity = capacity;
+	frameBuffer.head = 0;
+	frameBuffer.generation++;
+
+	// Get deviceData pointer:
+	VmaAllocationInfo info;
+	vmaGetAllocationInfo(s_pContext->GetVmaAllocator(), frameBuffer.buffer->GetVmaAllocation(), &info);
+	frameBuffer.pData = static_cast<char*>(info.pMappedData);
+}
\ No newline at end of file
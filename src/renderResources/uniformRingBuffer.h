@@ -0,0 +1,68 @@
+#ifndef __INCLUDE_GUARD_uniformRingBuffer_h__
+#define __INCLUDE_GUARD_uniformRingBuffer_h__
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+
+
+class VmaBuffer;
+struct VulkanContext;
+
+
+
+/// <summary>
+/// Purely static class that owns one persistently mapped uniform buffer per frame in flight.
+/// Per draw uniform data is bump allocated from the buffer of the current frameIndex and bound
+/// via VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC offsets, so all draws share a handful of allocations.
+/// Reset() must be called once per frame after the fence of the current frameIndex has been waited on.
+/// Not thread safe, all allocations happen on the main thread.
+/// </summary>
+class UniformRingBuffer
+{
+public: // Members
+
+private: // Members
+	struct FrameBuffer
+	{
+		std::unique_ptr<VmaBuffer> buffer;
+		char* pData;
+		uint64_t capacity;
+		uint64_t head;
+		uint64_t allocatedBytes;	// since the last Reset(), across buffer growth
+		uint64_t generation;		// incremented whenever the buffer is replaced, VkBuffer handles of destroyed buffers may be reused
+		std::vector<std::unique_ptr<VmaBuffer>> retiredBuffers;	// outgrown this frame, still referenced by recorded descriptor sets
+	};
+	static bool s_isInitialized;
+	static VulkanContext* s_pContext;
+	static uint64_t s_alignment;
+	static std::vector<FrameBuffer> s_frameBuffers;
+	static constexpr uint64_t s_initialCapacity = 1 << 20;
+
+public: // Methods
+	static void Init(VulkanContext* pContext);
+	static void Clear();
+
+	static void Reset();
+	static void Reserve(uint64_t size);
+	static uint32_t Allocate(const void* pData, uint64_t size);
+
+	// Getters:
+	static uint64_t GetAlignedSize(uint64_t size);
+	static const VkBuffer& GetVkBuffer(uint32_t frameIndex);
+	static uint64_t GetGeneration(uint32_t frameIndex);
+	static uint64_t GetAllocatedBytes();
+
+private: // Methods
+	static void CreateBuffer(FrameBuffer& frameBuffer, uint64_t capacity);
+
+	// Delete all constructors:
+	UniformRingBuffer() = delete;
+	UniformRingBuffer(const UniformRingBuffer&) = delete;
+	UniformRingBuffer& operator=(const UniformRingBuffer&) = delete;
+	~UniformRingBuffer() = delete;
+};
+
+
+
+#endif // __INCLUDE_GUARD_uniformRingBuffer_h__
\ No newline at end of file
@@ -17,6 +17,8 @@ std::vector<MeshRenderer*> Graphics::s_meshRenderers;
 Mesh* Graphics::s_pLineSegmentMesh;
 Mesh* Graphics::s_pSphereMesh;
 Material* Graphics::s_pLineSegmentMaterial;
+Material* Graphics::s_pSphereMaterial;
+Material* Graphics::s_pCornerMaterial;
 
 
 
@@ -34,11 +36,16 @@ void Graphics::Init()
 		s_transforms[i] = new Transform();
 		s_meshRenderers[i] = new MeshRenderer();
 		s_meshRenderers[i]->SetTransform(s_transforms[i]);
+		s_meshRenderers[i]->SetInstanced(true);
 		s_meshRenderers[i]->isActive = false;
 	}
 	s_pLineSegmentMesh = MeshManager::GetMesh("zylinderEdgy");
 	s_pSphereMesh = MeshManager::GetMesh("cubeSphere");
-	s_pLineSegmentMaterial = MaterialManager::GetMaterial("simpleUnlit");
+
+	// Debug geometry is drawn many times per frame, so use the instanced material variants:
+	s_pLineSegmentMaterial = MaterialManager::GetMaterial("simpleUnlitInstanced");
+	s_pSphereMaterial = MaterialManager::GetMaterial("simpleUnlitInstanced");
+	s_pCornerMaterial = MaterialManager::GetMaterial("simpleLitInstanced");
 }
 void Graphics::Clear()
 {
@@ -113,7 +120,7 @@ MaterialProperties* Graphics::DrawLineSegment(Float3 start, Float3 end, float wi
 // Draw Sphere:
 void Graphics::DrawSphere(Float3 position, float radius, Float4 color, bool receiveShadows, bool castShadows)
 {
-	MaterialProperties* pMaterialProperties = DrawMesh(s_pSphereMesh, MaterialManager::GetMaterial("simpleUnlit"), position, Float3x3::identity, Float3(radius), receiveShadows, castShadows);
+	MaterialProperties* pMaterialProperties = DrawMesh(s_pSphereMesh, s_pSphereMaterial, position, Float3x3::identity, Float3(radius), receiveShadows, castShadows);
 	pMaterialProperties->SetValue("SurfaceProperties", "diffuseColor", color);
 }
 
@@ -151,7 +158,7 @@ void Graphics::DrawFrustum(Float4x4 localToWorldMatrix, const Float4x4& projecti
 	// Draw corner points:
 	for (uint32_t i = 0; i < 8; i++)
 	{
-		MaterialProperties* pMaterialProperties = Graphics::DrawMesh(MeshManager::GetMesh("cubeSphere"), MaterialManager::GetMaterial("simpleLit"), Float3(cornerPoints[i]), Float3x3::identity, Float3(2.0f * width), receiveShadows, castShadows);
+		MaterialProperties* pMaterialProperties = Graphics::DrawMesh(s_pSphereMesh, s_pCornerMaterial, Float3(cornerPoints[i]), Float3x3::identity, Float3(2.0f * width), receiveShadows, castShadows);
 		pMaterialProperties->SetValue("SurfaceProperties", "diffuseColor", Float4::black);
 	}
 
@@ -193,7 +200,7 @@ void Graphics::DrawBounds(Float4x4 localToWorldMatrix, const Bounds& bounds, flo
 	// Draw corner points:
 	for (uint32_t i = 0; i < 8; i++)
 	{
-		MaterialProperties* pMaterialProperties = Graphics::DrawMesh(MeshManager::GetMesh("cubeSphere"), MaterialManager::GetMaterial("simpleLit"), Float3(cornerPoints[i]), Float3x3::identity, Float3(2.0f * width), receiveShadows, castShadows);
+		MaterialProperties* pMaterialProperties = Graphics::DrawMesh(s_pSphereMesh, s_pCornerMaterial, Float3(cornerPoints[i]), Float3x3::identity, Float3(2.0f * width), receiveShadows, castShadows);
 		pMaterialProperties->SetValue("SurfaceProperties", "diffuseColor", Float4::black);
 	}
 
@@ -230,23 +237,21 @@ void Graphics::ResetDrawCalls()
 
 
 // Getters:
-std::vector<MeshRenderer*>* Graphics::GetSortedMeshRenderers()
+/// <summary>
+/// Pool of immediate mode renderers, only the first entries up to the draw index are active.
+/// The pool is not sorted, it stays paired with s_transforms and the renderer orders its draws per frame.
+/// </summary>
+std::vector<MeshRenderer*>* Graphics::GetMeshRenderers()
 {
-	// Sort meshRenders according to material renderQueue:
-	std::sort(s_meshRenderers.begin(), s_meshRenderers.end(), [](MeshRenderer* a, MeshRenderer* b)
-	{
-		// Handle nullptr cases for materials (MeshRenderer* not in use):
-		const Material* materialA = a ? a->GetMaterial() : nullptr;
-		const Material* materialB = b ? b->GetMaterial() : nullptr;
-
-		// Default high value for nullptr:
-		uint32_t renderQueueA = materialA ? static_cast<uint32_t>(materialA->GetRenderQueue()) : UINT32_MAX; 
-		uint32_t renderQueueB = materialB ? static_cast<uint32_t>(materialB->GetRenderQueue()) : UINT32_MAX;
-
-		return renderQueueA < renderQueueB;
-	});
 	return &s_meshRenderers;
 }
+/// <summary>
+/// Number of Graphics::Draw* calls since the last ResetDrawCalls().
+/// </summary>
+uint32_t Graphics::GetDrawCallCount()
+{
+	return s_drawIndex;
+}
 
 
 
@@ -264,6 +269,7 @@ void Graphics::DoubleCapacityIfNeeded()
 			s_transforms[i] = new Transform();
 			s_meshRenderers[i] = new MeshRenderer();
 			s_meshRenderers[i]->SetTransform(s_transforms[i]);
+			s_meshRenderers[i]->SetInstanced(true);
 			s_meshRenderers[i]->isActive = false;
 		}
 	}
@@ -26,6 +26,8 @@ private: // Members
 	static Mesh* s_pLineSegmentMesh;
 	static Mesh* s_pSphereMesh;
 	static Material* s_pLineSegmentMaterial;
+	static Material* s_pSphereMaterial;
+	static Material* s_pCornerMaterial;
 
 public: // Methods
 	static void Init();
@@ -52,7 +54,8 @@ public: // Methods
 	static void ResetDrawCalls();
 
 	// Getters:
-	static std::vector<MeshRenderer*>* GetSortedMeshRenderers();
+	static std::vector<MeshRenderer*>* GetMeshRenderers();
+	static uint32_t GetDrawCallCount();
 
 private: // Methods
 	static void DoubleCapacityIfNeeded();
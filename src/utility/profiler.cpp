@@ -0,0 +1,113 @@
+#include "profiler.h"
+#include "logger.h"
+#include <fstream>
+#include <iomanip>
+
+
+
+// Static members:
+std::mutex Profiler::s_mutex;
+std::vector<std::unique_ptr<Profiler::ThreadBuffer>> Profiler::s_threadBuffers;
+std::chrono::steady_clock::time_point Profiler::s_epoch = std::chrono::steady_clock::now();
+
+
+
+// Public methods:
+void Profiler::Record(const char* name, uint64_t startNs, uint64_t endNs)
+{
+	ThreadBuffer* pBuffer = GetThreadBuffer();
+	uint64_t head = pBuffer->head.load(std::memory_order_relaxed);
+	pBuffer->events[head % s_eventsPerThread] = { name, startNs, endNs - startNs };
+	pBuffer->head.store(head + 1, std::memory_order_release);	// publish the event to WriteChromeTrace()
+}
+void Profiler::SetThreadName(const std::string& name)
+{
+	ThreadBuffer* pBuffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(s_mutex);
+	pBuffer->name = name;
+}
+/// <summary>
+/// Writes the events currently held by all ring buffers in the chrome trace event format ("X" complete events).
+/// Load the file in chrome://tracing or ui.perfetto.dev.
+/// </summary>
+bool Profiler::WriteChromeTrace(const std::filesystem::path& filePath)
+{
+	#if !defined(EMBER_PROFILING_ACTIVE)
+	LOG_WARN("Profiler::WriteChromeTrace() profiling zones are compiled out, the trace will be empty.");
+	#endif
+
+	if (filePath.has_parent_path())
+		std::filesystem::create_directories(filePath.parent_path());
+	std::ofstream file(filePath, std::ios::trunc);
+	if (!file.is_open())
+	{
+		LOG_WARN("Could not open file for writing: {}", filePath.string());
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+	uint64_t eventCount = 0;
+	bool first = true;
+	file << std::fixed << std::setprecision(3);	// microseconds with nanosecond resolution
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (const std::unique_ptr<ThreadBuffer>& pBuffer : s_threadBuffers)
+	{
+		file << (first ? "\n" : ",\n");
+		first = false;
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << pBuffer->threadId << ",\"args\":{\"name\":\"" << pBuffer->name << "\"}}";
+
+		// Oldest event still in the ring first:
+		uint64_t head = pBuffer->head.load(std::memory_order_acquire);
+		uint64_t begin = head > s_eventsPerThread ? head - s_eventsPerThread : 0;
+		for (uint64_t i = begin; i < head; i++)
+		{
+			const ProfileEvent& event = pBuffer->events[i % s_eventsPerThread];
+			file << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":" << pBuffer->threadId
+				<< ",\"ts\":" << event.startNs / 1000.0 << ",\"dur\":" << event.durationNs / 1000.0 << "}";
+		}
+		eventCount += head - begin;
+	}
+	file << "\n]}\n";
+
+	LOG_INFO("Saved {} profiling events of {} threads to: {}", eventCount, s_threadBuffers.size(), filePath.string());
+	return true;
+}
+/// <summary>
+/// Drops all recorded events, e.g. to start a capture window. Only call while no other thread records.
+/// </summary>
+void Profiler::Reset()
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	for (std::unique_ptr<ThreadBuffer>& pBuffer : s_threadBuffers)
+		pBuffer->head.store(0, std::memory_order_relaxed);
+}
+
+
+
+// Getters:
+uint64_t Profiler::GetTimeNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+}
+
+
+
+// Private methods:
+/// <summary>
+/// Buffers are owned by the profiler and outlive their threads, so events of finished threads can still be exported.
+/// </summary>
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+{
+	thread_local ThreadBuffer* pThreadBuffer = nullptr;
+	if (pThreadBuffer == nullptr)
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		std::unique_ptr<ThreadBuffer> pBuffer = std::make_unique<ThreadBuffer>();
+		pBuffer->threadId = static_cast<uint32_t>(s_threadBuffers.size());
+		pBuffer->name = "Thread " + std::to_string(pBuffer->threadId);
+		pBuffer->head.store(0, std::memory_order_relaxed);
+		pThreadBuffer = pBuffer.get();
+		s_threadBuffers.push_back(std::move(pBuffer));
+	}
+	return pThreadBuffer;
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#ifndef __INCLUDE_GUARD_profiler_h__
+#define __INCLUDE_GUARD_profiler_h__
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+
+// Profiling zones are only compiled into debug builds, define EMBER_PROFILING_FORCE to keep them in release builds:
+#if !defined(NDEBUG) || defined(EMBER_PROFILING_FORCE)
+#define EMBER_PROFILING_ACTIVE
+#endif
+
+
+
+/// <summary>
+/// Completed profiling zone. The name must outlive the capture, string literals are expected.
+/// </summary>
+struct ProfileEvent
+{
+	const char* name;
+	uint64_t startNs;
+	uint64_t durationNs;
+};
+
+
+
+/// <summary>
+/// Scoped cpu zone profiler with chrome://tracing and Perfetto json export. <para/>
+/// Every thread records into its own fixed size ring buffer, which only that thread writes to, so recording is lock free.
+/// A buffer is registered once per thread (mutex), older events are overwritten when the ring wraps around. <para/>
+/// Capture only while no other thread records (e.g. between frames), as events of running zones may be overwritten while exporting.
+/// Use EMBER_PROFILE_SCOPE("name") to time the enclosing scope, it compiles to nothing without EMBER_PROFILING_ACTIVE.
+/// </summary>
+class Profiler
+{
+public: // Members:
+	static constexpr uint32_t s_eventsPerThread = 1 << 14;
+
+private: // Members:
+	struct ThreadBuffer
+	{
+		std::string name;
+		uint32_t threadId;
+		std::atomic<uint64_t> head;	// total number of events ever written
+		std::array<ProfileEvent, s_eventsPerThread> events;
+	};
+	static std::mutex s_mutex;
+	static std::vector<std::unique_ptr<ThreadBuffer>> s_threadBuffers;
+	static std::chrono::steady_clock::time_point s_epoch;
+
+public: // Methods:
+	static void Record(const char* name, uint64_t startNs, uint64_t endNs);
+	static void SetThreadName(const std::string& name);
+	static bool WriteChromeTrace(const std::filesystem::path& filePath);
+	static void Reset();
+
+	// Getters:
+	static uint64_t GetTimeNs();
+
+private: // Methods:
+	static ThreadBuffer* GetThreadBuffer();
+
+	// Delete all constructors:
+	Profiler() = delete;
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+	~Profiler() = delete;
+};
+
+
+
+/// <summary>
+/// Records the time between its construction and destruction as a zone of the calling thread.
+/// </summary>
+class ProfileScope
+{
+private: // Members:
+	const char* m_name;
+	uint64_t m_startNs;
+
+public: // Methods:
+	ProfileScope(const char* name) : m_name(name), m_startNs(Profiler::GetTimeNs()) {}
+	~ProfileScope() { Profiler::Record(m_name, m_startNs, Profiler::GetTimeNs()); }
+
+private: // Methods:
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+
+
+// Profiling macros:
+#if defined(EMBER_PROFILING_ACTIVE)
+#define EMBER_PROFILE_CONCAT_INNER(a, b) a##b
+#define EMBER_PROFILE_CONCAT(a, b) EMBER_PROFILE_CONCAT_INNER(a, b)
+#define EMBER_PROFILE_SCOPE(name) ::ProfileScope EMBER_PROFILE_CONCAT(profileScope, __COUNTER__)(name)
+#define EMBER_PROFILE_THREAD(name) ::Profiler::SetThreadName(name)
+#else
+#define EMBER_PROFILE_SCOPE(name)
+#define EMBER_PROFILE_THREAD(name)
+#endif
+
+
+
+#endif // __INCLUDE_GUARD_profiler_h__
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "radixSort.h"
+#include <utility>
+
+
+
+// Public methods:
+/// <summary>
+/// Sorts items ascending by key. Items with equal keys keep their relative order.
+/// The scratch vector is resized as needed, reusing it between calls avoids reallocations.
+/// </summary>
+void RadixSort::Sort(std::vector<SortItem>& items, std::vector<SortItem>& scratch)
+{
+	constexpr uint32_t digitCount = 8;
+	constexpr uint32_t bucketCount = 256;
+	uint32_t count = static_cast<uint32_t>(items.size());
+	if (count < 2)
+		return;
+
+	// Histograms of all digits in a single pass over the keys:
+	uint32_t histograms[digitCount][bucketCount] = {};
+	for (const SortItem& item : items)
+		for (uint32_t digit = 0; digit < digitCount; digit++)
+			histograms[digit][(item.key >> (8 * digit)) & 0xFF]++;
+
+	scratch.resize(count);
+	std::vector<SortItem>* pSource = &items;
+	std::vector<SortItem>* pTarget = &scratch;
+	for (uint32_t digit = 0; digit < digitCount; digit++)
+	{
+		uint32_t* histogram = histograms[digit];
+		uint32_t shift = 8 * digit;
+
+		// All keys share this digit, the pass would not change the order:
+		if (histogram[((*pSource)[0].key >> shift) & 0xFF] == count)
+			continue;
+
+		// Exclusive prefix sum turns bucket sizes into bucket start positions:
+		uint32_t offset = 0;
+		for (uint32_t bucket = 0; bucket < bucketCount; bucket++)
+		{
+			uint32_t size = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += size;
+		}
+
+		for (const SortItem& item : *pSource)
+			(*pTarget)[histogram[(item.key >> shift) & 0xFF]++] = item;
+		std::swap(pSource, pTarget);
+	}
+
+	// Odd number of executed passes leaves the result in the scratch vector:
+	if (pSource != &items)
+		items.swap(scratch);
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef __INCLUDE_GUARD_radixSort_h__
+#define __INCLUDE_GUARD_radixSort_h__
+#include <cstdint>
+#include <vector>
+
+
+
+/// <summary>
+/// Key/value pair sorted by RadixSort. The value is typically an index into the array that is being ordered.
+/// </summary>
+struct SortItem
+{
+	uint64_t key;
+	uint32_t value;
+};
+
+
+
+/// <summary>
+/// Stable least significant digit radix sort for 64 bit keys, one 8 bit digit per pass.
+/// Passes in which all keys share the same digit are skipped, so keys that only use a few
+/// of their bits (e.g. few render queues and materials) cost less than the full 8 passes.
+/// </summary>
+class RadixSort
+{
+public: // Methods
+	static void Sort(std::vector<SortItem>& items, std::vector<SortItem>& scratch);
+
+private: // Methods
+	// Delete all constructors:
+	RadixSort() = delete;
+	RadixSort(const RadixSort&) = delete;
+	RadixSort& operator=(const RadixSort&) = delete;
+	~RadixSort() = delete;
+};
+
+
+
+#endif // __INCLUDE_GUARD_radixSort_h__
\ No newline at end of file
@@ -172,6 +172,10 @@ void SpirvReflect::AddDescriptorBoundResources(DescriptorBoundResources* const d
     for (uint32_t setIndex = 0; setIndex < descriptorSetsReflection.size(); setIndex++)
     {
         SpvReflectDescriptorSet* pSetReflection = descriptorSetsReflection[setIndex];
+
+        // Set 0 (space0) is the global FrameData set, owned by the renderer and not part of any material:
+        if (pSetReflection->set == 0)
+            continue;
 		descriptorBoundResources->size += pSetReflection->binding_count;
         for (uint32_t bindingIndex = 0; bindingIndex < pSetReflection->binding_count; bindingIndex++)
         {
@@ -183,6 +187,10 @@ void SpirvReflect::AddDescriptorBoundResources(DescriptorBoundResources* const d
             layoutBinding.stageFlags = VkShaderStageFlagBits((int)m_module.shader_stage);
             layoutBinding.pImmutableSamplers = nullptr;
 
+            // Per object uniform buffers live in the UniformRingBuffer and are bound with dynamic offsets:
+            if (layoutBinding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+                layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+
             // Add binding and name to lists:
 			descriptorBoundResources->descriptorSetBindingNames.push_back(pBindingReflection->name);
 			descriptorBoundResources->descriptorSetLayoutBindings.push_back(layoutBinding);
@@ -207,6 +215,9 @@ std::vector<SpvReflectInterfaceVariable*> SpirvReflect::GetInputVariablesReflect
 	SPVA(spvReflectEnumerateInputVariables(&m_module, &inputCount, nullptr));
 	std::vector<SpvReflectInterfaceVariable*> inputs(inputCount);
 	SPVA(spvReflectEnumerateInputVariables(&m_module, &inputCount, inputs.data()));
+
+	// System values (e.g. SV_InstanceID) are not fed by vertex buffers:
+	std::erase_if(inputs, [](const SpvReflectInterfaceVariable* pInput) { return pInput->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN; });
 	return inputs;
 }
 std::vector<SpvReflectDescriptorSet*> SpirvReflect::GetDescriptorSetsReflection() const
@@ -0,0 +1,137 @@
+#include "threadPool.h"
+#include "profiler.h"
+#include <algorithm>
+
+
+
+// Constructor/Destructor:
+ThreadPool::ThreadPool(uint32_t threadCount)
+{
+	m_pTask = nullptr;
+	m_taskCount = 0;
+	m_nextTask = 0;
+	m_busyWorkerCount = 0;
+	m_generation = 0;
+	m_stop = false;
+
+	threadCount = std::max(threadCount, 1u);
+	m_workers.reserve(threadCount - 1);
+	for (uint32_t threadIndex = 1; threadIndex < threadCount; threadIndex++)
+		m_workers.emplace_back(&ThreadPool::WorkerLoop, this, threadIndex);
+}
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wakeCondition.notify_all();
+	for (std::thread& worker : m_workers)
+		worker.join();
+}
+
+
+
+// Public methods:
+/// <summary>
+/// Calls task(taskIndex, threadIndex) for every taskIndex in [0, taskCount) and returns once all tasks are done.
+/// Tasks are handed out in increasing order, but may finish in any order.
+/// </summary>
+void ThreadPool::ParallelFor(uint32_t taskCount, const std::function<void(uint32_t taskIndex, uint32_t threadIndex)>& task)
+{
+	if (taskCount == 0)
+		return;
+
+	// Not worth waking the workers:
+	if (m_workers.empty() || taskCount == 1)
+	{
+		for (uint32_t taskIndex = 0; taskIndex < taskCount; taskIndex++)
+			task(taskIndex, 0);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pTask = &task;
+		m_taskCount = taskCount;
+		m_nextTask = 0;
+		m_busyWorkerCount = static_cast<uint32_t>(m_workers.size());
+		m_generation++;
+	}
+	m_wakeCondition.notify_all();
+
+	// Calling thread works as well, then waits for the stragglers:
+	RunTasks(0);
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this] { return m_busyWorkerCount == 0; });
+	m_pTask = nullptr;
+}
+
+
+
+// Getters:
+uint32_t ThreadPool::GetThreadCount() const
+{
+	return static_cast<uint32_t>(m_workers.size()) + 1;
+}
+
+
+
+// Private methods:
+void ThreadPool::WorkerLoop(uint32_t threadIndex)
+{
+	EMBER_PROFILE_THREAD("Worker " + std::to_string(threadIndex));
+	uint64_t generation = 0;
+	while (true)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wakeCondition.wait(lock, [this, generation] { return m_stop || m_generation != generation || !m_jobs.empty(); });
+
+			// ParallelFor takes precedence over queued jobs, queued jobs are finished before stopping:
+			if (m_generation == generation)
+			{
+				if (m_jobs.empty())
+					return;
+				job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+			}
+			generation = m_generation;
+		}
+
+		if (job)
+		{
+			job();
+			continue;
+		}
+
+		RunTasks(threadIndex);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_busyWorkerCount--;
+			if (m_busyWorkerCount == 0)
+				m_doneCondition.notify_one();
+		}
+	}
+}
+void ThreadPool::RunTasks(uint32_t threadIndex)
+{
+	for (uint32_t taskIndex = m_nextTask++; taskIndex < m_taskCount; taskIndex = m_nextTask++)
+		(*m_pTask)(taskIndex, threadIndex);
+}
+void ThreadPool::Enqueue(std::function<void()> job)
+{
+	if (m_workers.empty())
+	{
+		job();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.push_back(std::move(job));
+	}
+	m_wakeCondition.notify_one();
+}
\ No newline at end of file
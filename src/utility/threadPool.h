@@ -0,0 +1,78 @@
+#ifndef __INCLUDE_GUARD_threadPool_h__
+#define __INCLUDE_GUARD_threadPool_h__
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+/// <summary>
+/// Fixed set of worker threads for fork/join style parallel loops.
+/// The calling thread takes part in the work as threadIndex 0, workers use 1..threadCount-1.
+/// The threadIndex allows tasks to use per thread resources without locking.
+/// Independent jobs can be queued with Submit(), idle workers pick them up in submission order.
+/// A ParallelFor waits for workers that are busy with a job, so long jobs delay it.
+/// </summary>
+class ThreadPool
+{
+private: // Members:
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_wakeCondition;
+	std::condition_variable m_doneCondition;
+	const std::function<void(uint32_t taskIndex, uint32_t threadIndex)>* m_pTask;
+	uint32_t m_taskCount;
+	std::atomic<uint32_t> m_nextTask;
+	uint32_t m_busyWorkerCount;
+	uint64_t m_generation;
+	std::deque<std::function<void()>> m_jobs;
+	bool m_stop;
+
+public: // Methods:
+	ThreadPool(uint32_t threadCount);
+	~ThreadPool();
+
+	void ParallelFor(uint32_t taskCount, const std::function<void(uint32_t taskIndex, uint32_t threadIndex)>& task);
+	template<typename Function>
+	std::future<std::invoke_result_t<Function>> Submit(Function&& function);
+
+	// Getters:
+	uint32_t GetThreadCount() const;
+
+private: // Methods:
+	void WorkerLoop(uint32_t threadIndex);
+	void RunTasks(uint32_t threadIndex);
+	void Enqueue(std::function<void()> job);
+
+	// Delete copy/move semantics:
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+};
+
+
+
+
+/// <summary>
+/// Queues function() for execution on a worker thread and returns a future for its result.
+/// Without worker threads the function runs immediately on the calling thread.
+/// </summary>
+template<typename Function>
+std::future<std::invoke_result_t<Function>> ThreadPool::Submit(Function&& function)
+{
+	using Result = std::invoke_result_t<Function>;
+	std::shared_ptr<std::packaged_task<Result()>> pTask = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+	std::future<Result> future = pTask->get_future();
+	Enqueue([pTask]() { (*pTask)(); });
+	return future;
+}
+
+
+
+#endif // __INCLUDE_GUARD_threadPool_h__
\ No newline at end of file
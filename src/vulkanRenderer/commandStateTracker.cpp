@@ -0,0 +1,135 @@
+#include "commandStateTracker.h"
+#include "logger.h"
+#include <algorithm>
+#include <cstring>
+
+
+
+// Constructor:
+CommandStateTracker::CommandStateTracker(VkCommandBuffer commandBuffer)
+{
+	m_commandBuffer = commandBuffer;
+	m_pipeline = VK_NULL_HANDLE;
+	m_descriptorSetLayouts.fill(VK_NULL_HANDLE);
+	m_descriptorSets.fill(VK_NULL_HANDLE);
+	m_indexBuffer = VK_NULL_HANDLE;
+	m_indexOffset = 0;
+	m_indexType = VK_INDEX_TYPE_UINT32;
+	m_pushConstantLayout = VK_NULL_HANDLE;
+	m_pushConstantStages = 0;
+	m_pushConstantOffset = 0;
+}
+
+
+
+// Public methods:
+void CommandStateTracker::BindPipeline(VkPipeline pipeline)
+{
+	if (m_pipeline == pipeline)
+	{
+		m_stats.elidedCommands++;
+		return;
+	}
+	m_pipeline = pipeline;
+	vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+	m_stats.pipelineBinds++;
+}
+void CommandStateTracker::BindDescriptorSet(VkPipelineLayout pipelineLayout, uint32_t set, VkDescriptorSet descriptorSet, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets)
+{
+	if (set >= s_maxDescriptorSets)
+	{
+		LOG_WARN("CommandStateTracker::BindDescriptorSet() set {} is not tracked, only sets < {} are supported.", set, s_maxDescriptorSets);
+		vkCmdBindDescriptorSets(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, set, 1, &descriptorSet, dynamicOffsetCount, pDynamicOffsets);
+		m_stats.descriptorSetBinds++;
+		return;
+	}
+
+	std::vector<uint32_t>& dynamicOffsets = m_dynamicOffsets[set];
+	bool sameOffsets = dynamicOffsets.size() == dynamicOffsetCount && (dynamicOffsetCount == 0 || memcmp(dynamicOffsets.data(), pDynamicOffsets, dynamicOffsetCount * sizeof(uint32_t)) == 0);
+	if (m_descriptorSetLayouts[set] == pipelineLayout && m_descriptorSets[set] == descriptorSet && sameOffsets)
+	{
+		m_stats.elidedCommands++;
+		return;
+	}
+
+	// Sets bound with another layout may be disturbed by this bind:
+	for (uint32_t i = 0; i < s_maxDescriptorSets; i++)
+		if (m_descriptorSetLayouts[i] != pipelineLayout)
+		{
+			m_descriptorSetLayouts[i] = VK_NULL_HANDLE;
+			m_descriptorSets[i] = VK_NULL_HANDLE;
+		}
+	m_descriptorSetLayouts[set] = pipelineLayout;
+	m_descriptorSets[set] = descriptorSet;
+	dynamicOffsets.assign(pDynamicOffsets, pDynamicOffsets + dynamicOffsetCount);
+	vkCmdBindDescriptorSets(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, set, 1, &descriptorSet, dynamicOffsetCount, pDynamicOffsets);
+	m_stats.descriptorSetBinds++;
+}
+void CommandStateTracker::BindVertexBuffers(uint32_t bindingCount, const VkBuffer* pBuffers, const VkDeviceSize* pOffsets)
+{
+	// Bindings beyond bindingCount stay bound, so a prefix match is sufficient:
+	bool same = m_vertexBuffers.size() >= bindingCount;
+	for (uint32_t i = 0; same && i < bindingCount; i++)
+		same = m_vertexBuffers[i] == pBuffers[i] && m_vertexOffsets[i] == pOffsets[i];
+	if (same)
+	{
+		m_stats.elidedCommands++;
+		return;
+	}
+
+	if (m_vertexBuffers.size() < bindingCount)
+	{
+		m_vertexBuffers.resize(bindingCount, VK_NULL_HANDLE);
+		m_vertexOffsets.resize(bindingCount, 0);
+	}
+	std::copy(pBuffers, pBuffers + bindingCount, m_vertexBuffers.begin());
+	std::copy(pOffsets, pOffsets + bindingCount, m_vertexOffsets.begin());
+	vkCmdBindVertexBuffers(m_commandBuffer, 0, bindingCount, pBuffers, pOffsets);
+	m_stats.bufferBinds++;
+}
+void CommandStateTracker::BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType)
+{
+	if (m_indexBuffer == buffer && m_indexOffset == offset && m_indexType == indexType)
+	{
+		m_stats.elidedCommands++;
+		return;
+	}
+	m_indexBuffer = buffer;
+	m_indexOffset = offset;
+	m_indexType = indexType;
+	vkCmdBindIndexBuffer(m_commandBuffer, buffer, offset, indexType);
+	m_stats.bufferBinds++;
+}
+void CommandStateTracker::PushConstants(VkPipelineLayout pipelineLayout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* pValues)
+{
+	if (m_pushConstantLayout == pipelineLayout && m_pushConstantStages == stageFlags && m_pushConstantOffset == offset
+		&& m_pushConstantData.size() == size && memcmp(m_pushConstantData.data(), pValues, size) == 0)
+	{
+		m_stats.elidedCommands++;
+		return;
+	}
+	m_pushConstantLayout = pipelineLayout;
+	m_pushConstantStages = stageFlags;
+	m_pushConstantOffset = offset;
+	m_pushConstantData.assign(static_cast<const char*>(pValues), static_cast<const char*>(pValues) + size);
+	vkCmdPushConstants(m_commandBuffer, pipelineLayout, stageFlags, offset, size, pValues);
+	m_stats.pushConstantUpdates++;
+}
+void CommandStateTracker::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstInstance)
+{
+	vkCmdDrawIndexed(m_commandBuffer, indexCount, instanceCount, 0, 0, firstInstance);
+	m_stats.drawCalls++;
+	m_stats.triangles += static_cast<uint64_t>(indexCount / 3) * instanceCount;
+}
+
+
+
+// Getters:
+VkCommandBuffer CommandStateTracker::GetVkCommandBuffer() const
+{
+	return m_commandBuffer;
+}
+const RenderStats& CommandStateTracker::GetStats() const
+{
+	return m_stats;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef __INCLUDE_GUARD_commandStateTracker_h__
+#define __INCLUDE_GUARD_commandStateTracker_h__
+#include "renderStats.h"
+#include <vulkan/vulkan.h>
+#include <array>
+#include <vector>
+
+
+
+/// <summary>
+/// Thin layer between the renderer and the vkCmd* bind calls of a single command buffer.
+/// Binds that would not change the bound state are skipped and counted as elided, issued commands and draws are counted in GetStats().
+/// Bound state is not inherited between command buffers, so each (secondary) command buffer needs its own tracker.
+/// Descriptor sets and push constants are compared together with their pipeline layout, binding the same
+/// set with a different layout is always issued, as layout compatibility is not checked.
+/// </summary>
+class CommandStateTracker
+{
+private: // Members:
+	static constexpr uint32_t s_maxDescriptorSets = 4;
+	VkCommandBuffer m_commandBuffer;
+	VkPipeline m_pipeline;
+	std::array<VkPipelineLayout, s_maxDescriptorSets> m_descriptorSetLayouts;
+	std::array<VkDescriptorSet, s_maxDescriptorSets> m_descriptorSets;
+	std::array<std::vector<uint32_t>, s_maxDescriptorSets> m_dynamicOffsets;
+	std::vector<VkBuffer> m_vertexBuffers;
+	std::vector<VkDeviceSize> m_vertexOffsets;
+	VkBuffer m_indexBuffer;
+	VkDeviceSize m_indexOffset;
+	VkIndexType m_indexType;
+	VkPipelineLayout m_pushConstantLayout;
+	VkShaderStageFlags m_pushConstantStages;
+	uint32_t m_pushConstantOffset;
+	std::vector<char> m_pushConstantData;
+	RenderStats m_stats;
+
+public: // Methods:
+	CommandStateTracker(VkCommandBuffer commandBuffer);
+
+	void BindPipeline(VkPipeline pipeline);
+	void BindDescriptorSet(VkPipelineLayout pipelineLayout, uint32_t set, VkDescriptorSet descriptorSet, uint32_t dynamicOffsetCount = 0, const uint32_t* pDynamicOffsets = nullptr);
+	void BindVertexBuffers(uint32_t bindingCount, const VkBuffer* pBuffers, const VkDeviceSize* pOffsets);
+	void BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType);
+	void PushConstants(VkPipelineLayout pipelineLayout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* pValues);
+	void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+
+	// Getters:
+	VkCommandBuffer GetVkCommandBuffer() const;
+	const RenderStats& GetStats() const;
+};
+
+
+
+#endif // __INCLUDE_GUARD_commandStateTracker_h__
\ No newline at end of file
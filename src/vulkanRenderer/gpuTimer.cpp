@@ -0,0 +1,256 @@
+#include "gpuTimer.h"
+#include "logger.h"
+#include "vulkanContext.h"
+#include "vulkanMacros.h"
+#include <algorithm>
+
+
+
+// RollingAverage:
+void RollingAverage::Add(double sample)
+{
+	if (count == s_windowSize)
+		sum -= samples[next];
+	else
+		count++;
+	samples[next] = sample;
+	sum += sample;
+	next = (next + 1) % s_windowSize;
+}
+double RollingAverage::Get() const
+{
+	return count == 0 ? 0.0 : sum / count;
+}
+
+
+
+// Constructor/Destructor:
+GpuTimer::GpuTimer(VulkanContext* pContext, uint32_t shadowLayerCount)
+{
+	m_pContext = pContext;
+	m_timestampPool = VK_NULL_HANDLE;
+	m_statisticsPool = VK_NULL_HANDLE;
+	m_statisticFlags = 0;
+	m_shadowLayerCount = shadowLayerCount;
+	m_timestampsPerFrame = s_shadowLayerBegin + 2 * shadowLayerCount;
+	m_timestampMask = 0;
+	m_msPerTick = 0.0;
+	m_recorded.assign(m_pContext->framesInFlight, false);
+	m_shadowLayerTimes.resize(shadowLayerCount);
+
+	// Timestamps are only supported if the graphics queue has valid timestamp bits:
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(m_pContext->GetVkPhysicalDevice(), &queueFamilyCount, nullptr);
+	std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(m_pContext->GetVkPhysicalDevice(), &queueFamilyCount, queueFamilyProperties.data());
+	uint32_t validBits = queueFamilyProperties[m_pContext->pLogicalDevice->GetGraphicsQueue().familyIndex].timestampValidBits;
+	if (validBits == 0)
+		LOG_WARN("GpuTimer: graphics queue does not support timestamps, gpu timings are disabled.");
+	else
+	{
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(m_pContext->GetVkPhysicalDevice(), &properties);
+		m_timestampMask = validBits >= 64 ? UINT64_MAX : (uint64_t(1) << validBits) - 1;
+		m_msPerTick = properties.limits.timestampPeriod / 1e6;
+
+		VkQueryPoolCreateInfo createInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+		createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		createInfo.queryCount = m_pContext->framesInFlight * m_timestampsPerFrame;
+		VKA(vkCreateQueryPool(m_pContext->GetVkDevice(), &createInfo, nullptr, &m_timestampPool));
+	}
+
+	// Optional pipeline statistics, one query per pass and frame in flight:
+	if (m_pContext->pPhysicalDevice->SupportsPipelineStatistics())
+	{
+		m_statisticFlags = VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+		VkQueryPoolCreateInfo createInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+		createInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+		createInfo.queryCount = m_pContext->framesInFlight * 2;
+		createInfo.pipelineStatistics = m_statisticFlags;
+		VKA(vkCreateQueryPool(m_pContext->GetVkDevice(), &createInfo, nullptr, &m_statisticsPool));
+	}
+}
+GpuTimer::~GpuTimer()
+{
+	if (m_timestampPool != VK_NULL_HANDLE)
+		vkDestroyQueryPool(m_pContext->GetVkDevice(), m_timestampPool, nullptr);
+	if (m_statisticsPool != VK_NULL_HANDLE)
+		vkDestroyQueryPool(m_pContext->GetVkDevice(), m_statisticsPool, nullptr);
+}
+
+
+
+// Recording:
+/// <summary>
+/// Folds the results of the last submission of the current frameIndex into the averages.
+/// Must be called after the fence of the frameIndex has been waited on, so no query is still pending on the gpu.
+/// </summary>
+void GpuTimer::ReadResults()
+{
+	uint32_t frameIndex = m_pContext->frameIndex;
+	if (!m_recorded[frameIndex])
+		return;
+	m_recorded[frameIndex] = false;
+
+	// Timestamps (value and availability per query). VK_NOT_READY only means some slots were not written this frame:
+	if (m_timestampPool != VK_NULL_HANDLE)
+	{
+		m_timestamps.resize(2 * m_timestampsPerFrame);
+		VkResult result = vkGetQueryPoolResults(m_pContext->GetVkDevice(), m_timestampPool, frameIndex * m_timestampsPerFrame, m_timestampsPerFrame,
+			m_timestamps.size() * sizeof(uint64_t), m_timestamps.data(), 2 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+		if (result == VK_SUCCESS || result == VK_NOT_READY)
+		{
+			uint64_t begin, end;
+			if (GetTimestamp(s_frameBegin, begin) && GetTimestamp(s_frameEnd, end))
+				m_frameTime.Add(ToMs(begin, end));
+			if (GetTimestamp(s_frameBegin, begin) && GetTimestamp(s_shadowPassEnd, end))
+				m_shadowPassTime.Add(ToMs(begin, end));
+			if (GetTimestamp(s_shadingPassBegin, begin) && GetTimestamp(s_frameEnd, end))
+				m_shadingPassTime.Add(ToMs(begin, end));
+
+			// Render queues are drawn in ascending order, each ends where the next drawn one begins:
+			bool hasEnd = GetTimestamp(s_frameEnd, end);
+			for (uint32_t i = s_renderQueueCount; i-- > 0;)
+			{
+				if (GetTimestamp(s_renderQueueBegin + i, begin))
+				{
+					m_renderQueueTimes[i].Add(hasEnd ? ToMs(begin, end) : 0.0);
+					end = begin;
+					hasEnd = true;
+				}
+				else
+					m_renderQueueTimes[i].Add(0.0);
+			}
+
+			// Shadow layers without casters are not recorded:
+			for (uint32_t i = 0; i < m_shadowLayerCount; i++)
+			{
+				if (GetTimestamp(GetShadowLayerBeginSlot(i), begin) && GetTimestamp(GetShadowLayerEndSlot(i), end))
+					m_shadowLayerTimes[i].Add(ToMs(begin, end));
+				else
+					m_shadowLayerTimes[i].Add(0.0);
+			}
+		}
+		else
+			LOG_WARN("GpuTimer::ReadResults() failed to read timestamps: {}", std::to_string(result));
+	}
+
+	// Pipeline statistics (vertex invocations, fragment invocations and availability per pass):
+	if (m_statisticsPool != VK_NULL_HANDLE)
+	{
+		std::array<uint64_t, 6> statistics = {};
+		VkResult result = vkGetQueryPoolResults(m_pContext->GetVkDevice(), m_statisticsPool, frameIndex * 2, 2,
+			sizeof(statistics), statistics.data(), 3 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+		if (result == VK_SUCCESS || result == VK_NOT_READY)
+			for (uint32_t pass = 0; pass < 2; pass++)
+				if (statistics[3 * pass + 2] != 0)
+				{
+					m_invocations[pass][0].Add(static_cast<double>(statistics[3 * pass + 0]));
+					m_invocations[pass][1].Add(static_cast<double>(statistics[3 * pass + 1]));
+				}
+	}
+}
+/// <summary>
+/// Resets all queries of the current frameIndex. Must be recorded outside of a render pass, before any other query command of the frame.
+/// </summary>
+void GpuTimer::ResetQueries(VkCommandBuffer commandBuffer)
+{
+	uint32_t frameIndex = m_pContext->frameIndex;
+	if (m_timestampPool != VK_NULL_HANDLE)
+		vkCmdResetQueryPool(commandBuffer, m_timestampPool, frameIndex * m_timestampsPerFrame, m_timestampsPerFrame);
+	if (m_statisticsPool != VK_NULL_HANDLE)
+		vkCmdResetQueryPool(commandBuffer, m_statisticsPool, frameIndex * 2, 2);
+	m_recorded[frameIndex] = true;
+}
+/// <summary>
+/// Each slot may only be written once per frame. Thread safe, as long as every thread uses its own command buffer.
+/// </summary>
+void GpuTimer::WriteTimestamp(VkCommandBuffer commandBuffer, VkPipelineStageFlagBits stage, uint32_t slot)
+{
+	if (m_timestampPool == VK_NULL_HANDLE || slot >= m_timestampsPerFrame)
+		return;
+	vkCmdWriteTimestamp(commandBuffer, stage, m_timestampPool, m_pContext->frameIndex * m_timestampsPerFrame + slot);
+}
+/// <summary>
+/// Must be recorded outside of the render pass. Secondary command buffers executed while the query is active
+/// need GetPipelineStatisticFlags() in their inheritance info.
+/// </summary>
+void GpuTimer::BeginStatistics(VkCommandBuffer commandBuffer, Pass pass)
+{
+	if (m_statisticsPool == VK_NULL_HANDLE)
+		return;
+	vkCmdBeginQuery(commandBuffer, m_statisticsPool, m_pContext->frameIndex * 2 + static_cast<uint32_t>(pass), 0);
+}
+void GpuTimer::EndStatistics(VkCommandBuffer commandBuffer, Pass pass)
+{
+	if (m_statisticsPool == VK_NULL_HANDLE)
+		return;
+	vkCmdEndQuery(commandBuffer, m_statisticsPool, m_pContext->frameIndex * 2 + static_cast<uint32_t>(pass));
+}
+
+
+
+// Getters:
+bool GpuTimer::IsEnabled() const
+{
+	return m_timestampPool != VK_NULL_HANDLE;
+}
+VkQueryPipelineStatisticFlags GpuTimer::GetPipelineStatisticFlags() const
+{
+	return m_statisticFlags;
+}
+uint32_t GpuTimer::GetRenderQueueSlot(Material::RenderQueue renderQueue)
+{
+	return s_renderQueueBegin + std::min(static_cast<uint32_t>(renderQueue) / 1000, s_renderQueueCount - 1);
+}
+uint32_t GpuTimer::GetShadowLayerBeginSlot(uint32_t shadowMapIndex)
+{
+	return s_shadowLayerBegin + 2 * shadowMapIndex;
+}
+uint32_t GpuTimer::GetShadowLayerEndSlot(uint32_t shadowMapIndex)
+{
+	return s_shadowLayerBegin + 2 * shadowMapIndex + 1;
+}
+double GpuTimer::GetFrameTime() const
+{
+	return m_frameTime.Get();
+}
+double GpuTimer::GetShadowPassTime() const
+{
+	return m_shadowPassTime.Get();
+}
+double GpuTimer::GetShadingPassTime() const
+{
+	return m_shadingPassTime.Get();
+}
+double GpuTimer::GetRenderQueueTime(Material::RenderQueue renderQueue) const
+{
+	return m_renderQueueTimes[GetRenderQueueSlot(renderQueue) - s_renderQueueBegin].Get();
+}
+double GpuTimer::GetShadowLayerTime(uint32_t shadowMapIndex) const
+{
+	return shadowMapIndex < m_shadowLayerCount ? m_shadowLayerTimes[shadowMapIndex].Get() : 0.0;
+}
+double GpuTimer::GetVertexInvocations(Pass pass) const
+{
+	return m_invocations[static_cast<uint32_t>(pass)][0].Get();
+}
+double GpuTimer::GetFragmentInvocations(Pass pass) const
+{
+	return m_invocations[static_cast<uint32_t>(pass)][1].Get();
+}
+
+
+
+// Private methods:
+bool GpuTimer::GetTimestamp(uint32_t slot, uint64_t& timestamp) const
+{
+	if (m_timestamps[2 * slot + 1] == 0)	// not written this frame
+		return false;
+	timestamp = m_timestamps[2 * slot] & m_timestampMask;
+	return true;
+}
+double GpuTimer::ToMs(uint64_t begin, uint64_t end) const
+{
+	return end >= begin ? (end - begin) * m_msPerTick : 0.0;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#ifndef __INCLUDE_GUARD_gpuTimer_h__
+#define __INCLUDE_GUARD_gpuTimer_h__
+#include "material.h"
+#include <vulkan/vulkan.h>
+#include <array>
+#include <vector>
+
+
+
+struct VulkanContext;
+
+
+
+/// <summary>
+/// Average over the last s_windowSize samples.
+/// </summary>
+struct RollingAverage
+{
+	static constexpr uint32_t s_windowSize = 64;
+	std::array<double, s_windowSize> samples = {};
+	double sum = 0.0;
+	uint32_t count = 0;
+	uint32_t next = 0;
+
+	void Add(double sample);
+	double Get() const;
+};
+
+
+
+/// <summary>
+/// Gpu timestamps and pipeline statistics of the shadow and shading pass, one set of queries per frame in flight. <para/>
+/// Timestamp slots: frame begin/end, shadow pass end, shading pass begin, begin of each render queue in the shading pass,
+/// begin/end of each shadow map layer. Queries that were not written in a frame (e.g. an empty render queue) are skipped. <para/>
+/// Results of a frameIndex are read without waiting after its fence has been signaled, i.e. framesInFlight frames later,
+/// and folded into rolling averages. Pipeline statistics need the pipelineStatisticsQuery and inheritedQueries device features.
+/// </summary>
+class GpuTimer
+{
+public: // Enums:
+	enum class Pass { shadow = 0, shading = 1 };
+
+public: // Members:
+	static constexpr uint32_t s_frameBegin = 0;
+	static constexpr uint32_t s_shadowPassEnd = 1;
+	static constexpr uint32_t s_shadingPassBegin = 2;
+	static constexpr uint32_t s_frameEnd = 3;
+	static constexpr uint32_t s_renderQueueCount = 8;	// render queue / 1000, same as in MeshRenderer::GetSortKey
+	static constexpr uint32_t s_renderQueueBegin = 4;
+	static constexpr uint32_t s_shadowLayerBegin = s_renderQueueBegin + s_renderQueueCount;
+
+private: // Members:
+	VkQueryPool m_timestampPool;
+	VkQueryPool m_statisticsPool;
+	VkQueryPipelineStatisticFlags m_statisticFlags;
+	uint32_t m_timestampsPerFrame;
+	uint32_t m_shadowLayerCount;
+	uint64_t m_timestampMask;
+	double m_msPerTick;
+	std::vector<bool> m_recorded;	// per frameIndex: queries have been reset and submitted since the last read.
+	std::vector<uint64_t> m_timestamps;	// readback storage: value and availability per query.
+	RollingAverage m_frameTime;
+	RollingAverage m_shadowPassTime;
+	RollingAverage m_shadingPassTime;
+	std::array<RollingAverage, s_renderQueueCount> m_renderQueueTimes;
+	std::vector<RollingAverage> m_shadowLayerTimes;
+	std::array<std::array<RollingAverage, 2>, 2> m_invocations;	// [pass][vertex, fragment]
+	VulkanContext* m_pContext;
+
+public: // Methods:
+	GpuTimer(VulkanContext* pContext, uint32_t shadowLayerCount);
+	~GpuTimer();
+
+	// Recording (frameIndex of the context):
+	void ReadResults();
+	void ResetQueries(VkCommandBuffer commandBuffer);
+	void WriteTimestamp(VkCommandBuffer commandBuffer, VkPipelineStageFlagBits stage, uint32_t slot);
+	void BeginStatistics(VkCommandBuffer commandBuffer, Pass pass);
+	void EndStatistics(VkCommandBuffer commandBuffer, Pass pass);
+
+	// Getters (averages in milliseconds and invocations per frame):
+	bool IsEnabled() const;
+	VkQueryPipelineStatisticFlags GetPipelineStatisticFlags() const;
+	static uint32_t GetRenderQueueSlot(Material::RenderQueue renderQueue);
+	static uint32_t GetShadowLayerBeginSlot(uint32_t shadowMapIndex);
+	static uint32_t GetShadowLayerEndSlot(uint32_t shadowMapIndex);
+	double GetFrameTime() const;
+	double GetShadowPassTime() const;
+	double GetShadingPassTime() const;
+	double GetRenderQueueTime(Material::RenderQueue renderQueue) const;
+	double GetShadowLayerTime(uint32_t shadowMapIndex) const;
+	double GetVertexInvocations(Pass pass) const;
+	double GetFragmentInvocations(Pass pass) const;
+
+private: // Methods:
+	bool GetTimestamp(uint32_t slot, uint64_t& timestamp) const;
+	double ToMs(uint64_t begin, uint64_t end) const;
+
+	// Delete copy semantics:
+	GpuTimer(const GpuTimer&) = delete;
+	GpuTimer& operator=(const GpuTimer&) = delete;
+};
+
+
+
+#endif // __INCLUDE_GUARD_gpuTimer_h__
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "renderStats.h"
+
+
+
+// Public methods:
+uint32_t RenderStats::GetIssuedCommands() const
+{
+	return pipelineBinds + descriptorSetBinds + bufferBinds + pushConstantUpdates;
+}
+uint32_t& RenderStats::ShadowDrawCalls(LightType lightType)
+{
+	return shadowDrawCalls[static_cast<uint32_t>(lightType)];
+}
+/// <summary>
+/// Adds the command buffer counters (draws, triangles, binds, push constants), frame wide values are left untouched.
+/// </summary>
+RenderStats& RenderStats::operator+=(const RenderStats& other)
+{
+	drawCalls += other.drawCalls;
+	triangles += other.triangles;
+	pipelineBinds += other.pipelineBinds;
+	descriptorSetBinds += other.descriptorSetBinds;
+	bufferBinds += other.bufferBinds;
+	pushConstantUpdates += other.pushConstantUpdates;
+	elidedCommands += other.elidedCommands;
+	return *this;
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef __INCLUDE_GUARD_renderStats_h__
+#define __INCLUDE_GUARD_renderStats_h__
+#include <array>
+#include <cstdint>
+
+
+
+/// <summary>
+/// Workload of one frame, filled by VulkanRenderer and CommandStateTracker.
+/// Counters cover the shadow and the shading pass unless stated otherwise.
+/// </summary>
+struct RenderStats
+{
+	enum class LightType { directional = 0, spot = 1, point = 2 };
+
+	uint64_t frameNumber = 0;
+	uint32_t drawCalls = 0;
+	uint64_t triangles = 0;				// instances included
+	uint32_t pipelineBinds = 0;
+	uint32_t descriptorSetBinds = 0;
+	uint32_t bufferBinds = 0;			// vertex and index buffers
+	uint32_t pushConstantUpdates = 0;
+	uint32_t elidedCommands = 0;		// redundant binds and push constants skipped by CommandStateTracker
+	uint64_t uniformBytes = 0;			// per draw uniform data written into the UniformRingBuffer
+	uint32_t activeRenderers = 0;		// active and inside the camera frustum
+	uint32_t culledRenderers = 0;		// active but outside the camera frustum
+	uint32_t immediateDraws = 0;		// Graphics::Draw* calls
+	std::array<uint32_t, 3> shadowDrawCalls = {};	// per LightType
+	uint32_t shadowMapsRendered = 0;	// shadow atlas tiles that were (re)rendered
+	uint32_t shadowMapsReused = 0;		// shadow atlas tiles that kept their content of a previous frame
+	float recordTime = 0.0f;			// cpu seconds spent recording command buffers
+	float deltaTime = 0.0f;				// Timer::GetDeltaTime() of the frame, to correlate spikes with the workload
+
+	uint32_t GetIssuedCommands() const;
+	uint32_t& ShadowDrawCalls(LightType lightType);
+	RenderStats& operator+=(const RenderStats& other);
+};
+
+
+
+#endif // __INCLUDE_GUARD_renderStats_h__
\ No newline at end of file
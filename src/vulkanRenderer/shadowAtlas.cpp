@@ -0,0 +1,243 @@
+#include "shadowAtlas.h"
+#include "logger.h"
+#include <algorithm>
+#include <bit>
+
+
+
+// Constructor:
+ShadowAtlas::ShadowAtlas(uint32_t size)
+{
+	Reset(size);
+}
+
+
+
+// Public methods:
+/// <summary>
+/// Frees all tiles and changes the edge length of the atlas, which must be a power of two.
+/// </summary>
+void ShadowAtlas::Reset(uint32_t size)
+{
+	m_size = size;
+	m_freeTiles.assign(GetLevel(s_minTileSize) + 1, std::vector<ShadowTile>());
+	m_freeTiles[0].push_back(ShadowTile{ 0, 0, size });
+	m_allocations.clear();
+}
+/// <summary>
+/// Assigns a tile to every request. Requests are clamped to [s_minTileSize, s_maxTileSize] and the largest
+/// requests are halved until the total area fits into the atlas. Requests that do not fit even at
+/// s_minTileSize get a tile of size 0.
+/// </summary>
+void ShadowAtlas::Allocate(std::vector<ShadowTileRequest>& requests)
+{
+	uint64_t area = 0;
+	for (ShadowTileRequest& request : requests)
+	{
+		request.size = std::clamp(request.size, s_minTileSize, std::min(s_maxTileSize, m_size));
+		area += static_cast<uint64_t>(request.size) * request.size;
+	}
+	uint64_t capacity = static_cast<uint64_t>(m_size) * m_size;
+	while (area > capacity)
+	{
+		ShadowTileRequest& largest = *std::max_element(requests.begin(), requests.end(), [](const ShadowTileRequest& a, const ShadowTileRequest& b) { return a.size < b.size; });
+		if (largest.size == s_minTileSize)
+		{
+			LOG_WARN("ShadowAtlas::Allocate() {} shadow maps do not fit into a {}x{} atlas.", requests.size(), m_size, m_size);
+			break;
+		}
+		area -= 3 * static_cast<uint64_t>(largest.size) * largest.size / 4;
+		largest.size /= 2;
+	}
+
+	// Keep tiles that are requested with the same size again, free tiles whose size changed:
+	for (auto& [key, allocation] : m_allocations)
+		allocation.isRequested = false;
+	for (ShadowTileRequest& request : requests)
+	{
+		request.isNewTile = true;
+		auto it = m_allocations.find({ request.pLight, request.face });
+		if (it == m_allocations.end())
+			continue;
+		if (it->second.tile.size == request.size)
+		{
+			it->second.isRequested = true;
+			request.tile = it->second.tile;
+			request.isNewTile = false;
+		}
+		else
+		{
+			FreeTile(it->second.tile);
+			m_allocations.erase(it);
+		}
+	}
+
+	// Free tiles of lights that are gone:
+	for (auto it = m_allocations.begin(); it != m_allocations.end();)
+	{
+		if (it->second.isRequested)
+			it++;
+		else
+		{
+			FreeTile(it->second.tile);
+			it = m_allocations.erase(it);
+		}
+	}
+
+	// Place new tiles, repack everything if fragmentation prevents it:
+	m_order.clear();
+	for (uint32_t i = 0; i < requests.size(); i++)
+		if (requests[i].isNewTile)
+			m_order.push_back(i);
+	if (AllocateInOrder(requests))
+		return;
+
+	LOG_TRACE("ShadowAtlas::Allocate() atlas is fragmented, repacking {} tiles.", requests.size());
+	Reset(m_size);
+	m_order.resize(requests.size());
+	for (uint32_t i = 0; i < requests.size(); i++)
+		m_order[i] = i;
+	AllocateInOrder(requests);
+}
+/// <summary>
+/// Records what has been rendered into the tile of the light face. Ignored if the light face has no tile.
+/// </summary>
+void ShadowAtlas::SetContent(const void* pLight, uint32_t face, const ShadowTileContent& content)
+{
+	auto it = m_allocations.find({ pLight, face });
+	if (it == m_allocations.end())
+		return;
+	it->second.hasContent = true;
+	it->second.content = content;
+}
+
+
+
+// Getters:
+uint32_t ShadowAtlas::GetSize() const
+{
+	return m_size;
+}
+/// <summary>
+/// Tile of the light face in atlas uv space: xy = offset, zw = size. Zero if the light has no tile.
+/// </summary>
+Float4 ShadowAtlas::GetUvRect(const void* pLight, uint32_t face) const
+{
+	auto it = m_allocations.find({ pLight, face });
+	if (it == m_allocations.end())
+		return Float4::zero;
+	const ShadowTile& tile = it->second.tile;
+	float texelSize = 1.0f / m_size;
+	return Float4(tile.x * texelSize, tile.y * texelSize, tile.size * texelSize, tile.size * texelSize);
+}
+/// <summary>
+/// Content of the tile of the light face, nullptr if it has no tile or nothing has been rendered into it yet.
+/// </summary>
+const ShadowTileContent* ShadowAtlas::GetContent(const void* pLight, uint32_t face) const
+{
+	auto it = m_allocations.find({ pLight, face });
+	if (it == m_allocations.end() || !it->second.hasContent)
+		return nullptr;
+	return &it->second.content;
+}
+/// <summary>
+/// Tile size for a shadow map that covers roughly pixelCoverage pixels on screen.
+/// </summary>
+uint32_t ShadowAtlas::GetTileSize(float pixelCoverage)
+{
+	uint32_t size = std::bit_ceil(static_cast<uint32_t>(std::clamp(pixelCoverage, 1.0f, static_cast<float>(s_maxTileSize))));
+	return std::max(size, s_minTileSize);
+}
+/// <summary>
+/// Smallest atlas size in [s_minAtlasSize, s_maxAtlasSize] that fits all requests at their requested size.
+/// </summary>
+uint32_t ShadowAtlas::GetRequiredSize(const std::vector<ShadowTileRequest>& requests)
+{
+	uint64_t area = 0;
+	uint32_t largest = 0;
+	for (const ShadowTileRequest& request : requests)
+	{
+		uint32_t size = std::clamp(request.size, s_minTileSize, s_maxTileSize);
+		area += static_cast<uint64_t>(size) * size;
+		largest = std::max(largest, size);
+	}
+
+	uint32_t size = std::max(s_minAtlasSize, largest);
+	while (static_cast<uint64_t>(size) * size < area && size < s_maxAtlasSize)
+		size *= 2;
+	return size;
+}
+
+
+
+// Private methods:
+uint32_t ShadowAtlas::GetLevel(uint32_t tileSize) const
+{
+	return std::countr_zero(m_size) - std::countr_zero(tileSize);
+}
+/// <summary>
+/// Takes the smallest free tile that is large enough and splits it down to the requested size.
+/// </summary>
+bool ShadowAtlas::AllocateTile(uint32_t size, ShadowTile& tile)
+{
+	uint32_t targetLevel = GetLevel(size);
+	int level = targetLevel;
+	while (level >= 0 && m_freeTiles[level].empty())
+		level--;
+	if (level < 0)
+		return false;
+
+	tile = m_freeTiles[level].back();
+	m_freeTiles[level].pop_back();
+	for (; level < static_cast<int>(targetLevel); level++)
+	{
+		uint32_t half = tile.size / 2;
+		m_freeTiles[level + 1].push_back(ShadowTile{ tile.x + half, tile.y, half });
+		m_freeTiles[level + 1].push_back(ShadowTile{ tile.x, tile.y + half, half });
+		m_freeTiles[level + 1].push_back(ShadowTile{ tile.x + half, tile.y + half, half });
+		tile.size = half;
+	}
+	return true;
+}
+/// <summary>
+/// Returns the tile to its free list and merges it with its siblings as long as all four quadrants are free.
+/// </summary>
+void ShadowAtlas::FreeTile(ShadowTile tile)
+{
+	uint32_t level = GetLevel(tile.size);
+	while (level > 0)
+	{
+		uint32_t parentSize = 2 * tile.size;
+		auto isSibling = [&](const ShadowTile& other) { return other.x / parentSize == tile.x / parentSize && other.y / parentSize == tile.y / parentSize; };
+		std::vector<ShadowTile>& freeTiles = m_freeTiles[level];
+		if (std::count_if(freeTiles.begin(), freeTiles.end(), isSibling) < 3)
+			break;
+
+		std::erase_if(freeTiles, isSibling);
+		tile = ShadowTile{ tile.x - tile.x % parentSize, tile.y - tile.y % parentSize, parentSize };
+		level--;
+	}
+	m_freeTiles[level].push_back(tile);
+}
+/// <summary>
+/// Allocates the requests in m_order largest first, which packs power of two tiles without gaps into an empty atlas.
+/// Requests that do not fit get a tile of size 0. Returns false if any request did not fit.
+/// </summary>
+bool ShadowAtlas::AllocateInOrder(std::vector<ShadowTileRequest>& requests)
+{
+	std::stable_sort(m_order.begin(), m_order.end(), [&](uint32_t a, uint32_t b) { return requests[a].size > requests[b].size; });
+	bool allocatedAll = true;
+	for (uint32_t i : m_order)
+	{
+		ShadowTileRequest& request = requests[i];
+		request.isNewTile = true;
+		if (!AllocateTile(request.size, request.tile))
+		{
+			request.tile = ShadowTile{ 0, 0, 0 };
+			allocatedAll = false;
+			continue;
+		}
+		m_allocations[{ request.pLight, request.face }] = Allocation{ request.tile, true, false, ShadowTileContent{} };
+	}
+	return allocatedAll;
+}
\ No newline at end of file
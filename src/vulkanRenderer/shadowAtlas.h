@@ -0,0 +1,101 @@
+#ifndef __INCLUDE_GUARD_shadowAtlas_h__
+#define __INCLUDE_GUARD_shadowAtlas_h__
+#include "float4.h"
+#include "float4x4.h"
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+
+/// <summary>
+/// Square region of the shadow atlas in texels.
+/// </summary>
+struct ShadowTile
+{
+	uint32_t x;
+	uint32_t y;
+	uint32_t size;
+};
+
+
+
+/// <summary>
+/// What was rendered into a tile. Tiles keep their depth values across frames until they are rendered again.
+/// </summary>
+struct ShadowTileContent
+{
+	Float4x4 worldToClipMatrix;	// light matrix the tile was rendered with
+	uint64_t casterHash;		// identifies the casters and their transforms that were rendered into the tile
+};
+
+
+
+/// <summary>
+/// Tile request of one shadow map, i.e. a directional light, spot light or point light face.
+/// The light and face identify the tile across frames.
+/// </summary>
+struct ShadowTileRequest
+{
+	const void* pLight;
+	uint32_t face;
+	uint32_t size;		// requested edge length in texels, power of two, may be reduced by ShadowAtlas::Allocate()
+	ShadowTile tile;	// result of ShadowAtlas::Allocate()
+	bool isNewTile;		// tile was (re)assigned this frame, its previous content does not belong to the light
+};
+
+
+
+/// <summary>
+/// Quadtree (buddy) allocator for square power of two tiles in the shadow atlas. <para/>
+/// Tiles are kept across frames as long as their light requests the same size again.
+/// Tiles of lights that vanished or changed size are freed and merged with their free siblings,
+/// new tiles are placed largest first. If that fails due to fragmentation all tiles are repacked,
+/// which always succeeds as long as the total requested area fits into the atlas. <para/>
+/// The content of a tile is only known after SetContent(), (re)assigned tiles start without content.
+/// </summary>
+class ShadowAtlas
+{
+public: // Members:
+	static constexpr uint32_t s_minTileSize = 128;
+	static constexpr uint32_t s_maxTileSize = 2048;
+	static constexpr uint32_t s_minAtlasSize = 1024;
+	static constexpr uint32_t s_maxAtlasSize = 4096;
+
+private: // Members:
+	struct Allocation
+	{
+		ShadowTile tile;
+		bool isRequested;
+		bool hasContent;
+		ShadowTileContent content;
+	};
+	uint32_t m_size;
+	std::vector<std::vector<ShadowTile>> m_freeTiles;	// per quadtree level, level 0 is the whole atlas
+	std::map<std::pair<const void*, uint32_t>, Allocation> m_allocations;
+	std::vector<uint32_t> m_order;						// scratch: request indices, largest tile first
+
+public: // Methods:
+	ShadowAtlas(uint32_t size);
+	void Reset(uint32_t size);
+	void Allocate(std::vector<ShadowTileRequest>& requests);
+	void SetContent(const void* pLight, uint32_t face, const ShadowTileContent& content);
+
+	// Getters:
+	uint32_t GetSize() const;
+	Float4 GetUvRect(const void* pLight, uint32_t face) const;
+	const ShadowTileContent* GetContent(const void* pLight, uint32_t face) const;
+	static uint32_t GetTileSize(float pixelCoverage);
+	static uint32_t GetRequiredSize(const std::vector<ShadowTileRequest>& requests);
+
+private: // Methods:
+	uint32_t GetLevel(uint32_t tileSize) const;
+	bool AllocateTile(uint32_t size, ShadowTile& tile);
+	void FreeTile(ShadowTile tile);
+	bool AllocateInOrder(std::vector<ShadowTileRequest>& requests);
+};
+
+
+
+#endif // __INCLUDE_GUARD_shadowAtlas_h__
\ No newline at end of file
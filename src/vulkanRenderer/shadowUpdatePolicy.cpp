@@ -0,0 +1,68 @@
+#include "shadowUpdatePolicy.h"
+#include "shadowAtlas.h"
+#include <cstring>
+
+
+
+// Public methods:
+/// <summary>
+/// FNV-1a style hash step over one caster, 64 bits at a time. Start with s_emptyCasterHash and chain the visible casters in a fixed order.
+/// Changes when the caster moves, changes its mesh or the mesh data changes (meshVersion).
+/// </summary>
+uint64_t ShadowUpdatePolicy::HashCaster(uint64_t hash, const void* pMeshRenderer, const void* pMesh, uint64_t meshVersion, const Float4x4& localToWorldMatrix)
+{
+	auto hashWord = [&hash](uint64_t word) { hash = (hash ^ word) * 1099511628211ull; };
+	hashWord(reinterpret_cast<uintptr_t>(pMeshRenderer));
+	hashWord(reinterpret_cast<uintptr_t>(pMesh));
+	hashWord(meshVersion);
+	uint64_t words[sizeof(Float4x4) / sizeof(uint64_t)];
+	memcpy(words, &localToWorldMatrix, sizeof(Float4x4));
+	for (uint64_t word : words)
+		hashWord(word);
+	return hash;
+}
+/// <summary>
+/// Whether the time sliced view with the given index (among all time sliced views) may be updated this frame. A budget of 0 allows all views.
+/// </summary>
+bool ShadowUpdatePolicy::IsInTimeSliceWindow(uint32_t timeSlicedIndex, uint32_t timeSlicedCount, uint32_t budget, uint32_t cursor)
+{
+	if (budget == 0)
+		return true;
+	return (timeSlicedIndex + timeSlicedCount - cursor % timeSlicedCount) % timeSlicedCount < budget;
+}
+/// <summary>
+/// Cursor of the next frame's window, which starts right after the current one.
+/// </summary>
+uint32_t ShadowUpdatePolicy::AdvanceTimeSliceCursor(uint32_t cursor, uint32_t timeSlicedCount, uint32_t budget)
+{
+	if (timeSlicedCount == 0)
+		return cursor;
+	return (cursor + budget) % timeSlicedCount;
+}
+/// <summary>
+/// Whether the casters of a view must be culled and hashed this frame. Views outside of the window keep their content unchecked.
+/// </summary>
+bool ShadowUpdatePolicy::IsCheckRequired(const ShadowTileContent* pContent, bool isInTimeSliceWindow)
+{
+	return pContent == nullptr || isInTimeSliceWindow;
+}
+/// <summary>
+/// Whether the tile must be rendered, i.e. has no content or its content was rendered with another light matrix or other casters.
+/// </summary>
+bool ShadowUpdatePolicy::IsRenderRequired(const ShadowTileContent* pContent, const Float4x4& worldToClipMatrix, uint64_t casterHash)
+{
+	return pContent == nullptr || pContent->worldToClipMatrix != worldToClipMatrix || pContent->casterHash != casterHash;
+}
+
+
+
+// Getters:
+/// <summary>
+/// Maximum number of frames between two checks of the same time sliced view.
+/// </summary>
+uint32_t ShadowUpdatePolicy::GetTimeSlicePeriod(uint32_t timeSlicedCount, uint32_t budget)
+{
+	if (budget == 0 || budget >= timeSlicedCount)
+		return 1;
+	return (timeSlicedCount + budget - 1) / budget;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef __INCLUDE_GUARD_shadowUpdatePolicy_h__
+#define __INCLUDE_GUARD_shadowUpdatePolicy_h__
+#include "float4x4.h"
+#include <cstdint>
+
+
+
+struct ShadowTileContent;
+
+
+
+/// <summary>
+/// Purely static class that decides which shadow maps are rendered in a frame, see VulkanRenderer::RecordShadowCommandBuffer(). <para/>
+/// A tile is reused as long as its light matrix and caster hash match what was rendered into it. <para/>
+/// Time sliced views are only checked inside a round robin window of 'budget' views that advances by 'budget' every frame,
+/// so every time sliced view is checked at least once every GetTimeSlicePeriod() frames. Views without content are always rendered.
+/// </summary>
+class ShadowUpdatePolicy
+{
+public: // Members:
+	static constexpr uint64_t s_emptyCasterHash = 14695981039346656037ull;	// caster hash of a view without casters
+
+public: // Methods:
+	static uint64_t HashCaster(uint64_t hash, const void* pMeshRenderer, const void* pMesh, uint64_t meshVersion, const Float4x4& localToWorldMatrix);
+	static bool IsInTimeSliceWindow(uint32_t timeSlicedIndex, uint32_t timeSlicedCount, uint32_t budget, uint32_t cursor);
+	static uint32_t AdvanceTimeSliceCursor(uint32_t cursor, uint32_t timeSlicedCount, uint32_t budget);
+	static bool IsCheckRequired(const ShadowTileContent* pContent, bool isInTimeSliceWindow);
+	static bool IsRenderRequired(const ShadowTileContent* pContent, const Float4x4& worldToClipMatrix, uint64_t casterHash);
+
+	// Getters:
+	static uint32_t GetTimeSlicePeriod(uint32_t timeSlicedCount, uint32_t budget);
+
+private: // Methods
+	// Delete all constructors:
+	ShadowUpdatePolicy() = delete;
+	ShadowUpdatePolicy(const ShadowUpdatePolicy&) = delete;
+	ShadowUpdatePolicy& operator=(const ShadowUpdatePolicy&) = delete;
+	~ShadowUpdatePolicy() = delete;
+};
+
+
+
+#endif // __INCLUDE_GUARD_shadowUpdatePolicy_h__
\ No newline at end of file
@@ -0,0 +1,405 @@
+#include "uploadManager.h"
+#include "logger.h"
+#include "profiler.h"
+#include "vmaBuffer.h"
+#include "vmaImage.h"
+#include "vulkanCommand.h"
+#include "vulkanContext.h"
+#include "vulkanMacros.h"
+#include <algorithm>
+#include <cstring>
+
+
+
+// Static members:
+bool UploadManager::s_isInitialized = false;
+VulkanContext* UploadManager::s_pContext;
+bool UploadManager::s_hasTransferQueue = false;
+uint64_t UploadManager::s_alignment = 16;
+std::unique_ptr<VmaBuffer> UploadManager::s_ringBuffer;
+char* UploadManager::s_pRingData = nullptr;
+uint64_t UploadManager::s_ringHead = 0;
+uint64_t UploadManager::s_ringTail = 0;
+std::array<UploadManager::Batch, UploadManager::s_batchCount> UploadManager::s_batches;
+uint32_t UploadManager::s_batchIndex = 0;
+uint64_t UploadManager::s_uploadedBytes = 0;
+
+
+
+// Initialization and cleanup:
+void UploadManager::Init(VulkanContext* pContext)
+{
+	if (s_isInitialized)
+		return;
+
+	s_isInitialized = true;
+	s_pContext = pContext;
+	s_hasTransferQueue = s_pContext->pLogicalDevice->GetTransferQueue().familyIndex != s_pContext->pLogicalDevice->GetGraphicsQueue().familyIndex;
+	s_ringHead = 0;
+	s_ringTail = 0;
+	s_batchIndex = 0;
+	s_uploadedBytes = 0;
+
+	// Image copies need offsets that are multiples of the texel size, 16 covers all uncompressed formats:
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(s_pContext->GetVkPhysicalDevice(), &properties);
+	s_alignment = std::max<uint64_t>(properties.limits.optimalBufferCopyOffsetAlignment, 16);
+
+	// Ring buffer:
+	{
+		VkBufferCreateInfo* pBufferInfo = new VkBufferCreateInfo();
+		pBufferInfo->sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		pBufferInfo->size = s_ringCapacity;
+		pBufferInfo->usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		pBufferInfo->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		VmaAllocationCreateInfo* pAllocInfo = new VmaAllocationCreateInfo();
+		pAllocInfo->usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+		pAllocInfo->flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+		pAllocInfo->requiredFlags = 0;
+		pAllocInfo->preferredFlags = 0;
+
+		s_ringBuffer = std::make_unique<VmaBuffer>(s_pContext, pBufferInfo, pAllocInfo);
+
+		VmaAllocationInfo info;
+		vmaGetAllocationInfo(s_pContext->GetVmaAllocator(), s_ringBuffer->GetVmaAllocation(), &info);
+		s_pRingData = static_cast<char*>(info.pMappedData);
+	}
+
+	// Batches:
+	for (Batch& batch : s_batches)
+	{
+		if (s_hasTransferQueue)
+			batch.transferCommand = std::make_unique<VulkanCommand>(s_pContext, s_pContext->pLogicalDevice->GetTransferQueue());
+		batch.graphicsCommand = std::make_unique<VulkanCommand>(s_pContext, s_pContext->pLogicalDevice->GetGraphicsQueue());
+
+		VkSemaphoreCreateInfo semaphoreInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+		VKA(vkCreateSemaphore(s_pContext->GetVkDevice(), &semaphoreInfo, nullptr, &batch.transferToGraphicsSemaphore));
+		VkFenceCreateInfo fenceInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+		VKA(vkCreateFence(s_pContext->GetVkDevice(), &fenceInfo, nullptr, &batch.fence));
+		batch.isInFlight = false;
+		batch.ringHead = 0;
+	}
+}
+/// <summary>
+/// Uploads that have not been flushed yet are discarded, their destinations may already be destroyed.
+/// </summary>
+void UploadManager::Clear()
+{
+	s_pContext->WaitDeviceIdle();
+	for (Batch& batch : s_batches)
+	{
+		batch.transferCommand.reset();
+		batch.graphicsCommand.reset();
+		vkDestroySemaphore(s_pContext->GetVkDevice(), batch.transferToGraphicsSemaphore, nullptr);
+		vkDestroyFence(s_pContext->GetVkDevice(), batch.fence, nullptr);
+		batch.isInFlight = false;
+		batch.bufferCopies.clear();
+		batch.imageCopies.clear();
+		batch.oversizedBuffers.clear();
+	}
+	s_ringBuffer.reset();
+	s_pRingData = nullptr;
+	s_isInitialized = false;
+}
+
+
+
+// Uploads:
+/// <summary>
+/// Copies 'size' bytes of pData into the staging ring buffer and queues their copy to dstOffset of the destination.
+/// The destination needs VK_BUFFER_USAGE_TRANSFER_DST_BIT and VK_SHARING_MODE_EXCLUSIVE.
+/// </summary>
+void UploadManager::UploadBuffer(VmaBuffer* pDstBuffer, uint64_t dstOffset, const void* pData, uint64_t size)
+{
+	if (size == 0)
+		return;
+	VkBuffer dstBuffer = pDstBuffer->GetVkBuffer();
+
+	// Each buffer is released and acquired once per batch, so its copies must be consecutive and may not overlap:
+	{
+		Batch& batch = GetBatch();
+		bool isTrailing = true;
+		for (auto it = batch.bufferCopies.rbegin(); it != batch.bufferCopies.rend(); it++)
+		{
+			if (it->dstBuffer != dstBuffer)
+			{
+				isTrailing = false;
+				continue;
+			}
+			bool overlaps = dstOffset < it->region.dstOffset + it->region.size && it->region.dstOffset < dstOffset + size;
+			if (!isTrailing || overlaps)
+			{
+				Flush();
+				break;
+			}
+		}
+	}
+
+	BufferCopy copy = {};
+	copy.srcBuffer = AllocateStaging(pData, size, copy.region.srcOffset);
+	copy.dstBuffer = dstBuffer;
+	copy.region.dstOffset = dstOffset;
+	copy.region.size = size;
+	GetBatch().bufferCopies.push_back(copy);
+	s_uploadedBytes += size;
+}
+/// <summary>
+/// Copies 'size' bytes of pData into the staging ring buffer and queues their copy into mip level 0 of all layers of the image.
+/// The image needs VK_IMAGE_USAGE_TRANSFER_DST_BIT, and VK_IMAGE_USAGE_TRANSFER_SRC_BIT if it has more than one mip level.
+/// It ends up in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, with all mip levels generated.
+/// </summary>
+void UploadManager::UploadImage(VmaImage* pDstImage, const void* pData, uint64_t size)
+{
+	ImageCopy copy = {};
+	copy.srcBuffer = AllocateStaging(pData, size, copy.srcOffset);
+	copy.pDstImage = pDstImage;
+	GetBatch().imageCopies.push_back(copy);
+	pDstImage->SetLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);	// once the batch has been executed
+	s_uploadedBytes += size;
+}
+/// <summary>
+/// Records and submits all uploads queued since the last flush. Does not wait for them to finish.
+/// </summary>
+void UploadManager::Flush()
+{
+	Batch& batch = s_batches[s_batchIndex];
+	if (batch.bufferCopies.empty() && batch.imageCopies.empty())
+		return;
+	EMBER_PROFILE_SCOPE("UploadManager::Flush");
+
+	// Ring buffer memory may not be host coherent:
+	VKA(vmaFlushAllocation(s_pContext->GetVmaAllocator(), s_ringBuffer->GetVmaAllocation(), 0, VK_WHOLE_SIZE));
+	RecordBatch(batch);
+
+	// Transfer queue, releases ownership when done:
+	if (s_hasTransferQueue)
+	{
+		VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &batch.transferCommand->GetVkCommandBuffer();
+		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.pSignalSemaphores = &batch.transferToGraphicsSemaphore;
+		VKA(vkQueueSubmit(s_pContext->pLogicalDevice->GetTransferQueue().queue, 1, &submitInfo, VK_NULL_HANDLE));
+	}
+
+	// Graphics queue, acquires ownership and generates mipmaps:
+	{
+		VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+		submitInfo.waitSemaphoreCount = s_hasTransferQueue ? 1 : 0;
+		submitInfo.pWaitSemaphores = &batch.transferToGraphicsSemaphore;
+		submitInfo.pWaitDstStageMask = &waitStage;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &batch.graphicsCommand->GetVkCommandBuffer();
+		VKA(vkResetFences(s_pContext->GetVkDevice(), 1, &batch.fence));
+		VKA(vkQueueSubmit(s_pContext->pLogicalDevice->GetGraphicsQueue().queue, 1, &submitInfo, batch.fence));
+	}
+
+	batch.isInFlight = true;
+	batch.ringHead = s_ringHead;
+	batch.bufferCopies.clear();
+	batch.imageCopies.clear();
+	s_batchIndex = (s_batchIndex + 1) % s_batchCount;
+}
+/// <summary>
+/// Flushes pending uploads and waits until all batches have been executed.
+/// </summary>
+void UploadManager::WaitIdle()
+{
+	Flush();
+	while (WaitForOldestBatch());
+}
+
+
+
+// Getters:
+/// <summary>
+/// Total bytes uploaded since Init(), including uploads that have not been flushed yet.
+/// </summary>
+uint64_t UploadManager::GetUploadedBytes()
+{
+	return s_uploadedBytes;
+}
+
+
+
+// Private methods:
+/// <summary>
+/// Batch that collects new uploads. If it is still in flight from its last use, waits for it first.
+/// </summary>
+UploadManager::Batch& UploadManager::GetBatch()
+{
+	Batch& batch = s_batches[s_batchIndex];
+	if (batch.isInFlight)
+	{
+		VKA(vkWaitForFences(s_pContext->GetVkDevice(), 1, &batch.fence, VK_TRUE, UINT64_MAX));
+		RetireBatch(batch);
+	}
+	return batch;
+}
+/// <summary>
+/// Copies the data into the ring buffer and returns the staging buffer and offset of the copy.
+/// A full ring buffer is freed by flushing and waiting for the oldest batches in flight.
+/// Uploads larger than a quarter of the ring buffer get their own staging buffer instead.
+/// </summary>
+VkBuffer UploadManager::AllocateStaging(const void* pData, uint64_t size, VkDeviceSize& srcOffset)
+{
+	uint64_t alignedSize = (size + s_alignment - 1) / s_alignment * s_alignment;
+	if (alignedSize > s_ringCapacity / 4)
+	{
+		Batch& batch = GetBatch();
+		batch.oversizedBuffers.push_back(VmaBuffer::StagingBuffer(s_pContext, size, const_cast<void*>(pData)));
+		srcOffset = 0;
+		return batch.oversizedBuffers.back().GetVkBuffer();
+	}
+
+	// Allocations never wrap around, the end of the ring buffer is skipped instead:
+	uint64_t offset = s_ringHead % s_ringCapacity;
+	uint64_t padding = (offset + alignedSize > s_ringCapacity) ? s_ringCapacity - offset : 0;
+	while (s_ringHead + padding + alignedSize - s_ringTail > s_ringCapacity)
+		if (!WaitForOldestBatch())
+			Flush();	// only the batch that is being collected holds ring buffer memory
+
+	s_ringHead += padding;
+	srcOffset = s_ringHead % s_ringCapacity;
+	memcpy(s_pRingData + srcOffset, pData, static_cast<size_t>(size));
+	s_ringHead += alignedSize;
+	return s_ringBuffer->GetVkBuffer();
+}
+/// <summary>
+/// Waits for the oldest batch in flight and frees its resources. Returns false if no batch is in flight.
+/// </summary>
+bool UploadManager::WaitForOldestBatch()
+{
+	// Batches are submitted in index order, the batch at s_batchIndex was submitted first:
+	for (uint32_t i = 0; i < s_batchCount; i++)
+	{
+		Batch& batch = s_batches[(s_batchIndex + i) % s_batchCount];
+		if (batch.isInFlight)
+		{
+			VKA(vkWaitForFences(s_pContext->GetVkDevice(), 1, &batch.fence, VK_TRUE, UINT64_MAX));
+			RetireBatch(batch);
+			return true;
+		}
+	}
+	return false;
+}
+void UploadManager::RecordBatch(Batch& batch)
+{
+	// Without a dedicated transfer queue family everything is recorded into the graphics command buffer:
+	VkCommandBuffer graphicsCommand = batch.graphicsCommand->GetVkCommandBuffer();
+	VkCommandBuffer transferCommand = s_hasTransferQueue ? batch.transferCommand->GetVkCommandBuffer() : graphicsCommand;
+	VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	if (s_hasTransferQueue)
+	{
+		VKA(vkResetCommandPool(s_pContext->GetVkDevice(), batch.transferCommand->GetVkCommandPool(), 0));
+		VKA(vkBeginCommandBuffer(transferCommand, &beginInfo));
+	}
+	VKA(vkResetCommandPool(s_pContext->GetVkDevice(), batch.graphicsCommand->GetVkCommandPool(), 0));
+	VKA(vkBeginCommandBuffer(graphicsCommand, &beginInfo));
+
+	// Images need transfer dst layout before the copies:
+	std::vector<VkImageMemoryBarrier> imageBarriers(batch.imageCopies.size(), { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER });
+	for (uint32_t i = 0; i < batch.imageCopies.size(); i++)
+	{
+		VkImageMemoryBarrier& barrier = imageBarriers[i];
+		barrier.srcAccessMask = VK_ACCESS_NONE;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = batch.imageCopies[i].pDstImage->GetVkImage();
+		barrier.subresourceRange = *batch.imageCopies[i].pDstImage->GetSubresourceRange();
+	}
+	if (!imageBarriers.empty())
+		vkCmdPipelineBarrier(transferCommand, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+
+	// Consecutive copies between the same buffers share one copy command:
+	std::vector<VkBufferMemoryBarrier> bufferBarriers;
+	std::vector<VkBufferCopy> regions;
+	for (uint32_t i = 0; i < batch.bufferCopies.size();)
+	{
+		const BufferCopy& first = batch.bufferCopies[i];
+		regions.clear();
+		for (; i < batch.bufferCopies.size() && batch.bufferCopies[i].srcBuffer == first.srcBuffer && batch.bufferCopies[i].dstBuffer == first.dstBuffer; i++)
+			regions.push_back(batch.bufferCopies[i].region);
+		vkCmdCopyBuffer(transferCommand, first.srcBuffer, first.dstBuffer, static_cast<uint32_t>(regions.size()), regions.data());
+
+		if (bufferBarriers.empty() || bufferBarriers.back().buffer != first.dstBuffer)
+		{
+			VkBufferMemoryBarrier barrier = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+			barrier.buffer = first.dstBuffer;
+			barrier.offset = 0;
+			barrier.size = VK_WHOLE_SIZE;
+			bufferBarriers.push_back(barrier);
+		}
+	}
+	for (const ImageCopy& copy : batch.imageCopies)
+	{
+		VkBufferImageCopy region = {};
+		region.bufferOffset = copy.srcOffset;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+		region.imageSubresource.aspectMask = copy.pDstImage->GetSubresourceRange()->aspectMask;
+		region.imageSubresource.mipLevel = 0;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = copy.pDstImage->GetSubresourceRange()->layerCount;
+		region.imageOffset = { 0, 0, 0 };
+		region.imageExtent = copy.pDstImage->GetExtent();
+		vkCmdCopyBufferToImage(transferCommand, copy.srcBuffer, copy.pDstImage->GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+	}
+
+	// Ownership transfer from the transfer to the graphics queue family, images with mipmaps stay in transfer dst layout for the blits:
+	uint32_t srcFamily = s_hasTransferQueue ? s_pContext->pLogicalDevice->GetTransferQueue().familyIndex : VK_QUEUE_FAMILY_IGNORED;
+	uint32_t dstFamily = s_hasTransferQueue ? s_pContext->pLogicalDevice->GetGraphicsQueue().familyIndex : VK_QUEUE_FAMILY_IGNORED;
+	for (VkBufferMemoryBarrier& barrier : bufferBarriers)
+	{
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+		barrier.srcQueueFamilyIndex = srcFamily;
+		barrier.dstQueueFamilyIndex = dstFamily;
+	}
+	for (uint32_t i = 0; i < batch.imageCopies.size(); i++)
+	{
+		VkImageMemoryBarrier& barrier = imageBarriers[i];
+		bool hasMipmaps = batch.imageCopies[i].pDstImage->GetSubresourceRange()->levelCount > 1;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = hasMipmaps ? VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT : VK_ACCESS_SHADER_READ_BIT;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = hasMipmaps ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		barrier.srcQueueFamilyIndex = srcFamily;
+		barrier.dstQueueFamilyIndex = dstFamily;
+	}
+	VkPipelineStageFlags dstStages = VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	if (s_hasTransferQueue)
+	{
+		// Release, the dst access masks are ignored:
+		vkCmdPipelineBarrier(transferCommand, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
+			static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(), static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+		VKA(vkEndCommandBuffer(transferCommand));
+
+		// Acquire, the src access masks are ignored, the semaphore orders it after the release:
+		vkCmdPipelineBarrier(graphicsCommand, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStages, 0, 0, nullptr,
+			static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(), static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+	}
+	else
+		vkCmdPipelineBarrier(graphicsCommand, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStages, 0, 0, nullptr,
+			static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(), static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+
+	for (const ImageCopy& copy : batch.imageCopies)
+	{
+		uint32_t mipLevels = copy.pDstImage->GetSubresourceRange()->levelCount;
+		if (mipLevels > 1)
+			copy.pDstImage->GenerateMipmaps(graphicsCommand, mipLevels);
+	}
+	VKA(vkEndCommandBuffer(graphicsCommand));
+}
+void UploadManager::RetireBatch(Batch& batch)
+{
+	s_ringTail = batch.ringHead;
+	batch.oversizedBuffers.clear();
+	batch.isInFlight = false;
+}
\ No newline at end of file
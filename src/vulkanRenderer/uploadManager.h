@@ -0,0 +1,99 @@
+#ifndef __INCLUDE_GUARD_uploadManager_h__
+#define __INCLUDE_GUARD_uploadManager_h__
+#include <array>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+
+
+class VmaBuffer;
+class VmaImage;
+class VulkanCommand;
+struct VulkanContext;
+
+
+
+/// <summary>
+/// Purely static class that streams cpu data into device local buffers and images.
+/// Data is copied into a persistently mapped staging ring buffer right away, the copy commands are collected
+/// into a batch and recorded on the dedicated transfer queue when the batch is flushed. Ownership of all written
+/// resources is then released to the graphics queue, which acquires it and generates mipmaps in a second submit
+/// that waits on the transfer submit. Each batch signals a fence, its ring buffer range is reused once it passed.
+/// Images with more than one mip level get their mipmaps generated in the graphics submit.
+/// Flush() is called by the renderer once per frame before the frame is submitted, so uploads are visible to that frame.
+/// Destinations must not be in use by the gpu and must stay alive until their batch has been flushed.
+/// Not thread safe, all uploads happen on the main thread.
+/// </summary>
+class UploadManager
+{
+public: // Members
+
+private: // Members
+	struct BufferCopy
+	{
+		VkBuffer srcBuffer;
+		VkBuffer dstBuffer;
+		VkBufferCopy region;
+	};
+	struct ImageCopy
+	{
+		VkBuffer srcBuffer;
+		VmaImage* pDstImage;
+		VkDeviceSize srcOffset;
+	};
+	struct Batch
+	{
+		std::unique_ptr<VulkanCommand> transferCommand;
+		std::unique_ptr<VulkanCommand> graphicsCommand;
+		VkSemaphore transferToGraphicsSemaphore;
+		VkFence fence;
+		bool isInFlight;
+		uint64_t ringHead;	// s_ringHead at submission, ring buffer bytes before it are free once the fence passed
+		std::vector<BufferCopy> bufferCopies;
+		std::vector<ImageCopy> imageCopies;
+		std::vector<VmaBuffer> oversizedBuffers;	// staging buffers of uploads that do not fit into the ring buffer
+	};
+	static bool s_isInitialized;
+	static VulkanContext* s_pContext;
+	static bool s_hasTransferQueue;	// false if transfers fall back to the graphics queue family
+	static uint64_t s_alignment;
+	static std::unique_ptr<VmaBuffer> s_ringBuffer;
+	static char* s_pRingData;
+	static uint64_t s_ringHead;	// total bytes ever allocated, position in the ring buffer is s_ringHead % s_ringCapacity
+	static uint64_t s_ringTail;	// total bytes ever released
+	static constexpr uint64_t s_ringCapacity = 64 << 20;
+	static constexpr uint32_t s_batchCount = 4;
+	static std::array<Batch, s_batchCount> s_batches;
+	static uint32_t s_batchIndex;	// batch that collects new uploads
+	static uint64_t s_uploadedBytes;
+
+public: // Methods
+	static void Init(VulkanContext* pContext);
+	static void Clear();
+
+	static void UploadBuffer(VmaBuffer* pDstBuffer, uint64_t dstOffset, const void* pData, uint64_t size);
+	static void UploadImage(VmaImage* pDstImage, const void* pData, uint64_t size);
+	static void Flush();
+	static void WaitIdle();
+
+	// Getters:
+	static uint64_t GetUploadedBytes();
+
+private: // Methods
+	static Batch& GetBatch();
+	static VkBuffer AllocateStaging(const void* pData, uint64_t size, VkDeviceSize& srcOffset);
+	static bool WaitForOldestBatch();
+	static void RecordBatch(Batch& batch);
+	static void RetireBatch(Batch& batch);
+
+	// Delete all constructors:
+	UploadManager() = delete;
+	UploadManager(const UploadManager&) = delete;
+	UploadManager& operator=(const UploadManager&) = delete;
+	~UploadManager() = delete;
+};
+
+
+
+#endif // __INCLUDE_GUARD_uploadManager_h__
\ No newline at end of file
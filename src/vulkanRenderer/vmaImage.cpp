@@ -103,6 +103,17 @@ VkImageSubresourceLayers VmaImage::GetSubresourceLayers() const
 
 
 
+// Setters:
+/// <summary>
+/// For layout transitions recorded outside of this class, e.g. by the UploadManager.
+/// </summary>
+void VmaImage::SetLayout(VkImageLayout layout)
+{
+	m_layout = layout;
+}
+
+
+
 // Transitions etc.:
 void VmaImage::TransitionLayoutUndefinedToTransfer()
 {
@@ -133,6 +144,39 @@ void VmaImage::TransitionLayoutUndefinedToTransfer()
 
 	m_layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
 }
+/// <summary>
+/// For attachments that are loaded (loadOp LOAD) by a render pass that expects them in shader read layout.
+/// The content stays undefined until it is rendered to.
+/// </summary>
+void VmaImage::TransitionLayoutUndefinedToShaderRead()
+{
+	// Transition is executed on graphicsQueue.
+	VulkanCommand command = VulkanCommand::BeginSingleTimeCommand(m_pContext, m_pContext->pLogicalDevice->GetGraphicsQueue());
+
+	VkImageMemoryBarrier barrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+	barrier.srcAccessMask = VK_ACCESS_NONE;				// types of memory access allowed before the barrier
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;	// types of memory access allowed after the barrier
+	barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image = m_image;
+	barrier.subresourceRange = *m_pSubresourceRange;
+
+	VkPipelineStageFlags srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;		// Immediatly
+	VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;	// Before final stage
+	vkCmdPipelineBarrier(
+		command.GetVkCommandBuffer(),
+		srcStage, dstStage,
+		0,	// dependency flags, typically 0
+		0, nullptr,				// memory barriers
+		0, nullptr,	// buffer memory barriers
+		1, &barrier);	// image memory barriers
+
+	VulkanCommand::EndSingleTimeCommand(m_pContext, command, m_pContext->pLogicalDevice->GetGraphicsQueue());
+
+	m_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
 void VmaImage::HandoffTransferToGraphicsQueue()
 {
 	// On transition ownership of the image is transferred from the transferQueue to the graphicsQueue.
@@ -252,7 +296,14 @@ void VmaImage::TransitionLayoutTransferToShaderRead()
 void VmaImage::GenerateMipmaps(uint32_t mipLevels)
 {
 	VulkanCommand command = VulkanCommand::BeginSingleTimeCommand(m_pContext, m_pContext->pLogicalDevice->GetGraphicsQueue());
-
+	GenerateMipmaps(command.GetVkCommandBuffer(), mipLevels);
+	VulkanCommand::EndSingleTimeCommand(m_pContext, command, m_pContext->pLogicalDevice->GetGraphicsQueue());
+}
+/// <summary>
+/// Records the mipmap generation into a graphics command buffer. All mip levels must be in transfer dst layout.
+/// </summary>
+void VmaImage::GenerateMipmaps(VkCommandBuffer commandBuffer, uint32_t mipLevels)
+{
 	VkImageMemoryBarrier barrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
 	barrier.image = m_image;
 	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
@@ -273,7 +324,7 @@ void VmaImage::GenerateMipmaps(uint32_t mipLevels)
 		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
 		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
 
-		vkCmdPipelineBarrier(command.GetVkCommandBuffer(),
+		vkCmdPipelineBarrier(commandBuffer,
 			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
 			0, nullptr,				// memory barriers
 			0, nullptr,	// buffer memory barrier
@@ -293,7 +344,7 @@ void VmaImage::GenerateMipmaps(uint32_t mipLevels)
 		blit.dstSubresource.baseArrayLayer = 0;
 		blit.dstSubresource.layerCount = 1;
 
-		vkCmdBlitImage(command.GetVkCommandBuffer(),
+		vkCmdBlitImage(commandBuffer,
 			m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
 			m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 			1, &blit,
@@ -304,7 +355,7 @@ void VmaImage::GenerateMipmaps(uint32_t mipLevels)
 		barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
 		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
-		vkCmdPipelineBarrier(command.GetVkCommandBuffer(),
+		vkCmdPipelineBarrier(commandBuffer,
 			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
 			0, nullptr,
 			0, nullptr,
@@ -321,14 +372,12 @@ void VmaImage::GenerateMipmaps(uint32_t mipLevels)
 	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
 	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
-	vkCmdPipelineBarrier(command.GetVkCommandBuffer(),
+	vkCmdPipelineBarrier(commandBuffer,
 		VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
 		0, nullptr,
 		0, nullptr,
 		1, &barrier);
 
-	VulkanCommand::EndSingleTimeCommand(m_pContext, command, m_pContext->pLogicalDevice->GetGraphicsQueue());
-
 	m_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 }
 
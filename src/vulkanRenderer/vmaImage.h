@@ -41,11 +41,16 @@ public: // Methods:
 	const VkExtent3D& GetExtent() const;
 	VkImageSubresourceLayers GetSubresourceLayers() const;
 
+	// Setters:
+	void SetLayout(VkImageLayout layout);
+
 	// Transitions etc.:
 	void TransitionLayoutUndefinedToTransfer();
 	void HandoffTransferToGraphicsQueue();
 	void TransitionLayoutTransferToShaderRead();
+	void TransitionLayoutUndefinedToShaderRead();
 	void GenerateMipmaps(uint32_t mipLevels);
+	void GenerateMipmaps(VkCommandBuffer commandBuffer, uint32_t mipLevels);
 
 	// Static methods:
 	static void CopyImageToImage(VulkanContext* context, VmaImage* srcImage, VmaImage* dstImage, const VulkanQueue& queue);
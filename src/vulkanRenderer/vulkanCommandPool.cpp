@@ -0,0 +1,59 @@
+#include "vulkanCommandPool.h"
+#include "vulkanContext.h"
+#include "vulkanMacros.h"
+
+
+
+// Constructor/Destructor:
+VulkanCommandPool::VulkanCommandPool(VulkanContext* pContext, VulkanQueue queue)
+{
+	m_pContext = pContext;
+	m_usedCount = 0;
+
+	VkCommandPoolCreateInfo createInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+	createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;	// buffers are rerecorded every frame.
+	createInfo.queueFamilyIndex = queue.familyIndex;
+	VKA(vkCreateCommandPool(m_pContext->GetVkDevice(), &createInfo, nullptr, &m_pool));
+}
+VulkanCommandPool::~VulkanCommandPool()
+{
+	// Destroying the pool frees all its command buffers:
+	vkDestroyCommandPool(m_pContext->GetVkDevice(), m_pool, nullptr);
+}
+
+
+
+// Public methods:
+/// <summary>
+/// Resets all command buffers of the pool to the initial state. Only call once the gpu is done with them.
+/// </summary>
+void VulkanCommandPool::Reset()
+{
+	VKA(vkResetCommandPool(m_pContext->GetVkDevice(), m_pool, 0));
+	m_usedCount = 0;
+}
+/// <summary>
+/// Next unused secondary command buffer of this pool, allocates a new one if all are in use.
+/// </summary>
+VkCommandBuffer VulkanCommandPool::GetSecondaryCommandBuffer()
+{
+	if (m_usedCount == m_secondaryBuffers.size())
+	{
+		VkCommandBufferAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+		allocateInfo.commandPool = m_pool;
+		allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;	// executed from a primary command buffer via vkCmdExecuteCommands.
+		allocateInfo.commandBufferCount = 1;
+		VkCommandBuffer buffer;
+		VKA(vkAllocateCommandBuffers(m_pContext->GetVkDevice(), &allocateInfo, &buffer));
+		m_secondaryBuffers.push_back(buffer);
+	}
+	return m_secondaryBuffers[m_usedCount++];
+}
+
+
+
+// Getters:
+const VkCommandPool& VulkanCommandPool::GetVkCommandPool() const
+{
+	return m_pool;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef __INCLUDE_GUARD_vulkanCommandPool_h__
+#define __INCLUDE_GUARD_vulkanCommandPool_h__
+#include <vulkan/vulkan.h>
+#include <vector>
+
+
+
+struct VulkanContext;
+struct VulkanQueue;
+
+
+
+/// <summary>
+/// Command pool for one recording thread and one frame in flight.
+/// Hands out secondary command buffers, which are recycled all at once by Reset().
+/// Must only be used by one thread at a time (vulkan command pools are externally synchronized).
+/// </summary>
+class VulkanCommandPool
+{
+private: // Members:
+	VkCommandPool m_pool;
+	std::vector<VkCommandBuffer> m_secondaryBuffers;
+	uint32_t m_usedCount;
+	VulkanContext* m_pContext;
+
+public: // Methods:
+	VulkanCommandPool(VulkanContext* pContext, VulkanQueue queue);
+	~VulkanCommandPool();
+
+	void Reset();
+	VkCommandBuffer GetSecondaryCommandBuffer();
+
+	// Getters:
+	const VkCommandPool& GetVkCommandPool() const;
+
+private: // Methods:
+	// Delete copy semantics:
+	VulkanCommandPool(const VulkanCommandPool&) = delete;
+	VulkanCommandPool& operator=(const VulkanCommandPool&) = delete;
+};
+
+
+
+#endif // __INCLUDE_GUARD_vulkanCommandPool_h__
\ No newline at end of file
@@ -4,13 +4,15 @@
 
 
 // Constructor:
-VulkanContext::VulkanContext(uint32_t framesInFlight, VkSampleCountFlagBits msaaSamples)
+VulkanContext::VulkanContext(uint32_t framesInFlight, VkSampleCountFlagBits msaaSamples, bool headless, VkExtent2D headlessExtent)
 {
 	this->framesInFlight = framesInFlight;
 	this->frameIndex = 0;
+	m_headless = headless;
 
 	// Window:
-	pWindow = std::make_unique<SdlWindow>();
+	if (!m_headless)
+		pWindow = std::make_unique<SdlWindow>();
 
 	// Get instance extensions:
 	std::vector<const char*> instanceExtensions;
@@ -18,23 +20,30 @@ VulkanContext::VulkanContext(uint32_t framesInFlight, VkSampleCountFlagBits msaa
 	instanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 	instanceExtensions.push_back(VK_EXT_VALIDATION_FEATURES_EXTENSION_NAME);
 	#endif
-	pWindow->AddSdlInstanceExtensions(instanceExtensions);	// sdl instance extensions
+	if (!m_headless)
+		pWindow->AddSdlInstanceExtensions(instanceExtensions);	// sdl instance extensions
 	// and more ...
 
 	// Get device extensions:
 	std::vector<const char*> deviceExtensions;
-	deviceExtensions.emplace_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+	if (!m_headless)
+		deviceExtensions.emplace_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 	deviceExtensions.emplace_back(VK_EXT_SHADER_VIEWPORT_INDEX_LAYER_EXTENSION_NAME);
 	// and more ...
 
 	// Create vulkan context:
 	pInstance = std::make_unique<VulkanInstance>(instanceExtensions);
-	pPhysicalDevice = std::make_unique<VulkanPhysicalDevice>(pInstance.get());
-	pSurface = std::make_unique<VulkanSurface>(pInstance.get(), pPhysicalDevice.get(), pWindow.get());
+	pPhysicalDevice = std::make_unique<VulkanPhysicalDevice>(pInstance.get(), m_headless);
+	if (!m_headless)
+		pSurface = std::make_unique<VulkanSurface>(pInstance.get(), pPhysicalDevice.get(), pWindow.get());
 	pLogicalDevice = std::make_unique<VulkanLogicalDevice>(pPhysicalDevice.get(), pSurface.get(), deviceExtensions);
 	pAllocator = std::make_unique<VulkanMemoryAllocator>(pInstance.get(), pLogicalDevice.get(), pPhysicalDevice.get());
 	pDescriptorPool = std::make_unique<VulkanDescriptorPool>(pLogicalDevice.get());
-	pSwapchain = std::make_unique<VulkanSwapchain>(pLogicalDevice.get(), pSurface.get(), VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+	pPipelineCache = std::make_unique<VulkanPipelineCache>(pLogicalDevice.get(), pPhysicalDevice.get(), "../pipelineCache");
+	if (!m_headless)
+		pSwapchain = std::make_unique<VulkanSwapchain>(pLogicalDevice.get(), pSurface.get(), VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+	else
+		pOffscreenTargets = std::make_unique<VulkanOffscreenTargets>(this, framesInFlight, headlessExtent, VK_FORMAT_R8G8B8A8_SRGB);
 
 	this->msaaSamples = std::min(msaaSamples, pPhysicalDevice->GetMaxMsaaSamples());
 }
@@ -78,6 +87,10 @@ const VkDescriptorPool& VulkanContext::GetVkDescriptorPool() const
 {
 	return pDescriptorPool->GetVkDescriptorPool();
 }
+const VkPipelineCache& VulkanContext::GetVkPipelineCache() const
+{
+	return pPipelineCache->GetVkPipelineCache();
+}
 const VkSwapchainKHR& VulkanContext::GetVkSwapchainKHR() const
 {
 	return pSwapchain->GetVkSwapchainKHR();
@@ -93,6 +106,26 @@ bool VulkanContext::DepthBiasEnabled() const
 
 
 
+// Render target getters:
+bool VulkanContext::IsHeadless() const
+{
+	return m_headless;
+}
+VkExtent2D VulkanContext::GetRenderExtent() const
+{
+	return m_headless ? pOffscreenTargets->GetExtent() : pSurface->GetCurrentExtent();
+}
+VkFormat VulkanContext::GetRenderFormat() const
+{
+	return m_headless ? pOffscreenTargets->GetFormat() : pSurface->GetVkSurfaceFormatKHR().format;
+}
+const std::vector<VkImageView>& VulkanContext::GetRenderTargetImageViews() const
+{
+	return m_headless ? pOffscreenTargets->GetImageViews() : pSwapchain->GetImageViews();
+}
+
+
+
 // Public frame logic:
 void VulkanContext::UpdateFrameIndex()
 {
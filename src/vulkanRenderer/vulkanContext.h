@@ -7,7 +7,9 @@
 #include "vulkanInstance.h"
 #include "vulkanLogicalDevice.h"
 #include "vulkanMemoryAllocator.h"
+#include "vulkanOffscreenTargets.h"
 #include "vulkanPhysicalDevice.h"
+#include "vulkanPipelineCache.h"
 #include "vulkanSurface.h"
 #include "vulkanSwapchain.h"
 #include <vulkan/vulkan.h>
@@ -26,7 +28,9 @@
 /// - VulkanLogicalDevice:		VkDevice and queues (graphics, present, compute, transfer). <para/>
 /// - VulkanMemoryAllocator:	VmaAllocator for flexible memory allocation pools. <para/>
 /// - VulkanDescriptorPool:		VkDescriptorPool settings. <para/>
+/// - VulkanPipelineCache:		VkPipelineCache shared by all pipelines, persisted to disk. <para/>
 /// - VulkanSwapchain:			VkSwapchainKHR, spwapchain images, image views, and recreation. <para/>
+/// - VulkanOffscreenTargets:	replaces window, surface and swapchain in headless mode. <para/>
 /// - framesInFlight:			Number of frames in flight for synchronization. <para/>
 /// - frameIndex:				Current frame index for synchronization. <para/>
 /// - msaaSamples:				Msaa level, clamped to the maximum supported by the physical device. <para/>
@@ -41,13 +45,18 @@ public: // Members:
 	std::unique_ptr<VulkanLogicalDevice> pLogicalDevice;
 	std::unique_ptr<VulkanMemoryAllocator> pAllocator;
 	std::unique_ptr<VulkanDescriptorPool> pDescriptorPool;
+	std::unique_ptr<VulkanPipelineCache> pPipelineCache;
 	std::unique_ptr<VulkanSwapchain> pSwapchain;
+	std::unique_ptr<VulkanOffscreenTargets> pOffscreenTargets;
 	uint32_t framesInFlight;
 	uint32_t frameIndex;
 	VkSampleCountFlagBits msaaSamples;
 
+private: // Members:
+	bool m_headless;
+
 public: // Methods:
-	VulkanContext(uint32_t framesInFlight, VkSampleCountFlagBits msaaSamples);
+	VulkanContext(uint32_t framesInFlight, VkSampleCountFlagBits msaaSamples, bool headless = false, VkExtent2D headlessExtent = { 1280, 720 });
 	~VulkanContext();
 
 	// Getters:
@@ -58,10 +67,17 @@ public: // Methods:
 	const VkDevice& GetVkDevice() const;
 	const VmaAllocator& GetVmaAllocator() const;
 	const VkDescriptorPool& GetVkDescriptorPool() const;
+	const VkPipelineCache& GetVkPipelineCache() const;
 	const VkSwapchainKHR& GetVkSwapchainKHR() const;
 	bool DepthClampEnabled() const;
 	bool DepthBiasEnabled() const;
 
+	// Render target getters, valid with and without window:
+	bool IsHeadless() const;
+	VkExtent2D GetRenderExtent() const;
+	VkFormat GetRenderFormat() const;
+	const std::vector<VkImageView>& GetRenderTargetImageViews() const;
+
 	// Frame logic:
 	void UpdateFrameIndex();
 	void ResetFrameIndex();
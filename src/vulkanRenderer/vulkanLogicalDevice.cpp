@@ -14,10 +14,13 @@ VulkanLogicalDevice::VulkanLogicalDevice(VulkanPhysicalDevice* pPhysicalDevice,
 	VkPhysicalDeviceFeatures enabledFearutes = {};
 	enabledFearutes.samplerAnisotropy = VK_TRUE;
 	enabledFearutes.depthClamp = pPhysicalDevice->SupportsDepthClamp();
+	enabledFearutes.shaderClipDistance = VK_TRUE;	// required by device selection, point light shadows clip cube faces to their atlas tiles
+	enabledFearutes.pipelineStatisticsQuery = pPhysicalDevice->SupportsPipelineStatistics();
+	enabledFearutes.inheritedQueries = pPhysicalDevice->SupportsPipelineStatistics();
 
 	// Find queue family indices:
 	m_graphicsQueue.familyIndex = FindGraphicsAndComputeQueueFamilyIndex(pPhysicalDevice->GetVkPhysicalDevice());
-	m_presentQueue.familyIndex = FindPresentQueueFamilyIndex(pPhysicalDevice->GetVkPhysicalDevice(), pSurface->GetVkSurfaceKHR());
+	m_presentQueue.familyIndex = (pSurface != nullptr) ? FindPresentQueueFamilyIndex(pPhysicalDevice->GetVkPhysicalDevice(), pSurface->GetVkSurfaceKHR()) : -1; // no surface in headless mode
 	m_computeQueue.familyIndex = FindPureComputeQueueFamilyIndex(pPhysicalDevice->GetVkPhysicalDevice());
 	m_transferQueue.familyIndex = FindPureTransferQueueFamilyIndex(pPhysicalDevice->GetVkPhysicalDevice());
 
@@ -0,0 +1,178 @@
+#include "vulkanOffscreenTargets.h"
+#include "logger.h"
+#include "vmaBuffer.h"
+#include "vmaImage.h"
+#include "vulkanCommand.h"
+#include "vulkanContext.h"
+#include "vulkanLogicalDevice.h"
+#include "vulkanMacros.h"
+#include <cstring>
+#include <fstream>
+
+
+
+// Constructor/Destructor:
+VulkanOffscreenTargets::VulkanOffscreenTargets(VulkanContext* pContext, uint32_t count, VkExtent2D extent, VkFormat format)
+{
+	m_pContext = pContext;
+	m_extent = extent;
+	m_format = format;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		VkImageSubresourceRange* pSubresourceRange = new VkImageSubresourceRange();
+		pSubresourceRange->aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		pSubresourceRange->baseMipLevel = 0;
+		pSubresourceRange->levelCount = 1;
+		pSubresourceRange->baseArrayLayer = 0;
+		pSubresourceRange->layerCount = 1;
+
+		VkImageCreateInfo* pImageInfo = new VkImageCreateInfo();
+		pImageInfo->sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		pImageInfo->imageType = VK_IMAGE_TYPE_2D;
+		pImageInfo->extent.width = m_extent.width;
+		pImageInfo->extent.height = m_extent.height;
+		pImageInfo->extent.depth = 1;
+		pImageInfo->mipLevels = 1;
+		pImageInfo->arrayLayers = 1;
+		pImageInfo->format = m_format;
+		pImageInfo->tiling = VK_IMAGE_TILING_OPTIMAL;
+		pImageInfo->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		pImageInfo->usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		pImageInfo->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		pImageInfo->samples = VK_SAMPLE_COUNT_1_BIT;
+		pImageInfo->flags = 0;
+
+		VmaAllocationCreateInfo* pAllocationInfo = new VmaAllocationCreateInfo();
+		pAllocationInfo->usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+		pAllocationInfo->flags = 0;
+		pAllocationInfo->requiredFlags = 0;
+		pAllocationInfo->preferredFlags = 0;
+
+		m_targets.push_back(std::make_unique<VmaImage>(m_pContext, pImageInfo, pAllocationInfo, pSubresourceRange));
+		m_images.push_back(m_targets.back()->GetVkImage());
+		m_imageViews.push_back(m_targets.back()->GetVkImageView());
+	}
+}
+VulkanOffscreenTargets::~VulkanOffscreenTargets()
+{
+
+}
+
+
+
+// Public methods:
+// Getters:
+const std::vector<VkImage>& VulkanOffscreenTargets::GetImages() const
+{
+	return m_images;
+}
+const std::vector<VkImageView>& VulkanOffscreenTargets::GetImageViews() const
+{
+	return m_imageViews;
+}
+VkExtent2D VulkanOffscreenTargets::GetExtent() const
+{
+	return m_extent;
+}
+VkFormat VulkanOffscreenTargets::GetFormat() const
+{
+	return m_format;
+}
+
+// Readback:
+/// <summary>
+/// Copies the image into host memory, tightly packed with 4 bytes per pixel in the channel order of the target format.
+/// Waits for the device to be idle, so the last frame rendered into the image is complete. Not meant for per frame use.
+/// </summary>
+std::vector<uint8_t> VulkanOffscreenTargets::Readback(uint32_t imageIndex) const
+{
+	if (imageIndex >= m_targets.size())
+	{
+		LOG_WARN("VulkanOffscreenTargets::Readback() imageIndex {} out of range, only {} targets exist.", imageIndex, m_targets.size());
+		return {};
+	}
+	m_pContext->WaitDeviceIdle();
+
+	uint64_t size = 4ull * m_extent.width * m_extent.height;
+	VkBufferCreateInfo* pBufferInfo = new VkBufferCreateInfo();
+	pBufferInfo->sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	pBufferInfo->size = size;
+	pBufferInfo->usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+	pBufferInfo->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	VmaAllocationCreateInfo* pAllocInfo = new VmaAllocationCreateInfo();
+	pAllocInfo->usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+	pAllocInfo->flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+	pAllocInfo->requiredFlags = 0;
+	pAllocInfo->preferredFlags = 0;
+	VmaBuffer stagingBuffer(m_pContext, pBufferInfo, pAllocInfo);
+
+	// The shading render pass leaves the targets in transfer src layout:
+	const VulkanQueue& queue = m_pContext->pLogicalDevice->GetGraphicsQueue();
+	VulkanCommand command = VulkanCommand::BeginSingleTimeCommand(m_pContext, queue);
+	{
+		// Make the color attachment writes of earlier submissions visible to the copy:
+		VkImageMemoryBarrier barrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+		barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = m_images[imageIndex];
+		barrier.subresourceRange = *m_targets[imageIndex]->GetSubresourceRange();
+		vkCmdPipelineBarrier(command.GetVkCommandBuffer(), VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+		VkBufferImageCopy region = {};
+		region.bufferOffset = 0;
+		region.bufferRowLength = 0;		// tightly packed
+		region.bufferImageHeight = 0;	// tightly packed
+		region.imageSubresource = m_targets[imageIndex]->GetSubresourceLayers();
+		region.imageOffset = { 0, 0, 0 };
+		region.imageExtent = { m_extent.width, m_extent.height, 1 };
+		vkCmdCopyImageToBuffer(command.GetVkCommandBuffer(), m_images[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, stagingBuffer.GetVkBuffer(), 1, &region);
+	}
+	VulkanCommand::EndSingleTimeCommand(m_pContext, command, queue);
+
+	VmaAllocationInfo info;
+	vmaGetAllocationInfo(m_pContext->GetVmaAllocator(), stagingBuffer.GetVmaAllocation(), &info);
+	VKA(vmaInvalidateAllocation(m_pContext->GetVmaAllocator(), stagingBuffer.GetVmaAllocation(), 0, VK_WHOLE_SIZE));
+	std::vector<uint8_t> pixels(size);
+	memcpy(pixels.data(), info.pMappedData, size);
+	return pixels;
+}
+/// <summary>
+/// Writes the image as binary .ppm (P6), which needs no image library and is understood by most image viewers and diff tools.
+/// </summary>
+bool VulkanOffscreenTargets::SaveAsPpm(uint32_t imageIndex, const std::filesystem::path& filePath) const
+{
+	std::vector<uint8_t> pixels = Readback(imageIndex);
+	if (pixels.empty())
+		return false;
+
+	std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		LOG_WARN("Could not open file for writing: {}", filePath.string());
+		return false;
+	}
+
+	// Bgra formats need their red and blue channels swapped:
+	bool isBgra = m_format == VK_FORMAT_B8G8R8A8_SRGB || m_format == VK_FORMAT_B8G8R8A8_UNORM;
+	file << "P6\n" << m_extent.width << " " << m_extent.height << "\n255\n";
+	std::vector<uint8_t> row(3 * m_extent.width);
+	for (uint32_t y = 0; y < m_extent.height; y++)
+	{
+		const uint8_t* pPixel = &pixels[4ull * y * m_extent.width];
+		for (uint32_t x = 0; x < m_extent.width; x++, pPixel += 4)
+		{
+			row[3 * x + 0] = isBgra ? pPixel[2] : pPixel[0];
+			row[3 * x + 1] = pPixel[1];
+			row[3 * x + 2] = isBgra ? pPixel[0] : pPixel[2];
+		}
+		file.write(reinterpret_cast<const char*>(row.data()), row.size());
+	}
+	LOG_INFO("Saved image {} to: {}", imageIndex, filePath.string());
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef __INCLUDE_GUARD_vulkanOffscreenTargets_h__
+#define __INCLUDE_GUARD_vulkanOffscreenTargets_h__
+#include <vulkan/vulkan.h>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+
+
+class VmaImage;
+struct VulkanContext;
+
+
+
+/// <summary>
+/// Swapchain replacement for headless mode: one offscreen color image per frame in flight.
+/// The shading render pass resolves into these images and leaves them in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+/// so their content can be read back to the host for regression tests.
+/// </summary>
+class VulkanOffscreenTargets
+{
+private: // Members:
+	std::vector<std::unique_ptr<VmaImage>> m_targets;
+	std::vector<VkImage> m_images;
+	std::vector<VkImageView> m_imageViews;
+	VkExtent2D m_extent;
+	VkFormat m_format;
+	VulkanContext* m_pContext;
+
+public: // Methods:
+	VulkanOffscreenTargets(VulkanContext* pContext, uint32_t count, VkExtent2D extent, VkFormat format);
+	~VulkanOffscreenTargets();
+
+	// Getters:
+	const std::vector<VkImage>& GetImages() const;
+	const std::vector<VkImageView>& GetImageViews() const;
+	VkExtent2D GetExtent() const;
+	VkFormat GetFormat() const;
+
+	// Readback:
+	std::vector<uint8_t> Readback(uint32_t imageIndex) const;
+	bool SaveAsPpm(uint32_t imageIndex, const std::filesystem::path& filePath) const;
+};
+
+
+
+#endif // __INCLUDE_GUARD_vulkanOffscreenTargets_h__
\ No newline at end of file
@@ -5,8 +5,9 @@
 
 
 // Constructor/Destructor:
-VulkanPhysicalDevice::VulkanPhysicalDevice(VulkanInstance* pInstance)
+VulkanPhysicalDevice::VulkanPhysicalDevice(VulkanInstance* pInstance, bool acceptAnyDeviceType)
 {
+	m_acceptAnyDeviceType = acceptAnyDeviceType;
 	uint32_t numPhysicalDevices = 0;
 	VKA(vkEnumeratePhysicalDevices(pInstance->GetVkInstance(), &numPhysicalDevices, nullptr));
 	if (numPhysicalDevices == 0)
@@ -31,6 +32,7 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(VulkanInstance* pInstance)
 	if (devices[0].second < 0)
 		throw std::runtime_error("Failed to find a suitable GPU!");
 	m_physicalDevice = devices[0].first;
+	DeviceScore(m_physicalDevice);	// DeviceScore() sets the feature support flags, the last scored device is not necessarily the picked one
 
 	// Determine max msaa samples:
 	m_maxMsaaSamples = MaxUsableMsaaSampleCount();
@@ -63,6 +65,10 @@ VkBool32 VulkanPhysicalDevice::SupportsMultiViewport() const
 {
 	return m_supportsMultiViewport;
 }
+VkBool32 VulkanPhysicalDevice::SupportsPipelineStatistics() const
+{
+	return m_supportsPipelineStatistics;
+}
 
 
 
@@ -75,7 +81,8 @@ int VulkanPhysicalDevice::DeviceScore(VkPhysicalDevice dev)
 	vkGetPhysicalDeviceFeatures(dev, &deviceFeatures);
 
 	// Check essential features:
-	VkBool32 essentials = (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU);
+	// Headless mode also accepts integrated and cpu devices (e.g. lavapipe on ci machines):
+	VkBool32 essentials = m_acceptAnyDeviceType || (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU);
 	essentials &= HasGraphicsAndComputeQueueFamily(dev);
 	essentials &= deviceFeatures.geometryShader;
 	essentials &= deviceFeatures.tessellationShader;
@@ -92,9 +99,11 @@ int VulkanPhysicalDevice::DeviceScore(VkPhysicalDevice dev)
 
 	// Check optional features:
 	int score = 0;
+	score += 100 * (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU);
 	score += 10 * deviceFeatures.depthClamp; m_supportsDepthClamp = deviceFeatures.depthClamp;
 	score += 10 * deviceFeatures.depthBiasClamp; m_supportsDepthBias = deviceFeatures.depthBiasClamp;
 	score += 10 * deviceFeatures.multiViewport; m_supportsMultiViewport = deviceFeatures.multiViewport;
+	m_supportsPipelineStatistics = deviceFeatures.pipelineStatisticsQuery && deviceFeatures.inheritedQueries;	// gpu profiling only, not scored
 	// score +=  5 * deviceFeatures.fillModeNonSolid;
 	// score +=  1 * deviceFeatures.shaderFloat64;
 	// score +=  1 * deviceFeatures.shaderInt64;
@@ -16,9 +16,11 @@ private: // Members:
 	VkBool32 m_supportsDepthClamp = false;
 	VkBool32 m_supportsDepthBias = false;
 	VkBool32 m_supportsMultiViewport = false;
+	VkBool32 m_supportsPipelineStatistics = false;
+	bool m_acceptAnyDeviceType;
 
 public: // Methods:
-	VulkanPhysicalDevice(VulkanInstance* pInstance);
+	VulkanPhysicalDevice(VulkanInstance* pInstance, bool acceptAnyDeviceType = false);
 	~VulkanPhysicalDevice();
 
 	const VkPhysicalDevice& GetVkPhysicalDevice() const;
@@ -26,6 +28,7 @@ public: // Methods:
 	VkBool32 SupportsDepthClamp() const;
 	VkBool32 SupportsDepthBias() const;
 	VkBool32 SupportsMultiViewport() const;
+	VkBool32 SupportsPipelineStatistics() const;
 
 private: // Methods:
 	int DeviceScore(VkPhysicalDevice device);
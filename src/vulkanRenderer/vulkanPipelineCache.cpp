@@ -0,0 +1,103 @@
+#include "vulkanPipelineCache.h"
+#include "vulkanLogicalDevice.h"
+#include "vulkanMacros.h"
+#include "vulkanPhysicalDevice.h"
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+
+
+// Constructor/Destructor:
+VulkanPipelineCache::VulkanPipelineCache(VulkanLogicalDevice* pLogicalDevice, VulkanPhysicalDevice* pPhysicalDevice, const std::filesystem::path& directoryPath)
+{
+	m_pLogicalDevice = pLogicalDevice;
+	vkGetPhysicalDeviceProperties(pPhysicalDevice->GetVkPhysicalDevice(), &m_properties);
+
+	// File name: pipelineCache_<pipelineCacheUUID>_<driverVersion>.bin
+	std::ostringstream fileName;
+	fileName << "pipelineCache_" << std::hex << std::setfill('0');
+	for (uint32_t i = 0; i < VK_UUID_SIZE; i++)
+		fileName << std::setw(2) << static_cast<uint32_t>(m_properties.pipelineCacheUUID[i]);
+	fileName << "_" << std::dec << m_properties.driverVersion << ".bin";
+	m_filePath = directoryPath / fileName.str();
+
+	// Start cold if there is no valid cache file:
+	std::vector<char> data = Load();
+	VkPipelineCacheCreateInfo createInfo = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+	createInfo.initialDataSize = data.size();
+	createInfo.pInitialData = data.empty() ? nullptr : data.data();
+	VKA(vkCreatePipelineCache(m_pLogicalDevice->GetVkDevice(), &createInfo, nullptr, &m_pipelineCache));
+}
+VulkanPipelineCache::~VulkanPipelineCache()
+{
+	Save();
+	vkDestroyPipelineCache(m_pLogicalDevice->GetVkDevice(), m_pipelineCache, nullptr);
+}
+
+
+
+// Public methods:
+const VkPipelineCache& VulkanPipelineCache::GetVkPipelineCache() const
+{
+	return m_pipelineCache;
+}
+void VulkanPipelineCache::Save() const
+{
+	size_t size = 0;
+	VKA(vkGetPipelineCacheData(m_pLogicalDevice->GetVkDevice(), m_pipelineCache, &size, nullptr));
+	std::vector<char> data(size);
+	VKA(vkGetPipelineCacheData(m_pLogicalDevice->GetVkDevice(), m_pipelineCache, &size, data.data()));
+
+	std::error_code errorCode;
+	std::filesystem::create_directories(m_filePath.parent_path(), errorCode);
+	std::ofstream file(m_filePath, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		LOG_WARN("Pipeline cache could not be saved to: {}", m_filePath.string());
+		return;
+	}
+	file.write(data.data(), size);
+	LOG_TRACE("Pipeline cache saved: {} ({} bytes)", m_filePath.string(), size);
+}
+
+
+
+// Private methods:
+std::vector<char> VulkanPipelineCache::Load() const
+{
+	std::ifstream file(m_filePath, std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+	{
+		LOG_TRACE("No pipeline cache found at: {}, starting cold.", m_filePath.string());
+		return {};
+	}
+
+	size_t fileSize = static_cast<size_t>(file.tellg());
+	file.seekg(0, std::ios::beg);
+	std::vector<char> data(fileSize);
+	file.read(data.data(), fileSize);
+
+	if (!IsCompatible(data))
+	{
+		LOG_WARN("Pipeline cache {} does not match the current device, starting cold.", m_filePath.string());
+		return {};
+	}
+	LOG_TRACE("Pipeline cache loaded: {} ({} bytes)", m_filePath.string(), fileSize);
+	return data;
+}
+bool VulkanPipelineCache::IsCompatible(const std::vector<char>& data) const
+{
+	// Drivers should reject foreign data themselves, but not all of them do so gracefully:
+	if (data.size() < sizeof(VkPipelineCacheHeaderVersionOne))
+		return false;
+
+	VkPipelineCacheHeaderVersionOne header;
+	memcpy(&header, data.data(), sizeof(VkPipelineCacheHeaderVersionOne));
+	return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne)
+		&& header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+		&& header.vendorID == m_properties.vendorID
+		&& header.deviceID == m_properties.deviceID
+		&& memcmp(header.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
\ No newline at end of file
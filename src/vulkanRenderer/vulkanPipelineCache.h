@@ -0,0 +1,41 @@
+#ifndef __INCLUDE_GUARD_vulkanPipelineCache_h__
+#define __INCLUDE_GUARD_vulkanPipelineCache_h__
+#include <vulkan/vulkan.h>
+#include <filesystem>
+#include <vector>
+
+
+
+class VulkanLogicalDevice;
+class VulkanPhysicalDevice;
+
+
+
+/// <summary>
+/// VkPipelineCache shared by all pipelines, persisted to disk between runs.
+/// The cache file name contains the pipelineCacheUUID and driver version of the physical device,
+/// so a driver update or another gpu starts with a cold cache instead of feeding incompatible data to the driver.
+/// The cache is loaded on construction and saved on destruction.
+/// </summary>
+class VulkanPipelineCache
+{
+private: // Members:
+	VkPipelineCache m_pipelineCache;
+	VkPhysicalDeviceProperties m_properties;
+	std::filesystem::path m_filePath;
+	VulkanLogicalDevice* m_pLogicalDevice;
+
+public: // Methods:
+	VulkanPipelineCache(VulkanLogicalDevice* pLogicalDevice, VulkanPhysicalDevice* pPhysicalDevice, const std::filesystem::path& directoryPath);
+	~VulkanPipelineCache();
+	const VkPipelineCache& GetVkPipelineCache() const;
+	void Save() const;
+
+private: // Methods:
+	std::vector<char> Load() const;
+	bool IsCompatible(const std::vector<char>& data) const;
+};
+
+
+
+#endif // __INCLUDE_GUARD_vulkanPipelineCache_h__
\ No newline at end of file
@@ -1,24 +1,41 @@
 #include "vulkanRenderer.h"
+#include "camera.h"
+#include "commandStateTracker.h"
 #include "directionalLight.h"
+#include "frameData.h"
+#include "gameObject.h"
+#include "gpuTimer.h"
 #include "graphics.h"
 #include "macros.h"
+#include "material.h"
 #include "mesh.h"
 #include "meshRenderer.h"
 #include "materialProperties.h"
 #include "pointLight.h"
+#include "pointShadowPushConstant.h"
+#include "profiler.h"
 #include "renderPassManager.h"
 #include "scene.h"
 #include "shadingPushConstant.h"
 #include "shadingRenderPass.h"
 #include "shadowPushConstant.h"
 #include "shadowRenderPass.h"
+#include "shadowUpdatePolicy.h"
 #include "spirvReflect.h"
 #include "spotLight.h"
+#include "storageBuffer.h"
+#include "threadPool.h"
+#include "timer.h"
 #include "transform.h"
+#include "uniformRingBuffer.h"
+#include "uploadManager.h"
 #include "vmaBuffer.h"
 #include "vulkanCommand.h"
+#include "vulkanCommandPool.h"
 #include "vulkanContext.h"
 #include "vulkanMacros.h"
+#include <algorithm>
+#include <chrono>
 
 
 
@@ -26,6 +43,14 @@
 VulkanRenderer::VulkanRenderer(VulkanContext* pContext)
 {
 	m_pContext = pContext;
+	m_visibleCount = 0;
+	m_culledCount = 0;
+	m_pInstanceBuffer = nullptr;
+	m_instanceCapacity = 0;
+	m_recordTime = 0.0f;
+	m_frameNumber = 0;
+	m_timeSlicedShadowBudget = 0;
+	m_timeSliceCursor = 0;
 
 	// Command buffers:
 	m_shadowCommands.reserve(m_pContext->framesInFlight);
@@ -36,6 +61,13 @@ VulkanRenderer::VulkanRenderer(VulkanContext* pContext)
 		m_shadingCommands.emplace_back(m_pContext, m_pContext->pLogicalDevice->GetGraphicsQueue());
 	}
 
+	// Gpu timestamps and pipeline statistics:
+	m_pGpuTimer = std::make_unique<GpuTimer>(m_pContext, ShadowRenderPass::s_shadowMapCount);
+
+	// Recording threads with their own command pools:
+	m_pThreadPool = std::make_unique<ThreadPool>(std::thread::hardware_concurrency());
+	CreateThreadCommandPools();
+
 	// Synchronization objects:
 	CreateFences();
 	CreateSemaphores();
@@ -56,26 +88,59 @@ VulkanRenderer::~VulkanRenderer()
 // Public methods:
 bool VulkanRenderer::RenderFrame(Scene* pScene)
 {
-	// Resize Swapchain if needed:
-	VkExtent2D windowExtent = m_pContext->pWindow->GetExtent();
-	VkExtent2D surfaceExtend = m_pContext->pSurface->GetCurrentExtent();
-	if (m_rebuildSwapchain || windowExtent.width != surfaceExtend.width || windowExtent.height != surfaceExtend.height)
+	EMBER_PROFILE_SCOPE("VulkanRenderer::RenderFrame");
+	// Resize Swapchain if needed (offscreen targets in headless mode have a fixed size):
+	if (!m_pContext->IsHeadless())
 	{
-		m_rebuildSwapchain = false;
-		m_pContext->ResetFrameIndex();
-		RebuildSwapchain();
+		VkExtent2D windowExtent = m_pContext->pWindow->GetExtent();
+		VkExtent2D surfaceExtend = m_pContext->pSurface->GetCurrentExtent();
+		if (m_rebuildSwapchain || windowExtent.width != surfaceExtend.width || windowExtent.height != surfaceExtend.height)
+		{
+			m_rebuildSwapchain = false;
+			m_pContext->ResetFrameIndex();
+			RebuildSwapchain();
+		}
 	}
 
 	// Wait for fence of previous frame with same frameIndex to finish:
-	VKA(vkWaitForFences(m_pContext->GetVkDevice(), 1, &m_fences[m_pContext->frameIndex], VK_TRUE, UINT64_MAX));
+	{
+		EMBER_PROFILE_SCOPE("VulkanRenderer::WaitForFence");
+		VKA(vkWaitForFences(m_pContext->GetVkDevice(), 1, &m_fences[m_pContext->frameIndex], VK_TRUE, UINT64_MAX));
+	}
+	m_pGpuTimer->ReadResults();	// queries of this frameIndex are complete (fence)
 	if (!AcquireImage() || pScene->GetActiveCamera() == nullptr)
 		return 0;
 	VKA(vkResetFences(m_pContext->GetVkDevice(), 1, &m_fences[m_pContext->frameIndex]));
 
 	SetMeshRendererGroups(pScene);
+	CullMeshRenderers(pScene);
+	BuildInstanceBatches();
+	CollectShadowViews(pScene);
+	UniformRingBuffer::Reset();	// previous use of this frameIndex has finished (fence)
+
+	// Secondary command buffers of this frameIndex are no longer in use (fence):
+	std::chrono::steady_clock::time_point recordStart = std::chrono::steady_clock::now();
+	m_stats = RenderStats();
+	for (std::unique_ptr<VulkanCommandPool>& pool : m_threadCommandPools[m_pContext->frameIndex])
+		pool->Reset();
 	RecordShadowCommandBuffer(pScene);
+	FrameData::Update(pScene);	// needs the shadow atlas tiles and the matrices they were rendered with
 	RecordShadingCommandBuffer(pScene);
+	m_recordTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - recordStart).count();
+
+	// Frame wide stats, the command buffer counters have been summed up while recording:
+	m_stats.frameNumber = m_frameNumber;
+	m_stats.uniformBytes = UniformRingBuffer::GetAllocatedBytes();
+	m_stats.activeRenderers = m_visibleCount;
+	m_stats.culledRenderers = m_culledCount;
+	m_stats.immediateDraws = Graphics::GetDrawCallCount();
+	m_stats.recordTime = m_recordTime;
+	m_stats.deltaTime = Timer::GetDeltaTime();
+	m_statsHistory[m_frameNumber % m_statsHistory.size()] = m_stats;
+	m_frameNumber++;
+
 	Graphics::ResetDrawCalls();
+	UploadManager::Flush();	// mesh and texture uploads of this frame are acquired by the graphics queue before the frame
 	SubmitCommandBuffers();
 	if (!PresentImage())
 		return 0;
@@ -86,6 +151,93 @@ const VulkanContext* const VulkanRenderer::GetContext() const
 {
 	return m_pContext;
 }
+uint32_t VulkanRenderer::GetVisibleCount() const
+{
+	return m_visibleCount;
+}
+uint32_t VulkanRenderer::GetCulledCount() const
+{
+	return m_culledCount;
+}
+/// <summary>
+/// Number of shadow casters rendered into each shadow map of the last frame, 0 for reused shadow maps,
+/// in shadow map order: directional lights, spot lights, six cube faces per point light.
+/// </summary>
+const std::vector<uint32_t>& VulkanRenderer::GetShadowCasterCounts() const
+{
+	return m_shadowCasterCounts;
+}
+/// <summary>
+/// Shadow maps of lights with time sliced shadows are checked for changes round robin, viewCount per frame.
+/// They keep using their outdated content and light matrix in between. 0 checks all of them every frame.
+/// </summary>
+void VulkanRenderer::SetTimeSlicedShadowBudget(uint32_t viewCount)
+{
+	m_timeSlicedShadowBudget = viewCount;
+}
+uint32_t VulkanRenderer::GetTimeSlicedShadowBudget() const
+{
+	return m_timeSlicedShadowBudget;
+}
+/// <summary>
+/// Number of threads recording secondary command buffers, including the main thread.
+/// Draws are split into slices of at least s_minDrawsPerSlice, so small scenes use fewer threads.
+/// </summary>
+void VulkanRenderer::SetThreadCount(uint32_t threadCount)
+{
+	// Command pools of frames in flight may still be in use:
+	m_pContext->WaitDeviceIdle();
+	m_pThreadPool = std::make_unique<ThreadPool>(threadCount);
+	CreateThreadCommandPools();
+}
+uint32_t VulkanRenderer::GetThreadCount() const
+{
+	return m_pThreadPool->GetThreadCount();
+}
+/// <summary>
+/// Cpu time in seconds spent on recording the shadow and shading command buffers of the last frame.
+/// </summary>
+float VulkanRenderer::GetRecordTime() const
+{
+	return m_recordTime;
+}
+/// <summary>
+/// Number of pipeline, descriptor set, vertex/index buffer and push constant commands recorded in the last frame.
+/// </summary>
+uint32_t VulkanRenderer::GetIssuedCommandCount() const
+{
+	return GetStats().GetIssuedCommands();
+}
+/// <summary>
+/// Number of such commands skipped in the last frame, because they would not have changed the bound state.
+/// </summary>
+uint32_t VulkanRenderer::GetElidedCommandCount() const
+{
+	return GetStats().elidedCommands;
+}
+uint32_t VulkanRenderer::GetImageIndex() const
+{
+	return m_imageIndex;
+}
+const GpuTimer* VulkanRenderer::GetGpuTimer() const
+{
+	return m_pGpuTimer.get();
+}
+/// <summary>
+/// Stats of the last recorded frame (framesAgo = 0) or of the frames before it, up to GetStatsHistoryCount() - 1 frames back.
+/// Frames outside of the history return empty stats.
+/// </summary>
+const RenderStats& VulkanRenderer::GetStats(uint32_t framesAgo) const
+{
+	static const RenderStats emptyStats;
+	if (framesAgo >= GetStatsHistoryCount())
+		return emptyStats;
+	return m_statsHistory[(m_frameNumber - 1 - framesAgo) % m_statsHistory.size()];
+}
+uint32_t VulkanRenderer::GetStatsHistoryCount() const
+{
+	return static_cast<uint32_t>(std::min<uint64_t>(m_frameNumber, m_statsHistory.size()));
+}
 
 
 
@@ -110,6 +262,13 @@ void VulkanRenderer::RebuildSwapchain()
 }
 bool VulkanRenderer::AcquireImage()
 {
+	// One offscreen target per frameIndex, its reuse is guarded by the frame fence:
+	if (m_pContext->IsHeadless())
+	{
+		m_imageIndex = m_pContext->frameIndex;
+		return true;
+	}
+
 	// Signal acquireSemaphore when done:
 	VkResult result = vkAcquireNextImageKHR(m_pContext->GetVkDevice(), m_pContext->GetVkSwapchainKHR(), UINT64_MAX, m_acquireSemaphores[m_pContext->frameIndex], VK_NULL_HANDLE, &m_imageIndex);
 
@@ -130,11 +289,430 @@ bool VulkanRenderer::AcquireImage()
 void VulkanRenderer::SetMeshRendererGroups(Scene* pScene)
 {
 	m_pMeshRendererGroups[0] = pScene->GetSortedMeshRenderers();
-	m_pMeshRendererGroups[1] = Graphics::GetSortedMeshRenderers();
+	m_pMeshRendererGroups[1] = Graphics::GetMeshRenderers();
+}
+void VulkanRenderer::CullMeshRenderers(Scene* pScene)
+{
+	EMBER_PROFILE_SCOPE("VulkanRenderer::CullMeshRenderers");
+	Camera* pCamera = pScene->GetActiveCamera();
+	Frustum frustum(pCamera->GetProjectionMatrix() * pCamera->GetViewMatrix());
+	m_visibleCount = 0;
+	m_culledCount = 0;
+
+	for (uint32_t groupIndex = 0; groupIndex < m_pMeshRendererGroups.size(); groupIndex++)
+	{
+		std::vector<MeshRenderer*>& group = *m_pMeshRendererGroups[groupIndex];
+		std::vector<uint8_t>& visibility = m_visibilities[groupIndex];
+		std::vector<Bounds>& worldBounds = m_worldBounds[groupIndex];
+		std::vector<Float4x4>& localToWorldMatrices = m_localToWorldMatrices[groupIndex];
+		worldBounds.resize(group.size());
+		localToWorldMatrices.resize(group.size());
+		visibility.resize(group.size());
+
+		// World space bounds of all active renderers, tested against the camera frustum in one batch:
+		for (uint32_t i = 0; i < group.size(); i++)
+		{
+			MeshRenderer* meshRenderer = group[i];
+			if (!meshRenderer->IsActive())
+			{
+				worldBounds[i] = Bounds();
+				continue;
+			}
+
+			// Cache matrices and upload pending mesh changes here, recording threads only read them:
+			Mesh* pMesh = meshRenderer->GetMesh();
+			pMesh->GetVertexBuffer(m_pContext);
+			pMesh->GetIndexBuffer(m_pContext);
+			localToWorldMatrices[i] = meshRenderer->GetTransform()->GetLocalToWorldMatrix();
+			if (meshRenderer->GetMaterial()->GetType() != Material::Type::skybox)
+				worldBounds[i] = pMesh->GetBounds().Transform(localToWorldMatrices[i]);
+			else
+				worldBounds[i] = Bounds();
+		}
+		frustum.Intersects(worldBounds, visibility);
+
+		for (uint32_t i = 0; i < group.size(); i++)
+		{
+			MeshRenderer* meshRenderer = group[i];
+			if (!meshRenderer->IsActive())
+			{
+				visibility[i] = 0;
+				continue;
+			}
+
+			// Skybox is drawn around the camera independent of its transform:
+			if (meshRenderer->GetMaterial()->GetType() == Material::Type::skybox)
+				visibility[i] = 1;
+
+			if (visibility[i])
+				m_visibleCount++;
+			else
+				m_culledCount++;
+		}
+	}
+}
+void VulkanRenderer::BuildInstanceBatches()
+{
+	EMBER_PROFILE_SCOPE("VulkanRenderer::BuildInstanceBatches");
+	static std::string blockName = "SurfaceProperties";
+	static std::string memberName = "diffuseColor";
+	m_instanceBatches.clear();
+	m_instanceBatchMap.clear();
+
+	// Assign every visible instanced renderer to the batch of its mesh, material and shadow receiving.
+	// Renderers that are not instanced but whose material reads instanceData get a batch of their own (one entry instance slice):
+	uint32_t instanceCount = 0;
+	for (uint32_t groupIndex = 0; groupIndex < m_pMeshRendererGroups.size(); groupIndex++)
+	{
+		std::vector<MeshRenderer*>& group = *m_pMeshRendererGroups[groupIndex];
+		std::vector<uint32_t>& batchIndices = m_instanceBatchIndices[groupIndex];
+		batchIndices.assign(group.size(), UINT32_MAX);
+
+		for (uint32_t i = 0; i < group.size(); i++)
+		{
+			MeshRenderer* meshRenderer = group[i];
+			if (!m_visibilities[groupIndex][i] || !meshRenderer->GetUsesInstanceData())
+				continue;
+
+			uint32_t batchIndex = static_cast<uint32_t>(m_instanceBatches.size());
+			if (meshRenderer->GetInstanced())
+			{
+				std::tuple<Mesh*, Material*, bool> key(meshRenderer->GetMesh(), meshRenderer->GetMaterial(), meshRenderer->GetReceiveShadows());
+				batchIndex = m_instanceBatchMap.emplace(key, batchIndex).first->second;
+			}
+			if (batchIndex == m_instanceBatches.size())
+				m_instanceBatches.push_back(InstanceBatch{ meshRenderer, 0, 0 });
+			m_instanceBatches[batchIndex].instanceCount++;
+			batchIndices[i] = batchIndex;
+			instanceCount++;
+		}
+	}
+	if (instanceCount == 0)
+		return;
+
+	// Contiguous instance range for each batch:
+	uint32_t firstInstance = 0;
+	for (InstanceBatch& batch : m_instanceBatches)
+	{
+		batch.firstInstance = firstInstance;
+		firstInstance += batch.instanceCount;
+		batch.instanceCount = 0;	// recounted while gathering
+	}
+
+	// Gather per instance data:
+	m_instanceData.resize(instanceCount);
+	for (uint32_t groupIndex = 0; groupIndex < m_pMeshRendererGroups.size(); groupIndex++)
+		for (uint32_t i = 0; i < m_pMeshRendererGroups[groupIndex]->size(); i++)
+		{
+			uint32_t batchIndex = m_instanceBatchIndices[groupIndex][i];
+			if (batchIndex == UINT32_MAX)
+				continue;
+
+			MeshRenderer* meshRenderer = (*m_pMeshRendererGroups[groupIndex])[i];
+			InstanceBatch& batch = m_instanceBatches[batchIndex];
+			Transform* pTransform = meshRenderer->GetTransform();
+			Float4 color = meshRenderer->GetMaterialProperties()->GetValue<Float4>(blockName, memberName);
+			m_instanceData[batch.firstInstance + batch.instanceCount] = InstanceData(pTransform->GetLocalToWorldMatrix(), pTransform->GetLocalToWorldNormalMatrix(), color);
+			batch.instanceCount++;
+		}
+
+	// Upload into the region of the current frame, the gpu is done reading it (fence of this frameIndex):
+	ReserveInstanceBuffer(instanceCount);
+	uint32_t regionStart = m_pContext->frameIndex * m_instanceCapacity;
+	m_pInstanceBuffer->UpdateBuffer(m_instanceData.data(), regionStart * sizeof(InstanceData), instanceCount * sizeof(InstanceData));
+	for (InstanceBatch& batch : m_instanceBatches)
+		batch.firstInstance += regionStart;
+}
+void VulkanRenderer::ReserveInstanceBuffer(uint32_t instanceCount)
+{
+	if (instanceCount <= m_instanceCapacity)
+		return;
+
+	// Grow geometrically. MaterialProperties keep the old buffer alive until their descriptor sets point to the new one:
+	m_instanceCapacity = std::max(2 * m_instanceCapacity, std::max(instanceCount, 256u));
+	m_pInstanceBuffer = std::make_shared<StorageBuffer>(m_pContext, m_pContext->framesInFlight * m_instanceCapacity * sizeof(InstanceData));
 }
 
+void VulkanRenderer::CreateThreadCommandPools()
+{
+	uint32_t threadCount = m_pThreadPool->GetThreadCount();
+	m_threadCommandPools.clear();
+	m_threadCommandPools.resize(m_pContext->framesInFlight);
+	for (uint32_t frameIndex = 0; frameIndex < m_pContext->framesInFlight; frameIndex++)
+		for (uint32_t threadIndex = 0; threadIndex < threadCount; threadIndex++)
+			m_threadCommandPools[frameIndex].push_back(std::make_unique<VulkanCommandPool>(m_pContext, m_pContext->pLogicalDevice->GetGraphicsQueue()));
+	m_shadowVisibilities.resize(threadCount);
+	m_shadowFaceMasks.resize(threadCount);
+}
+void VulkanRenderer::BeginSecondaryCommandBuffer(VkCommandBuffer commandBuffer, VkRenderPass renderPass, VkFramebuffer framebuffer)
+{
+	// Secondary command buffers continue the render pass begun in the primary command buffer:
+	VkCommandBufferInheritanceInfo inheritanceInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+	inheritanceInfo.renderPass = renderPass;
+	inheritanceInfo.subpass = 0;
+	inheritanceInfo.framebuffer = framebuffer;
+	inheritanceInfo.pipelineStatistics = m_pGpuTimer->GetPipelineStatisticFlags();	// executed inside the statistics query of the primary
+
+	VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+	beginInfo.pInheritanceInfo = &inheritanceInfo;
+	VKA(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+}
+
+/// <summary>
+/// Collects one shadow view per directional light cascade, spot light and point light face and assigns their shadow atlas tiles.
+/// Tile sizes follow the screen coverage of the lights: directional lights cover the whole screen,
+/// spot and point lights are estimated by the projected size of the sphere with radius farClip around them.
+/// </summary>
+void VulkanRenderer::CollectShadowViews(Scene* pScene)
+{
+	int shadowMapIndex = 0;
+	m_shadowViews.clear();
+	m_shadowTileRequests.clear();
+	m_shadowBatches.clear();
+
+	Camera* pCamera = pScene->GetActiveCamera();
+	Float3 cameraPosition = pCamera->GetTransform()->GetPosition();
+	float screenHeight = static_cast<float>(m_pContext->GetRenderExtent().height);
+	float tanHalfFov = mathf::Tan(0.5f * pCamera->GetFov());
+	auto getTileSize = [&](const Float3& lightPosition, float range)
+	{
+		float distance = Float3::Distance(lightPosition, cameraPosition);
+		float pixelCoverage = distance <= range ? screenHeight : screenHeight * range / (distance * tanHalfFov);
+		return ShadowAtlas::GetTileSize(pixelCoverage);
+	};
+
+	// Directional Lights:
+	const std::array<DirectionalLight*, MAX_D_LIGHTS>& directionalLights = pScene->GetDirectionalLights();
+	for (uint32_t lightIndex = 0; lightIndex < MAX_D_LIGHTS; lightIndex++)
+	{
+		DirectionalLight* light = directionalLights[lightIndex];
+		if (light == nullptr)
+			continue;
+
+		// One view and batch per cascade, culled against the light space bounds of its camera frustum slice:
+		uint32_t cascadeCount = light->GetSolvedShadowCascadeCount();
+		if (cascadeCount > 0)
+		{
+			uint32_t tileSize = light->GetShadowCascadeTileSize();
+			for (uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; cascadeIndex++)
+			{
+				const ShadowCascade& cascade = light->GetShadowCascade(cascadeIndex);
+				m_shadowBatches.push_back(ShadowBatch{ static_cast<uint32_t>(m_shadowViews.size()), 1 });
+				m_shadowViews.push_back(ShadowView{ cascade.worldToClipMatrix, cascade.casterFrustum, shadowMapIndex, RenderStats::LightType::directional, ShadowTile{}, lightIndex, light->GetTimeSlicedShadows() });
+				m_shadowTileRequests.push_back(ShadowTileRequest{ light, cascadeIndex, tileSize });
+				shadowMapIndex++;
+			}
+			continue;
+		}
+
+		// Without active camera: casters between the light and its view volume still throw shadows into it, so the near plane is dropped:
+		Float4x4 worldToClipMatrix = light->GetProjectionMatrix() * light->GetViewMatrix();
+		m_shadowBatches.push_back(ShadowBatch{ static_cast<uint32_t>(m_shadowViews.size()), 1 });
+		m_shadowViews.push_back(ShadowView{ worldToClipMatrix, Frustum(worldToClipMatrix).ExtrudeNearPlane(), shadowMapIndex, RenderStats::LightType::directional, ShadowTile{}, lightIndex, light->GetTimeSlicedShadows() });
+		m_shadowTileRequests.push_back(ShadowTileRequest{ light, 0, ShadowAtlas::s_maxTileSize });
+		shadowMapIndex++;
+	}
+
+	// Spot Lights:
+	const std::array<SpotLight*, MAX_S_LIGHTS>& spotLights = pScene->GetSpotLights();
+	for (uint32_t lightIndex = 0; lightIndex < MAX_S_LIGHTS; lightIndex++)
+	{
+		SpotLight* light = spotLights[lightIndex];
+		if (light == nullptr)
+			continue;
+
+		Float4x4 worldToClipMatrix = light->GetProjectionMatrix() * light->GetViewMatrix();
+		m_shadowBatches.push_back(ShadowBatch{ static_cast<uint32_t>(m_shadowViews.size()), 1 });
+		m_shadowViews.push_back(ShadowView{ worldToClipMatrix, Frustum(worldToClipMatrix), shadowMapIndex, RenderStats::LightType::spot, ShadowTile{}, lightIndex, light->GetTimeSlicedShadows() });
+		m_shadowTileRequests.push_back(ShadowTileRequest{ light, 0, getTileSize(light->GetPosition(), light->GetFarClip()) });
+		shadowMapIndex++;
+	}
+
+	// Point Lights:
+	const std::array<PointLight*, MAX_P_LIGHTS>& pointLights = pScene->GetPointLights();
+	for (uint32_t lightIndex = 0; lightIndex < MAX_P_LIGHTS; lightIndex++)
+	{
+		PointLight* light = pointLights[lightIndex];
+		if (light == nullptr)
+			continue;
+
+		uint32_t tileSize = getTileSize(light->GetPosition(), light->GetFarClip());
+		m_shadowBatches.push_back(ShadowBatch{ static_cast<uint32_t>(m_shadowViews.size()), 6 });
+		for (uint32_t faceIndex = 0; faceIndex < 6; faceIndex++)
+		{
+			Float4x4 worldToClipMatrix = light->GetProjectionMatrix() * light->GetViewMatrix(faceIndex);
+			m_shadowViews.push_back(ShadowView{ worldToClipMatrix, Frustum(worldToClipMatrix), shadowMapIndex, RenderStats::LightType::point, ShadowTile{}, lightIndex, light->GetTimeSlicedShadows() });
+			m_shadowTileRequests.push_back(ShadowTileRequest{ light, faceIndex, tileSize });
+			shadowMapIndex++;
+		}
+	}
+
+	// A grown atlas is a new image, the frame data descriptors must point to it:
+	ShadowRenderPass* renderPass = dynamic_cast<ShadowRenderPass*>(RenderPassManager::GetRenderPass("shadowRenderPass"));
+	if (renderPass->AllocateTiles(m_shadowTileRequests))
+		FrameData::UpdateShadowMapDescriptors();
+	for (uint32_t i = 0; i < m_shadowViews.size(); i++)
+		m_shadowViews[i].tile = m_shadowTileRequests[i].tile;
+
+	// Round robin window of m_timeSlicedShadowBudget views over all time sliced views:
+	uint32_t timeSlicedCount = static_cast<uint32_t>(std::count_if(m_shadowViews.begin(), m_shadowViews.end(), [](const ShadowView& view) { return view.isTimeSliced; }));
+	uint32_t timeSlicedIndex = 0;
+	for (ShadowView& view : m_shadowViews)
+	{
+		view.isUpdateAllowed = true;
+		if (view.isTimeSliced)
+		{
+			view.isUpdateAllowed = ShadowUpdatePolicy::IsInTimeSliceWindow(timeSlicedIndex, timeSlicedCount, m_timeSlicedShadowBudget, m_timeSliceCursor);
+			timeSlicedIndex++;
+		}
+	}
+	m_timeSliceCursor = ShadowUpdatePolicy::AdvanceTimeSliceCursor(m_timeSliceCursor, timeSlicedCount, m_timeSlicedShadowBudget);
+}
+uint32_t VulkanRenderer::CullShadowCasters(const Frustum& frustum, std::array<std::vector<uint8_t>, 2>& visibilities)
+{
+	uint32_t casterCount = 0;
+	for (uint32_t groupIndex = 0; groupIndex < m_pMeshRendererGroups.size(); groupIndex++)
+	{
+		std::vector<MeshRenderer*>& group = *m_pMeshRendererGroups[groupIndex];
+		std::vector<uint8_t>& visibility = visibilities[groupIndex];
+		visibility.resize(group.size());
+		frustum.Intersects(m_worldBounds[groupIndex], visibility);
+
+		for (uint32_t i = 0; i < group.size(); i++)
+		{
+			visibility[i] = visibility[i] && group[i]->IsActive() && group[i]->GetCastShadows();
+			casterCount += visibility[i];
+		}
+	}
+	return casterCount;
+}
+/// <summary>
+/// Hash over the visible casters, see ShadowUpdatePolicy::HashCaster().
+/// Changes when a caster moves, changes its mesh or mesh data, enters or leaves the view.
+/// </summary>
+uint64_t VulkanRenderer::HashShadowCasters(const std::array<std::vector<uint8_t>, 2>& visibilities) const
+{
+	uint64_t hash = ShadowUpdatePolicy::s_emptyCasterHash;
+	for (uint32_t groupIndex = 0; groupIndex < m_pMeshRendererGroups.size(); groupIndex++)
+		for (uint32_t i = 0; i < m_pMeshRendererGroups[groupIndex]->size(); i++)
+			if (visibilities[groupIndex][i])
+			{
+				MeshRenderer* meshRenderer = (*m_pMeshRendererGroups[groupIndex])[i];
+				Mesh* pMesh = meshRenderer->GetMesh();
+				hash = ShadowUpdatePolicy::HashCaster(hash, meshRenderer, pMesh, pMesh->GetVersion(), m_localToWorldMatrices[groupIndex][i]);
+			}
+	return hash;
+}
 void VulkanRenderer::RecordShadowCommandBuffer(Scene* pScene)
 {
+	EMBER_PROFILE_SCOPE("VulkanRenderer::RecordShadowCommandBuffer");
+	ShadowRenderPass* renderPass = dynamic_cast<ShadowRenderPass*>(RenderPassManager::GetRenderPass("shadowRenderPass"));
+	VkFramebuffer framebuffer = renderPass->GetFramebuffers()[m_pContext->frameIndex];
+	uint32_t atlasSize = renderPass->GetAtlasSize();
+	ShadowAtlas& atlas = renderPass->GetAtlas();
+
+	// Cull every shadow view and record the changed ones, unchanged tiles keep their content.
+	// Each batch is recorded into its own secondary command buffer, point lights render all their changed faces in one pass:
+	m_shadowCasterCounts.assign(m_shadowViews.size(), 0);
+	m_shadowSecondaryBuffers.assign(m_shadowBatches.size(), VK_NULL_HANDLE);
+	m_shadowViewStats.assign(m_shadowViews.size(), RenderStats());
+	m_shadowViewRendered.assign(m_shadowViews.size(), 0);
+	m_shadowViewContents.resize(m_shadowViews.size());
+	m_pThreadPool->ParallelFor(static_cast<uint32_t>(m_shadowBatches.size()), [&](uint32_t batchIndex, uint32_t threadIndex)
+	{
+		const ShadowBatch& batch = m_shadowBatches[batchIndex];
+		const ShadowView& firstView = m_shadowViews[batch.firstView];
+		bool isPointLight = firstView.lightType == RenderStats::LightType::point;
+		std::array<std::vector<uint8_t>, 2>& visibilities = m_shadowVisibilities[threadIndex];
+		std::array<std::vector<uint8_t>, 2>& faceMasks = m_shadowFaceMasks[threadIndex];
+		if (isPointLight)
+			for (uint32_t groupIndex = 0; groupIndex < m_pMeshRendererGroups.size(); groupIndex++)
+				faceMasks[groupIndex].assign(m_pMeshRendererGroups[groupIndex]->size(), 0);
+
+		uint32_t renderedCount = 0;
+		uint32_t batchCasterCount = 0;
+		std::array<VkClearRect, 6> clearRects;
+		for (uint32_t viewIndex = batch.firstView; viewIndex < batch.firstView + batch.viewCount; viewIndex++)
+		{
+			const ShadowView& shadowView = m_shadowViews[viewIndex];
+			const ShadowTileRequest& request = m_shadowTileRequests[viewIndex];
+			if (shadowView.tile.size == 0)	// did not fit into the shadow atlas
+				continue;
+			const ShadowTileContent* pContent = atlas.GetContent(request.pLight, request.face);
+			if (!ShadowUpdatePolicy::IsCheckRequired(pContent, shadowView.isUpdateAllowed))
+				continue;
+
+			uint32_t casterCount = CullShadowCasters(shadowView.frustum, visibilities);
+			uint64_t casterHash = HashShadowCasters(visibilities);
+			if (!ShadowUpdatePolicy::IsRenderRequired(pContent, shadowView.worldToClipMatrix, casterHash))
+				continue;
+
+			if (isPointLight)
+				for (uint32_t groupIndex = 0; groupIndex < m_pMeshRendererGroups.size(); groupIndex++)
+					for (uint32_t i = 0; i < visibilities[groupIndex].size(); i++)
+						faceMasks[groupIndex][i] |= visibilities[groupIndex][i] << request.face;
+
+			// The atlas is loaded, so the old content of the tile is cleared first:
+			VkClearRect& clearRect = clearRects[renderedCount];
+			clearRect.rect.offset = VkOffset2D{ static_cast<int32_t>(shadowView.tile.x), static_cast<int32_t>(shadowView.tile.y) };
+			clearRect.rect.extent = VkExtent2D{ shadowView.tile.size, shadowView.tile.size };
+			clearRect.baseArrayLayer = 0;
+			clearRect.layerCount = 1;
+
+			m_shadowCasterCounts[viewIndex] = casterCount;
+			m_shadowViewRendered[viewIndex] = 1;
+			m_shadowViewContents[viewIndex] = ShadowTileContent{ shadowView.worldToClipMatrix, casterHash };
+			batchCasterCount += casterCount;
+			renderedCount++;
+		}
+		if (renderedCount == 0)
+			return;
+
+		// Point lights time their whole pass in the timestamp slots of their first face:
+		VkCommandBuffer commandBuffer = m_threadCommandPools[m_pContext->frameIndex][threadIndex]->GetSecondaryCommandBuffer();
+		BeginSecondaryCommandBuffer(commandBuffer, renderPass->GetVkRenderPass(), framebuffer);
+		m_pGpuTimer->WriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, GpuTimer::GetShadowLayerBeginSlot(firstView.shadowMapIndex));
+		VkClearAttachment clearAttachment = {};
+		clearAttachment.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+		clearAttachment.clearValue.depthStencil = { 1.0f, 0 };
+		vkCmdClearAttachments(commandBuffer, 1, &clearAttachment, renderedCount, clearRects.data());
+
+		CommandStateTracker tracker(commandBuffer);
+		if (batchCasterCount != 0 && isPointLight)
+		{
+			// Faces are mapped into their tiles by the vertex shader, the viewport covers the whole atlas:
+			SetViewportAndScissor(commandBuffer, VkExtent2D{ atlasSize, atlasSize });
+			tracker.BindPipeline(MeshRenderer::GetPointShadowPipeline());
+			tracker.BindDescriptorSet(MeshRenderer::GetPointShadowPipelineLayout(), 0, *FrameData::GetDescriptorSets(m_pContext->frameIndex));
+			RecordPointShadowDrawCalls(tracker, firstView.lightIndex, faceMasks);
+		}
+		else if (batchCasterCount != 0)
+		{
+			SetViewportAndScissor(commandBuffer, VkExtent2D{ firstView.tile.size, firstView.tile.size }, VkOffset2D{ static_cast<int32_t>(firstView.tile.x), static_cast<int32_t>(firstView.tile.y) });
+			tracker.BindPipeline(MeshRenderer::GetShadowPipeline());
+			RecordShadowDrawCalls(tracker, firstView, visibilities);
+		}
+		m_pGpuTimer->WriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, GpuTimer::GetShadowLayerEndSlot(firstView.shadowMapIndex));
+		VKA(vkEndCommandBuffer(commandBuffer));
+		m_shadowSecondaryBuffers[batchIndex] = commandBuffer;
+		m_shadowViewStats[batch.firstView] = tracker.GetStats();
+	});
+	std::erase(m_shadowSecondaryBuffers, VK_NULL_HANDLE);
+	for (uint32_t viewIndex = 0; viewIndex < m_shadowViews.size(); viewIndex++)
+	{
+		m_stats += m_shadowViewStats[viewIndex];
+		m_stats.ShadowDrawCalls(m_shadowViews[viewIndex].lightType) += m_shadowViewStats[viewIndex].drawCalls;
+		if (m_shadowViewRendered[viewIndex])
+		{
+			const ShadowTileRequest& request = m_shadowTileRequests[viewIndex];
+			atlas.SetContent(request.pLight, request.face, m_shadowViewContents[viewIndex]);
+			m_stats.shadowMapsRendered++;
+		}
+		else if (m_shadowViews[viewIndex].tile.size != 0)
+			m_stats.shadowMapsReused++;
+	}
+
 	vkResetCommandPool(m_pContext->GetVkDevice(), m_shadowCommands[m_pContext->frameIndex].GetVkCommandPool(), 0);
 	VkCommandBuffer commandBuffer = m_shadowCommands[m_pContext->frameIndex].GetVkCommandBuffer();
 
@@ -142,120 +720,201 @@ void VulkanRenderer::RecordShadowCommandBuffer(Scene* pScene)
 	VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
 	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 	VKA(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+	m_pGpuTimer->ResetQueries(commandBuffer);	// first command buffer of the frame
+	m_pGpuTimer->WriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, GpuTimer::s_frameBegin);
+	m_pGpuTimer->BeginStatistics(commandBuffer, GpuTimer::Pass::shadow);
+	if (!m_shadowSecondaryBuffers.empty())	// all tiles reused, the atlas stays untouched
 	{
-		// Render pass info:
-		ShadowRenderPass* renderPass = dynamic_cast<ShadowRenderPass*>(RenderPassManager::GetRenderPass("shadowRenderPass"));
-		VkClearValue clearValues = {};
-		clearValues.depthStencil = { 1.0f, 0 };
+		// Render pass info, the atlas is loaded and not cleared:
 		VkRenderPassBeginInfo renderPassBeginInfo = { VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
 		renderPassBeginInfo.renderPass = renderPass->GetVkRenderPass();
-		renderPassBeginInfo.framebuffer = renderPass->GetFramebuffers()[m_pContext->frameIndex];
+		renderPassBeginInfo.framebuffer = framebuffer;
 		renderPassBeginInfo.renderArea.offset = { 0, 0 };
-		renderPassBeginInfo.renderArea.extent = VkExtent2D{ ShadowRenderPass::s_shadowMapWidth, ShadowRenderPass::s_shadowMapHeight };
-		renderPassBeginInfo.clearValueCount = 1;
-		renderPassBeginInfo.pClearValues = &clearValues;
-		const VkDeviceSize offsets[1] = { 0 };
+		renderPassBeginInfo.renderArea.extent = VkExtent2D{ atlasSize, atlasSize };
+		renderPassBeginInfo.clearValueCount = 0;
+		renderPassBeginInfo.pClearValues = nullptr;
 
-		// Begin render pass:
-		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+		// Begin render pass, shadow views are executed in shadow map order:
+		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+		vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(m_shadowSecondaryBuffers.size()), m_shadowSecondaryBuffers.data());
+		vkCmdEndRenderPass(commandBuffer);
+	}
+	m_pGpuTimer->EndStatistics(commandBuffer, GpuTimer::Pass::shadow);
+	m_pGpuTimer->WriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, GpuTimer::s_shadowPassEnd);
+	VKA(vkEndCommandBuffer(commandBuffer));
+}
+void VulkanRenderer::RecordShadowDrawCalls(CommandStateTracker& tracker, const ShadowView& shadowView, const std::array<std::vector<uint8_t>, 2>& visibilities)
+{
+	EMBER_PROFILE_SCOPE("VulkanRenderer::RecordShadowDrawCalls");
+	const VkDeviceSize offsets[1] = { 0 };
+	for (uint32_t groupIndex = 0; groupIndex < m_pMeshRendererGroups.size(); groupIndex++)
+		for (uint32_t i = 0; i < m_pMeshRendererGroups[groupIndex]->size(); i++)
 		{
-			Mesh* pMesh = nullptr;
-			int shadowMapIndex = 0;
-			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, MeshRenderer::GetShadowPipeline());
-
-			// Directional Lights:
-			for (auto& light : pScene->GetDirectionalLights())
+			MeshRenderer* meshRenderer = (*m_pMeshRendererGroups[groupIndex])[i];
+			if (visibilities[groupIndex][i])	// active shadow caster inside the shadow view
 			{
-				if (light == nullptr)
-					continue;
-
-				for (auto group : m_pMeshRendererGroups)
-					for (MeshRenderer* meshRenderer : *group)
-					{
-						if (meshRenderer->IsActive() && meshRenderer->GetCastShadows())
-						{
-							pMesh = meshRenderer->GetMesh();
-
-							// Update shader specific data (push constants):
-							Float4x4 localToClipMatrix = light->GetProjectionMatrix() * light->GetViewMatrix() * meshRenderer->GetTransform()->GetLocalToWorldMatrix();
-							ShadowPushConstant pushConstant(shadowMapIndex, localToClipMatrix);
-							vkCmdPushConstants(commandBuffer, MeshRenderer::GetShadowPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ShadowPushConstant), &pushConstant);
-
-							vkCmdBindVertexBuffers(commandBuffer, 0, 1, &pMesh->GetVertexBuffer(m_pContext)->GetVkBuffer(), offsets);
-							vkCmdBindIndexBuffer(commandBuffer, pMesh->GetIndexBuffer(m_pContext)->GetVkBuffer(), 0, Mesh::GetIndexType());
-
-							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, meshRenderer->GetShadowPipelineLayout(), 0, 1, meshRenderer->GetShadowDescriptorSets(m_pContext->frameIndex), 0, nullptr);
-							vkCmdDrawIndexed(commandBuffer, 3 * pMesh->GetTriangleCount(), 1, 0, 0, 0);
-						}
-					}
-				shadowMapIndex++;
-			}
+				Mesh* pMesh = meshRenderer->GetMesh();
 
-			// Spot Lights:
-			for (auto& light : pScene->GetSpotLights())
-			{
-				if (light == nullptr)
-					continue;
-
-				for (auto group : m_pMeshRendererGroups)
-					for (MeshRenderer* meshRenderer : *group)
-					{
-						if (meshRenderer->IsActive() && meshRenderer->GetCastShadows())
-						{
-							pMesh = meshRenderer->GetMesh();
-
-							// Update shader specific data (push constants):
-							Float4x4 localToClipMatrix = light->GetProjectionMatrix() * light->GetViewMatrix() * meshRenderer->GetTransform()->GetLocalToWorldMatrix();
-							ShadowPushConstant pushConstant(shadowMapIndex, localToClipMatrix);
-							vkCmdPushConstants(commandBuffer, MeshRenderer::GetShadowPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ShadowPushConstant), &pushConstant);
-
-							vkCmdBindVertexBuffers(commandBuffer, 0, 1, &pMesh->GetVertexBuffer(m_pContext)->GetVkBuffer(), offsets);
-							vkCmdBindIndexBuffer(commandBuffer, pMesh->GetIndexBuffer(m_pContext)->GetVkBuffer(), 0, Mesh::GetIndexType());
-
-							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, meshRenderer->GetShadowPipelineLayout(), 0, 1, meshRenderer->GetShadowDescriptorSets(m_pContext->frameIndex), 0, nullptr);
-							vkCmdDrawIndexed(commandBuffer, 3 * pMesh->GetTriangleCount(), 1, 0, 0, 0);
-						}
-					}
-				shadowMapIndex++;
-			}
+				// Update shader specific data (push constants):
+				Float4x4 localToClipMatrix = shadowView.worldToClipMatrix * m_localToWorldMatrices[groupIndex][i];
+				ShadowPushConstant pushConstant(localToClipMatrix);
+				tracker.PushConstants(MeshRenderer::GetShadowPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ShadowPushConstant), &pushConstant);
 
-			// Point Lights:
-			for (auto& light : pScene->GetPointLights())
-			{
-				if (light == nullptr)
-					continue;
+				tracker.BindVertexBuffers(1, &pMesh->GetVertexBuffer(m_pContext)->GetVkBuffer(), offsets);
+				tracker.BindIndexBuffer(pMesh->GetIndexBuffer(m_pContext)->GetVkBuffer(), 0, Mesh::GetIndexType());
+
+				tracker.BindDescriptorSet(MeshRenderer::GetShadowPipelineLayout(), 1, *MeshRenderer::GetShadowDescriptorSets(m_pContext->frameIndex));
+				tracker.DrawIndexed(3 * pMesh->GetTriangleCount());
+			}
+		}
+}
+/// <summary>
+/// One draw per caster for all cube faces it is visible in, one instance per face.
+/// The face matrices and tiles are read from the point light data in FrameData, which is written before submission.
+/// </summary>
+void VulkanRenderer::RecordPointShadowDrawCalls(CommandStateTracker& tracker, uint32_t pointLightIndex, const std::array<std::vector<uint8_t>, 2>& faceMasks)
+{
+	EMBER_PROFILE_SCOPE("VulkanRenderer::RecordPointShadowDrawCalls");
+	const VkDeviceSize offsets[1] = { 0 };
+	for (uint32_t groupIndex = 0; groupIndex < m_pMeshRendererGroups.size(); groupIndex++)
+		for (uint32_t i = 0; i < m_pMeshRendererGroups[groupIndex]->size(); i++)
+		{
+			uint8_t faceMask = faceMasks[groupIndex][i];
+			if (faceMask == 0)	// not a caster of any rendered face
+				continue;
 
-				for (uint32_t faceIndex = 0; faceIndex < 6; faceIndex++)
+			// Pack the indices of the rendered faces, 4 bits per instance:
+			uint32_t faceIndices = 0;
+			uint32_t faceCount = 0;
+			for (uint32_t faceIndex = 0; faceIndex < 6; faceIndex++)
+				if (faceMask & (1 << faceIndex))
 				{
-					for (auto group : m_pMeshRendererGroups)
-						for (MeshRenderer* meshRenderer : *group)
-						{
-							if (meshRenderer->IsActive() && meshRenderer->GetCastShadows())
-							{
-								pMesh = meshRenderer->GetMesh();
-
-								// Update shader specific data (push constants):
-								Float4x4 localToClipMatrix = light->GetProjectionMatrix() * light->GetViewMatrix(faceIndex) * meshRenderer->GetTransform()->GetLocalToWorldMatrix();
-								ShadowPushConstant pushConstant(shadowMapIndex, localToClipMatrix);
-								vkCmdPushConstants(commandBuffer, MeshRenderer::GetShadowPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(ShadowPushConstant), &pushConstant);
-
-								vkCmdBindVertexBuffers(commandBuffer, 0, 1, &pMesh->GetVertexBuffer(m_pContext)->GetVkBuffer(), offsets);
-								vkCmdBindIndexBuffer(commandBuffer, pMesh->GetIndexBuffer(m_pContext)->GetVkBuffer(), 0, Mesh::GetIndexType());
-
-								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, meshRenderer->GetShadowPipelineLayout(), 0, 1, meshRenderer->GetShadowDescriptorSets(m_pContext->frameIndex), 0, nullptr);
-								vkCmdDrawIndexed(commandBuffer, 3 * pMesh->GetTriangleCount(), 1, 0, 0, 0);
-							}
-						}
-					shadowMapIndex++;
+					faceIndices |= faceIndex << (4 * faceCount);
+					faceCount++;
 				}
+
+			MeshRenderer* meshRenderer = (*m_pMeshRendererGroups[groupIndex])[i];
+			Mesh* pMesh = meshRenderer->GetMesh();
+			PointShadowPushConstant pushConstant(m_localToWorldMatrices[groupIndex][i], pointLightIndex, faceIndices);
+			tracker.PushConstants(MeshRenderer::GetPointShadowPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PointShadowPushConstant), &pushConstant);
+
+			tracker.BindVertexBuffers(1, &pMesh->GetVertexBuffer(m_pContext)->GetVkBuffer(), offsets);
+			tracker.BindIndexBuffer(pMesh->GetIndexBuffer(m_pContext)->GetVkBuffer(), 0, Mesh::GetIndexType());
+
+			tracker.BindDescriptorSet(MeshRenderer::GetPointShadowPipelineLayout(), 1, *MeshRenderer::GetShadowDescriptorSets(m_pContext->frameIndex));
+			tracker.DrawIndexed(3 * pMesh->GetTriangleCount(), faceCount);
+		}
+}
+void VulkanRenderer::PrepareShadingDraws(Scene* pScene)
+{
+	EMBER_PROFILE_SCOPE("VulkanRenderer::PrepareShadingDraws");
+	m_drawOrder.clear();
+	m_shadingDraws.clear();
+	m_vertexBuffers.clear();
+	m_vertexOffsets.clear();
+
+	// Draw key of every visible draw, depth is the distance to the camera quantized to 16 bits:
+	Camera* pCamera = pScene->GetActiveCamera();
+	Float3 cameraPosition = pCamera->GetTransform()->GetPosition();
+	float depthScale = UINT16_MAX / pCamera->GetFarClip();
+	for (uint32_t groupIndex = 0; groupIndex < m_pMeshRendererGroups.size(); groupIndex++)
+		for (uint32_t i = 0; i < m_pMeshRendererGroups[groupIndex]->size(); i++)
+		{
+			MeshRenderer* meshRenderer = (*m_pMeshRendererGroups[groupIndex])[i];
+			if (!m_visibilities[groupIndex][i])	// inactive or outside the camera frustum
+				continue;
+
+			// Instanced renderers are drawn all at once by the first renderer of their batch:
+			uint32_t batchIndex = m_instanceBatchIndices[groupIndex][i];
+			if (batchIndex != UINT32_MAX && m_instanceBatches[batchIndex].pMeshRenderer != meshRenderer)
+				continue;
+
+			// Every draw of a material that reads instanceData needs an instance slice, see BuildInstanceBatches():
+			if (batchIndex == UINT32_MAX && meshRenderer->GetUsesInstanceData())
+			{
+				LOG_ERROR("VulkanRenderer::PrepareShadingDraws() '{}' reads instanceData but has no instance slice, draw skipped.", meshRenderer->GetGameObject()->GetName());
+				continue;
 			}
+
+			float distance = Float3::Distance(m_worldBounds[groupIndex][i].center, cameraPosition);
+			uint16_t depth = static_cast<uint16_t>(mathf::Clamp(distance * depthScale, 0.0f, static_cast<float>(UINT16_MAX)));
+			m_drawOrder.push_back(SortItem{ meshRenderer->GetSortKey(depth), (groupIndex << 31) | i });
 		}
-		vkCmdEndRenderPass(commandBuffer);
+	RadixSort::Sort(m_drawOrder, m_drawOrderScratch);
+
+	// Uniform buffer and descriptor set updates touch shared state (transforms, lazily created buffers), so they stay on the main thread:
+	for (const SortItem& item : m_drawOrder)
+	{
+		uint32_t groupIndex = item.value >> 31;
+		uint32_t i = item.value & 0x7FFFFFFF;
+		MeshRenderer* meshRenderer = (*m_pMeshRendererGroups[groupIndex])[i];
+
+		ShadingDraw draw = {};
+		draw.pMeshRenderer = meshRenderer;
+		draw.instanceCount = 1;
+		draw.firstInstance = 0;
+
+		// Materials that read instanceData always get the buffer bound, non instanced renderers use their one entry slice:
+		uint32_t batchIndex = m_instanceBatchIndices[groupIndex][i];
+		if (batchIndex != UINT32_MAX)
+		{
+			const InstanceBatch& batch = m_instanceBatches[batchIndex];
+			draw.instanceCount = batch.instanceCount;
+			draw.firstInstance = batch.firstInstance;
+			meshRenderer->GetMaterialProperties()->SetStorageBuffer("instanceData", m_pInstanceBuffer);
+		}
+
+		// Update shader specific data, every uniform block is copied into this frame's ring buffer region (static objects included):
+		meshRenderer->SetRenderMatrizes();
+		meshRenderer->GetMaterialProperties()->UpdateShaderData();
+
+		// Resolve vertex and index buffers, Material::GetMeshBuffers/GetMeshOffsets write into shared storage:
+		Mesh* pMesh = meshRenderer->GetMesh();
+		Material* pMaterial = meshRenderer->GetMaterial();
+		draw.bindingCount = pMaterial->GetVertexInputDescriptions()->size;
+		draw.firstBinding = static_cast<uint32_t>(m_vertexBuffers.size());
+		const VkBuffer* pBuffers = pMaterial->GetMeshBuffers(pMesh);
+		const VkDeviceSize* pOffsets = pMaterial->GetMeshOffsets(pMesh);
+		m_vertexBuffers.insert(m_vertexBuffers.end(), pBuffers, pBuffers + draw.bindingCount);
+		m_vertexOffsets.insert(m_vertexOffsets.end(), pOffsets, pOffsets + draw.bindingCount);
+		draw.indexBuffer = pMesh->GetIndexBuffer(m_pContext)->GetVkBuffer();
+		draw.indexCount = 3 * pMesh->GetTriangleCount();
+		m_shadingDraws.push_back(draw);
 	}
-	VKA(vkEndCommandBuffer(commandBuffer));
 }
 void VulkanRenderer::RecordShadingCommandBuffer(Scene* pScene)
 {
+	EMBER_PROFILE_SCOPE("VulkanRenderer::RecordShadingCommandBuffer");
+	ShadingRenderPass* renderPass = dynamic_cast<ShadingRenderPass*>(RenderPassManager::GetRenderPass("shadingRenderPass"));
+	VkFramebuffer framebuffer = renderPass->GetFramebuffers()[m_imageIndex];
+	VkExtent2D extent = m_pContext->GetRenderExtent();	// not thread safe, queried once
+	PrepareShadingDraws(pScene);
+
+	Float3 cameraPosition = pScene->GetActiveCamera()->GetTransform()->GetPosition();
+	ShadingPushConstant pushConstant(Timer::GetTime(), Timer::GetDeltaTime(), pScene->GetDirectionalLightsCount(), pScene->GetSpotLightsCount(), pScene->GetPointLightsCount(), cameraPosition);
+
+	// Record contiguous slices of the sorted draw list, executing them in slice order keeps the sorting intact:
+	uint32_t drawCount = static_cast<uint32_t>(m_shadingDraws.size());
+	uint32_t sliceCount = std::min(m_pThreadPool->GetThreadCount(), (drawCount + s_minDrawsPerSlice - 1) / s_minDrawsPerSlice);
+	m_shadingSecondaryBuffers.assign(sliceCount, VK_NULL_HANDLE);
+	m_shadingSliceStats.assign(sliceCount, RenderStats());
+	m_pThreadPool->ParallelFor(sliceCount, [&](uint32_t sliceIndex, uint32_t threadIndex)
+	{
+		uint32_t firstDraw = static_cast<uint32_t>(static_cast<uint64_t>(sliceIndex) * drawCount / sliceCount);
+		uint32_t endDraw = static_cast<uint32_t>(static_cast<uint64_t>(sliceIndex + 1) * drawCount / sliceCount);
+
+		VkCommandBuffer commandBuffer = m_threadCommandPools[m_pContext->frameIndex][threadIndex]->GetSecondaryCommandBuffer();
+		BeginSecondaryCommandBuffer(commandBuffer, renderPass->GetVkRenderPass(), framebuffer);
+		SetViewportAndScissor(commandBuffer, extent);	// dynamic state is not inherited from the primary command buffer
+		CommandStateTracker tracker(commandBuffer);
+		RecordShadingDrawCalls(tracker, firstDraw, endDraw, pushConstant);
+		VKA(vkEndCommandBuffer(commandBuffer));
+		m_shadingSecondaryBuffers[sliceIndex] = commandBuffer;
+		m_shadingSliceStats[sliceIndex] = tracker.GetStats();
+	});
+	for (const RenderStats& sliceStats : m_shadingSliceStats)
+		m_stats += sliceStats;
+
 	vkResetCommandPool(m_pContext->GetVkDevice(), m_shadingCommands[m_pContext->frameIndex].GetVkCommandPool(), 0);
 	VkCommandBuffer commandBuffer = m_shadingCommands[m_pContext->frameIndex].GetVkCommandBuffer();
 
@@ -263,89 +922,80 @@ void VulkanRenderer::RecordShadingCommandBuffer(Scene* pScene)
 	VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
 	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 	VKA(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+	m_pGpuTimer->WriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, GpuTimer::s_shadingPassBegin);
+	m_pGpuTimer->BeginStatistics(commandBuffer, GpuTimer::Pass::shading);
 	{
-		// Viewport and Scissor:
-		SetViewportAndScissor(commandBuffer);
-
 		// Render pass info:
-		ShadingRenderPass* renderPass = dynamic_cast<ShadingRenderPass*>(RenderPassManager::GetRenderPass("shadingRenderPass"));
 		std::array<VkClearValue, 2> clearValues{};
 		clearValues[0].color = { 0.0f, 0.0f, 0.0f, 1.0f };
 		clearValues[1].depthStencil = { 1.0f, 0 };
 		VkRenderPassBeginInfo renderPassBeginInfo = { VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
 		renderPassBeginInfo.renderPass = renderPass->GetVkRenderPass();
-		renderPassBeginInfo.framebuffer = renderPass->GetFramebuffers()[m_imageIndex];
+		renderPassBeginInfo.framebuffer = framebuffer;
 		renderPassBeginInfo.renderArea.offset = { 0, 0 };
-		renderPassBeginInfo.renderArea.extent = m_pContext->pSurface->GetCurrentExtent();
+		renderPassBeginInfo.renderArea.extent = extent;
 		renderPassBeginInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
 		renderPassBeginInfo.pClearValues = clearValues.data();
 
 		// Begin render pass:
-		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-		{
-			Mesh* pMesh = nullptr;
-			Material* pMaterial = nullptr;
-			uint32_t bindingCount = 0;
-			Material* pPreviousMaterial = nullptr;
-			Float3 cameraPosition = pScene->GetActiveCamera()->GetTransform()->GetPosition();
-			ShadingPushConstant pushConstant(Timer::GetTime(), Timer::GetDeltaTime(), pScene->GetDirectionalLightsCount(), pScene->GetSpotLightsCount(), pScene->GetPointLightsCount(), cameraPosition);
-
-			for (auto group : m_pMeshRendererGroups)
-				for (MeshRenderer* meshRenderer : *group)
-				{
-					if (meshRenderer->IsActive())
-					{
-						pMesh = meshRenderer->GetMesh();
-
-						// Update shader specific data (uniform buffers):
-						meshRenderer->SetRenderMatrizes(pScene->GetActiveCamera());
-						meshRenderer->SetLightData(pScene->GetDirectionalLights());
-						meshRenderer->SetLightData(pScene->GetSpotLights());
-						meshRenderer->SetLightData(pScene->GetPointLights());
-						meshRenderer->GetMaterialProperties()->UpdateShaderData();
-
-						// Change pipeline if material has changed:
-						pMaterial = meshRenderer->GetMaterial();
-						if (pPreviousMaterial != pMaterial)
-						{
-							pPreviousMaterial = pMaterial;
-							bindingCount = pMaterial->GetVertexInputDescriptions()->size;
-							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, meshRenderer->GetShadingPipeline());
-							vkCmdPushConstants(commandBuffer, meshRenderer->GetShadingPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(ShadingPushConstant), &pushConstant);
-						}
-						
-						vkCmdBindVertexBuffers(commandBuffer, 0, bindingCount, pMaterial->GetMeshBuffers(pMesh), pMaterial->GetMeshOffsets(pMesh));
-						vkCmdBindIndexBuffer(commandBuffer, pMesh->GetIndexBuffer(m_pContext)->GetVkBuffer(), 0, Mesh::GetIndexType());
-
-						// For debugging binding missmatch error:
-						//std::cout << "GameObject:     " << meshRenderer->GetGameObject()->GetName() << std::endl;
-						//std::cout << "descriptorSet:  " << *meshRenderer->GetShadingDescriptorSets(m_pContext->frameIndex) << std::endl;
-						//std::cout << "Pipeline:       " << meshRenderer->GetShadingPipeline() << std::endl;
-						//std::cout << "PipelineLayout: " << meshRenderer->GetShadingPipelineLayout() << std::endl;
-						//Texture2d* texture = meshRenderer->GetMaterialProperties()->GetTexture2d("colorMap");
-						//if (texture != nullptr)
-						//	std::cout << "texture:        " << texture->GetName() << std::endl;
-						//texture = meshRenderer->GetMaterialProperties()->GetTexture2d("cubeMap");
-						//if (texture != nullptr)
-						//	std::cout << "texture:        " << texture->GetName() << std::endl;
-
-						vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, meshRenderer->GetShadingPipelineLayout(), 0, 1, meshRenderer->GetShadingDescriptorSets(m_pContext->frameIndex), 0, nullptr);
-						vkCmdDrawIndexed(commandBuffer, 3 * pMesh->GetTriangleCount(), 1, 0, 0, 0);
-					}
-				}
-		}
+		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+		if (!m_shadingSecondaryBuffers.empty())
+			vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(m_shadingSecondaryBuffers.size()), m_shadingSecondaryBuffers.data());
 		vkCmdEndRenderPass(commandBuffer);
 	}
+	m_pGpuTimer->EndStatistics(commandBuffer, GpuTimer::Pass::shading);
+	m_pGpuTimer->WriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, GpuTimer::s_frameEnd);
 	VKA(vkEndCommandBuffer(commandBuffer));
 }
+void VulkanRenderer::RecordShadingDrawCalls(CommandStateTracker& tracker, uint32_t firstDraw, uint32_t endDraw, const ShadingPushConstant& pushConstant)
+{
+	EMBER_PROFILE_SCOPE("VulkanRenderer::RecordShadingDrawCalls");
+	// Bound state is not inherited between secondary command buffers, so each slice starts with a fresh tracker:
+	for (uint32_t drawIndex = firstDraw; drawIndex < endDraw; drawIndex++)
+	{
+		const ShadingDraw& draw = m_shadingDraws[drawIndex];
+		MeshRenderer* meshRenderer = draw.pMeshRenderer;
+
+		// The first draw of each render queue marks its begin on the gpu timeline:
+		Material::RenderQueue renderQueue = meshRenderer->GetMaterial()->GetRenderQueue();
+		if (drawIndex == 0 || m_shadingDraws[drawIndex - 1].pMeshRenderer->GetMaterial()->GetRenderQueue() != renderQueue)
+			m_pGpuTimer->WriteTimestamp(tracker.GetVkCommandBuffer(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, GpuTimer::GetRenderQueueSlot(renderQueue));
+
+		// Pipeline, push constants and global set only change with the material:
+		const VkPipelineLayout& pipelineLayout = meshRenderer->GetShadingPipelineLayout();
+		tracker.BindPipeline(meshRenderer->GetShadingPipeline());
+		tracker.PushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(ShadingPushConstant), &pushConstant);
+		tracker.BindDescriptorSet(pipelineLayout, 0, *FrameData::GetDescriptorSets(m_pContext->frameIndex));
+
+		tracker.BindVertexBuffers(draw.bindingCount, &m_vertexBuffers[draw.firstBinding], &m_vertexOffsets[draw.firstBinding]);
+		tracker.BindIndexBuffer(draw.indexBuffer, 0, Mesh::GetIndexType());
+
+		// For debugging binding missmatch error:
+		//std::cout << "GameObject:     " << meshRenderer->GetGameObject()->GetName() << std::endl;
+		//std::cout << "descriptorSet:  " << *meshRenderer->GetShadingDescriptorSets(m_pContext->frameIndex) << std::endl;
+		//std::cout << "Pipeline:       " << meshRenderer->GetShadingPipeline() << std::endl;
+		//std::cout << "PipelineLayout: " << meshRenderer->GetShadingPipelineLayout() << std::endl;
+		//Texture2d* texture = meshRenderer->GetMaterialProperties()->GetTexture2d("colorMap");
+		//if (texture != nullptr)
+		//	std::cout << "texture:        " << texture->GetName() << std::endl;
+		//texture = meshRenderer->GetMaterialProperties()->GetTexture2d("cubeMap");
+		//if (texture != nullptr)
+		//	std::cout << "texture:        " << texture->GetName() << std::endl;
+
+		const std::vector<uint32_t>& dynamicOffsets = meshRenderer->GetShadingDynamicOffsets(m_pContext->frameIndex);
+		tracker.BindDescriptorSet(pipelineLayout, 1, *meshRenderer->GetShadingDescriptorSets(m_pContext->frameIndex), static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+		tracker.DrawIndexed(draw.indexCount, draw.instanceCount, draw.firstInstance);
+	}
+}
 
 void VulkanRenderer::SubmitCommandBuffers()
 {
+	EMBER_PROFILE_SCOPE("VulkanRenderer::SubmitCommandBuffers");
 	// Shadow render pass:
 	{
 		VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;	// wait at depth and stencil test stage
 		VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
-		submitInfo.waitSemaphoreCount = 1;
+		submitInfo.waitSemaphoreCount = m_pContext->IsHeadless() ? 0 : 1;				// nothing to acquire in headless mode
 		submitInfo.pWaitSemaphores = &m_acquireSemaphores[m_pContext->frameIndex];		// wait for acquireSemaphor
 		submitInfo.pWaitDstStageMask = &waitStage;
 		submitInfo.commandBufferCount = 1;
@@ -364,7 +1014,7 @@ void VulkanRenderer::SubmitCommandBuffers()
 		submitInfo.pWaitDstStageMask = &waitStage;
 		submitInfo.commandBufferCount = 1;
 		submitInfo.pCommandBuffers = &m_shadingCommands[m_pContext->frameIndex].GetVkCommandBuffer();
-		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.signalSemaphoreCount = m_pContext->IsHeadless() ? 0 : 1;					// nothing to present in headless mode
 		submitInfo.pSignalSemaphores = &m_releaseSemaphores[m_pContext->frameIndex];			// signal releaseSemaphor when done
 		VKA(vkQueueSubmit(m_pContext->pLogicalDevice->GetGraphicsQueue().queue, 1, &submitInfo, m_fences[m_pContext->frameIndex])); // signal fence when done
 	}
@@ -372,6 +1022,10 @@ void VulkanRenderer::SubmitCommandBuffers()
 
 bool VulkanRenderer::PresentImage()
 {
+	EMBER_PROFILE_SCOPE("VulkanRenderer::PresentImage");
+	if (m_pContext->IsHeadless())
+		return true;
+
 	VkPresentInfoKHR presentInfo = { VK_STRUCTURE_TYPE_PRESENT_INFO_KHR };
 	presentInfo.waitSemaphoreCount = 1;
 	presentInfo.pWaitSemaphores = &m_releaseSemaphores[m_pContext->frameIndex]; // wait for releaseSemaphor
@@ -393,16 +1047,19 @@ bool VulkanRenderer::PresentImage()
 	}
 }
 
-void VulkanRenderer::SetViewportAndScissor(VkCommandBuffer& commandBuffer)
+void VulkanRenderer::SetViewportAndScissor(VkCommandBuffer& commandBuffer, const VkExtent2D& extent, const VkOffset2D& offset)
 {
 	VkViewport viewport = {};
-	viewport.width = (float)m_pContext->pSurface->GetCurrentExtent().width;
-	viewport.height = (float)m_pContext->pSurface->GetCurrentExtent().height;
+	viewport.x = (float)offset.x;
+	viewport.y = (float)offset.y;
+	viewport.width = (float)extent.width;
+	viewport.height = (float)extent.height;
 	viewport.minDepth = 0.0f;
 	viewport.maxDepth = 1.0f;
 
 	VkRect2D scissor = {};
-	scissor.extent = m_pContext->pSurface->GetCurrentExtent();
+	scissor.offset = offset;
+	scissor.extent = extent;
 
 	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
@@ -1,16 +1,88 @@
 #ifndef __INCLUDE_GUARD_vulkanRenderer_h__
 #define __INCLUDE_GUARD_vulkanRenderer_h__
+#include "bounds.h"
+#include "float4x4.h"
+#include "frustum.h"
+#include "instanceData.h"
+#include "radixSort.h"
+#include "renderStats.h"
+#include "shadowAtlas.h"
 #include <vulkan/vulkan.h>
 #include <array>
+#include <map>
+#include <memory>
+#include <tuple>
 #include <vector>
 
 
 
+class CommandStateTracker;
+class GpuTimer;
+class Material;
 class Mesh;
 class MeshRenderer;
 class Scene;
+struct ShadingPushConstant;
+class StorageBuffer;
+class ThreadPool;
 struct VulkanContext;
 class VulkanCommand;
+class VulkanCommandPool;
+
+
+
+/// <summary>
+/// Single instanced draw call for all visible renderers sharing mesh, material and receiveShadows.
+/// Non instanced renderers whose material reads instanceData get a batch with a single instance.
+/// </summary>
+struct InstanceBatch
+{
+	MeshRenderer* pMeshRenderer;	// first renderer of the batch, provides the descriptor set.
+	uint32_t firstInstance;			// index of the first instance in the instance buffer.
+	uint32_t instanceCount;
+};
+
+
+
+/// <summary>
+/// Draw call of the shading pass. Prepared on the main thread, recorded by any worker thread.
+/// </summary>
+struct ShadingDraw
+{
+	MeshRenderer* pMeshRenderer;
+	VkBuffer indexBuffer;
+	uint32_t indexCount;
+	uint32_t firstInstance;
+	uint32_t instanceCount;
+	uint32_t firstBinding;	// index of the first vertex buffer/offset in VulkanRenderer::m_vertexBuffers/m_vertexOffsets.
+	uint32_t bindingCount;
+};
+
+
+
+/// <summary>
+/// One shadow map, i.e. a directional light cascade, spot light or point light face, rendered into its tile of the shadow atlas.
+/// </summary>
+struct ShadowView
+{
+	Float4x4 worldToClipMatrix;
+	Frustum frustum;
+	int shadowMapIndex;
+	RenderStats::LightType lightType;
+	ShadowTile tile;
+	uint32_t lightIndex;	// slot of the light in the scene, index of its light data in FrameData
+	bool isTimeSliced;		// the light allows its shadow map updates to lag behind
+	bool isUpdateAllowed;	// false for time sliced views outside of this frame's round robin window
+};
+/// <summary>
+/// Consecutive shadow views recorded into one secondary command buffer:
+/// a single directional light cascade or spot light view, or all six cube faces of a point light, which are rendered in a single instanced pass.
+/// </summary>
+struct ShadowBatch
+{
+	uint32_t firstView;
+	uint32_t viewCount;
+};
 
 
 
@@ -34,21 +106,97 @@ private: // Members:
 	bool m_rebuildSwapchain;
 	std::array<std::vector<MeshRenderer*>*, 2> m_pMeshRendererGroups;
 
+	// Frustum culling (one visibility flag per mesh renderer of each group):
+	std::array<std::vector<uint8_t>, 2> m_visibilities;
+	std::array<std::vector<Bounds>, 2> m_worldBounds;
+	std::array<std::vector<Float4x4>, 2> m_localToWorldMatrices;
+	uint32_t m_visibleCount;
+	uint32_t m_culledCount;
+
+	// Shadow caster culling (one visibility flag per mesh renderer of each group and thread, one caster count per shadow map):
+	std::vector<std::array<std::vector<uint8_t>, 2>> m_shadowVisibilities;
+	std::vector<std::array<std::vector<uint8_t>, 2>> m_shadowFaceMasks;	// point lights: bit f set = caster is drawn into cube face f
+	std::vector<uint32_t> m_shadowCasterCounts;
+
+	// Shadow map caching (per shadow view, tiles are only rendered if their light or casters changed):
+	std::vector<uint8_t> m_shadowViewRendered;
+	std::vector<ShadowTileContent> m_shadowViewContents;
+	uint32_t m_timeSlicedShadowBudget;	// time sliced shadow views that may be updated per frame, 0 = all
+	uint32_t m_timeSliceCursor;
+
+	// Instancing (one region of m_instanceCapacity instances per frame in flight):
+	std::shared_ptr<StorageBuffer> m_pInstanceBuffer;
+	uint32_t m_instanceCapacity;
+	std::vector<InstanceData> m_instanceData;
+	std::vector<InstanceBatch> m_instanceBatches;
+	std::array<std::vector<uint32_t>, 2> m_instanceBatchIndices;	// batch index per mesh renderer, UINT32_MAX = material does not read instanceData.
+	std::map<std::tuple<Mesh*, Material*, bool>, uint32_t> m_instanceBatchMap;
+
+	// Multithreaded recording (secondary command buffers from one pool per frame in flight and thread):
+	std::unique_ptr<ThreadPool> m_pThreadPool;
+	std::vector<std::vector<std::unique_ptr<VulkanCommandPool>>> m_threadCommandPools;	// [frameIndex][threadIndex]
+	std::vector<ShadowView> m_shadowViews;
+	std::vector<ShadowTileRequest> m_shadowTileRequests;	// parallel to m_shadowViews
+	std::vector<ShadowBatch> m_shadowBatches;
+	std::vector<VkCommandBuffer> m_shadowSecondaryBuffers;
+	std::vector<SortItem> m_drawOrder;	// sort key and (groupIndex << 31 | index) of each visible draw.
+	std::vector<SortItem> m_drawOrderScratch;
+	std::vector<ShadingDraw> m_shadingDraws;
+	std::vector<VkBuffer> m_vertexBuffers;
+	std::vector<VkDeviceSize> m_vertexOffsets;
+	std::vector<VkCommandBuffer> m_shadingSecondaryBuffers;
+	float m_recordTime;
+	std::unique_ptr<GpuTimer> m_pGpuTimer;
+
+	// Render stats (command buffer counters per shadow view and shading slice, summed up into m_stats after recording):
+	std::vector<RenderStats> m_shadowViewStats;
+	std::vector<RenderStats> m_shadingSliceStats;
+	RenderStats m_stats;
+	std::array<RenderStats, 128> m_statsHistory;	// ring of the last frames, indexed by frameNumber
+	uint64_t m_frameNumber;
+	static constexpr uint32_t s_minDrawsPerSlice = 64;
+
 public: // Methods:
 	VulkanRenderer(VulkanContext* pContext);
 	~VulkanRenderer();
 	bool RenderFrame(Scene* pScene);
 	const VulkanContext* const GetContext() const;
+	uint32_t GetVisibleCount() const;
+	uint32_t GetCulledCount() const;
+	const std::vector<uint32_t>& GetShadowCasterCounts() const;
+	void SetTimeSlicedShadowBudget(uint32_t viewCount);
+	uint32_t GetTimeSlicedShadowBudget() const;
+	void SetThreadCount(uint32_t threadCount);
+	uint32_t GetThreadCount() const;
+	float GetRecordTime() const;
+	uint32_t GetIssuedCommandCount() const;
+	uint32_t GetElidedCommandCount() const;
+	uint32_t GetImageIndex() const;
+	const RenderStats& GetStats(uint32_t framesAgo = 0) const;
+	uint32_t GetStatsHistoryCount() const;
+	const GpuTimer* GetGpuTimer() const;
 
 private: // Methods:
 	void RebuildSwapchain();
 	bool AcquireImage();
 	void SetMeshRendererGroups(Scene* pScene);
+	void CullMeshRenderers(Scene* pScene);
+	void BuildInstanceBatches();
+	void ReserveInstanceBuffer(uint32_t instanceCount);
+	void CreateThreadCommandPools();
+	void BeginSecondaryCommandBuffer(VkCommandBuffer commandBuffer, VkRenderPass renderPass, VkFramebuffer framebuffer);
+	void CollectShadowViews(Scene* pScene);
+	uint32_t CullShadowCasters(const Frustum& frustum, std::array<std::vector<uint8_t>, 2>& visibilities);
+	uint64_t HashShadowCasters(const std::array<std::vector<uint8_t>, 2>& visibilities) const;
 	void RecordShadowCommandBuffer(Scene* pScene);
+	void RecordShadowDrawCalls(CommandStateTracker& tracker, const ShadowView& shadowView, const std::array<std::vector<uint8_t>, 2>& visibilities);
+	void RecordPointShadowDrawCalls(CommandStateTracker& tracker, uint32_t pointLightIndex, const std::array<std::vector<uint8_t>, 2>& faceMasks);
+	void PrepareShadingDraws(Scene* pScene);
 	void RecordShadingCommandBuffer(Scene* pScene);
+	void RecordShadingDrawCalls(CommandStateTracker& tracker, uint32_t firstDraw, uint32_t endDraw, const ShadingPushConstant& pushConstant);
 	void SubmitCommandBuffers();
 	bool PresentImage();
-	void SetViewportAndScissor(VkCommandBuffer& commandBuffer);
+	void SetViewportAndScissor(VkCommandBuffer& commandBuffer, const VkExtent2D& extent, const VkOffset2D& offset = { 0, 0 });
 	void CreateFences();
 	void CreateSemaphores();
 	void DestroyFences();
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "logger.h"
 #include <iostream>
 
 // Floating point precision:
@@ -35,6 +36,8 @@ constexpr float epsilon = 1e-6f;
 
 // mathf testing:
 #include "mathf.h"
+#include "simd.h"
+#include "testBatch.h"
 #include "testBounds.h"
 #include "testEmberRandom.h"
 #include "testFloat2.h"
@@ -45,17 +48,31 @@ constexpr float epsilon = 1e-6f;
 #include "testFloat3x3.h"
 #include "testFloat4.h"
 #include "testFloat4x4.h"
+#include "testFrustum.h"
 #include "testGeometry3d.h"
 #include "testInt2.h"
 #include "testInt3.h"
 #include "testMathf.h"
+#include "testQuaternion.h"
 #include "testUint3.h"
 
+// renderResources testing:
+#include "testShadowCascade.h"
+
+// vulkanRenderer testing:
+#include "testShadowAtlas.h"
+#include "testShadowUpdatePolicy.h"
+
+// utility testing:
+#include "testRadixSort.h"
+#include "testThreadPool.h"
+
 
 
 int main(int argc, char** argv)
 {
 	mathf::Random::Init();
+	Logger::Init();
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
\ No newline at end of file
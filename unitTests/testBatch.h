@@ -0,0 +1,139 @@
+#ifndef __INCLUDE_GUARD_testBatch_h__
+#define __INCLUDE_GUARD_testBatch_h__
+
+
+
+// Sizes that are not multiples of four also exercise the scalar remainder:
+std::vector<Float3> RandomFloat3s(size_t count)
+{
+	std::vector<Float3> vectors(count);
+	for (Float3& vector : vectors)
+		vector = Float3(mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f));
+	return vectors;
+}
+
+
+
+TEST(batch, Translate)
+{
+	std::vector<Float3> points = RandomFloat3s(103);
+	std::vector<Float3> result = points;
+	Float3 translation = Float3(1.0f, -2.0f, 3.5f);
+	mathf::batch::Translate(result, translation);
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		EXPECT_NEAR3(result[i], (points[i] + translation), epsilon);
+	}
+}
+TEST(batch, Scale)
+{
+	std::vector<Float3> vectors = RandomFloat3s(102);
+	std::vector<Float3> result = vectors;
+	Float3 scale = Float3(2.0f, 0.5f, -3.0f);
+	mathf::batch::Scale(result, scale);
+	for (size_t i = 0; i < vectors.size(); i++)
+	{
+		EXPECT_NEAR3(result[i], (scale * vectors[i]), epsilon);
+	}
+}
+TEST(batch, Lerp)
+{
+	std::vector<Float3> vectors = RandomFloat3s(101);
+	std::vector<Float3> targets = RandomFloat3s(101);
+	std::vector<Float3> result = vectors;
+	mathf::batch::Lerp(result, targets, 0.3f);
+	for (size_t i = 0; i < vectors.size(); i++)
+	{
+		EXPECT_NEAR3(result[i], (vectors[i] + 0.3f * (targets[i] - vectors[i])), 1e-5f);
+	}
+}
+TEST(batch, Normalize)
+{
+	std::vector<Float3> vectors = RandomFloat3s(99);
+	vectors[2] = Float3::zero;
+	vectors[97] = Float3::zero;
+	std::vector<Float3> result = vectors;
+	mathf::batch::Normalize(result);
+	for (size_t i = 0; i < vectors.size(); i++)
+	{
+		EXPECT_NEAR3(result[i], vectors[i].Normalize(), epsilon);
+	}
+}
+TEST(batch, ProjectOnPlanes)
+{
+	std::vector<Float3> vectors = RandomFloat3s(37);
+	std::vector<Float3> normals = RandomFloat3s(37);
+	mathf::batch::Normalize(normals);
+	std::vector<Float3> result = vectors;
+	mathf::batch::ProjectOnPlanes(result, normals);
+	for (size_t i = 0; i < vectors.size(); i++)
+	{
+		EXPECT_NEAR3(result[i], geometry3d::PointToPlaneProjection(vectors[i], Float3::zero, normals[i]), 1e-4f);
+	}
+}
+TEST(batch, TransformFloat3x3)
+{
+	std::vector<Float3> vectors = RandomFloat3s(103);
+	std::vector<Float3> result = vectors;
+	Float3x3 matrix = Float3x3::Rows(1.0f, 2.0f, 3.0f, 0.5f, -1.0f, 2.0f, 3.0f, 0.2f, -2.0f);
+	mathf::batch::Transform(result, matrix);
+	for (size_t i = 0; i < vectors.size(); i++)
+	{
+		EXPECT_NEAR3(result[i], (matrix * vectors[i]), 1e-4f);
+	}
+}
+TEST(batch, TransformPoints)
+{
+	std::vector<Float3> points = RandomFloat3s(103);
+	std::vector<Float3> result = points;
+	Float4x4 matrix = Float4x4::TRS(Float3(1.0f, 2.0f, 3.0f), Float3x3::Rotate(Float3(0.3f, -1.1f, 0.7f)), Float3(2.0f, 3.0f, 4.0f));
+	mathf::batch::TransformPoints(result, matrix);
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		EXPECT_NEAR3(result[i], Float3(matrix * Float4(points[i], 1.0f)), 1e-4f);
+	}
+}
+TEST(batch, TransformDirections)
+{
+	std::vector<Float3> directions = RandomFloat3s(103);
+	std::vector<Float3> result = directions;
+	Float4x4 matrix = Float4x4::TRS(Float3(1.0f, 2.0f, 3.0f), Float3x3::Rotate(Float3(0.3f, -1.1f, 0.7f)), Float3(2.0f, 3.0f, 4.0f));
+	mathf::batch::TransformDirections(result, matrix);
+	for (size_t i = 0; i < directions.size(); i++)
+	{
+		EXPECT_NEAR3(result[i], Float3(matrix * Float4(directions[i], 0.0f)), 1e-4f);
+	}
+}
+TEST(batch, MinMax)
+{
+	std::vector<Float3> points = RandomFloat3s(1001);
+	points[999] = Float3(-20.0f, 0.0f, 20.0f);
+	Float3 min, max;
+	mathf::batch::MinMax(points, min, max);
+	Float3 expectedMin = points[0];
+	Float3 expectedMax = points[0];
+	for (const Float3& point : points)
+	{
+		expectedMin = Float3::Min(expectedMin, point);
+		expectedMax = Float3::Max(expectedMax, point);
+	}
+	EXPECT_FLOAT3_EQ(min, expectedMin);
+	EXPECT_FLOAT3_EQ(max, expectedMax);
+	EXPECT_FLOAT_EQ(min.x, -20.0f);
+	EXPECT_FLOAT_EQ(max.z, 20.0f);
+}
+TEST(batch, MaxDistanceSq)
+{
+	std::vector<Float3> points = RandomFloat3s(1002);
+	points[1001] = Float3(30.0f, 0.0f, 0.0f);
+	Float3 point = Float3(1.0f, 2.0f, 3.0f);
+	float expected = 0.0f;
+	for (const Float3& p : points)
+		expected = mathf::Max(expected, Float3::DistanceSq(p, point));
+	EXPECT_FLOAT_EQ(mathf::batch::MaxDistanceSq(points, point), expected);
+	EXPECT_FLOAT_EQ(expected, Float3::DistanceSq(points[1001], point));
+}
+
+
+
+#endif // __INCLUDE_GUARD_testBatch_h__
\ No newline at end of file
@@ -3,6 +3,16 @@
 
 
 
+TEST(Bounds, ConstructorPoints)
+{
+	std::vector<Float3> points = { Float3(1.0f, 2.0f, 3.0f), Float3(-1.0f, 0.0f, 5.0f), Float3(0.0f, 4.0f, 2.0f) };
+	for (int i = 0; i < 10; i++)
+		points.push_back(Float3(0.5f));
+	points.push_back(Float3(3.0f, -2.0f, 0.0f));
+	Bounds bounds(points);
+	EXPECT_FLOAT3_EQ(bounds.GetMin(), Float3(-1.0f, -2.0f, 0.0f));
+	EXPECT_FLOAT3_EQ(bounds.GetMax(), Float3(3.0f, 4.0f, 5.0f));
+}
 TEST(Bounds, GetMin)
 {
 	Bounds bounds(Float3(1.0f, 2.0f, 3.0f), Float3(2.0f, 3.0f, 4.0f));
@@ -79,6 +89,14 @@ TEST(Bounds, SetMinMax)
 	EXPECT_FLOAT3_EQ(size, Float3(1.0f, 2.0f, 4.0f));
 	EXPECT_FLOAT3_EQ(center, Float3(0.5f, 1.0f, 2.0f));
 }
+TEST(Bounds, Transform)
+{
+	Bounds bounds(Float3(1.0f, 0.0f, 0.0f), Float3(1.0f, 2.0f, 3.0f));
+	Float4x4 matrix = Float4x4::TRS(Float3(0.0f, 5.0f, 0.0f), Float3x3::RotateZ(mathf::PI_2), Float3(2.0f));
+	Bounds result = bounds.Transform(matrix);
+	EXPECT_NEAR3(result.center, Float3(0.0f, 7.0f, 0.0f), 1e-5f);
+	EXPECT_NEAR3(result.extents, Float3(4.0f, 2.0f, 6.0f), 1e-5f);
+}
 
 
 
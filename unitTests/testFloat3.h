@@ -4,6 +4,16 @@
 
 
 // Constructors:
+TEST(Float3, Constexpr)
+{
+	constexpr Float3 a = Float3(1.0f, 2.0f, 3.0f);
+	constexpr Float3 b = 2.0f * a - Float3::one;
+	static_assert(b == Float3(1.0f, 3.0f, 5.0f));
+	static_assert(Float3::Dot(a, Float3::forward) == 3.0f);
+	static_assert(Float3::Cross(Float3::right, Float3::up) == Float3::forward);
+	static_assert(Float3::Max(a, b)[2] == 5.0f);
+	EXPECT_FLOAT3_EQ(b, Float3(1.0f, 3.0f, 5.0f));
+}
 TEST(Float3, DirectionConstructor)
 {
 	Float3 direction = Float3::Direction(mathf::PI_4, mathf::PI_4);
@@ -137,6 +137,16 @@ TEST(Float3x3, RotateFromTo)
 	Float3 v1 = rotMatrix * v0;
 	EXPECT_NEAR3(v1, to, epsilon);
 }
+TEST(Float3x3, RotateFromToAntiparallel)
+{
+	Float3 directions[4] = { Float3::right, Float3::up, Float3::forward, Float3(1.0f, -2.0f, 0.5f).Normalize() };
+	for (const Float3& from : directions)
+	{
+		Float3x3 rotMatrix = Float3x3::RotateFromTo(from, -from);
+		EXPECT_NEAR(rotMatrix.Determinant(), 1.0f, 1e-5f);
+		EXPECT_NEAR3((rotMatrix * from), (-from), 1e-5f);
+	}
+}
 //TEST(Float3x3, RotateThreeLeg)
 //{
 //  Wrong, but will need changing once world coordinate system has been changed
@@ -4,6 +4,17 @@
 
 
 // Static constructors:
+TEST(Float4x4, Constexpr)
+{
+	constexpr Float4x4 matrix = Float4x4::Rows
+	(1.0f, 0.0f, 0.0f, 0.0f,
+	 0.0f, 1.0f, 0.0f, 0.0f,
+	 0.0f, 0.0f, 1.0f, 0.0f,
+	 0.0f, 0.0f, 0.0f, 1.0f);
+	static_assert(matrix.data[0] == Float4x4::identity.data[0] && matrix.data[5] == Float4x4::identity.data[5]);
+	static_assert(Float4x4::zero.data[15] == 0.0f);
+	EXPECT_EQ(matrix, Float4x4::identity);
+}
 TEST(Float4x4, ConstructorRowsScalar)
 {
 	Float4 row0 = Float4(1.0f, 2.0f, 3.0f, 4.0f);
@@ -107,6 +118,18 @@ TEST(Float4x4, InverseDet)
 	Float4x4 zero = matrix * matrixInv - Float4x4::identity;
 	EXPECT_TRUE(zero.IsEpsilonZero());
 }
+TEST(Float4x4, InverseAffine)
+{
+	Float4 row0 = Float4(4.0f, 1.0f, 2.0f, 1.0f);
+	Float4 row1 = Float4(1.0f, 3.0f, 1.0f, 2.0f);
+	Float4 row2 = Float4(0.5f, 1.0f, 4.0f, 3.0f);
+	Float4 row3 = Float4(0.0f, 0.0f, 0.0f, 1.0f);
+	Float4x4 matrix = Float4x4::Rows(row0, row1, row2, row3);
+	Float4x4 matrixInv = matrix.InverseAffine();
+	EXPECT_TRUE(matrixInv.IsEpsilonEqual(matrix.Inverse()));
+	Float4x4 zero = matrix * matrixInv - Float4x4::identity;
+	EXPECT_TRUE(zero.IsEpsilonZero());
+}
 TEST(Float4x4, IsEpsilonZero)
 {
 	Float4x4 zero = Float4x4::zero;
@@ -211,6 +234,17 @@ TEST(Float4x4, TRSFloat4x4)
 	Float4 v2 = Float4x4::Translate(position) * Float4x4::RotateY(mathf::PI_2) * Float4x4::Scale(scale) * v0;
 	EXPECT_NEAR4(v1, v2, epsilon);
 }
+TEST(Float4x4, InverseTRS)
+{
+	Float3 position = Float3(1.0f, 2.0f, 3.0f);
+	Float3x3 rotationMatrix = Float3x3::Rotate(Float3(0.3f, -1.1f, 0.7f));
+	Float3 scale = Float3(2.0f, 3.0f, 4.0f);
+	Float4x4 trsMatrix = Float4x4::TRS(position, rotationMatrix, scale);
+	Float4x4 trsMatrixInv = Float4x4::InverseTRS(position, rotationMatrix, scale);
+	EXPECT_TRUE(trsMatrixInv.IsEpsilonEqual(trsMatrix.Inverse()));
+	Float4x4 zero = trsMatrix * trsMatrixInv - Float4x4::identity;
+	EXPECT_TRUE(zero.IsEpsilonZero());
+}
 TEST(Float4x4, Perspective)
 {
 	float fov = mathf::PI_2;
@@ -358,6 +392,22 @@ TEST(Float4x4, GetScale)
 	Float3 scaleResult = trsMatrix.GetScale();
 	EXPECT_NEAR3(scaleResult, scale, epsilon);
 }
+TEST(Float4x4, GetSignedScale)
+{
+	Float3 position = Float3(1.0f, 2.0f, 3.0f);
+	Float3x3 rotationMatrix = Float3x3::RotateY(0.3f) * Float3x3::RotateX(0.7f);
+	Float3 scale = Float3(2.0f, 3.0f, 4.0f);
+	EXPECT_NEAR3(Float4x4::TRS(position, rotationMatrix, scale).GetSignedScale(), scale, epsilon);
+
+	// Mirrored along y: the decomposition must rebuild the matrix from a proper rotation and a negative scale.x:
+	Float4x4 mirrored = Float4x4::TRS(position, rotationMatrix, Float3(2.0f, -3.0f, 4.0f));
+	Float3 signedScale = mirrored.GetSignedScale();
+	Float3x3 rotationResult = mirrored.GetRotation3x3(signedScale);
+	EXPECT_LT(signedScale.x, 0.0f);
+	EXPECT_NEAR(rotationResult.Determinant(), 1.0f, 1e-5f);
+	EXPECT_TRUE(Float4x4::TRS(position, rotationResult, signedScale).IsEpsilonEqual(mirrored));
+	EXPECT_TRUE(Float4x4::TRS(position, Quaternion(rotationResult).ToFloat3x3(), signedScale).IsEpsilonEqual(mirrored));
+}
 TEST(Float4x4, GetRotation3x3)
 {
 	Float3 position = Float3(1.0f, 2.0f, 3.0f);
@@ -664,5 +714,109 @@ TEST(Float4x4, OperatorMultiplicationFloat4Left)
 }
 
 
+// Backend kernels (simd path against scalar reference):
+Float4x4 RandomFloat4x4()
+{
+	Float4x4 matrix;
+	for (int i = 0; i < 16; i++)
+		matrix[i] = mathf::Random::Uniform(-10.0f, 10.0f);
+	return matrix;
+}
+TEST(Float4x4, KernelMultiply)
+{
+	for (int n = 0; n < 100; n++)
+	{
+		Float4x4 a = RandomFloat4x4();
+		Float4x4 b = RandomFloat4x4();
+		Float4x4 reference = float4x4Kernels::scalar::Multiply(a, b);
+		Float4x4 simd = float4x4Kernels::simd::Multiply(a, b);
+		for (int i = 0; i < 16; i++)
+			EXPECT_NEAR(simd[i], reference[i], 1e-3f);
+	}
+}
+TEST(Float4x4, KernelMultiplyFloat4)
+{
+	for (int n = 0; n < 100; n++)
+	{
+		Float4x4 a = RandomFloat4x4();
+		Float4 b = Float4(mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f));
+		Float4 reference = float4x4Kernels::scalar::Multiply(a, b);
+		Float4 simd = float4x4Kernels::simd::Multiply(a, b);
+		EXPECT_NEAR4(simd, reference, 1e-3f);
+	}
+}
+TEST(Float4x4, KernelTranspose)
+{
+	Float4x4 a = RandomFloat4x4();
+	Float4x4 reference = float4x4Kernels::scalar::Transpose(a);
+	Float4x4 simd = float4x4Kernels::simd::Transpose(a);
+	EXPECT_EQ(simd, reference);
+	EXPECT_EQ(reference.GetRow(0), a.GetColumn(0));
+	EXPECT_EQ(reference.GetRow(3), a.GetColumn(3));
+}
+TEST(Float4x4, KernelAdjugate)
+{
+	for (int n = 0; n < 100; n++)
+	{
+		Float4x4 a = RandomFloat4x4();
+		Float4x4 reference = float4x4Kernels::scalar::Adjugate(a);
+		Float4x4 simd = float4x4Kernels::simd::Adjugate(a);
+		for (int i = 0; i < 16; i++)
+			EXPECT_NEAR(simd[i], reference[i], 1e-4f * (1.0f + mathf::Abs(reference[i])));
+	}
+}
+TEST(Float4x4, KernelInverse)
+{
+	for (int n = 0; n < 100; n++)
+	{
+		// Diagonally dominant, so the matrix is well conditioned:
+		Float4x4 a = RandomFloat4x4() + 40.0f * Float4x4::identity;
+		float det = a.Determinant();
+		Float4x4 reference = float4x4Kernels::scalar::Adjugate(a) / det;
+		Float4x4 simd = float4x4Kernels::simd::Adjugate(a) / det;
+		EXPECT_TRUE((a * simd).IsEpsilonEqual(Float4x4::identity));
+		EXPECT_TRUE(simd.IsEpsilonEqual(reference));
+	}
+}
+TEST(Float4x4, KernelBackend)
+{
+	// The UnitTestsScalar target defines MATHF_FORCE_SCALAR, so the simd kernels run on the scalar emulation there:
+#if defined(MATHF_FORCE_SCALAR)
+	#if !defined(MATHF_SIMD_SCALAR)
+	FAIL() << "MATHF_FORCE_SCALAR is defined, but simd.h did not select the scalar backend.";
+	#endif
+#endif
+	SUCCEED();
+}
+TEST(Float4x4, KernelExactResults)
+{
+	// Small integer entries are exact in float, so every backend must match these values bit for bit:
+	Float4x4 a = Float4x4::Rows
+	( 1.0f,  2.0f, 0.0f, -1.0f,
+	  3.0f, -2.0f, 1.0f,  0.0f,
+	  0.0f,  1.0f, 4.0f,  2.0f,
+	 -1.0f,  0.0f, 2.0f,  1.0f);
+	Float4x4 b = Float4x4::Rows
+	( 2.0f, 0.0f,  1.0f,  1.0f,
+	 -1.0f, 3.0f,  0.0f,  2.0f,
+	  1.0f, 1.0f, -2.0f,  0.0f,
+	  0.0f, 2.0f,  1.0f, -3.0f);
+	Float4 v = Float4(1.0f, -2.0f, 3.0f, 4.0f);
+	Float4x4 ab = Float4x4::Rows
+	(0.0f,  4.0f,  0.0f,  8.0f,
+	 9.0f, -5.0f,  1.0f, -1.0f,
+	 3.0f, 11.0f, -6.0f, -4.0f,
+	 0.0f,  4.0f, -4.0f, -4.0f);
+	EXPECT_EQ(float4x4Kernels::simd::Multiply(a, b), ab);
+	EXPECT_EQ(float4x4Kernels::scalar::Multiply(a, b), ab);
+	EXPECT_EQ(a * b, ab);
+	EXPECT_EQ(float4x4Kernels::simd::Multiply(a, v), Float4(-7.0f, 10.0f, 18.0f, 9.0f));
+	EXPECT_EQ(a * v, Float4(-7.0f, 10.0f, 18.0f, 9.0f));
+	EXPECT_EQ(v * a, Float4(-9.0f, 9.0f, 18.0f, 9.0f));
+	EXPECT_EQ(float4x4Kernels::simd::Transpose(a).GetRow(1), Float4(2.0f, -2.0f, 1.0f, 0.0f));
+	EXPECT_EQ(float4x4Kernels::simd::Adjugate(a), float4x4Kernels::scalar::Adjugate(a));
+}
+
+
 
 #endif // __INCLUDE_GUARD_testFloat4x4_h__
\ No newline at end of file
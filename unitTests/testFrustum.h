@@ -0,0 +1,80 @@
+#ifndef __INCLUDE_GUARD_testFrustum_h__
+#define __INCLUDE_GUARD_testFrustum_h__
+
+
+
+// Camera at origin looking down -z, 90 degree fov, near = 1, far = 100:
+Frustum TestFrustum()
+{
+	Float4x4 projection = Float4x4::Perspective(mathf::PI_2, 1.0f, 1.0f, 100.0f);
+	return Frustum(projection);
+}
+
+
+
+TEST(Frustum, Contains)
+{
+	Frustum frustum = TestFrustum();
+	EXPECT_TRUE(frustum.Contains(Float3(0.0f, 0.0f, -10.0f)));
+	EXPECT_TRUE(frustum.Contains(Float3(9.0f, -9.0f, -10.0f)));
+	EXPECT_FALSE(frustum.Contains(Float3(11.0f, 0.0f, -10.0f)));
+	EXPECT_FALSE(frustum.Contains(Float3(0.0f, 0.0f, 10.0f)));
+	EXPECT_FALSE(frustum.Contains(Float3(0.0f, 0.0f, -0.5f)));
+	EXPECT_FALSE(frustum.Contains(Float3(0.0f, 0.0f, -101.0f)));
+}
+TEST(Frustum, IntersectsSphere)
+{
+	Frustum frustum = TestFrustum();
+	EXPECT_TRUE(frustum.Intersects(Float3(0.0f, 0.0f, -10.0f), 1.0f));
+	EXPECT_TRUE(frustum.Intersects(Float3(11.0f, 0.0f, -10.0f), 1.0f));
+	EXPECT_FALSE(frustum.Intersects(Float3(13.0f, 0.0f, -10.0f), 1.0f));
+	EXPECT_FALSE(frustum.Intersects(Float3(0.0f, 0.0f, 5.0f), 1.0f));
+}
+TEST(Frustum, IntersectsBounds)
+{
+	Frustum frustum = TestFrustum();
+	EXPECT_TRUE(frustum.Intersects(Bounds(Float3(0.0f, 0.0f, -10.0f), Float3(1.0f))));
+	EXPECT_TRUE(frustum.Intersects(Bounds(Float3(10.5f, 0.0f, -10.0f), Float3(1.0f))));
+	EXPECT_FALSE(frustum.Intersects(Bounds(Float3(12.5f, 0.0f, -10.0f), Float3(1.0f))));
+	EXPECT_FALSE(frustum.Intersects(Bounds(Float3(0.0f, 0.0f, 5.0f), Float3(1.0f))));
+	EXPECT_FALSE(frustum.Intersects(Bounds(Float3(0.0f, 0.0f, -105.0f), Float3(1.0f))));
+}
+TEST(Frustum, IntersectsViewProjection)
+{
+	// Camera at (0, 0, 20) looking down -z:
+	Float4x4 view = Float4x4::Translate(Float3(0.0f, 0.0f, -20.0f));
+	Frustum frustum = Frustum(Float4x4::Perspective(mathf::PI_2, 1.0f, 1.0f, 100.0f) * view);
+	EXPECT_TRUE(frustum.Intersects(Bounds(Float3(0.0f), Float3(1.0f))));
+	EXPECT_FALSE(frustum.Intersects(Bounds(Float3(0.0f, 0.0f, 25.0f), Float3(1.0f))));
+}
+TEST(Frustum, IntersectsBatch)
+{
+	Frustum frustum = TestFrustum();
+	std::vector<Bounds> bounds(103);
+	for (Bounds& box : bounds)
+		box = Bounds(Float3(mathf::Random::Uniform(-40.0f, 40.0f), mathf::Random::Uniform(-40.0f, 40.0f), mathf::Random::Uniform(-120.0f, 20.0f)), Float3(mathf::Random::Uniform(0.0f, 5.0f)));
+	std::vector<uint8_t> results(bounds.size());
+	uint32_t count = frustum.Intersects(bounds, results);
+	uint32_t expectedCount = 0;
+	for (size_t i = 0; i < bounds.size(); i++)
+	{
+		EXPECT_EQ(results[i] != 0, frustum.Intersects(bounds[i]));
+		expectedCount += frustum.Intersects(bounds[i]);
+	}
+	EXPECT_EQ(count, expectedCount);
+}
+TEST(Frustum, ExtrudeNearPlane)
+{
+	// Orthographic light view looking down -z, near = 1, far = 10:
+	Frustum frustum = Frustum(Float4x4::Orthographic(-5.0f, 5.0f, -5.0f, 5.0f, 1.0f, 10.0f));
+	Frustum extruded = frustum.ExtrudeNearPlane();
+	Bounds behindNear = Bounds(Float3(0.0f, 0.0f, 20.0f), Float3(1.0f));
+	EXPECT_FALSE(frustum.Intersects(behindNear));
+	EXPECT_TRUE(extruded.Intersects(behindNear));
+	EXPECT_FALSE(extruded.Intersects(Bounds(Float3(0.0f, 0.0f, -20.0f), Float3(1.0f))));
+	EXPECT_FALSE(extruded.Intersects(Bounds(Float3(8.0f, 0.0f, 20.0f), Float3(1.0f))));
+}
+
+
+
+#endif // __INCLUDE_GUARD_testFrustum_h__
\ No newline at end of file
@@ -0,0 +1,229 @@
+#ifndef __INCLUDE_GUARD_testQuaternion_h__
+#define __INCLUDE_GUARD_testQuaternion_h__
+
+
+
+// Helpers:
+Quaternion RandomQuaternion()
+{
+	Float3 axis = Float3(mathf::Random::Uniform(-1.0f, 1.0f), mathf::Random::Uniform(-1.0f, 1.0f), mathf::Random::Uniform(-1.0f, 1.0f));
+	return Quaternion::Rotate(axis, mathf::Random::Uniform(-mathf::PI, mathf::PI));
+}
+
+
+
+// Constructors:
+TEST(Quaternion, ConstructorDefault)
+{
+	Quaternion q;
+	EXPECT_EQ(q, Quaternion::identity);
+}
+TEST(Quaternion, ConstructorFloat3x3)
+{
+	for (int n = 0; n < 100; n++)
+	{
+		Quaternion q = RandomQuaternion();
+		Quaternion p = Quaternion(q.ToFloat3x3());
+		// q and -q represent the same rotation:
+		if (Quaternion::Dot(p, q) < 0.0f)
+			p = -p;
+		EXPECT_NEAR4(p, q, 1e-5f);
+	}
+}
+TEST(Quaternion, ConstructorFloat4x4)
+{
+	Float4x4 matrix = Float4x4::RotateY(mathf::PI_2);
+	Quaternion q = Quaternion(matrix);
+	EXPECT_NEAR4(q, Quaternion::RotateY(mathf::PI_2), epsilon);
+}
+
+// Static constructors:
+TEST(Quaternion, RotateX)
+{
+	Float3 v = Quaternion::RotateX(mathf::PI_2) * Float3(0.0f, 1.0f, 0.0f);
+	EXPECT_NEAR3(v, Float3(0.0f, 0.0f, 1.0f), epsilon);
+}
+TEST(Quaternion, RotateY)
+{
+	Float3 v = Quaternion::RotateY(mathf::PI_2) * Float3(1.0f, 0.0f, 0.0f);
+	EXPECT_NEAR3(v, Float3(0.0f, 0.0f, -1.0f), epsilon);
+}
+TEST(Quaternion, RotateZ)
+{
+	Float3 v = Quaternion::RotateZ(mathf::PI_2) * Float3(1.0f, 0.0f, 0.0f);
+	EXPECT_NEAR3(v, Float3(0.0f, 1.0f, 0.0f), epsilon);
+}
+TEST(Quaternion, RotateAroundAxis)
+{
+	Float3 axis = Float3(1.0f, 1.0f, 0.0f);
+	Float3 v = Quaternion::Rotate(axis, mathf::PI) * Float3::right;
+	EXPECT_NEAR3(v, Float3::up, epsilon);
+}
+TEST(Quaternion, RotateByEulerAngles)
+{
+	Float3 angles = Float3(0.3f, -1.2f, 2.1f);
+	Uint3 orders[2] = { Uint3(1, 0, 2), Uint3(2, 1, 0) };
+	for (const Uint3& order : orders)
+	{
+		Float3x3 local = Quaternion::Rotate(angles, order, CoordinateSystem::local).ToFloat3x3();
+		Float3x3 world = Quaternion::Rotate(angles, order, CoordinateSystem::world).ToFloat3x3();
+		EXPECT_TRUE(local.IsEpsilonEqual(Float3x3::Rotate(angles, order, CoordinateSystem::local)));
+		EXPECT_TRUE(world.IsEpsilonEqual(Float3x3::Rotate(angles, order, CoordinateSystem::world)));
+	}
+}
+TEST(Quaternion, RotateFromTo)
+{
+	Float3 from = Float3(1.0f, 0.0f, 0.0f);
+	Float3 to = Float3(0.0f, 1.0f, 0.0f);
+	Float3 v = Quaternion::RotateFromTo(from, to) * from;
+	EXPECT_NEAR3(v, to, epsilon);
+}
+TEST(Quaternion, RotateFromToParallel)
+{
+	Float3 directions[4] = { Float3::right, Float3::up, Float3::forward, Float3(1.0f, -2.0f, 0.5f).Normalize() };
+	for (const Float3& from : directions)
+	{
+		Quaternion antiparallel = Quaternion::RotateFromTo(from, -from);
+		EXPECT_NEAR(antiparallel.Length(), 1.0f, epsilon);
+		EXPECT_NEAR3((antiparallel * from), (-from), 1e-5f);
+		EXPECT_TRUE(Quaternion::RotateFromTo(from, 2.0f * from).IsEpsilonIdentity());
+	}
+}
+
+// Math operations:
+TEST(Quaternion, Length)
+{
+	Quaternion q = Quaternion(1.0f, 2.0f, 2.0f, 4.0f);
+	EXPECT_FLOAT_EQ(q.LengthSq(), 25.0f);
+	EXPECT_FLOAT_EQ(q.Length(), 5.0f);
+}
+TEST(Quaternion, Normalize)
+{
+	Quaternion q = Quaternion(1.0f, 2.0f, 2.0f, 4.0f).Normalize();
+	EXPECT_NEAR4(q, Quaternion(0.2f, 0.4f, 0.4f, 0.8f), epsilon);
+	EXPECT_EQ(Quaternion(0.0f, 0.0f, 0.0f, 0.0f).Normalize(), Quaternion::identity);
+}
+TEST(Quaternion, Inverse)
+{
+	Quaternion q = RandomQuaternion();
+	EXPECT_TRUE((q * q.Inverse()).IsEpsilonIdentity());
+	EXPECT_TRUE(q.Inverse().IsEpsilonEqual(q.Conjugate()));
+}
+TEST(Quaternion, ToFloat3x3)
+{
+	Float3 axis = Float3(1.0f, -2.0f, 0.5f);
+	Float3x3 matrix = Quaternion::Rotate(axis, 0.7f).ToFloat3x3();
+	EXPECT_TRUE(matrix.IsEpsilonEqual(Float3x3::Rotate(axis, 0.7f)));
+}
+TEST(Quaternion, ToFloat4x4)
+{
+	Float3 axis = Float3(1.0f, -2.0f, 0.5f);
+	Float4x4 matrix = Quaternion::Rotate(axis, 0.7f).ToFloat4x4();
+	EXPECT_TRUE(matrix.IsEpsilonEqual(Float4x4::Rotate(axis, 0.7f)));
+}
+
+// Static math operations:
+TEST(Quaternion, Nlerp)
+{
+	Quaternion a = Quaternion::RotateZ(0.0f);
+	Quaternion b = Quaternion::RotateZ(mathf::PI_2);
+	EXPECT_NEAR4(Quaternion::Nlerp(a, b, 0.0f), a, epsilon);
+	EXPECT_NEAR4(Quaternion::Nlerp(a, b, 1.0f), b, epsilon);
+	EXPECT_NEAR4(Quaternion::Nlerp(a, b, 0.5f), Quaternion::RotateZ(mathf::PI_4), epsilon);
+}
+TEST(Quaternion, Slerp)
+{
+	Quaternion a = Quaternion::RotateZ(0.0f);
+	Quaternion b = Quaternion::RotateZ(mathf::PI_2);
+	EXPECT_NEAR4(Quaternion::Slerp(a, b, 0.0f), a, epsilon);
+	EXPECT_NEAR4(Quaternion::Slerp(a, b, 1.0f), b, epsilon);
+	EXPECT_NEAR4(Quaternion::Slerp(a, b, 0.25f), Quaternion::RotateZ(0.25f * mathf::PI_2), epsilon);
+}
+TEST(Quaternion, SlerpShortestArc)
+{
+	Quaternion a = Quaternion::RotateZ(0.1f);
+	Quaternion b = -Quaternion::RotateZ(0.5f);
+	Float3 v = Quaternion::Slerp(a, b, 0.5f) * Float3::right;
+	Float3 expected = Quaternion::RotateZ(0.3f) * Float3::right;
+	EXPECT_NEAR3(v, expected, 1e-5f);
+}
+
+// Multiplication:
+TEST(Quaternion, OperatorMultiplication)
+{
+	for (int n = 0; n < 100; n++)
+	{
+		Quaternion a = RandomQuaternion();
+		Quaternion b = RandomQuaternion();
+		Float3x3 product = (a * b).ToFloat3x3();
+		EXPECT_TRUE(product.IsEpsilonEqual(a.ToFloat3x3() * b.ToFloat3x3()));
+	}
+}
+TEST(Quaternion, OperatorMultiplicationAssignment)
+{
+	Quaternion a = RandomQuaternion();
+	Quaternion b = RandomQuaternion();
+	Quaternion c = a;
+	c *= b;
+	EXPECT_EQ(c, a * b);
+}
+TEST(Quaternion, OperatorMultiplicationFloat3)
+{
+	for (int n = 0; n < 100; n++)
+	{
+		Quaternion q = RandomQuaternion();
+		Float3 v = Float3(mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f));
+		Float3 rotated = q * v;
+		Float3 expected = q.ToFloat3x3() * v;
+		EXPECT_NEAR3(rotated, expected, 1e-4f);
+	}
+}
+
+// Comparison:
+TEST(Quaternion, IsEpsilonIdentity)
+{
+	EXPECT_TRUE(Quaternion::identity.IsEpsilonIdentity());
+	EXPECT_TRUE((-Quaternion::identity).IsEpsilonIdentity());
+	EXPECT_FALSE(Quaternion::RotateX(0.1f).IsEpsilonIdentity());
+}
+TEST(Quaternion, OperatorEquality)
+{
+	Quaternion a = Quaternion(1.0f, 2.0f, 3.0f, 4.0f);
+	Quaternion b = Quaternion(1.0f, 2.0f, 3.0f, 4.0f);
+	EXPECT_TRUE(a == b);
+	EXPECT_FALSE(a != b);
+}
+
+// Backend kernels (simd path against scalar reference):
+TEST(Quaternion, KernelMultiply)
+{
+	for (int n = 0; n < 100; n++)
+	{
+		Quaternion a = RandomQuaternion();
+		Quaternion b = RandomQuaternion();
+		EXPECT_NEAR4(quaternionKernels::simd::Multiply(a, b), quaternionKernels::scalar::Multiply(a, b), 1e-6f);
+	}
+}
+TEST(Quaternion, KernelNormalize)
+{
+	for (int n = 0; n < 100; n++)
+	{
+		Quaternion q = Quaternion(mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f), mathf::Random::Uniform(-10.0f, 10.0f));
+		EXPECT_NEAR4(quaternionKernels::simd::Normalize(q), quaternionKernels::scalar::Normalize(q), 1e-6f);
+	}
+}
+TEST(Quaternion, KernelNlerpSlerp)
+{
+	for (int n = 0; n < 100; n++)
+	{
+		Quaternion a = RandomQuaternion();
+		Quaternion b = RandomQuaternion();
+		float t = mathf::Random::Uniform(0.0f, 1.0f);
+		EXPECT_NEAR4(quaternionKernels::simd::Nlerp(a, b, t), quaternionKernels::scalar::Nlerp(a, b, t), 1e-6f);
+		EXPECT_NEAR4(quaternionKernels::simd::Slerp(a, b, t), quaternionKernels::scalar::Slerp(a, b, t), 1e-6f);
+	}
+}
+
+
+
+#endif // __INCLUDE_GUARD_testQuaternion_h__
\ No newline at end of file
@@ -0,0 +1,114 @@
+#ifndef __INCLUDE_GUARD_testRadixSort_h__
+#define __INCLUDE_GUARD_testRadixSort_h__
+#include "radixSort.h"
+#include <algorithm>
+#include <random>
+
+
+
+// Items with the given keys, the value is the original index to check stability:
+std::vector<SortItem> SortItems(const std::vector<uint64_t>& keys)
+{
+	std::vector<SortItem> items(keys.size());
+	for (uint32_t i = 0; i < keys.size(); i++)
+		items[i] = SortItem{ keys[i], i };
+	return items;
+}
+// Random keys whose bits outside of mask are zero, i.e. digits that are zero in all keys:
+std::vector<uint64_t> RandomKeys(size_t count, uint64_t mask, uint64_t seed)
+{
+	std::mt19937_64 generator(seed);
+	std::vector<uint64_t> keys(count);
+	for (uint64_t& key : keys)
+		key = generator() & mask;
+	return keys;
+}
+void ExpectStableSorted(const std::vector<SortItem>& items, const std::vector<uint64_t>& keys)
+{
+	std::vector<SortItem> expected = SortItems(keys);
+	std::stable_sort(expected.begin(), expected.end(), [](const SortItem& a, const SortItem& b) { return a.key < b.key; });
+	ASSERT_EQ(items.size(), expected.size());
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		EXPECT_EQ(items[i].key, expected[i].key) << "i = " << i;
+		EXPECT_EQ(items[i].value, expected[i].value) << "i = " << i;
+	}
+}
+
+
+
+TEST(RadixSort, EmptyAndSingle)
+{
+	std::vector<SortItem> scratch;
+	std::vector<SortItem> items;
+	RadixSort::Sort(items, scratch);
+	EXPECT_TRUE(items.empty());
+
+	items = { SortItem{ 42, 7 } };
+	RadixSort::Sort(items, scratch);
+	ASSERT_EQ(items.size(), 1u);
+	EXPECT_EQ(items[0].key, 42u);
+	EXPECT_EQ(items[0].value, 7u);
+}
+TEST(RadixSort, StableWithEqualKeys)
+{
+	std::vector<uint64_t> keys = RandomKeys(1000, 0x0300000000000003ull, 1);
+	std::vector<SortItem> items = SortItems(keys);
+	std::vector<SortItem> scratch;
+	RadixSort::Sort(items, scratch);
+	for (size_t i = 1; i < items.size(); i++)
+	{
+		EXPECT_LE(items[i - 1].key, items[i].key);
+		if (items[i - 1].key == items[i].key)
+		{
+			EXPECT_LT(items[i - 1].value, items[i].value);
+		}
+	}
+}
+TEST(RadixSort, MatchesStableSort)
+{
+	// Full keys, sparse keys and keys with many duplicates, with one scratch vector reused across calls:
+	std::vector<SortItem> scratch;
+	for (uint64_t mask : { ~0ull, 0xFF00FF00000000FFull, 0x000000000000000Full, 0x8000000000000001ull })
+		for (size_t count : { 2, 3, 255, 256, 257, 5000 })
+		{
+			std::vector<uint64_t> keys = RandomKeys(count, mask, mask ^ count);
+			std::vector<SortItem> items = SortItems(keys);
+			RadixSort::Sort(items, scratch);
+			ExpectStableSorted(items, keys);
+		}
+}
+TEST(RadixSort, SkipsConstantDigits)
+{
+	// All digits are constant, no pass may touch the scratch vector:
+	std::vector<uint64_t> keys(100, 0x0123456789ABCDEFull);
+	std::vector<SortItem> items = SortItems(keys);
+	std::vector<SortItem> scratch(100, SortItem{ 0, UINT32_MAX });
+	RadixSort::Sort(items, scratch);
+	ExpectStableSorted(items, keys);
+	for (const SortItem& item : scratch)
+		EXPECT_EQ(item.value, UINT32_MAX);
+}
+TEST(RadixSort, OddPassCount)
+{
+	// Keys only differ in one digit, the single executed pass reads the input and writes the result into scratch,
+	// which must end up in items. Had all eight passes run, scratch would hold an already sorted array:
+	std::vector<uint64_t> keys = RandomKeys(1000, 0x00000000FF000000ull, 2);
+	std::vector<SortItem> items = SortItems(keys);
+	std::vector<SortItem> scratch;
+	RadixSort::Sort(items, scratch);
+	ExpectStableSorted(items, keys);
+	ASSERT_EQ(scratch.size(), keys.size());
+	for (uint32_t i = 0; i < scratch.size(); i++)
+		EXPECT_EQ(scratch[i].value, i);
+
+	// Three executed passes:
+	keys = RandomKeys(1000, 0x00FF0000FF0000FFull, 3);
+	items = SortItems(keys);
+	RadixSort::Sort(items, scratch);
+	ExpectStableSorted(items, keys);
+}
+
+
+
+#endif // __INCLUDE_GUARD_testRadixSort_h__
\ No newline at end of file
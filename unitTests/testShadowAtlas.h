@@ -0,0 +1,154 @@
+#ifndef __INCLUDE_GUARD_testShadowAtlas_h__
+#define __INCLUDE_GUARD_testShadowAtlas_h__
+#include "shadowAtlas.h"
+
+
+
+// All requests belong to one light, the face identifies the tile:
+static const int s_atlasTestLight = 0;
+std::vector<ShadowTileRequest> TileRequests(const std::vector<uint32_t>& sizes, uint32_t firstFace = 0)
+{
+	std::vector<ShadowTileRequest> requests(sizes.size());
+	for (uint32_t i = 0; i < sizes.size(); i++)
+		requests[i] = ShadowTileRequest{ &s_atlasTestLight, firstFace + i, sizes[i], ShadowTile{}, false };
+	return requests;
+}
+bool TilesOverlap(const ShadowTile& a, const ShadowTile& b)
+{
+	return a.x < b.x + b.size && b.x < a.x + a.size && a.y < b.y + b.size && b.y < a.y + a.size;
+}
+void ExpectDisjointTiles(const std::vector<ShadowTileRequest>& requests, uint32_t atlasSize)
+{
+	for (uint32_t i = 0; i < requests.size(); i++)
+	{
+		const ShadowTile& tile = requests[i].tile;
+		if (tile.size == 0)
+			continue;
+		EXPECT_LE(tile.x + tile.size, atlasSize);
+		EXPECT_LE(tile.y + tile.size, atlasSize);
+		EXPECT_EQ(tile.x % tile.size, 0u);
+		EXPECT_EQ(tile.y % tile.size, 0u);
+		for (uint32_t j = i + 1; j < requests.size(); j++)
+			if (requests[j].tile.size != 0)
+			{
+				EXPECT_FALSE(TilesOverlap(tile, requests[j].tile)) << "tiles " << i << " and " << j;
+			}
+	}
+}
+
+
+
+TEST(ShadowAtlas, SplitsIntoDisjointTiles)
+{
+	// One 512, two 256 and forty 128 tiles cover the 1024 atlas exactly:
+	std::vector<uint32_t> sizes = { 512, 256, 256 };
+	sizes.resize(43, 128);
+	std::vector<ShadowTileRequest> requests = TileRequests(sizes);
+	ShadowAtlas atlas(1024);
+	atlas.Allocate(requests);
+	for (uint32_t i = 0; i < requests.size(); i++)
+	{
+		EXPECT_EQ(requests[i].tile.size, sizes[i]);
+		EXPECT_TRUE(requests[i].isNewTile);
+	}
+	ExpectDisjointTiles(requests, 1024);
+}
+TEST(ShadowAtlas, FailsWhenFull)
+{
+	// 65 minimum size tiles do not fit into 64 slots, exactly one request is left without a tile:
+	std::vector<ShadowTileRequest> requests = TileRequests(std::vector<uint32_t>(65, ShadowAtlas::s_minTileSize));
+	ShadowAtlas atlas(1024);
+	atlas.Allocate(requests);
+	uint32_t failedCount = 0;
+	for (const ShadowTileRequest& request : requests)
+		failedCount += request.tile.size == 0;
+	EXPECT_EQ(failedCount, 1u);
+	ExpectDisjointTiles(requests, 1024);
+}
+TEST(ShadowAtlas, HalvesLargestRequestsToFit)
+{
+	std::vector<ShadowTileRequest> requests = TileRequests({ 2048, 1024, 128 });
+	ShadowAtlas atlas(1024);
+	atlas.Allocate(requests);
+	uint64_t area = 0;
+	for (const ShadowTileRequest& request : requests)
+	{
+		EXPECT_NE(request.tile.size, 0u);
+		area += static_cast<uint64_t>(request.tile.size) * request.tile.size;
+	}
+	EXPECT_LE(area, 1024ull * 1024ull);
+	EXPECT_EQ(requests[2].tile.size, 128u);
+	ExpectDisjointTiles(requests, 1024);
+}
+TEST(ShadowAtlas, PlacesLargestFirst)
+{
+	// Requested smallest first, the 512 tile still gets the first quadrant:
+	std::vector<ShadowTileRequest> requests = TileRequests({ 128, 256, 512 });
+	ShadowAtlas atlas(1024);
+	atlas.Allocate(requests);
+	EXPECT_EQ(requests[2].tile.x, 0u);
+	EXPECT_EQ(requests[2].tile.y, 0u);
+	EXPECT_EQ(requests[2].tile.size, 512u);
+	ExpectDisjointTiles(requests, 1024);
+}
+TEST(ShadowAtlas, KeepsTilesOfUnchangedRequests)
+{
+	ShadowAtlas atlas(1024);
+	std::vector<ShadowTileRequest> first = TileRequests({ 512, 256, 128 });
+	atlas.Allocate(first);
+	atlas.SetContent(&s_atlasTestLight, 0, ShadowTileContent{ Float4x4::identity, 1 });
+
+	// Same sizes keep tile and content, a changed size gets a new tile:
+	std::vector<ShadowTileRequest> second = TileRequests({ 512, 256, 256 });
+	atlas.Allocate(second);
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		EXPECT_FALSE(second[i].isNewTile);
+		EXPECT_EQ(second[i].tile.x, first[i].tile.x);
+		EXPECT_EQ(second[i].tile.y, first[i].tile.y);
+	}
+	EXPECT_TRUE(second[2].isNewTile);
+	EXPECT_EQ(second[2].tile.size, 256u);
+	ASSERT_NE(atlas.GetContent(&s_atlasTestLight, 0), nullptr);
+	EXPECT_EQ(atlas.GetContent(&s_atlasTestLight, 0)->casterHash, 1u);
+	EXPECT_EQ(atlas.GetContent(&s_atlasTestLight, 2), nullptr);
+	ExpectDisjointTiles(second, 1024);
+}
+TEST(ShadowAtlas, MergesFreedTiles)
+{
+	// Four 256 tiles fill one 512 quadrant next to a 512 tile:
+	ShadowAtlas atlas(1024);
+	std::vector<ShadowTileRequest> first = TileRequests({ 256, 256, 256, 256, 512 });
+	atlas.Allocate(first);
+	ExpectDisjointTiles(first, 1024);
+
+	// The 256 tiles are freed and three 512 tiles requested. They only fit next to the kept tile
+	// if the freed tiles merged back into their quadrant, otherwise the atlas is repacked and the kept tile is new:
+	std::vector<ShadowTileRequest> second = TileRequests({ 512 }, 4);
+	std::vector<ShadowTileRequest> added = TileRequests({ 512, 512, 512 }, 5);
+	second.insert(second.end(), added.begin(), added.end());
+	atlas.Allocate(second);
+	EXPECT_FALSE(second[0].isNewTile);
+	EXPECT_EQ(second[0].tile.x, first[4].tile.x);
+	EXPECT_EQ(second[0].tile.y, first[4].tile.y);
+	for (const ShadowTileRequest& request : second)
+		EXPECT_EQ(request.tile.size, 512u);
+	ExpectDisjointTiles(second, 1024);
+
+	// Freeing everything merges up to the whole atlas:
+	std::vector<ShadowTileRequest> whole = TileRequests({ 1024 }, 9);
+	std::vector<ShadowTileRequest> none;
+	atlas.Allocate(none);
+	atlas.Allocate(whole);
+	EXPECT_EQ(whole[0].tile.size, 1024u);
+}
+TEST(ShadowAtlas, RequiredSize)
+{
+	EXPECT_EQ(ShadowAtlas::GetRequiredSize(TileRequests({ 128 })), ShadowAtlas::s_minAtlasSize);
+	EXPECT_EQ(ShadowAtlas::GetRequiredSize(TileRequests({ 1024, 128 })), 2048u);
+	EXPECT_EQ(ShadowAtlas::GetRequiredSize(TileRequests({ 2048, 2048, 2048, 2048, 2048 })), ShadowAtlas::s_maxAtlasSize);
+}
+
+
+
+#endif // __INCLUDE_GUARD_testShadowAtlas_h__
\ No newline at end of file
@@ -0,0 +1,158 @@
+#ifndef __INCLUDE_GUARD_testShadowCascade_h__
+#define __INCLUDE_GUARD_testShadowCascade_h__
+#include "shadowCascade.h"
+
+
+
+// Camera and light setup shared by the cascade tests:
+struct CascadeTestSetup
+{
+	Float4x4 cameraLocalToWorldMatrix = Float4x4::Translate(Float3(3.0f, 2.0f, -5.0f)) * Float4x4::RotateY(0.7f) * Float4x4::RotateX(-0.3f);
+	float fov = mathf::PI / 3.0f;
+	float aspectRatio = 16.0f / 9.0f;
+	float nearClip = 0.1f;
+	float farClip = 500.0f;
+	Float3 lightDirection = Float3(-0.4f, -1.0f, -0.3f).Normalize();
+	float splits[3] = { 0.1f, 0.3f, 0.6f };
+	float maxShadowDistance = 100.0f;
+	uint32_t shadowMapSize = 2048;
+
+	std::array<ShadowCascade, ShadowCascadeSolver::s_maxCascadeCount> Solve(uint32_t cascadeCount) const
+	{
+		std::array<ShadowCascade, ShadowCascadeSolver::s_maxCascadeCount> cascades;
+		ShadowCascadeSolver::Solve(cameraLocalToWorldMatrix, fov, aspectRatio, nearClip, farClip, lightDirection, cascadeCount, splits, maxShadowDistance, shadowMapSize, cascades);
+		return cascades;
+	}
+};
+// Texel placement is defined by the x and y rows of the light matrix. The depth row is not snapped and picks up rounding noise when the camera moves:
+bool SameTexelGrid(const ShadowCascade& a, const ShadowCascade& b)
+{
+	return a.worldToClipMatrix.GetRow(0) == b.worldToClipMatrix.GetRow(0) && a.worldToClipMatrix.GetRow(1) == b.worldToClipMatrix.GetRow(1);
+}
+// Edge length of one shadow map texel in world units, the orthographic projection scales by 1 / radius:
+float CascadeTexelSize(const ShadowCascade& cascade, uint32_t shadowMapSize)
+{
+	return 2.0f / (cascade.projectionMatrix.GetRow(0).x * shadowMapSize);
+}
+
+
+
+TEST(ShadowCascade, BoundsContainFrustumSlice)
+{
+	CascadeTestSetup setup;
+	float tanHalfFovY = mathf::Tan(0.5f * setup.fov);
+	float tanHalfFovX = setup.aspectRatio * tanHalfFovY;
+	Float3 position = Float3(setup.cameraLocalToWorldMatrix.GetColumn(3));
+	Float3 right = Float3(setup.cameraLocalToWorldMatrix.GetColumn(0));
+	Float3 up = Float3(setup.cameraLocalToWorldMatrix.GetColumn(1));
+	Float3 forward = -Float3(setup.cameraLocalToWorldMatrix.GetColumn(2));
+
+	// The corners span the caster bounds, they lie on its planes up to rounding:
+	for (uint32_t cascadeCount = 1; cascadeCount <= ShadowCascadeSolver::s_maxCascadeCount; cascadeCount++)
+	{
+		std::array<ShadowCascade, ShadowCascadeSolver::s_maxCascadeCount> cascades = setup.Solve(cascadeCount);
+		for (uint32_t i = 0; i < cascadeCount; i++)
+		{
+			const ShadowCascade& cascade = cascades[i];
+			for (float distance : { cascade.nearDistance, cascade.farDistance })
+				for (float x : { -1.0f, 1.0f })
+					for (float y : { -1.0f, 1.0f })
+					{
+						Float3 corner = position + distance * (forward + x * tanHalfFovX * right + y * tanHalfFovY * up);
+						Float4 clip = cascade.worldToClipMatrix * Float4(corner, 1.0f);
+						EXPECT_LE(mathf::Abs(clip.x), 1.0f + 1e-4f) << "cascade " << i << " of " << cascadeCount;
+						EXPECT_LE(mathf::Abs(clip.y), 1.0f + 1e-4f) << "cascade " << i << " of " << cascadeCount;
+						EXPECT_GE(clip.z, -1e-4f) << "cascade " << i << " of " << cascadeCount;
+						EXPECT_LE(clip.z, 1.0f + 1e-4f) << "cascade " << i << " of " << cascadeCount;
+						EXPECT_TRUE(cascade.casterFrustum.Intersects(corner, 1e-3f)) << "cascade " << i << " of " << cascadeCount;
+					}
+		}
+	}
+}
+TEST(ShadowCascade, WorldToClipIsProjectionTimesView)
+{
+	// The renderer draws with worldToClipMatrix, the visualization with projectionMatrix and viewMatrix:
+	CascadeTestSetup setup;
+	std::array<ShadowCascade, ShadowCascadeSolver::s_maxCascadeCount> cascades = setup.Solve(4);
+	for (uint32_t i = 0; i < 4; i++)
+		EXPECT_TRUE(cascades[i].worldToClipMatrix.IsEpsilonEqual(cascades[i].projectionMatrix * cascades[i].viewMatrix)) << "cascade " << i;
+}
+TEST(ShadowCascade, OriginSnapsToTexels)
+{
+	CascadeTestSetup setup;
+	std::array<ShadowCascade, ShadowCascadeSolver::s_maxCascadeCount> cascades = setup.Solve(4);
+	Float3 lightX = Float3(cascades[0].viewMatrix.GetRow(0));
+	Float3 lightY = Float3(cascades[0].viewMatrix.GetRow(1));
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		// Light space origin of the projection in whole texels:
+		const ShadowCascade& cascade = cascades[i];
+		float texelSize = CascadeTexelSize(cascade, setup.shadowMapSize);
+		float centerX = -cascade.projectionMatrix.GetRow(0).w / cascade.projectionMatrix.GetRow(0).x;
+		float centerY = -cascade.projectionMatrix.GetRow(1).w / cascade.projectionMatrix.GetRow(1).y;
+		EXPECT_NEAR(centerX / texelSize, std::round(centerX / texelSize), 1e-2f);
+		EXPECT_NEAR(centerY / texelSize, std::round(centerY / texelSize), 1e-2f);
+
+		// Move the camera in steps of 1/8 texel along each light axis. Once the origin has jumped by a texel,
+		// the next 3/4 texel of motion must leave the matrix unchanged:
+		for (const Float3& axis : { lightX, lightY })
+		{
+			CascadeTestSetup moved = setup;
+			ShadowCascade previous = cascade;
+			uint32_t step = 0;
+			for (; step < 16; step++)
+			{
+				moved.cameraLocalToWorldMatrix = Float4x4::Translate((step + 1) * texelSize / 8.0f * axis) * setup.cameraLocalToWorldMatrix;
+				ShadowCascade current = moved.Solve(4)[i];
+				if (!SameTexelGrid(current, previous))
+					break;
+			}
+			ASSERT_LT(step, 16u) << "origin did not follow the camera, cascade " << i;
+
+			ShadowCascade snapped = moved.Solve(4)[i];
+			for (uint32_t subStep = 1; subStep <= 6; subStep++)
+			{
+				CascadeTestSetup subTexel = moved;
+				subTexel.cameraLocalToWorldMatrix = Float4x4::Translate(subStep * texelSize / 8.0f * axis) * moved.cameraLocalToWorldMatrix;
+				ShadowCascade current = subTexel.Solve(4)[i];
+				EXPECT_TRUE(SameTexelGrid(current, snapped)) << "cascade " << i << ", sub step " << subStep;
+			}
+		}
+	}
+}
+TEST(ShadowCascade, SplitDistancesIncrease)
+{
+	CascadeTestSetup setup;
+	for (uint32_t cascadeCount = 1; cascadeCount <= ShadowCascadeSolver::s_maxCascadeCount; cascadeCount++)
+	{
+		std::array<ShadowCascade, ShadowCascadeSolver::s_maxCascadeCount> cascades = setup.Solve(cascadeCount);
+		EXPECT_FLOAT_EQ(cascades[0].nearDistance, setup.nearClip);
+		EXPECT_FLOAT_EQ(cascades[cascadeCount - 1].farDistance, setup.maxShadowDistance);
+		for (uint32_t i = 0; i < cascadeCount; i++)
+		{
+			EXPECT_LT(cascades[i].nearDistance, cascades[i].farDistance);
+			if (i > 0)
+			{
+				EXPECT_FLOAT_EQ(cascades[i].nearDistance, cascades[i - 1].farDistance);
+			}
+		}
+	}
+
+	// Unordered splits are clamped, the distances still never decrease:
+	setup.splits[0] = 0.5f;
+	setup.splits[1] = 0.2f;
+	setup.splits[2] = 0.9f;
+	std::array<ShadowCascade, ShadowCascadeSolver::s_maxCascadeCount> cascades = setup.Solve(4);
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		EXPECT_LE(cascades[i].nearDistance, cascades[i].farDistance);
+		if (i > 0)
+		{
+			EXPECT_FLOAT_EQ(cascades[i].nearDistance, cascades[i - 1].farDistance);
+		}
+	}
+}
+
+
+
+#endif // __INCLUDE_GUARD_testShadowCascade_h__
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef __INCLUDE_GUARD_testShadowUpdatePolicy_h__
+#define __INCLUDE_GUARD_testShadowUpdatePolicy_h__
+#include "shadowAtlas.h"
+#include "shadowUpdatePolicy.h"
+
+
+
+// Hash of a single caster, the mesh renderer and mesh are only used as identities:
+static const int s_policyTestMeshRenderer = 0;
+static const int s_policyTestMesh = 0;
+uint64_t HashSingleCaster(uint64_t meshVersion, const Float4x4& localToWorldMatrix)
+{
+	return ShadowUpdatePolicy::HashCaster(ShadowUpdatePolicy::s_emptyCasterHash, &s_policyTestMeshRenderer, &s_policyTestMesh, meshVersion, localToWorldMatrix);
+}
+
+
+
+TEST(ShadowUpdatePolicy, ReusesUnchangedTile)
+{
+	Float4x4 worldToClipMatrix = Float4x4::Perspective(mathf::PI_2, 1.0f, 0.1f, 10.0f);
+	uint64_t casterHash = HashSingleCaster(0, Float4x4::Translate(Float3(1.0f, 2.0f, 3.0f)));
+	ShadowTileContent content = { worldToClipMatrix, casterHash };
+	EXPECT_FALSE(ShadowUpdatePolicy::IsRenderRequired(&content, worldToClipMatrix, HashSingleCaster(0, Float4x4::Translate(Float3(1.0f, 2.0f, 3.0f)))));
+
+	// Tiles without content are always rendered, even outside of the time slice window:
+	EXPECT_TRUE(ShadowUpdatePolicy::IsRenderRequired(nullptr, worldToClipMatrix, casterHash));
+	EXPECT_TRUE(ShadowUpdatePolicy::IsCheckRequired(nullptr, false));
+	EXPECT_TRUE(ShadowUpdatePolicy::IsCheckRequired(&content, true));
+	EXPECT_FALSE(ShadowUpdatePolicy::IsCheckRequired(&content, false));
+}
+TEST(ShadowUpdatePolicy, InvalidatesChangedTile)
+{
+	Float4x4 worldToClipMatrix = Float4x4::Perspective(mathf::PI_2, 1.0f, 0.1f, 10.0f);
+	Float4x4 localToWorldMatrix = Float4x4::Translate(Float3(1.0f, 2.0f, 3.0f));
+	ShadowTileContent content = { worldToClipMatrix, HashSingleCaster(0, localToWorldMatrix) };
+
+	// Moved light:
+	Float4x4 movedLight = worldToClipMatrix * Float4x4::Translate(Float3(0.0f, 0.0f, 0.01f));
+	EXPECT_TRUE(ShadowUpdatePolicy::IsRenderRequired(&content, movedLight, content.casterHash));
+
+	// Moved caster:
+	uint64_t movedCaster = HashSingleCaster(0, Float4x4::Translate(Float3(1.0f, 2.0f, 3.001f)));
+	EXPECT_TRUE(ShadowUpdatePolicy::IsRenderRequired(&content, worldToClipMatrix, movedCaster));
+
+	// Changed mesh data:
+	uint64_t deformedMesh = HashSingleCaster(1, localToWorldMatrix);
+	EXPECT_TRUE(ShadowUpdatePolicy::IsRenderRequired(&content, worldToClipMatrix, deformedMesh));
+
+	// Caster left the view:
+	EXPECT_TRUE(ShadowUpdatePolicy::IsRenderRequired(&content, worldToClipMatrix, ShadowUpdatePolicy::s_emptyCasterHash));
+}
+TEST(ShadowUpdatePolicy, TimeSliceBudget)
+{
+	// Every frame exactly min(budget, count) views are inside the window:
+	for (uint32_t count : { 1u, 2u, 5u, 7u, 12u })
+		for (uint32_t budget : { 1u, 2u, 3u, 7u, 20u })
+		{
+			uint32_t cursor = 0;
+			for (uint32_t frame = 0; frame < 50; frame++)
+			{
+				uint32_t inWindow = 0;
+				for (uint32_t i = 0; i < count; i++)
+					inWindow += ShadowUpdatePolicy::IsInTimeSliceWindow(i, count, budget, cursor);
+				EXPECT_EQ(inWindow, std::min(budget, count)) << "count = " << count << ", budget = " << budget << ", frame = " << frame;
+				cursor = ShadowUpdatePolicy::AdvanceTimeSliceCursor(cursor, count, budget);
+			}
+		}
+
+	// A budget of 0 updates all views every frame:
+	for (uint32_t i = 0; i < 10; i++)
+		EXPECT_TRUE(ShadowUpdatePolicy::IsInTimeSliceWindow(i, 10, 0, 3));
+	EXPECT_EQ(ShadowUpdatePolicy::GetTimeSlicePeriod(10, 0), 1u);
+}
+TEST(ShadowUpdatePolicy, DirtyViewIsNeverSkippedLongerThanPeriod)
+{
+	// A view that changes in any frame is checked, and thus rendered, within GetTimeSlicePeriod() frames.
+	// The cursor may also be stale from a frame with more time sliced views:
+	for (uint32_t count : { 1u, 2u, 5u, 7u, 12u })
+		for (uint32_t budget : { 1u, 2u, 3u, 7u })
+			for (uint32_t initialCursor : { 0u, 4u, 11u })
+			{
+				uint32_t period = ShadowUpdatePolicy::GetTimeSlicePeriod(count, budget);
+				for (uint32_t view = 0; view < count; view++)
+					for (uint32_t dirtyFrame = 0; dirtyFrame < 2 * period; dirtyFrame++)
+					{
+						uint32_t cursor = initialCursor;
+						for (uint32_t frame = 0; frame < dirtyFrame; frame++)
+							cursor = ShadowUpdatePolicy::AdvanceTimeSliceCursor(cursor, count, budget);
+
+						uint32_t delay = 0;
+						while (!ShadowUpdatePolicy::IsInTimeSliceWindow(view, count, budget, cursor) && delay <= period)
+						{
+							cursor = ShadowUpdatePolicy::AdvanceTimeSliceCursor(cursor, count, budget);
+							delay++;
+						}
+						EXPECT_LT(delay, period) << "count = " << count << ", budget = " << budget << ", view = " << view << ", dirtyFrame = " << dirtyFrame;
+					}
+			}
+}
+
+
+
+#endif // __INCLUDE_GUARD_testShadowUpdatePolicy_h__
\ No newline at end of file
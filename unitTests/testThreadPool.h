@@ -0,0 +1,132 @@
+#ifndef __INCLUDE_GUARD_testThreadPool_h__
+#define __INCLUDE_GUARD_testThreadPool_h__
+#include "threadPool.h"
+#include <stdexcept>
+
+
+
+// Counts how often every task index was visited, the visit counters are atomic as tasks run concurrently:
+std::vector<uint32_t> ParallelForVisits(ThreadPool& threadPool, uint32_t taskCount)
+{
+	std::vector<std::atomic<uint32_t>> visits(taskCount);
+	threadPool.ParallelFor(taskCount, [&](uint32_t taskIndex, uint32_t threadIndex)
+	{
+		EXPECT_LT(threadIndex, threadPool.GetThreadCount());
+		visits[taskIndex]++;
+	});
+	std::vector<uint32_t> result(taskCount);
+	for (uint32_t i = 0; i < taskCount; i++)
+		result[i] = visits[i].load();
+	return result;
+}
+
+
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce)
+{
+	ThreadPool threadPool(4);
+	uint32_t threadCount = threadPool.GetThreadCount();
+	for (uint32_t taskCount : { 0u, 1u, threadCount - 1, threadCount, threadCount + 1, 1000u })
+	{
+		std::vector<uint32_t> visits = ParallelForVisits(threadPool, taskCount);
+		for (uint32_t i = 0; i < taskCount; i++)
+			EXPECT_EQ(visits[i], 1u) << "taskCount = " << taskCount << ", taskIndex = " << i;
+	}
+}
+TEST(ThreadPool, ParallelForWithoutWorkers)
+{
+	ThreadPool threadPool(1);
+	for (uint32_t taskCount : { 0u, 1u, 2u, 100u })
+	{
+		std::vector<uint32_t> visits = ParallelForVisits(threadPool, taskCount);
+		for (uint32_t i = 0; i < taskCount; i++)
+			EXPECT_EQ(visits[i], 1u) << "taskCount = " << taskCount << ", taskIndex = " << i;
+	}
+}
+TEST(ThreadPool, ParallelForBackToBack)
+{
+	// Workers of the previous call may still be on their way back to sleep when the next call starts:
+	ThreadPool threadPool(4);
+	for (uint32_t iteration = 0; iteration < 1000; iteration++)
+	{
+		uint32_t taskCount = iteration % 9;
+		std::atomic<uint32_t> first = 0;
+		std::atomic<uint32_t> second = 0;
+		threadPool.ParallelFor(taskCount, [&](uint32_t taskIndex, uint32_t /*threadIndex*/) { first += taskIndex + 1; });
+		threadPool.ParallelFor(taskCount, [&](uint32_t taskIndex, uint32_t /*threadIndex*/) { second += taskIndex + 1; });
+		EXPECT_EQ(first.load(), taskCount * (taskCount + 1) / 2);
+		EXPECT_EQ(second.load(), taskCount * (taskCount + 1) / 2);
+	}
+}
+TEST(ThreadPool, SubmitCompletesFutures)
+{
+	// Without workers the jobs run inline:
+	for (uint32_t threadCount : { 1u, 4u })
+	{
+		ThreadPool threadPool(threadCount);
+		std::vector<std::future<uint32_t>> futures;
+		for (uint32_t i = 0; i < 100; i++)
+			futures.push_back(threadPool.Submit([i]() { return i * i; }));
+		for (uint32_t i = 0; i < 100; i++)
+			EXPECT_EQ(futures[i].get(), i * i);
+	}
+}
+TEST(ThreadPool, SubmitPassesExceptions)
+{
+	for (uint32_t threadCount : { 1u, 4u })
+	{
+		ThreadPool threadPool(threadCount);
+		std::future<int> future = threadPool.Submit([]() -> int { throw std::runtime_error("job failed"); });
+		EXPECT_THROW(future.get(), std::runtime_error);
+
+		// The worker that ran the failing job keeps working:
+		std::vector<uint32_t> visits = ParallelForVisits(threadPool, 100);
+		for (uint32_t i = 0; i < 100; i++)
+			EXPECT_EQ(visits[i], 1u);
+		EXPECT_EQ(threadPool.Submit([]() { return 1; }).get(), 1);
+	}
+}
+TEST(ThreadPool, SubmitDuringParallelFor)
+{
+	// Jobs submitted from tasks and from a second thread while a ParallelFor runs must neither deadlock nor starve it.
+	// A failure shows as a hanging test:
+	ThreadPool threadPool(4);
+	std::atomic<bool> isDone = false;
+	std::atomic<uint32_t> jobCount = 0;
+	std::vector<std::future<void>> externalFutures;
+	std::thread submitter([&]()
+	{
+		while (!isDone)
+		{
+			externalFutures.push_back(threadPool.Submit([&]() { jobCount++; }));
+			std::this_thread::yield();
+		}
+	});
+
+	for (uint32_t iteration = 0; iteration < 20; iteration++)
+	{
+		std::vector<std::future<uint32_t>> taskFutures(64);
+		std::vector<std::atomic<uint32_t>> visits(64);
+		threadPool.ParallelFor(64, [&](uint32_t taskIndex, uint32_t /*threadIndex*/)
+		{
+			taskFutures[taskIndex] = threadPool.Submit([taskIndex]() { return taskIndex; });
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+			visits[taskIndex]++;
+		});
+		for (uint32_t i = 0; i < 64; i++)
+		{
+			EXPECT_EQ(visits[i].load(), 1u);
+			EXPECT_EQ(taskFutures[i].get(), i);
+		}
+	}
+
+	isDone = true;
+	submitter.join();
+	for (std::future<void>& future : externalFutures)
+		future.get();
+	EXPECT_EQ(jobCount.load(), externalFutures.size());
+}
+
+
+
+#endif // __INCLUDE_GUARD_testThreadPool_h__
\ No newline at end of file